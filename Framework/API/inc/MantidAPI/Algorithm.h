@@ -297,6 +297,11 @@ public:
 
   virtual bool processGroups();
 
+  /// Whether the base processGroups() may execute this algorithm on several
+  /// members of the input groups at the same time. Only override this to return
+  /// true if exec() is safe to run concurrently on different workspaces.
+  virtual bool supportsConcurrentGroupProcessing() const { return false; }
+
   void copyNonWorkspaceProperties(IAlgorithm *alg, int periodNum);
 
   const Parallel::Communicator &communicator() const;
@@ -436,7 +441,7 @@ protected:
 
   friend class WorkspaceHistory; // Allow workspace history loading to adjust
                                  // g_execCount
-  static size_t g_execCount;     ///< Counter to keep track of algorithm execution order
+  static std::atomic<size_t> g_execCount; ///< Counter to keep track of algorithm execution order
 
   virtual void setOtherProperties(IAlgorithm *alg, const std::string &propertyName, const std::string &propertyValue,
                                   int periodNum);
@@ -479,6 +484,14 @@ private:
 
   void linkHistoryWithLastChild();
 
+  bool processGroupMembersConcurrently() const;
+  std::shared_ptr<Algorithm> createGroupMemberAlgorithm(const size_t entry, const double startProgress,
+                                                        const double endProgress,
+                                                        std::vector<std::string> &outputWSNames);
+  void executeGroupMember(Algorithm &alg, const size_t entry) const;
+  void addGroupMemberOutputs(const std::vector<std::shared_ptr<WorkspaceGroup>> &outGroups,
+                             const std::vector<std::string> &outputWSNames) const;
+
   void logAlgorithmInfo() const;
 
   bool executeInternal();
@@ -49,6 +49,8 @@ public:
   virtual void resetAllXToSingleBin() = 0;
 
   virtual void clearMRU() const = 0;
+  /// Histogram all the spectra at once and keep the histograms until the events change
+  virtual std::size_t cacheHistograms() const = 0;
 
 protected:
   /// Protected copy constructor. May be used by childs for cloning.
@@ -11,7 +11,11 @@
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/Statistics.h"
 
+#include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace NeXus {
@@ -37,6 +41,9 @@ namespace API {
 /**
    This class contains the information about the log entries
 
+   Logs may be deferred: they are then known by name only, and the loader
+   given for them is run the first time they are accessed. Deferred logs may
+   be loaded from several threads reading the same object at once.
 
    @author Martyn Gigg, Tessella plc
    @date 02/10/201
@@ -87,6 +94,15 @@ public:
   template <class TYPE>
   void addProperty(const std::string &name, const TYPE &value, const std::string &units, bool overwrite = false);
 
+  /// Reads the value of a deferred log
+  using PropertyLoader = std::function<std::unique_ptr<Kernel::Property>()>;
+  /// Add a log whose value is only loaded when it is first accessed
+  void addDeferredProperty(const std::string &name, PropertyLoader loader, bool overwrite = false);
+  /// Is the property deferred and not loaded yet
+  bool isDeferredProperty(const std::string &name) const;
+  /// Load all the deferred properties
+  void loadDeferredProperties() const;
+
   /// Does the property exist on the object
   bool hasProperty(const std::string &name) const;
   /// Remove a named property
@@ -201,8 +217,19 @@ protected:
   static const char *PROTON_CHARGE_LOG_NAME;
 
 private:
+  /// Lock the deferred properties if there are any left to load
+  std::unique_lock<std::mutex> lockDeferredProperties() const;
+  /// Load a deferred property. The deferred properties must be locked.
+  void loadDeferredProperty(const std::string &name) const;
+
   /// Cache for the retrieved single values
   std::unique_ptr<Kernel::Cache<std::pair<std::string, Kernel::Math::StatisticType>, double>> m_singleValueCache;
+  /// Loaders of the properties that have not been read yet, keyed by upper case name
+  mutable std::map<std::string, std::pair<std::string, PropertyLoader>> m_deferredProperties;
+  /// Guards loading of the deferred properties
+  mutable std::mutex m_deferredMutex;
+  /// True while there are deferred properties left to load
+  mutable std::atomic<bool> m_hasDeferredProperties{false};
 };
 /// shared pointer to the logManager base class
 using LogManager_sptr = std::shared_ptr<LogManager>;
@@ -0,0 +1,80 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+#include "MantidGeometry/IDTypes.h"
+#include "MantidKernel/V3D.h"
+
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class SpectrumInfo;
+
+/** NeighbourGraph holds the nearest neighbours of every spectrum of a
+  workspace in compressed sparse row form.
+
+  The neighbours of the spectrum at workspace index i are the entries
+  offsets()[i] to offsets()[i + 1] of indices(), holding their workspace
+  indices, and of distances(), holding the vector from the spectrum to each
+  neighbour. Each row is sorted by spectrum number and includes the spectrum
+  itself, as returned by the nearest neighbour search. Monitors, and masked
+  spectra if requested, have no neighbours and are nobody's neighbour.
+
+  Building a graph is expensive for large instruments, so get() returns the
+  most recently built graph again for the same detector positions, spectrum
+  numbers and options. The graph is only remembered while it is in use, e.g.
+  by a WorkspaceNearestNeighbours, and is freed with its last user.
+*/
+class MANTID_API_DLL NeighbourGraph {
+public:
+  NeighbourGraph(int nNeighbours, const SpectrumInfo &spectrumInfo, const std::vector<specnum_t> &spectrumNumbers,
+                 bool ignoreMaskedDetectors = false);
+
+  static std::shared_ptr<const NeighbourGraph> get(int nNeighbours, const SpectrumInfo &spectrumInfo,
+                                                   const std::vector<specnum_t> &spectrumNumbers,
+                                                   bool ignoreMaskedDetectors = false);
+  static void clearCache();
+
+  /// @return the number of spectra, including those without neighbours
+  size_t size() const { return m_offsets.size() - 1; }
+  /// @return true if the spectrum at the given index takes part in the graph
+  bool contains(size_t index) const { return m_included[index] != 0; }
+  /// @return the number of nearest neighbours searched for each spectrum
+  int numberOfNeighbours() const { return m_nNeighbours; }
+  /// @return the largest distance between a spectrum and one of its neighbours
+  double cutoff() const { return m_cutoff; }
+
+  /// @return the start of the neighbours of each spectrum, and the end of the last one
+  const std::vector<size_t> &offsets() const { return m_offsets; }
+  /// @return the workspace indices of the neighbours
+  const std::vector<size_t> &indices() const { return m_indices; }
+  /// @return the vectors from each spectrum to its neighbours
+  const std::vector<Kernel::V3D> &distances() const { return m_distances; }
+
+private:
+  bool matches(int nNeighbours, const std::vector<specnum_t> &spectrumNumbers, bool ignoreMaskedDetectors,
+               const std::vector<char> &included, const std::vector<Kernel::V3D> &positions) const;
+  void build(const SpectrumInfo &spectrumInfo);
+
+  int m_nNeighbours;
+  bool m_ignoreMaskedDetectors;
+  std::vector<specnum_t> m_spectrumNumbers;
+  /// non-zero for the spectra in the graph
+  std::vector<char> m_included;
+  /// positions of the spectra in the graph, used to recognise a cached graph
+  std::vector<Kernel::V3D> m_positions;
+  double m_cutoff;
+  std::vector<size_t> m_offsets;
+  std::vector<size_t> m_indices;
+  std::vector<Kernel::V3D> m_distances;
+};
+
+} // namespace API
+} // namespace Mantid
@@ -0,0 +1,50 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/DllConfig.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+
+/** Parser for the element-wise workspace expressions evaluated by algorithms
+  such as EvaluateMDHistoExpression and EvaluateWorkspaceExpression, e.g.
+
+     where(A > 10, 0, (A - B) * 2.5) | ~C
+
+  Operators, from lowest to highest precedence:
+
+     |   ^   &   < > ==   + -   * /   unary - ~   **
+
+  Functions: log(x), log10(x), exp(x) and where(mask, values, otherwise).
+  Names refer to workspaces; names which are not identifiers are quoted with
+  ' or ". It is up to the caller to decide which operations it supports.
+*/
+class MANTID_API_DLL WorkspaceExpressionParser {
+public:
+  /// A node of a parsed expression
+  struct Node {
+    enum class Kind { Number, Workspace, Unary, Binary, Function };
+    Kind kind;
+    /// operator, function or workspace name
+    std::string text;
+    double value;
+    std::vector<std::unique_ptr<Node>> arguments;
+  };
+  using Node_uptr = std::unique_ptr<Node>;
+
+  static Node_uptr parse(const std::string &expression);
+  static void workspaceNames(const Node &node, std::multiset<std::string> &names);
+};
+
+} // namespace API
+} // namespace Mantid
@@ -12,6 +12,7 @@
 #include "MantidAPI/AlgorithmHistory.h"
 #include "MantidKernel/EnvironmentHistory.h"
 #include <ctime>
+#include <mutex>
 #include <set>
 
 //-----------------------------------------------------------------------------
@@ -29,6 +30,11 @@ class HistoryView;
 /** This class stores information about the Workspace History used by algorithms
   on a workspace and the environment history.
 
+  The algorithm histories are held in a chain of immutable segments that is
+  shared between copies, so copying a history, or appending to a copy, does
+  not depend on the length of the history. The chain is flattened into a
+  single list the first time the whole list is asked for.
+
   @author Dickon Champion, ISIS, RAL
   @date 21/01/2008
 */
@@ -39,7 +45,7 @@ public:
   /// Destructor
   virtual ~WorkspaceHistory() = default;
   /// Copy constructor
-  WorkspaceHistory(const WorkspaceHistory &) = default;
+  WorkspaceHistory(const WorkspaceHistory &other);
   /// Deleted copy assignment operator since m_environment has no copy
   /// assignment.
   WorkspaceHistory &operator=(const WorkspaceHistory &) = delete;
@@ -86,10 +92,16 @@ private:
   AlgorithmHistory_sptr parseAlgorithmHistory(const std::string &rawData);
   /// Find the history entries at this level in the file.
   std::set<int> findHistoryEntries(::NeXus::File *file);
+  /// A run of algorithm histories following those of the previous segment
+  struct Segment;
+  /// Return the shared chain of algorithm histories
+  std::shared_ptr<Segment> segments() const;
   /// The environment of the workspace
   const Kernel::EnvironmentHistory m_environment;
-  /// The algorithms which have been called on the workspace
-  Mantid::API::AlgorithmHistories m_algorithms;
+  /// The last segment of algorithms which have been called on the workspace
+  mutable std::shared_ptr<Segment> m_algorithms;
+  /// Guards m_algorithms while it is shared or flattened in const methods
+  mutable std::mutex m_mutex;
 };
 
 MANTID_API_DLL std::ostream &operator<<(std::ostream &, const WorkspaceHistory &);
@@ -9,14 +9,10 @@
 #include "MantidAPI/DllConfig.h"
 #include "MantidGeometry/IDTypes.h"
 #include "MantidKernel/V3D.h"
+#include <map>
 #include <memory>
-// Boost graphing
-#ifndef Q_MOC_RUN
-#define BOOST_ALLOW_DEPRECATED_HEADERS
-#include <boost/graph/adjacency_list.hpp>
-#undef BOOST_ALLOW_DEPRECATED_HEADERS
 #include <unordered_map>
-#endif
+#include <vector>
 
 namespace Mantid {
 namespace Geometry {
@@ -24,6 +20,7 @@ class Instrument;
 class IDetector;
 } // namespace Geometry
 namespace API {
+class NeighbourGraph;
 class SpectrumInfo;
 /**
  * This class is not intended for direct use. Use WorkspaceNearestNeighbourInfo
@@ -33,19 +30,10 @@ class SpectrumInfo;
  * instrument geometry. This class can be queried through calls to the
  * getNeighbours() function on a Detector object.
  *
- * This class uses the ANN Library, from David M Mount and Sunil Arya which
- * is incorporated into Mantid's Kernel module. Mantid uses version 1.1.2
- * of this library.
- * ANN is available from <http://www.cs.umd.edu/~mount/ANN/> and is released
- * under the GNU LGPL.
- *
- * Known potential issue: boost's graph has an issue that may cause compilation
- * errors in some circumstances in the current version of boost used by
- * Mantid (1.43) based on tr1::tie. This issue is fixed in later versions
- * of boost, but should in theory be guarded against by this file only being
- * included in ParameterMap.
- *
- *
+ * The neighbours are held in a NeighbourGraph, built with the ANN Library
+ * from David M Mount and Sunil Arya which is incorporated into Mantid's Kernel
+ * module. ANN is available from <http://www.cs.umd.edu/~mount/ANN/> and is
+ * released under the GNU LGPL.
  */
 class MANTID_API_DLL WorkspaceNearestNeighbours {
 public:
@@ -67,15 +55,6 @@ private:
   /// Vector of spectrum numbers
   const std::vector<specnum_t> m_spectrumNumbers;
 
-  /// typedef for Graph object used to hold the calculated information
-  using Graph =
-      boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::property<boost::vertex_name_t, int64_t>,
-                            boost::property<boost::edge_name_t, Mantid::Kernel::V3D>>;
-  /// Vertex descriptor object for Graph
-  using Vertex = boost::graph_traits<Graph>::vertex_descriptor;
-  /// map object of int to Graph Vertex descriptor
-  using MapIV = std::unordered_map<specnum_t, Vertex>;
-
   /// Construct the graph based on the given number of neighbours and the
   /// current instument and spectra-detector mapping
   void build(const int noNeighbours);
@@ -86,16 +65,10 @@ private:
   int m_noNeighbours;
   /// The largest value of the distance to a nearest neighbour
   double m_cutoff;
-  /// map between the DetectorID and the Graph node descriptor
-  MapIV m_specToVertex;
-  /// boost::graph object
-  Graph m_graph;
-  /// property map holding the node's related DetectorID's
-  boost::property_map<Graph, boost::vertex_name_t>::type m_vertexID;
-  /// property map holding the edge's related Distance value.
-  boost::property_map<Graph, boost::edge_name_t>::type m_edgeLength;
-  /// V3D for scaling
-  Kernel::V3D m_scale;
+  /// map between the spectrum numbers and the workspace indices
+  std::unordered_map<specnum_t, size_t> m_specToIndex;
+  /// The neighbours of every spectrum
+  std::shared_ptr<const NeighbourGraph> m_graph;
   /// Cached radius value. used to avoid uncessary recalculations.
   mutable double m_radius;
   /// Flag indicating that masked detectors should be ignored
@@ -34,9 +34,14 @@
 #include <Poco/RWLock.h>
 #include <Poco/Void.h>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include <json/json.h>
 
 #include <algorithm>
+#include <exception>
 #include <iterator>
 #include <map>
 #include <memory>
@@ -105,7 +110,7 @@ template MANTID_API_DLL bool Algorithm::isEmpty<std::size_t>(const std::size_t);
 //=============================================================================================
 
 /// Initialize static algorithm counter
-size_t Algorithm::g_execCount = 0;
+std::atomic<size_t> Algorithm::g_execCount{0};
 
 /// Constructor
 Algorithm::Algorithm()
@@ -1355,7 +1360,8 @@ void Algorithm::fillHistory(const std::vector<Workspace_sptr> &outputWorkspaces)
  *
  * This should be called after checkGroups(), which sets up required members.
  * It goes through each member of the group(s), creates and sets an algorithm
- * for each and executes them one by one.
+ * for each and executes them one by one, or several at a time if
+ * processGroupMembersConcurrently() allows it.
  *
  * If there are several group input workspaces, then the member of each group
  * is executed pair-wise.
@@ -1379,139 +1385,241 @@ bool Algorithm::processGroups() {
     }
   }
 
-  double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
-  // Go through each entry in the input group(s)
-  for (size_t entry = 0; entry < m_groupSize; entry++) {
-    // use create Child Algorithm that look like this one
-    Algorithm_sptr alg_sptr = this->createChildAlgorithm(this->name(), progress_proportion * static_cast<double>(entry),
-                                                         progress_proportion * (1 + static_cast<double>(entry)),
-                                                         this->isLogging(), this->version());
-    // Make a child algorithm and turn off history recording for it, but always
-    // store result in the ADS
-    alg_sptr->setChild(true);
-    alg_sptr->setAlwaysStoreInADS(true);
-    alg_sptr->enableHistoryRecordingForChild(false);
-    alg_sptr->setRethrows(true);
-
-    Algorithm *alg = alg_sptr.get();
-    // Set all non-workspace properties
-    this->copyNonWorkspaceProperties(alg, int(entry) + 1);
-
-    std::string outputBaseName;
-
-    // ---------- Set all the input workspaces ----------------------------
-    for (size_t iwp = 0; iwp < m_unrolledInputWorkspaces.size(); iwp++) {
-      std::vector<Workspace_sptr> &thisGroup = m_unrolledInputWorkspaces[iwp];
-      if (!thisGroup.empty()) {
-        // By default (for a single group) point to the first/only workspace
-        Workspace_sptr ws = thisGroup[0];
-
-        if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
-          // Either: this is the single group
-          // OR: all inputs are groups
-          // ... so get then entry^th workspace in this group
-          if (entry < thisGroup.size()) {
-            ws = thisGroup[entry];
-          } else {
-            // This can happen when one has more than one input group
-            // workspaces, having different sizes. For example one workspace
-            // group is the corrections which has N parts (e.g. weights for
-            // polarized measurement) while the other one is the actual input
-            // workspace group, where each item needs to be corrected together
-            // with all N inputs of the second group. In this case processGroup
-            // needs to be overridden, which is currently not possible in
-            // python.
-            throw std::runtime_error("Unable to process over groups; consider passing workspaces "
-                                     "one-by-one or override processGroup method of the algorithm.");
+  if (processGroupMembersConcurrently()) {
+    // Set up every member first so that the child algorithms see the same
+    // inputs, names and properties as when running them in turn
+    std::vector<Algorithm_sptr> algs(m_groupSize);
+    std::vector<std::vector<std::string>> outputWSNames(m_groupSize);
+    for (size_t entry = 0; entry < m_groupSize; entry++)
+      algs[entry] = createGroupMemberAlgorithm(entry, -1., -1., outputWSNames[entry]);
+
+    // Share the OpenMP threads between the members running at the same time
+    // so that the loops inside the child algorithms do not oversubscribe
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    const int concurrency = std::min(maxThreads, static_cast<int>(m_groupSize));
+    const int threadsPerMember = std::max(1, maxThreads / concurrency);
+    g_log.debug() << "Executing " << m_groupSize << " group members, " << concurrency << " at a time with "
+                  << threadsPerMember << " threads each\n";
+
+    Progress progress(this, 0.0, 1.0, m_groupSize);
+    std::vector<std::exception_ptr> errors(m_groupSize);
+    tbb::task_arena arena(concurrency);
+    arena.execute([&] {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, m_groupSize, 1), [&](const tbb::blocked_range<size_t> &range) {
+        for (size_t entry = range.begin(); entry != range.end(); ++entry) {
+          if (m_cancel)
+            return;
+          const int previousThreads = PARALLEL_GET_MAX_THREADS;
+          PARALLEL_SET_NUM_THREADS(threadsPerMember)
+          try {
+            executeGroupMember(*algs[entry], entry);
+          } catch (...) {
+            errors[entry] = std::current_exception();
           }
+          PARALLEL_SET_NUM_THREADS(previousThreads)
+          progress.report();
         }
-        // Append the names together
-        if (!outputBaseName.empty())
-          outputBaseName += "_";
-        outputBaseName += ws->getName();
-
-        // Set the property using the name of that workspace
-        if (auto *prop = dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
-          if (ws->getName().empty()) {
-            alg->setProperty(prop->name(), ws);
-          } else {
-            alg->setPropertyValue(prop->name(), ws->getName());
-          }
+      });
+    });
+
+    // Fill in the output groups in the order of the members. As when running
+    // them in turn, the outputs of the members which succeeded are kept if
+    // another member fails and the first failure is reported.
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      if (algs[entry]->isExecuted())
+        addGroupMemberOutputs(outGroups, outputWSNames[entry]);
+    }
+    const auto firstError = std::find_if(errors.cbegin(), errors.cend(), [](const auto &error) { return error; });
+    if (firstError != errors.cend())
+      std::rethrow_exception(*firstError);
+  } else {
+    double progress_proportion = 1.0 / static_cast<double>(m_groupSize);
+    // Go through each entry in the input group(s)
+    for (size_t entry = 0; entry < m_groupSize; entry++) {
+      std::vector<std::string> outputWSNames;
+      auto alg = createGroupMemberAlgorithm(entry, progress_proportion * static_cast<double>(entry),
+                                            progress_proportion * (1 + static_cast<double>(entry)), outputWSNames);
+      executeGroupMember(*alg, entry);
+      // this has to be done after execute() because a workspace must exist
+      // when it is added to a group
+      addGroupMemberOutputs(outGroups, outputWSNames);
+    }
+  }
+
+  // restore group notifications
+  for (auto &outGroup : outGroups) {
+    outGroup->observeADSNotifications(true);
+  }
+
+  return true;
+}
+
+/**
+ * Whether the base processGroups() runs the members of the groups
+ * concurrently. This is opt-in: the algorithm must declare that it supports it
+ * and the MultiThreaded.ConcurrentGroupProcessing setting must be enabled.
+ * Members are never run concurrently if any input is not thread-safe, e.g. a
+ * file-backed MD workspace.
+ * @return true if the group members should be executed concurrently
+ */
+bool Algorithm::processGroupMembersConcurrently() const {
+  if (m_groupSize < 2 || PARALLEL_GET_MAX_THREADS < 2 || !supportsConcurrentGroupProcessing())
+    return false;
+  if (!ConfigService::Instance().getValue<bool>("MultiThreaded.ConcurrentGroupProcessing").get_value_or(false))
+    return false;
+  return std::all_of(m_unrolledInputWorkspaces.cbegin(), m_unrolledInputWorkspaces.cend(), [](const auto &group) {
+    return std::all_of(group.cbegin(), group.cend(), [](const auto &ws) { return !ws || ws->threadSafe(); });
+  });
+}
+
+/**
+ * Create the child algorithm processing one member of the input group(s) and
+ * set its properties.
+ * @param entry :: the index of the member in the group(s)
+ * @param startProgress :: the progress of this algorithm when the child starts,
+ * or -1 for the child not to report progress
+ * @param endProgress :: the progress of this algorithm when the child ends
+ * @param outputWSNames :: set to the name of the output workspace of each pure
+ * output workspace property, or an empty string if it is not set
+ * @return the child algorithm, ready to execute
+ */
+Algorithm_sptr Algorithm::createGroupMemberAlgorithm(const size_t entry, const double startProgress,
+                                                     const double endProgress,
+                                                     std::vector<std::string> &outputWSNames) {
+  // use create Child Algorithm that look like this one
+  Algorithm_sptr alg_sptr =
+      this->createChildAlgorithm(this->name(), startProgress, endProgress, this->isLogging(), this->version());
+  // Make a child algorithm and turn off history recording for it, but always
+  // store result in the ADS
+  alg_sptr->setChild(true);
+  alg_sptr->setAlwaysStoreInADS(true);
+  alg_sptr->enableHistoryRecordingForChild(false);
+  alg_sptr->setRethrows(true);
+
+  Algorithm *alg = alg_sptr.get();
+  // Set all non-workspace properties
+  this->copyNonWorkspaceProperties(alg, int(entry) + 1);
+
+  std::string outputBaseName;
+
+  // ---------- Set all the input workspaces ----------------------------
+  for (size_t iwp = 0; iwp < m_unrolledInputWorkspaces.size(); iwp++) {
+    std::vector<Workspace_sptr> &thisGroup = m_unrolledInputWorkspaces[iwp];
+    if (!thisGroup.empty()) {
+      // By default (for a single group) point to the first/only workspace
+      Workspace_sptr ws = thisGroup[0];
+
+      if ((m_singleGroup == int(iwp)) || m_singleGroup < 0) {
+        // Either: this is the single group
+        // OR: all inputs are groups
+        // ... so get then entry^th workspace in this group
+        if (entry < thisGroup.size()) {
+          ws = thisGroup[entry];
         } else {
-          throw std::logic_error("Found a Workspace property which doesn't "
-                                 "inherit from Property.");
+          // This can happen when one has more than one input group
+          // workspaces, having different sizes. For example one workspace
+          // group is the corrections which has N parts (e.g. weights for
+          // polarized measurement) while the other one is the actual input
+          // workspace group, where each item needs to be corrected together
+          // with all N inputs of the second group. In this case processGroup
+          // needs to be overridden, which is currently not possible in
+          // python.
+          throw std::runtime_error("Unable to process over groups; consider passing workspaces "
+                                   "one-by-one or override processGroup method of the algorithm.");
         }
-      } // not an empty (i.e. optional) input
-    }   // for each InputWorkspace property
-
-    std::vector<std::string> outputWSNames(m_pureOutputWorkspaceProps.size());
-    // ---------- Set all the output workspaces ----------------------------
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      if (auto *prop = dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
-        // Default name = "in1_in2_out"
-        const std::string inName = prop->value();
-        if (inName.empty())
-          continue;
-        std::string outName;
-        if (m_groupsHaveSimilarNames) {
-          outName.append(inName).append("_").append(Strings::toString(entry + 1));
+      }
+      // Append the names together
+      if (!outputBaseName.empty())
+        outputBaseName += "_";
+      outputBaseName += ws->getName();
+
+      // Set the property using the name of that workspace
+      if (auto *prop = dynamic_cast<Property *>(m_inputWorkspaceProps[iwp])) {
+        if (ws->getName().empty()) {
+          alg->setProperty(prop->name(), ws);
         } else {
-          outName.append(outputBaseName).append("_").append(inName);
+          alg->setPropertyValue(prop->name(), ws->getName());
         }
-
-        auto inputProp =
-            std::find_if(m_inputWorkspaceProps.begin(), m_inputWorkspaceProps.end(), WorkspacePropertyValueIs(inName));
-
-        // Overwrite workspaces in any input property if they have the same
-        // name as an output (i.e. copy name button in algorithm dialog used)
-        // (only need to do this for a single input, multiple will be handled
-        // by ADS)
-        if (inputProp != m_inputWorkspaceProps.end()) {
-          const auto &inputGroup = m_unrolledInputWorkspaces[inputProp - m_inputWorkspaceProps.begin()];
-          if (!inputGroup.empty())
-            outName = inputGroup[entry]->getName();
-        }
-        // Except if all inputs had similar names, then the name is "out_1"
-
-        // Set in the output
-        alg->setPropertyValue(prop->name(), outName);
-
-        outputWSNames[owp] = outName;
       } else {
         throw std::logic_error("Found a Workspace property which doesn't "
                                "inherit from Property.");
       }
-    } // for each OutputWorkspace property
+    } // not an empty (i.e. optional) input
+  }   // for each InputWorkspace property
+
+  outputWSNames.assign(m_pureOutputWorkspaceProps.size(), std::string());
+  // ---------- Set all the output workspaces ----------------------------
+  for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+    if (auto *prop = dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp])) {
+      // Default name = "in1_in2_out"
+      const std::string inName = prop->value();
+      if (inName.empty())
+        continue;
+      std::string outName;
+      if (m_groupsHaveSimilarNames) {
+        outName.append(inName).append("_").append(Strings::toString(entry + 1));
+      } else {
+        outName.append(outputBaseName).append("_").append(inName);
+      }
 
-    // ------------ Execute the algo --------------
-    try {
-      alg->execute();
-    } catch (std::exception &e) {
-      std::ostringstream msg;
-      msg << "Execution of " << this->name() << " for group entry " << (entry + 1) << " failed: ";
-      msg << e.what(); // Add original message
-      throw std::runtime_error(msg.str());
-    }
+      auto inputProp =
+          std::find_if(m_inputWorkspaceProps.begin(), m_inputWorkspaceProps.end(), WorkspacePropertyValueIs(inName));
+
+      // Overwrite workspaces in any input property if they have the same
+      // name as an output (i.e. copy name button in algorithm dialog used)
+      // (only need to do this for a single input, multiple will be handled
+      // by ADS)
+      if (inputProp != m_inputWorkspaceProps.end()) {
+        const auto &inputGroup = m_unrolledInputWorkspaces[inputProp - m_inputWorkspaceProps.begin()];
+        if (!inputGroup.empty())
+          outName = inputGroup[entry]->getName();
+      }
+      // Except if all inputs had similar names, then the name is "out_1"
 
-    // ------------ Fill in the output workspace group ------------------
-    // this has to be done after execute() because a workspace must exist
-    // when it is added to a group
-    for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
-      auto *prop = dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp]);
-      if (prop && prop->value().empty())
-        continue;
-      // And add it to the output group
-      outGroups[owp]->add(outputWSNames[owp]);
+      // Set in the output
+      alg->setPropertyValue(prop->name(), outName);
+
+      outputWSNames[owp] = outName;
+    } else {
+      throw std::logic_error("Found a Workspace property which doesn't "
+                             "inherit from Property.");
     }
+  } // for each OutputWorkspace property
 
-  } // for each entry in each group
+  return alg_sptr;
+}
 
-  // restore group notifications
-  for (auto &outGroup : outGroups) {
-    outGroup->observeADSNotifications(true);
+/**
+ * Execute the child algorithm processing one member of the input group(s).
+ * @param alg :: the child algorithm
+ * @param entry :: the index of the member in the group(s)
+ * @throws std::runtime_error if the child algorithm fails
+ */
+void Algorithm::executeGroupMember(Algorithm &alg, const size_t entry) const {
+  try {
+    alg.execute();
+  } catch (std::exception &e) {
+    std::ostringstream msg;
+    msg << "Execution of " << this->name() << " for group entry " << (entry + 1) << " failed: ";
+    msg << e.what(); // Add original message
+    throw std::runtime_error(msg.str());
   }
+}
 
-  return true;
+/**
+ * Add the outputs of one member to the output workspace groups.
+ * @param outGroups :: the output group of each pure output workspace property
+ * @param outputWSNames :: the names set by createGroupMemberAlgorithm()
+ */
+void Algorithm::addGroupMemberOutputs(const std::vector<WorkspaceGroup_sptr> &outGroups,
+                                      const std::vector<std::string> &outputWSNames) const {
+  for (size_t owp = 0; owp < m_pureOutputWorkspaceProps.size(); owp++) {
+    auto *prop = dynamic_cast<Property *>(m_pureOutputWorkspaceProps[owp]);
+    if (prop && prop->value().empty())
+      continue;
+    // And add it to the output group
+    outGroups[owp]->add(outputWSNames[owp]);
+  }
 }
 
 //--------------------------------------------------------------------------------------------
@@ -6,12 +6,15 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAPI/LogManager.h"
 #include "MantidKernel/Cache.h"
+#include "MantidKernel/Exception.h"
 #include "MantidKernel/PropertyManager.h"
 #include "MantidKernel/PropertyNexus.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
 #include <nexus/NeXusFile.hpp>
 
+#include <algorithm>
+
 namespace Mantid::API {
 
 using namespace Kernel;
@@ -84,6 +87,13 @@ bool convertPropertyToDouble(const Property *property, double &value, const Math
          convertPropertyToDouble<uint64_t>(property, value, function) ||
          convertPropertyToDouble<float>(property, value, function);
 }
+
+/// Deferred properties are looked up by name ignoring case, like PropertyManager
+std::string deferredKey(const std::string &name) {
+  std::string key = name;
+  std::transform(key.begin(), key.end(), key.begin(), toupper);
+  return key;
+}
 } // namespace
 
 /// Name of the log entry containing the proton charge when retrieved using
@@ -99,15 +109,25 @@ LogManager::LogManager()
           std::make_unique<Kernel::Cache<std::pair<std::string, Kernel::Math::StatisticType>, double>>()) {}
 
 LogManager::LogManager(const LogManager &other)
-    : m_manager(std::make_unique<Kernel::PropertyManager>(*other.m_manager)),
-      m_singleValueCache(std::make_unique<Kernel::Cache<std::pair<std::string, Kernel::Math::StatisticType>, double>>(
-          *other.m_singleValueCache)) {}
+    : m_singleValueCache(std::make_unique<Kernel::Cache<std::pair<std::string, Kernel::Math::StatisticType>, double>>(
+          *other.m_singleValueCache)) {
+  const auto lock = other.lockDeferredProperties();
+  m_manager = std::make_unique<Kernel::PropertyManager>(*other.m_manager);
+  m_deferredProperties = other.m_deferredProperties;
+  m_hasDeferredProperties = !m_deferredProperties.empty();
+}
 
 // Defined as default in source for forward declaration with std::unique_ptr.
 LogManager::~LogManager() = default;
 
 LogManager &LogManager::operator=(const LogManager &other) {
+  if (&other == this) {
+    return *this;
+  }
+  const auto lock = other.lockDeferredProperties();
   *m_manager = *other.m_manager;
+  m_deferredProperties = other.m_deferredProperties;
+  m_hasDeferredProperties = !m_deferredProperties.empty();
   m_singleValueCache = std::make_unique<Kernel::Cache<std::pair<std::string, Kernel::Math::StatisticType>, double>>(
       *other.m_singleValueCache);
   return *this;
@@ -195,6 +215,7 @@ const Types::Core::DateAndTime LogManager::endTime() const {
  */
 void LogManager::filterByTime(const Types::Core::DateAndTime start, const Types::Core::DateAndTime stop) {
   // The propery manager operator will make all timeseriesproperties filter.
+  loadDeferredProperties();
   m_manager->filterByTime(start, stop);
 }
 
@@ -217,6 +238,7 @@ void LogManager::splitByTime(TimeSplitterType &splitter, std::vector<LogManager
   }
 
   // Now that will do the split down here.
+  loadDeferredProperties();
   m_manager->splitByTime(splitter, output_managers);
 }
 
@@ -232,6 +254,7 @@ void LogManager::filterByLog(const Kernel::TimeSeriesProperty<bool> &filter,
                              const std::vector<std::string> &excludedFromFiltering) {
   // This will invalidate the cache
   m_singleValueCache->clear();
+  loadDeferredProperties();
   m_manager->filterByProperty(filter, excludedFromFiltering);
 }
 
@@ -250,19 +273,73 @@ void LogManager::addProperty(std::unique_ptr<Kernel::Property> prop, bool overwr
   // separate locations
   // Similar we don't want more than one run_title
   std::string name = prop->name();
-  if (hasProperty(name) && (overwrite || prop->name() == PROTON_CHARGE_LOG_NAME || prop->name() == "run_title")) {
-    removeProperty(name);
+  if (hasProperty(name)) {
+    if (overwrite || prop->name() == PROTON_CHARGE_LOG_NAME || prop->name() == "run_title") {
+      // A deferred property is dropped without being loaded
+      removeProperty(name);
+    } else if (isDeferredProperty(name)) {
+      throw Exception::ExistsError("Property with given name already exists", name);
+    }
   }
   m_manager->declareProperty(std::move(prop), "");
 }
 
+//-----------------------------------------------------------------------------------------------
+/**
+ * Add a log that is only read when it is first accessed, for example when
+ * getProperty() is called with its name or getProperties() is called. It is
+ * reported by hasProperty() straight away.
+ * If the loader throws, or returns nullptr, a warning is logged and the log
+ * is dropped.
+ * @param name :: The name of the log. The loader must return a property of
+ * the same name.
+ * @param loader :: Callable reading the log
+ * @param overwrite :: If true, a current log of the same name is replaced
+ * @throws Exception::ExistsError if the log exists and overwrite is false
+ */
+void LogManager::addDeferredProperty(const std::string &name, PropertyLoader loader, bool overwrite) {
+  if (hasProperty(name)) {
+    if (!overwrite) {
+      throw Exception::ExistsError("Property with given name already exists", name);
+    }
+    removeProperty(name);
+  }
+  std::lock_guard<std::mutex> lock(m_deferredMutex);
+  m_deferredProperties.emplace(deferredKey(name), std::make_pair(name, std::move(loader)));
+  m_hasDeferredProperties = true;
+}
+
+/**
+ * @param name :: The name of the property
+ * @return True if the property exists but has not been loaded yet
+ */
+bool LogManager::isDeferredProperty(const std::string &name) const {
+  const auto lock = lockDeferredProperties();
+  return m_deferredProperties.count(deferredKey(name)) > 0;
+}
+
+/**
+ * Load all the properties that have not been loaded yet
+ */
+void LogManager::loadDeferredProperties() const {
+  const auto lock = lockDeferredProperties();
+  while (!m_deferredProperties.empty()) {
+    // Copy the name, the entry is erased by the load
+    const std::string name = m_deferredProperties.begin()->second.first;
+    loadDeferredProperty(name);
+  }
+}
+
 //-----------------------------------------------------------------------------------------------
 /**
  * Returns true if the named property exists
  * @param name :: The name of the property
  * @return True if the property exists, false otherwise
  */
-bool LogManager::hasProperty(const std::string &name) const { return m_manager->existsProperty(name); }
+bool LogManager::hasProperty(const std::string &name) const {
+  const auto lock = lockDeferredProperties();
+  return m_deferredProperties.count(deferredKey(name)) > 0 || m_manager->existsProperty(name);
+}
 
 //-----------------------------------------------------------------------------------------------
 /**
@@ -277,6 +354,10 @@ void LogManager::removeProperty(const std::string &name, bool delProperty) {
   for (unsigned int stat = 0; stat < 7; ++stat) {
     m_singleValueCache->removeCache(std::make_pair(name, static_cast<Math::StatisticType>(stat)));
   }
+  const auto lock = lockDeferredProperties();
+  if (m_deferredProperties.erase(deferredKey(name)) > 0) {
+    m_hasDeferredProperties = !m_deferredProperties.empty();
+  }
   m_manager->removeProperty(name, delProperty);
 }
 
@@ -284,12 +365,17 @@ void LogManager::removeProperty(const std::string &name, bool delProperty) {
  * Return all of the current properties
  * @returns A vector of the current list of properties
  */
-const std::vector<Kernel::Property *> &LogManager::getProperties() const { return m_manager->getProperties(); }
+const std::vector<Kernel::Property *> &LogManager::getProperties() const {
+  loadDeferredProperties();
+  return m_manager->getProperties();
+}
 
 //-----------------------------------------------------------------------------------------------
-/** Return the total memory used by the run object, in bytes.
+/** Return the total memory used by the run object, in bytes. Deferred
+ * properties are not loaded and not counted.
  */
 size_t LogManager::getMemorySize() const {
+  const auto lock = lockDeferredProperties();
   size_t total = 0;
   std::vector<Property *> props = m_manager->getProperties();
   for (auto p : props) {
@@ -401,7 +487,11 @@ int LogManager::getPropertyAsIntegerValue(const std::string &name) const {
  * it does not exist
  * @return A pointer to the named property
  */
-Kernel::Property *LogManager::getProperty(const std::string &name) const { return m_manager->getProperty(name); }
+Kernel::Property *LogManager::getProperty(const std::string &name) const {
+  const auto lock = lockDeferredProperties();
+  loadDeferredProperty(name);
+  return m_manager->getProperty(name);
+}
 
 /** Clear out the contents of all logs of type TimeSeriesProperty.
  *  Single-value properties will be left unchanged.
@@ -447,7 +537,7 @@ void LogManager::saveNexus(::NeXus::File *file, const std::string &group, bool k
   file->putAttr("version", 1);
 
   // Save all the properties as NXlog
-  std::vector<Property *> props = m_manager->getProperties();
+  std::vector<Property *> props = getProperties();
   for (auto &prop : props) {
     try {
       prop->saveProperty(file);
@@ -558,7 +648,12 @@ void LogManager::loadNexus(::NeXus::File *file, const std::map<std::string, std:
 /**
  * Clear the logs.
  */
-void LogManager::clearLogs() { m_manager->clear(); }
+void LogManager::clearLogs() {
+  const auto lock = lockDeferredProperties();
+  m_deferredProperties.clear();
+  m_hasDeferredProperties = false;
+  m_manager->clear();
+}
 
 /// Gets the correct log name for the matching invalid values log for a given
 /// log name
@@ -585,14 +680,58 @@ Kernel::TimeSeriesProperty<bool> *LogManager::getInvalidValuesFilter(const std::
   return nullptr;
 }
 
-bool LogManager::operator==(const LogManager &other) const { return *m_manager == *(other.m_manager); }
+bool LogManager::operator==(const LogManager &other) const {
+  loadDeferredProperties();
+  other.loadDeferredProperties();
+  return *m_manager == *(other.m_manager);
+}
 
-bool LogManager::operator!=(const LogManager &other) const { return *m_manager != *(other.m_manager); }
+bool LogManager::operator!=(const LogManager &other) const { return !(*this == other); }
 
 //-----------------------------------------------------------------------------------------------------------------------
 // Private methods
 //-----------------------------------------------------------------------------------------------------------------------
 
+/**
+ * While deferred properties are left, loading one changes the property
+ * manager, so every access to it must hold the lock. Once they have all been
+ * loaded the lock is no longer needed.
+ * @return A lock that owns the mutex if there are deferred properties
+ */
+std::unique_lock<std::mutex> LogManager::lockDeferredProperties() const {
+  std::unique_lock<std::mutex> lock(m_deferredMutex, std::defer_lock);
+  if (m_hasDeferredProperties) {
+    lock.lock();
+  }
+  return lock;
+}
+
+/**
+ * Load the named property if it is deferred. The caller must hold the lock
+ * returned by lockDeferredProperties().
+ * @param name :: The name of the property
+ */
+void LogManager::loadDeferredProperty(const std::string &name) const {
+  const auto entry = m_deferredProperties.find(deferredKey(name));
+  if (entry == m_deferredProperties.end()) {
+    return;
+  }
+  const auto deferred = std::move(entry->second);
+  m_deferredProperties.erase(entry);
+  try {
+    if (auto prop = deferred.second()) {
+      m_manager->declareProperty(std::move(prop), "");
+    } else {
+      g_log.warning() << "Log \"" << deferred.first << "\" could not be loaded and has been removed.\n";
+    }
+  } catch (std::exception &e) {
+    g_log.warning() << "Log \"" << deferred.first << "\" could not be loaded and has been removed: " << e.what()
+                    << "\n";
+  }
+  // Only now that the manager is complete may other threads read it without the lock
+  m_hasDeferredProperties = !m_deferredProperties.empty();
+}
+
 /** @cond */
 /// Macro to instantiate concrete template members
 #define INSTANTIATE(TYPE)                                                                                              \
@@ -0,0 +1,187 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/NeighbourGraph.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Objects/BoundingBox.h"
+// Nearest neighbours library
+#include "MantidKernel/ANN/ANN.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <numeric>
+
+namespace Mantid::API {
+using Kernel::V3D;
+
+namespace {
+/// Guards the cached graph
+std::mutex g_cacheMutex;
+/// The most recently built graph, for as long as one of its users keeps it
+std::weak_ptr<const NeighbourGraph> g_cachedGraph;
+
+/// Flag the spectra taking part in the graph: monitors are always left out
+std::vector<char> includedSpectra(const SpectrumInfo &spectrumInfo, bool ignoreMaskedDetectors) {
+  std::vector<char> included(spectrumInfo.size(), 0);
+  for (size_t i = 0; i < spectrumInfo.size(); ++i) {
+    const bool heedMasking = ignoreMaskedDetectors && spectrumInfo.isMasked(i);
+    included[i] = !spectrumInfo.isMonitor(i) && !heedMasking;
+  }
+  return included;
+}
+
+/// The positions of the included spectra, in workspace index order
+std::vector<V3D> positionsOf(const SpectrumInfo &spectrumInfo, const std::vector<char> &included) {
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < included.size(); ++i)
+    if (included[i])
+      indices.emplace_back(i);
+  std::vector<V3D> positions(indices.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(indices.size()); ++i)
+    positions[i] = spectrumInfo.position(indices[i]);
+  return positions;
+}
+} // namespace
+
+/**
+ * Constructor: builds the graph
+ * @param nNeighbours :: Number of neighbours to find for each spectrum
+ * @param spectrumInfo :: The SpectrumInfo of the workspace
+ * @param spectrumNumbers :: The spectrum numbers, in workspace index order
+ * @param ignoreMaskedDetectors :: If true, masked spectra are left out
+ * @throw std::runtime_error if there are no spectra to search
+ * @throw std::invalid_argument if there are not enough spectra for the number of neighbours
+ */
+NeighbourGraph::NeighbourGraph(int nNeighbours, const SpectrumInfo &spectrumInfo,
+                               const std::vector<specnum_t> &spectrumNumbers, bool ignoreMaskedDetectors)
+    : m_nNeighbours(nNeighbours), m_ignoreMaskedDetectors(ignoreMaskedDetectors), m_spectrumNumbers(spectrumNumbers),
+      m_included(includedSpectra(spectrumInfo, ignoreMaskedDetectors)),
+      m_positions(positionsOf(spectrumInfo, m_included)), m_cutoff(std::numeric_limits<double>::lowest()) {
+  build(spectrumInfo);
+}
+
+/**
+ * Return the graph for the given spectra, reusing the most recently built one
+ * if it is still in use and was built for the same spectrum numbers, detector
+ * positions and options.
+ * @param nNeighbours :: Number of neighbours to find for each spectrum
+ * @param spectrumInfo :: The SpectrumInfo of the workspace
+ * @param spectrumNumbers :: The spectrum numbers, in workspace index order
+ * @param ignoreMaskedDetectors :: If true, masked spectra are left out
+ * @return the neighbour graph
+ */
+std::shared_ptr<const NeighbourGraph> NeighbourGraph::get(int nNeighbours, const SpectrumInfo &spectrumInfo,
+                                                          const std::vector<specnum_t> &spectrumNumbers,
+                                                          bool ignoreMaskedDetectors) {
+  const auto included = includedSpectra(spectrumInfo, ignoreMaskedDetectors);
+  const auto positions = positionsOf(spectrumInfo, included);
+  {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    auto cachedGraph = g_cachedGraph.lock();
+    if (cachedGraph && cachedGraph->matches(nNeighbours, spectrumNumbers, ignoreMaskedDetectors, included, positions))
+      return cachedGraph;
+  }
+  auto graph = std::make_shared<const NeighbourGraph>(nNeighbours, spectrumInfo, spectrumNumbers,
+                                                      ignoreMaskedDetectors);
+  std::lock_guard<std::mutex> lock(g_cacheMutex);
+  g_cachedGraph = graph;
+  return graph;
+}
+
+/// Forget the cached graph, so that the next call to get() builds a new one
+void NeighbourGraph::clearCache() {
+  std::lock_guard<std::mutex> lock(g_cacheMutex);
+  g_cachedGraph.reset();
+}
+
+/// @return true if this graph was built for the given spectra and options
+bool NeighbourGraph::matches(int nNeighbours, const std::vector<specnum_t> &spectrumNumbers,
+                             bool ignoreMaskedDetectors, const std::vector<char> &included,
+                             const std::vector<V3D> &positions) const {
+  return m_nNeighbours == nNeighbours && m_ignoreMaskedDetectors == ignoreMaskedDetectors &&
+         m_spectrumNumbers == spectrumNumbers && m_included == included && m_positions == positions;
+}
+
+/**
+ * Find the neighbours of every included spectrum and store them row by row.
+ * @param spectrumInfo :: The SpectrumInfo of the workspace
+ */
+void NeighbourGraph::build(const SpectrumInfo &spectrumInfo) {
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < m_included.size(); ++i)
+    if (m_included[i])
+      indices.emplace_back(i);
+  if (indices.empty()) {
+    throw std::runtime_error("NearestNeighbours::build - Cannot find any spectra");
+  }
+  const auto nspectra = static_cast<int>(indices.size()); // ANN only deals with integers
+  if (m_nNeighbours >= nspectra) {
+    throw std::invalid_argument("NearestNeighbours::build - Invalid number of neighbours");
+  }
+
+  // Base the scaling on the first detector, should be adequate but we can look
+  // at this
+  Geometry::BoundingBox bbox;
+  spectrumInfo.detector(indices.front()).getBoundingBox(bbox);
+  const V3D scale(bbox.width());
+
+  ANNpointArray dataPoints = annAllocPts(nspectra, 3);
+  for (int pointNo = 0; pointNo < nspectra; ++pointNo) {
+    const V3D pos = m_positions[pointNo] / scale;
+    dataPoints[pointNo][0] = pos.X();
+    dataPoints[pointNo][1] = pos.Y();
+    dataPoints[pointNo][2] = pos.Z();
+  }
+
+  // The search keeps its state in globals of the ANN library so can not be
+  // shared between threads. Everything else is done in parallel.
+  std::vector<ANNidx> found(static_cast<size_t>(nspectra) * m_nNeighbours);
+  {
+    ANNkd_tree annTree(dataPoints, nspectra, 3);
+    std::vector<ANNdist> nnDistList(m_nNeighbours);
+    for (int pointNo = 0; pointNo < nspectra; ++pointNo) {
+      annTree.annkSearch(dataPoints[pointNo], m_nNeighbours, &found[static_cast<size_t>(pointNo) * m_nNeighbours],
+                         nnDistList.data(), 0.0);
+    }
+  }
+
+  m_offsets.assign(m_included.size() + 1, 0);
+  for (const auto index : indices)
+    m_offsets[index + 1] = m_nNeighbours;
+  std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+  m_indices.resize(found.size());
+  m_distances.resize(found.size());
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int pointNo = 0; pointNo < nspectra; ++pointNo) {
+    const auto row = &found[static_cast<size_t>(pointNo) * m_nNeighbours];
+    // Sort the row by spectrum number
+    std::sort(row, row + m_nNeighbours, [&](const ANNidx a, const ANNidx b) {
+      return m_spectrumNumbers[indices[a]] < m_spectrumNumbers[indices[b]];
+    });
+    // The distances that are returned are in our scaled coordinate
+    // system. We store the real space ones.
+    const ANNpoint scaledPos = dataPoints[pointNo];
+    const V3D realPos = V3D(scaledPos[0], scaledPos[1], scaledPos[2]) * scale;
+    const size_t offset = m_offsets[indices[pointNo]];
+    for (int i = 0; i < m_nNeighbours; ++i) {
+      const ANNidx index = row[i];
+      const V3D neighbour = V3D(dataPoints[index][0], dataPoints[index][1], dataPoints[index][2]) * scale;
+      m_indices[offset + i] = indices[index];
+      m_distances[offset + i] = neighbour - realPos;
+    }
+  }
+  for (const auto &distance : m_distances)
+    m_cutoff = std::max(m_cutoff, distance.norm());
+  annDeallocPts(dataPoints);
+  annClose();
+}
+
+} // namespace Mantid::API
@@ -77,7 +77,7 @@ bool Run::operator!=(const Run &other) { return !this->operator==(other); }
 
 std::shared_ptr<Run> Run::clone() {
   auto clone = std::make_shared<Run>();
-  for (auto property : this->m_manager->getProperties()) {
+  for (auto property : this->getProperties()) {
     clone->addProperty(property->clone());
   }
   clone->copyGoniometers(const_cast<Run &>(*this));
@@ -112,6 +112,8 @@ void Run::filterByTime(const Types::Core::DateAndTime start, const Types::Core::
  */
 Run &Run::operator+=(const Run &rhs) {
   // merge and copy properties where there is no risk of corrupting data
+  loadDeferredProperties();
+  rhs.loadDeferredProperties();
   mergeMergables(*m_manager, *rhs.m_manager);
 
   // Other properties are added together if they are on the approved list
@@ -182,16 +184,16 @@ void Run::setProtonCharge(const double charge) {
 double Run::getProtonCharge() const {
   double charge = 0.0;
 
-  if (!m_manager->existsProperty(PROTON_CHARGE_LOG_NAME) && !this->hasProperty("proton_charge")) {
+  if (!this->hasProperty(PROTON_CHARGE_LOG_NAME) && !this->hasProperty("proton_charge")) {
     g_log.notice() << "There is no proton charge associated with this workspace" << std::endl;
     return charge;
   }
 
-  if (!m_manager->existsProperty(PROTON_CHARGE_LOG_NAME)) {
+  if (!this->hasProperty(PROTON_CHARGE_LOG_NAME)) {
     integrateProtonCharge();
   }
-  if (m_manager->existsProperty(PROTON_CHARGE_LOG_NAME)) {
-    charge = m_manager->getProperty(PROTON_CHARGE_LOG_NAME);
+  if (this->hasProperty(PROTON_CHARGE_LOG_NAME)) {
+    charge = this->getPropertyValueAsType<double>(PROTON_CHARGE_LOG_NAME);
   } else {
     g_log.warning() << PROTON_CHARGE_LOG_NAME << " log was not found. Proton Charge set to 0.0\n";
   }
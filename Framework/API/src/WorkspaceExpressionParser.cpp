@@ -0,0 +1,208 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAPI/WorkspaceExpressionParser.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+
+namespace Mantid::API {
+
+namespace {
+using Node = WorkspaceExpressionParser::Node;
+using Node_uptr = WorkspaceExpressionParser::Node_uptr;
+
+Node_uptr makeNode(Node::Kind kind, std::string text, double value = 0.0) {
+  return std::make_unique<Node>(Node{kind, std::move(text), value, {}});
+}
+
+/// Recursive descent parser, see WorkspaceExpressionParser for the grammar
+class Parser {
+public:
+  explicit Parser(const std::string &expression) : m_text(expression), m_pos(0) {}
+
+  Node_uptr parse() {
+    auto node = parseBinary(0);
+    skipSpaces();
+    if (m_pos != m_text.size())
+      fail("unexpected '" + m_text.substr(m_pos, 1) + "'");
+    return node;
+  }
+
+private:
+  /// The binary operators grouped by increasing precedence
+  const std::vector<std::vector<std::string>> &binaryOperators() const {
+    static const std::vector<std::vector<std::string>> operators{
+        {"|"}, {"^"}, {"&"}, {"<", ">", "=="}, {"+", "-"}, {"*", "/"}};
+    return operators;
+  }
+
+  Node_uptr parseBinary(size_t level) {
+    if (level == binaryOperators().size())
+      return parseUnary();
+    auto lhs = parseBinary(level + 1);
+    std::string op;
+    while (matchAny(binaryOperators()[level], op)) {
+      // comparisons do not chain, i.e. "A < B < C" is an error
+      const bool comparison = binaryOperators()[level].front() == "<";
+      auto node = makeNode(Node::Kind::Binary, op);
+      node->arguments.emplace_back(std::move(lhs));
+      node->arguments.emplace_back(parseBinary(level + 1));
+      lhs = std::move(node);
+      if (comparison && matchAny(binaryOperators()[level], op))
+        fail("comparisons can not be chained");
+    }
+    return lhs;
+  }
+
+  Node_uptr parseUnary() {
+    std::string op;
+    if (matchAny({"-", "~"}, op)) {
+      auto node = makeNode(Node::Kind::Unary, op);
+      node->arguments.emplace_back(parseUnary());
+      return node;
+    }
+    return parsePower();
+  }
+
+  Node_uptr parsePower() {
+    auto base = parsePrimary();
+    std::string op;
+    if (matchAny({"**"}, op)) {
+      auto node = makeNode(Node::Kind::Binary, op);
+      node->arguments.emplace_back(std::move(base));
+      // right associative and binding more tightly than a unary minus on the
+      // left, as in python
+      node->arguments.emplace_back(parseUnary());
+      return node;
+    }
+    return base;
+  }
+
+  Node_uptr parsePrimary() {
+    skipSpaces();
+    if (m_pos == m_text.size())
+      fail("unexpected end of the expression");
+    const char c = m_text[m_pos];
+    if (c == '(') {
+      ++m_pos;
+      auto node = parseBinary(0);
+      expect(')');
+      return node;
+    }
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+      return parseNumber();
+    if (c == '\'' || c == '"') {
+      const auto end = m_text.find(c, m_pos + 1);
+      if (end == std::string::npos)
+        fail("missing closing quote");
+      auto name = m_text.substr(m_pos + 1, end - m_pos - 1);
+      m_pos = end + 1;
+      return makeNode(Node::Kind::Workspace, name);
+    }
+    if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+      const auto start = m_pos;
+      while (m_pos < m_text.size() && (std::isalnum(static_cast<unsigned char>(m_text[m_pos])) ||
+                                       m_text[m_pos] == '_' || m_text[m_pos] == '.'))
+        ++m_pos;
+      const auto name = m_text.substr(start, m_pos - start);
+      skipSpaces();
+      if (m_pos < m_text.size() && m_text[m_pos] == '(')
+        return parseFunction(name);
+      return makeNode(Node::Kind::Workspace, name);
+    }
+    fail("unexpected '" + std::string(1, c) + "'");
+  }
+
+  Node_uptr parseFunction(const std::string &name) {
+    static const std::map<std::string, size_t> functions{{"log", 1}, {"log10", 1}, {"exp", 1}, {"where", 3}};
+    const auto function = functions.find(name);
+    if (function == functions.end())
+      fail("unknown function " + name);
+    expect('(');
+    auto node = makeNode(Node::Kind::Function, name);
+    for (size_t i = 0; i < function->second; ++i) {
+      if (i > 0)
+        expect(',');
+      node->arguments.emplace_back(parseBinary(0));
+    }
+    expect(')');
+    return node;
+  }
+
+  Node_uptr parseNumber() {
+    const char *start = m_text.c_str() + m_pos;
+    char *end = nullptr;
+    const double value = std::strtod(start, &end);
+    if (end == start)
+      fail("invalid number");
+    const auto length = static_cast<size_t>(end - start);
+    auto node = makeNode(Node::Kind::Number, m_text.substr(m_pos, length), value);
+    m_pos += length;
+    return node;
+  }
+
+  void skipSpaces() {
+    while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+      ++m_pos;
+  }
+
+  /// Consume the first operator of a list found at the current position
+  bool matchAny(const std::vector<std::string> &operators, std::string &matched) {
+    skipSpaces();
+    for (const auto &op : operators) {
+      if (m_text.compare(m_pos, op.size(), op) != 0)
+        continue;
+      // "*" must not match the start of "**"
+      if (op == "*" && m_text.compare(m_pos, 2, "**") == 0)
+        continue;
+      m_pos += op.size();
+      matched = op;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char c) {
+    skipSpaces();
+    if (m_pos >= m_text.size() || m_text[m_pos] != c)
+      fail(std::string("expected '") + c + "'");
+    ++m_pos;
+  }
+
+  [[noreturn]] void fail(const std::string &message) const {
+    throw std::invalid_argument("Invalid expression at position " + std::to_string(m_pos) + ": " + message);
+  }
+
+  const std::string &m_text;
+  size_t m_pos;
+};
+
+} // namespace
+
+/** Parse an expression.
+ * @param expression :: the text of the expression
+ * @return the root of the tree of the expression
+ * @throw std::invalid_argument if the expression is not valid
+ */
+WorkspaceExpressionParser::Node_uptr WorkspaceExpressionParser::parse(const std::string &expression) {
+  return Parser(expression).parse();
+}
+
+/** Collect the names of the workspaces used by an expression
+ * @param node :: the root of the expression
+ * @param names :: the names, once per use, are added to this set
+ */
+void WorkspaceExpressionParser::workspaceNames(const Node &node, std::multiset<std::string> &names) {
+  if (node.kind == Node::Kind::Workspace)
+    names.insert(node.text);
+  for (const auto &argument : node.arguments)
+    workspaceNames(*argument, names);
+}
+
+} // namespace Mantid::API
@@ -53,11 +53,101 @@ struct AlgorithmHistoryComparator {
 };
 } // namespace
 
+/**
+ * A segment owns the algorithm histories appended after those of the previous
+ * segment. A segment is only appended to while a single WorkspaceHistory holds
+ * it, so once it is shared its contents never change.
+ */
+struct WorkspaceHistory::Segment {
+  Segment(std::shared_ptr<Segment> prev, AlgorithmHistories hist)
+      : previous(std::move(prev)), offset(previous ? previous->offset + previous->histories.size() : 0),
+        histories(std::move(hist)) {
+    // The 2^k-th predecessor is the 2^(k-1)-th predecessor of the 2^(k-1)-th one
+    for (const Segment *ancestor = previous.get(); ancestor; ancestor = ancestor->jumps[jumps.size() - 1]) {
+      jumps.emplace_back(ancestor);
+      if (ancestor->jumps.size() < jumps.size())
+        break;
+    }
+  }
+  /// Unlink the chain iteratively so a long chain does not exhaust the stack
+  ~Segment() {
+    auto prev = std::move(previous);
+    while (prev && prev.use_count() == 1) {
+      prev = std::move(prev->previous);
+    }
+  }
+  Segment(const Segment &) = delete;
+  Segment &operator=(const Segment &) = delete;
+
+  /// @return true if other is this segment or one of its predecessors
+  bool contains(const Segment *other) const {
+    for (auto segment = this; segment; segment = segment->previous.get()) {
+      if (segment == other)
+        return true;
+    }
+    return false;
+  }
+  /// @return the segment of the chain ending in this one that holds the given index
+  const Segment *find(const size_t index) const {
+    auto segment = this;
+    if (index >= segment->offset)
+      return segment;
+    // Jump back as far as possible while staying after the wanted segment
+    for (auto k = segment->jumps.size(); k-- > 0;) {
+      if (k < segment->jumps.size() && segment->jumps[k]->offset > index)
+        segment = segment->jumps[k];
+    }
+    return segment->previous.get();
+  }
+  /// @return the histories of the whole chain ending in this segment
+  AlgorithmHistories flatten() const {
+    AlgorithmHistories flat(offset + histories.size());
+    for (auto segment = this; segment; segment = segment->previous.get()) {
+      std::copy(segment->histories.cbegin(), segment->histories.cend(),
+                std::next(flat.begin(), static_cast<std::ptrdiff_t>(segment->offset)));
+    }
+    return flat;
+  }
+
+  /// The segment holding the histories before these
+  std::shared_ptr<Segment> previous;
+  /// The number of histories in the previous segments
+  size_t offset;
+  /// The histories in this segment
+  AlgorithmHistories histories;
+  /// The 1st, 2nd, 4th, 8th... predecessors, kept alive by previous
+  std::vector<const Segment *> jumps;
+};
+
 /// Default Constructor
 WorkspaceHistory::WorkspaceHistory() : m_environment() {}
 
+/**
+ * Copy constructor. The algorithm histories are shared with the original, so
+ * this does not depend on the length of the history.
+ * @param other :: The history to copy
+ */
+WorkspaceHistory::WorkspaceHistory(const WorkspaceHistory &other)
+    : m_environment(other.m_environment), m_algorithms(other.segments()) {}
+
+/// Returns the shared chain of algorithm histories
+std::shared_ptr<WorkspaceHistory::Segment> WorkspaceHistory::segments() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_algorithms;
+}
+
 /// Returns a const reference to the algorithmHistory
-const Mantid::API::AlgorithmHistories &WorkspaceHistory::getAlgorithmHistories() const { return m_algorithms; }
+const Mantid::API::AlgorithmHistories &WorkspaceHistory::getAlgorithmHistories() const {
+  static const AlgorithmHistories noHistories;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_algorithms)
+    return noHistories;
+  // Flatten the chain on first use. The segments may still be shared with
+  // other histories so they are left alone.
+  if (m_algorithms->previous)
+    m_algorithms = std::make_shared<Segment>(nullptr, m_algorithms->flatten());
+  return m_algorithms->histories;
+}
 /// Returns a const reference to the EnvironmentHistory
 const Kernel::EnvironmentHistory &WorkspaceHistory::getEnvironmentHistory() const { return m_environment; }
 
@@ -68,13 +158,22 @@ void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
     return;
   }
 
-  // Merge the histories
-  const AlgorithmHistories &otherAlgorithms = otherHistory.getAlgorithmHistories();
-
-  for (const auto &algHistory : otherAlgorithms) {
-    this->addHistory(algHistory);
+  // If one history follows on from the other the merged history is simply
+  // the longer one, and no histories need to be copied
+  const auto otherAlgorithms = otherHistory.segments();
+  if (!otherAlgorithms || (m_algorithms && m_algorithms->contains(otherAlgorithms.get()))) {
+    return;
+  }
+  if (!m_algorithms || otherAlgorithms->contains(m_algorithms.get())) {
+    m_algorithms = otherAlgorithms;
+    return;
   }
 
+  // Merge the histories
+  AlgorithmHistories merged = m_algorithms->flatten();
+  const AlgorithmHistories others = otherAlgorithms->flatten();
+  merged.insert(merged.end(), others.cbegin(), others.cend());
+
   using UniqueAlgorithmHistories =
       std::unordered_set<AlgorithmHistory_sptr, AlgorithmHistoryHasher, AlgorithmHistoryComparator>;
   // It is faster to default construct a set/unordered_set and insert the
@@ -83,35 +182,42 @@ void WorkspaceHistory::addHistory(const WorkspaceHistory &otherHistory) {
   //   "the constructor actually construct a new node for every element, before
   //   checking its value to determine if it should actually be inserted."
   UniqueAlgorithmHistories uniqueHistories;
-  for (const auto &algorithmHistory : m_algorithms) {
+  for (const auto &algorithmHistory : merged) {
     uniqueHistories.insert(algorithmHistory);
   }
-  m_algorithms.assign(std::begin(uniqueHistories), std::end(uniqueHistories));
-  std::sort(std::begin(m_algorithms), std::end(m_algorithms), AlgorithmHistorySearch());
+  merged.assign(std::begin(uniqueHistories), std::end(uniqueHistories));
+  std::sort(std::begin(merged), std::end(merged), AlgorithmHistorySearch());
+  m_algorithms = std::make_shared<Segment>(nullptr, std::move(merged));
 }
 
 /// Append an AlgorithmHistory to this WorkspaceHistory
 void WorkspaceHistory::addHistory(AlgorithmHistory_sptr algHistory) {
   // Assume it is always sorted as algorithm history should only be inserted in
-  // the correct order
-  m_algorithms.emplace_back(std::move(algHistory));
+  // the correct order. A segment shared with another history must not change
+  // so start a new one.
+  if (!m_algorithms || m_algorithms.use_count() > 1)
+    m_algorithms = std::make_shared<Segment>(std::move(m_algorithms), AlgorithmHistories());
+  m_algorithms->histories.emplace_back(std::move(algHistory));
 }
 
 /*
  Return the history length
  */
-size_t WorkspaceHistory::size() const { return m_algorithms.size(); }
+size_t WorkspaceHistory::size() const {
+  const auto algorithms = segments();
+  return algorithms ? algorithms->offset + algorithms->histories.size() : 0;
+}
 
 /**
  * Query if the history is empty or not
  * @returns True if the list is empty, false otherwise
  */
-bool WorkspaceHistory::empty() const { return m_algorithms.empty(); }
+bool WorkspaceHistory::empty() const { return size() == 0; }
 
 /**
  * Empty the list of algorithm history objects.
  */
-void WorkspaceHistory::clearHistory() { m_algorithms.clear(); }
+void WorkspaceHistory::clearHistory() { m_algorithms.reset(); }
 
 /**
  * Retrieve an algorithm history by index
@@ -123,7 +229,9 @@ AlgorithmHistory_const_sptr WorkspaceHistory::getAlgorithmHistory(const size_t i
   if (index >= this->size()) {
     throw std::out_of_range("WorkspaceHistory::getAlgorithmHistory() - Index out of range");
   }
-  return *std::next(m_algorithms.cbegin(), index);
+  const auto algorithms = segments();
+  const auto segment = algorithms->find(index);
+  return segment->histories[index - segment->offset];
 }
 
 /**
@@ -150,7 +258,7 @@ std::shared_ptr<IAlgorithm> WorkspaceHistory::getAlgorithm(const size_t index) c
  * @returns A shared pointer to the algorithm
  */
 std::shared_ptr<IAlgorithm> WorkspaceHistory::lastAlgorithm() const {
-  if (m_algorithms.empty()) {
+  if (empty()) {
     throw std::out_of_range("WorkspaceHistory::lastAlgorithm() - History contains no algorithms.");
   }
   return this->getAlgorithm(this->size() - 1);
@@ -164,7 +272,7 @@ std::shared_ptr<IAlgorithm> WorkspaceHistory::lastAlgorithm() const {
 void WorkspaceHistory::printSelf(std::ostream &os, const int indent) const {
   os << std::string(indent, ' ') << m_environment << '\n';
   os << std::string(indent, ' ') << "Histories:\n";
-  for (const auto &algorithm : m_algorithms) {
+  for (const auto &algorithm : getAlgorithmHistories()) {
     os << '\n';
     algorithm->printSelf(os, indent + 2);
   }
@@ -199,7 +307,7 @@ void WorkspaceHistory::saveNexus(::NeXus::File *file) const {
 
   // Algorithm History
   int algCount = 0;
-  for (const auto &algorithm : m_algorithms) {
+  for (const auto &algorithm : getAlgorithmHistories()) {
     algorithm->saveNexus(file, algCount);
   }
 
@@ -455,7 +563,7 @@ std::ostream &operator<<(std::ostream &os, const WorkspaceHistory &WH) {
 }
 
 bool WorkspaceHistory::operator==(const WorkspaceHistory &otherHistory) const {
-  return m_algorithms == otherHistory.m_algorithms;
+  return getAlgorithmHistories() == otherHistory.getAlgorithmHistories();
 }
 
 } // namespace Mantid::API
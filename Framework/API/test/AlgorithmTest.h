@@ -20,6 +20,7 @@
 #include "MantidAPI/WorkspaceProperty.h"
 #include "MantidFrameworkTestHelpers/FakeObjects.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/ReadLock.h"
 #include "MantidKernel/RebinParamsValidator.h"
@@ -73,6 +74,13 @@ public:
 };
 DECLARE_ALGORITHM(StubbedWorkspaceAlgorithm)
 
+class ConcurrentStubbedWorkspaceAlgorithm : public StubbedWorkspaceAlgorithm {
+public:
+  const std::string name() const override { return "ConcurrentStubbedWorkspaceAlgorithm"; }
+  bool supportsConcurrentGroupProcessing() const override { return true; }
+};
+DECLARE_ALGORITHM(ConcurrentStubbedWorkspaceAlgorithm)
+
 class StubbedWorkspaceAlgorithm2 : public Algorithm {
 public:
   StubbedWorkspaceAlgorithm2() : Algorithm() {}
@@ -151,6 +159,28 @@ const std::string FailingAlgorithm::FAIL_MSG("Algorithm failed as requested");
 
 DECLARE_ALGORITHM(FailingAlgorithm)
 
+class ConcurrentFailingAlgorithm : public FailingAlgorithm {
+public:
+  const std::string name() const override { return "ConcurrentFailingAlgorithm"; }
+  bool supportsConcurrentGroupProcessing() const override { return true; }
+
+  void init() override {
+    FailingAlgorithm::init();
+    declareProperty(
+        std::make_unique<WorkspaceProperty<>>("OutputWorkspace", "", Direction::Output, PropertyMode::Optional));
+  }
+
+  void exec() override {
+    FailingAlgorithm::exec();
+    if (!getPropertyValue("OutputWorkspace").empty()) {
+      auto out = std::make_shared<WorkspaceTester>();
+      out->initialize(1, 1, 1);
+      setProperty("OutputWorkspace", out);
+    }
+  }
+};
+DECLARE_ALGORITHM(ConcurrentFailingAlgorithm)
+
 class IndexingAlgorithm : public Algorithm {
 public:
   const std::string name() const override { return "IndexingAlgorithm"; }
@@ -629,12 +659,14 @@ public:
   //------------------------------------------------------------------------
   WorkspaceGroup_sptr do_test_groups(const std::string &group1, std::string contents1, const std::string &group2,
                                      std::string contents2, const std::string &group3, std::string contents3,
-                                     bool expectFail = false, int expectedNumber = 3) {
+                                     bool expectFail = false, int expectedNumber = 3, bool concurrent = false) {
     makeWorkspaceGroup(group1, std::move(contents1));
     makeWorkspaceGroup(group2, std::move(contents2));
     makeWorkspaceGroup(group3, std::move(contents3));
 
-    StubbedWorkspaceAlgorithm alg;
+    StubbedWorkspaceAlgorithm serialAlg;
+    ConcurrentStubbedWorkspaceAlgorithm concurrentAlg;
+    Algorithm &alg = concurrent ? concurrentAlg : serialAlg;
     alg.initialize();
     alg.setPropertyValue("InputWorkspace1", group1);
     alg.setPropertyValue("InputWorkspace2", group2);
@@ -753,6 +785,91 @@ public:
     TS_ASSERT_EQUALS(ws1->readY(0)[0], 234);
   }
 
+  void test_processGroups_concurrently_keeps_the_order_of_the_members() {
+    auto &config = ConfigService::Instance();
+    const auto previous = config.getString("MultiThreaded.ConcurrentGroupProcessing");
+    config.setString("MultiThreaded.ConcurrentGroupProcessing", "1");
+    WorkspaceGroup_sptr group = do_test_groups("A", "A_1,A_2,A_3,A_4,A_5,A_6,A_7,A_8", "B", "", "C",
+                                               "C_1,C_2,C_3,C_4,C_5,C_6,C_7,C_8", false, 8, true);
+    config.setString("MultiThreaded.ConcurrentGroupProcessing", previous);
+
+    for (size_t i = 0; i < group->size(); ++i) {
+      const auto member = std::to_string(i + 1);
+      const auto ws = std::dynamic_pointer_cast<MatrixWorkspace>(group->getItem(i));
+      TS_ASSERT_EQUALS(ws->getName(), "D_" + member);
+      TS_ASSERT_EQUALS(ws->getTitle(), "A_" + member + "+B+C_" + member);
+      TS_ASSERT_EQUALS(ws->readY(0)[0], 234);
+    }
+  }
+
+  void test_processGroups_concurrently_reports_the_failing_member() {
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4");
+    auto &config = ConfigService::Instance();
+    const auto previous = config.getString("MultiThreaded.ConcurrentGroupProcessing");
+    config.setString("MultiThreaded.ConcurrentGroupProcessing", "1");
+
+    ConcurrentFailingAlgorithm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setLogging(false);
+    alg.setPropertyValue("InputWorkspace", "A");
+    alg.setPropertyValue("WsNameToFail", "A_3");
+    TS_ASSERT_THROWS_EQUALS(alg.execute(), const std::runtime_error &e, std::string(e.what()),
+                            "Execution of ConcurrentFailingAlgorithm for group entry 3 failed: " +
+                                FailingAlgorithm::FAIL_MSG);
+    config.setString("MultiThreaded.ConcurrentGroupProcessing", previous);
+  }
+
+  void test_processGroups_concurrently_keeps_the_outputs_of_the_other_members_on_failure() {
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4");
+    auto &config = ConfigService::Instance();
+    const auto previous = config.getString("MultiThreaded.ConcurrentGroupProcessing");
+    config.setString("MultiThreaded.ConcurrentGroupProcessing", "1");
+
+    ConcurrentFailingAlgorithm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setLogging(false);
+    alg.setPropertyValue("InputWorkspace", "A");
+    alg.setPropertyValue("WsNameToFail", "A_3");
+    alg.setPropertyValue("OutputWorkspace", "D");
+    TS_ASSERT_THROWS(alg.execute(), const std::runtime_error &);
+    config.setString("MultiThreaded.ConcurrentGroupProcessing", previous);
+
+    const auto &ads = AnalysisDataService::Instance();
+    for (const auto &member : {"D_1", "D_2", "D_4"}) {
+      TS_ASSERT(ads.doesExist(member));
+    }
+    TS_ASSERT(!ads.doesExist("D_3"));
+    const auto group = ads.retrieveWS<WorkspaceGroup>("D");
+    TS_ASSERT_EQUALS(group->getNames(), std::vector<std::string>({"D_1", "D_2", "D_4"}));
+    AnalysisDataService::Instance().deepRemoveGroup("D");
+  }
+
+  void test_processGroups_concurrently_keeps_the_inputs_of_an_in_place_run_on_failure() {
+    makeWorkspaceGroup("A", "A_1,A_2,A_3,A_4");
+    const auto &ads = AnalysisDataService::Instance();
+    const auto failingInput = ads.retrieve("A_3");
+    auto &config = ConfigService::Instance();
+    const auto previous = config.getString("MultiThreaded.ConcurrentGroupProcessing");
+    config.setString("MultiThreaded.ConcurrentGroupProcessing", "1");
+
+    ConcurrentFailingAlgorithm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setLogging(false);
+    alg.setPropertyValue("InputWorkspace", "A");
+    alg.setPropertyValue("WsNameToFail", "A_3");
+    alg.setPropertyValue("OutputWorkspace", "A");
+    TS_ASSERT_THROWS(alg.execute(), const std::runtime_error &);
+    config.setString("MultiThreaded.ConcurrentGroupProcessing", previous);
+
+    for (const auto &member : {"A_1", "A_2", "A_3", "A_4"}) {
+      TS_ASSERT(ads.doesExist(member));
+    }
+    TS_ASSERT_EQUALS(ads.retrieve("A_3"), failingInput);
+  }
+
   void test_processGroups_failOnGroupMemberErrorMessage() {
     makeWorkspaceGroup("A", "A_1,A_2,A_3");
 
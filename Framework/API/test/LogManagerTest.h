@@ -18,6 +18,8 @@
 #include <cmath>
 #include <cxxtest/TestSuite.h>
 #include <json/value.h>
+#include <atomic>
+#include <thread>
 
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
@@ -586,6 +588,112 @@ public:
     }
   }
 
+  void test_deferred_property_is_loaded_on_first_access() {
+    LogManager runInfo;
+    int nLoads = 0;
+    runInfo.addDeferredProperty("deferred", [&nLoads]() {
+      ++nLoads;
+      return std::make_unique<PropertyWithValue<double>>("deferred", 3.5);
+    });
+    TS_ASSERT(runInfo.hasProperty("deferred"));
+    TS_ASSERT(runInfo.hasProperty("DEFERRED"));
+    TS_ASSERT(runInfo.isDeferredProperty("deferred"));
+    TS_ASSERT_EQUALS(nLoads, 0);
+
+    TS_ASSERT_DELTA(runInfo.getPropertyValueAsType<double>("deferred"), 3.5, 1e-12);
+    TS_ASSERT_DELTA(runInfo.getPropertyAsSingleValue("deferred"), 3.5, 1e-12);
+    TS_ASSERT(!runInfo.isDeferredProperty("deferred"));
+    TS_ASSERT_EQUALS(nLoads, 1);
+  }
+
+  void test_deferred_properties_are_loaded_by_getProperties() {
+    LogManager runInfo;
+    runInfo.addProperty<int>("loaded", 1);
+    runInfo.addDeferredProperty("deferred", []() { return std::make_unique<PropertyWithValue<int>>("deferred", 2); });
+    TS_ASSERT_EQUALS(runInfo.getProperties().size(), 2);
+    TS_ASSERT(!runInfo.isDeferredProperty("deferred"));
+  }
+
+  void test_copy_keeps_properties_deferred() {
+    LogManager runInfo;
+    int nLoads = 0;
+    runInfo.addDeferredProperty("deferred", [&nLoads]() {
+      ++nLoads;
+      return std::make_unique<PropertyWithValue<int>>("deferred", 2);
+    });
+    LogManager copy(runInfo);
+    TS_ASSERT(copy.isDeferredProperty("deferred"));
+    TS_ASSERT_EQUALS(copy.getPropertyValueAsType<int>("deferred"), 2);
+    TS_ASSERT(runInfo.isDeferredProperty("deferred"));
+    TS_ASSERT_EQUALS(nLoads, 1);
+  }
+
+  void test_deferred_property_replaces_and_is_replaced() {
+    LogManager runInfo;
+    runInfo.addProperty<int>("log", 1);
+    auto loader = []() { return std::make_unique<PropertyWithValue<int>>("log", 2); };
+    TS_ASSERT_THROWS(runInfo.addDeferredProperty("log", loader), const Exception::ExistsError &);
+    runInfo.addDeferredProperty("log", loader, true);
+    TS_ASSERT_EQUALS(runInfo.getPropertyValueAsType<int>("log"), 2);
+
+    int nLoads(0);
+    runInfo.addDeferredProperty(
+        "log",
+        [&nLoads]() {
+          ++nLoads;
+          return std::make_unique<PropertyWithValue<int>>("log", 3);
+        },
+        true);
+    TS_ASSERT_THROWS(runInfo.addProperty<int>("log", 4), const Exception::ExistsError &);
+    TS_ASSERT(runInfo.isDeferredProperty("log"));
+    runInfo.addProperty<int>("log", 4, true);
+    TS_ASSERT(!runInfo.isDeferredProperty("log"));
+    TS_ASSERT_EQUALS(runInfo.getPropertyValueAsType<int>("log"), 4);
+    TSM_ASSERT_EQUALS("A replaced deferred log is never loaded", nLoads, 0);
+
+    runInfo.addDeferredProperty(
+        "log", []() { return std::make_unique<PropertyWithValue<int>>("log", 5); }, true);
+    runInfo.removeProperty("log");
+    TS_ASSERT(!runInfo.hasProperty("log"));
+  }
+
+  void test_deferred_property_that_fails_to_load_is_removed() {
+    LogManager runInfo;
+    runInfo.addDeferredProperty("missing", []() -> std::unique_ptr<Property> {
+      throw std::runtime_error("The file has gone");
+    });
+    TS_ASSERT(runInfo.hasProperty("missing"));
+    TS_ASSERT_THROWS(runInfo.getProperty("missing"), const Exception::NotFoundError &);
+    TS_ASSERT(!runInfo.hasProperty("missing"));
+  }
+
+  void test_deferred_properties_can_be_loaded_from_several_threads() {
+    LogManager runInfo;
+    const int nLogs = 200;
+    for (int i = 0; i < nLogs; ++i) {
+      const std::string name = "log" + std::to_string(i);
+      runInfo.addDeferredProperty(name, [name, i]() { return std::make_unique<PropertyWithValue<int>>(name, i); });
+    }
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&runInfo, &mismatches, t, nLogs]() {
+        // Every thread reads every log, starting at a different one
+        for (int j = 0; j < nLogs; ++j) {
+          const int i = (j + t * nLogs / 4) % nLogs;
+          if (runInfo.getPropertyValueAsType<int>("log" + std::to_string(i)) != i) {
+            ++mismatches;
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    TS_ASSERT_EQUALS(mismatches.load(), 0);
+    TS_ASSERT_EQUALS(runInfo.getProperties().size(), nLogs);
+  }
+
 private:
   template <typename T> void doTest_GetPropertyAsSingleValue_SingleType(const T value) {
     LogManager runInfo;
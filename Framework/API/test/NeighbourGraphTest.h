@@ -0,0 +1,144 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/NeighbourGraph.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/WorkspaceNearestNeighbours.h"
+#include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidFrameworkTestHelpers/FakeObjects.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid;
+using namespace Mantid::API;
+using Mantid::Kernel::V3D;
+
+class NeighbourGraphTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static NeighbourGraphTest *createSuite() { return new NeighbourGraphTest(); }
+  static void destroySuite(NeighbourGraphTest *suite) { delete suite; }
+
+  void tearDown() override { NeighbourGraph::clearCache(); }
+
+  void test_rows_hold_the_nearest_neighbours_in_spectrum_order() {
+    const auto ws = makeWorkspace();
+    const auto &spectrumInfo = ws->spectrumInfo();
+    const auto spectrumNumbers = getSpectrumNumbers(*ws);
+    NeighbourGraph graph(8, spectrumInfo, spectrumNumbers);
+
+    TS_ASSERT_EQUALS(graph.size(), 18);
+    TS_ASSERT_EQUALS(graph.numberOfNeighbours(), 8);
+    const auto &offsets = graph.offsets();
+    const auto &indices = graph.indices();
+    const auto &distances = graph.distances();
+    TS_ASSERT_EQUALS(offsets.size(), 19);
+    TS_ASSERT_EQUALS(indices.size(), 18 * 8);
+    TS_ASSERT_EQUALS(distances.size(), 18 * 8);
+
+    double cutoff = 0.;
+    for (size_t i = 0; i < graph.size(); ++i) {
+      TS_ASSERT(graph.contains(i));
+      TS_ASSERT_EQUALS(offsets[i + 1] - offsets[i], 8);
+      for (auto j = offsets[i]; j < offsets[i + 1]; ++j) {
+        if (j > offsets[i])
+          TS_ASSERT_LESS_THAN(spectrumNumbers[indices[j - 1]], spectrumNumbers[indices[j]]);
+        const V3D expected = spectrumInfo.position(indices[j]) - spectrumInfo.position(i);
+        TS_ASSERT_DELTA(distances[j].norm(), expected.norm(), 1e-12);
+        cutoff = std::max(cutoff, distances[j].norm());
+      }
+    }
+    TS_ASSERT_DELTA(graph.cutoff(), cutoff, 1e-15);
+  }
+
+  void test_matches_WorkspaceNearestNeighbours() {
+    const auto ws = makeWorkspace();
+    const auto spectrumNumbers = getSpectrumNumbers(*ws);
+    NeighbourGraph graph(5, ws->spectrumInfo(), spectrumNumbers);
+    WorkspaceNearestNeighbours nn(5, ws->spectrumInfo(), spectrumNumbers);
+    for (size_t i = 0; i < graph.size(); ++i) {
+      const auto neighbours = nn.neighbours(spectrumNumbers[i]);
+      TS_ASSERT_EQUALS(neighbours.size(), graph.offsets()[i + 1] - graph.offsets()[i]);
+      auto j = graph.offsets()[i];
+      for (const auto &neighbour : neighbours) {
+        TS_ASSERT_EQUALS(neighbour.first, spectrumNumbers[graph.indices()[j]]);
+        TS_ASSERT_EQUALS(neighbour.second, graph.distances()[j]);
+        ++j;
+      }
+    }
+  }
+
+  void test_monitors_and_masked_spectra_have_no_neighbours() {
+    const auto ws = makeWorkspace();
+    auto &spectrumInfo = ws->mutableSpectrumInfo();
+    spectrumInfo.setMasked(0, true);
+    spectrumInfo.setMasked(1, true);
+    NeighbourGraph graph(8, ws->spectrumInfo(), getSpectrumNumbers(*ws), true);
+
+    TS_ASSERT(!graph.contains(0));
+    TS_ASSERT(!graph.contains(1));
+    TS_ASSERT_EQUALS(graph.offsets()[2], 0);
+    TS_ASSERT_EQUALS(graph.indices().size(), 16 * 8);
+    for (const auto index : graph.indices())
+      TS_ASSERT_LESS_THAN(1, index);
+  }
+
+  void test_too_many_neighbours_throws() {
+    const auto ws = makeWorkspace();
+    TS_ASSERT_THROWS(NeighbourGraph(18, ws->spectrumInfo(), getSpectrumNumbers(*ws)), const std::invalid_argument &);
+  }
+
+  void test_get_reuses_the_graph_for_the_same_spectra() {
+    const auto ws = makeWorkspace();
+    const auto spectrumNumbers = getSpectrumNumbers(*ws);
+    const auto graph = NeighbourGraph::get(8, ws->spectrumInfo(), spectrumNumbers);
+    TS_ASSERT_EQUALS(NeighbourGraph::get(8, ws->spectrumInfo(), spectrumNumbers), graph);
+    // An identical workspace
+    const auto other = makeWorkspace();
+    TS_ASSERT_EQUALS(NeighbourGraph::get(8, other->spectrumInfo(), spectrumNumbers), graph);
+
+    TS_ASSERT_DIFFERS(NeighbourGraph::get(4, ws->spectrumInfo(), spectrumNumbers), graph);
+    const auto smaller = NeighbourGraph::get(4, ws->spectrumInfo(), spectrumNumbers);
+    TS_ASSERT_EQUALS(smaller->numberOfNeighbours(), 4);
+    other->mutableSpectrumInfo().setMasked(3, true);
+    TS_ASSERT_DIFFERS(NeighbourGraph::get(4, other->spectrumInfo(), spectrumNumbers, true), smaller);
+
+    NeighbourGraph::clearCache();
+    TS_ASSERT_DIFFERS(NeighbourGraph::get(4, ws->spectrumInfo(), spectrumNumbers), smaller);
+  }
+
+  void test_get_does_not_keep_the_graph_alive() {
+    const auto ws = makeWorkspace();
+    const auto spectrumNumbers = getSpectrumNumbers(*ws);
+    auto graph = NeighbourGraph::get(8, ws->spectrumInfo(), spectrumNumbers);
+    const std::weak_ptr<const NeighbourGraph> cached(graph);
+    graph.reset();
+    TS_ASSERT(cached.expired());
+    TS_ASSERT(NeighbourGraph::get(8, ws->spectrumInfo(), spectrumNumbers));
+  }
+
+private:
+  static std::shared_ptr<MatrixWorkspace> makeWorkspace() {
+    auto ws = std::make_shared<WorkspaceTester>();
+    ws->initialize(18, 2, 1);
+    for (size_t i = 0; i < 18; ++i) {
+      ws->getSpectrum(i).setSpectrumNo(static_cast<specnum_t>(i + 1));
+      ws->getSpectrum(i).setDetectorID(static_cast<detid_t>(i + 1));
+    }
+    ws->setInstrument(ComponentCreationHelper::createTestInstrumentCylindrical(2));
+    return ws;
+  }
+
+  static std::vector<specnum_t> getSpectrumNumbers(const MatrixWorkspace &workspace) {
+    std::vector<specnum_t> spectrumNumbers;
+    for (size_t i = 0; i < workspace.getNumberHistograms(); ++i)
+      spectrumNumbers.emplace_back(workspace.getSpectrum(i).getSpectrumNo());
+    return spectrumNumbers;
+  }
+};
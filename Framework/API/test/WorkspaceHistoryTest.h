@@ -130,6 +130,68 @@ public:
     TS_ASSERT_THROWS(emptyHistory.lastAlgorithm(), const std::out_of_range &);
     TS_ASSERT_THROWS(emptyHistory.getAlgorithm(1), const std::out_of_range &);
   }
+
+  void test_Copies_Share_Histories_Until_They_Change() {
+    WorkspaceHistory history;
+    for (int i = 0; i < 3; ++i)
+      history.addHistory(makeHistory("Shared", i));
+    WorkspaceHistory copy(history);
+    copy.addHistory(makeHistory("CopyOnly", 3));
+    history.addHistory(makeHistory("OriginalOnly", 3));
+
+    TS_ASSERT_EQUALS(history.size(), 4);
+    TS_ASSERT_EQUALS(copy.size(), 4);
+    for (size_t i = 0; i < 3; ++i)
+      TS_ASSERT_EQUALS(copy.getAlgorithmHistory(i), history.getAlgorithmHistory(i));
+    TS_ASSERT_EQUALS(copy.getAlgorithmHistory(3)->name(), "CopyOnly");
+    TS_ASSERT_EQUALS(history.getAlgorithmHistory(3)->name(), "OriginalOnly");
+
+    const auto &histories = copy.getAlgorithmHistories();
+    TS_ASSERT_EQUALS(histories.size(), 4);
+    TS_ASSERT_EQUALS(histories[0]->name(), "Shared");
+    TS_ASSERT_EQUALS(histories[3]->name(), "CopyOnly");
+  }
+
+  void test_Adding_A_Following_History_Does_Not_Duplicate_Entries() {
+    WorkspaceHistory history;
+    history.addHistory(makeHistory("First", 0));
+    WorkspaceHistory later(history);
+    later.addHistory(makeHistory("Second", 1));
+
+    later.addHistory(history);
+    TS_ASSERT_EQUALS(later.size(), 2);
+    history.addHistory(later);
+    TS_ASSERT_EQUALS(history.size(), 2);
+    TS_ASSERT(history == later);
+
+    WorkspaceHistory other;
+    other.addHistory(makeHistory("Other", 2));
+    history.addHistory(other);
+    TS_ASSERT_EQUALS(history.size(), 3);
+    TS_ASSERT_EQUALS(history.getAlgorithmHistory(2)->name(), "Other");
+    TS_ASSERT_EQUALS(later.size(), 2);
+  }
+
+  void test_Indexing_Into_A_Long_Chain_Of_Copies() {
+    WorkspaceHistory history;
+    for (size_t i = 0; i < 100; ++i) {
+      // Each copy starts a new segment shared with the previous history
+      WorkspaceHistory copy(history);
+      copy.addHistory(makeHistory("Alg" + std::to_string(i), i));
+      history.clearHistory();
+      history.addHistory(copy);
+    }
+    TS_ASSERT_EQUALS(history.size(), 100);
+    for (size_t i = 0; i < 100; ++i)
+      TS_ASSERT_EQUALS(history.getAlgorithmHistory(i)->name(), "Alg" + std::to_string(i));
+    TS_ASSERT_THROWS(history.getAlgorithmHistory(100), const std::out_of_range &);
+  }
+
+private:
+  static AlgorithmHistory_sptr makeHistory(const std::string &name, const std::size_t execCount) {
+    return std::make_shared<AlgorithmHistory>(name, 1, "uuid-" + std::to_string(execCount),
+                                              Mantid::Types::Core::DateAndTime::defaultTime(), -1.0, execCount);
+  }
 };
 
 class WorkspaceHistoryTestPerformance : public CxxTest::TestSuite {
@@ -179,6 +241,16 @@ public:
     m_wsHist.addHistory(m_1000000Histories2);
   }
 
+  void test_copying_and_appending_100000_times() {
+    for (auto i = 0u; i < 100000; ++i) {
+      WorkspaceHistory copy(m_wsHist);
+      copy.addHistory(m_1000000Histories1[i]);
+      m_wsHist.clearHistory();
+      m_wsHist.addHistory(copy);
+    }
+    TS_ASSERT_EQUALS(m_wsHist.size(), 100000);
+  }
+
   void test_adding_1000000_to_1000000_workspace_histories() {
     // It's hard to test this without doing this bit
     for (auto i = 0u; i < 1000000; ++i) {
@@ -43,6 +43,10 @@ namespace Algorithms {
    numerical integral is calculated (default: all points). </LI>
     <LI> ExpMethod - The method to calculate exponential function (Normal of
    Fast approximation). </LI>
+    <LI> PathLengthsWorkspace - Path lengths of an earlier run with the same
+   geometry to reuse (optional). </LI>
+    <LI> OutputPathLengthsWorkspace - The path lengths of this run, for reuse
+   (optional). </LI>
     </UL>
 
     This class, which must be overridden to provide the specific sample geometry
@@ -120,6 +124,8 @@ private:
   void retrieveBaseProperties();
   void constructSample(API::Sample &sample);
   void calculateDistances(const Geometry::IDetector &detector, std::vector<double> &L2s) const;
+  API::MatrixWorkspace_sptr createPathLengthsWorkspace() const;
+  bool pathLengthsMatch(const API::MatrixWorkspace &pathLengths) const;
   inline double doIntegration(const double linearCoefAbs, const std::vector<double> &L2s, const size_t startIndex,
                               const size_t endIndex) const;
   inline double doIntegration(const double linearCoefAbsL1, const double linearCoefAbsL2,
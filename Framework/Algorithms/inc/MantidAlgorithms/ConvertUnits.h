@@ -63,6 +63,8 @@ public:
   }
   /// Algorithm's category for identification overriding a virtual method
   const std::string category() const override { return "Transforms\\Units"; }
+  /// Members of a workspace group are independent and may be converted concurrently
+  bool supportsConcurrentGroupProcessing() const override { return true; }
 
 protected:
   /// Reverses the workspace if X values are in descending order
@@ -16,6 +16,8 @@
 #include "MantidGeometry/IComponent.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 
+#include <atomic>
+
 namespace Mantid {
 namespace API {
 class Sample;
@@ -59,7 +61,7 @@ protected:
   std::tuple<double, int> sampleQW(const API::MatrixWorkspace_sptr &CumulativeProb, double x);
   double interpolateSquareRoot(const API::ISpectrum &histToInterpolate, double x);
   double interpolateGaussian(const API::ISpectrum &histToInterpolate, double x);
-  double Interpolate2D(API::MatrixWorkspace_sptr SOfQ, double w, double q);
+  double Interpolate2D(const API::MatrixWorkspace_sptr &SOfQ, double w, double q);
   void updateTrackDirection(Geometry::Track &track, const double cosT, const double phi);
   void integrateCumulative(const Mantid::HistogramData::Histogram &h, const double xmin, const double xmax,
                            std::vector<double> &resultX, std::vector<double> &resultY);
@@ -76,6 +78,10 @@ private:
                                     API::MatrixWorkspace_sptr &invPOfQ, const double kinc,
                                     const std::vector<double> &wValues, const Kernel::V3D &detPos,
                                     bool specialSingleScatterCalc);
+  void simulatePathRange(const int nPaths, const int nScatters, Kernel::PseudoRandomNumberGenerator &rng,
+                         const API::MatrixWorkspace_sptr &invPOfQ, const double kinc,
+                         const std::vector<double> &wValues, const Kernel::V3D &detPos, bool specialSingleScatterCalc,
+                         std::vector<double> &sumOfWeights, double &sumOfQSS);
   std::tuple<bool, std::vector<double>, double> scatter(const int nScatters, Kernel::PseudoRandomNumberGenerator &rng,
                                                         const API::MatrixWorkspace_sptr &invPOfQ, const double kinc,
                                                         const std::vector<double> &wValues, const Kernel::V3D &detPos,
@@ -102,7 +108,7 @@ private:
   std::tuple<double, double> getKinematicRange(double kf, double ki);
   std::vector<std::tuple<double, int, double>> generateInputKOutputWList(const double efixed,
                                                                          const std::vector<double> &xPoints);
-  long long m_callsToInterceptSurface{0};
+  std::atomic<long long> m_callsToInterceptSurface{0};
   std::map<int, int> m_attemptsToGenerateInitialTrack;
   int m_maxScatterPtAttempts;
   std::shared_ptr<const DataObjects::Histogram1D> m_sigmaSS; // scattering cross section as a function of k
@@ -111,6 +117,8 @@ private:
   API::MatrixWorkspace_sptr m_logSQ;
   Geometry::IObject_const_sptr m_sampleShape;
   bool m_importanceSampling;
+  /// Whether the paths, rather than the spectra, are simulated in parallel
+  bool m_parallelisePaths{false};
   Kernel::DeltaEMode::Type m_EMode;
   bool m_simulateEnergiesIndependently;
   Kernel::V3D m_sourcePos;
@@ -0,0 +1,44 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAlgorithms/DllConfig.h"
+
+namespace Mantid {
+namespace Algorithms {
+
+/** EvaluateWorkspaceExpression : evaluates an arithmetic expression over
+  MatrixWorkspaces in the analysis data service.
+
+  Chains of operations are evaluated in one pass over the data with
+  MatrixWorkspaceExpression, rather than one pass and one workspace per
+  operation as when Plus, Minus, Multiply, Divide, Power, Logarithm and
+  Exponential are called in turn.
+ */
+class MANTID_ALGORITHMS_DLL EvaluateWorkspaceExpression final : public API::Algorithm {
+public:
+  const std::string name() const override { return "EvaluateWorkspaceExpression"; }
+  /// Summary of algorithms purpose
+  const std::string summary() const override {
+    return "Evaluate an arithmetic expression of workspaces in a single pass over the data.";
+  }
+
+  int version() const override { return 1; }
+  const std::vector<std::string> seeAlso() const override {
+    return {"Plus", "Minus", "Multiply", "Divide", "Power", "Logarithm", "Exponential", "EvaluateMDHistoExpression"};
+  }
+  const std::string category() const override { return "Arithmetic"; }
+
+private:
+  void init() override;
+  void exec() override;
+  std::map<std::string, std::string> validateInputs() override;
+};
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -0,0 +1,91 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidAlgorithms/DllConfig.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace Algorithms {
+
+/** A chain of element-wise arithmetic operations on the Y and E values of a
+  histogram MatrixWorkspace.
+
+  Each step updates the running value of every bin exactly as the algorithm
+  of the same name (Plus, Minus, Multiply, Divide, Power, Logarithm and
+  Exponential) does, including the propagation of the errors and of the
+  spectrum and bin masking of workspace operands. evaluate() applies the whole
+  chain in a single pass: the spectra are shared out between threads and every
+  step is applied to a block of a spectrum small enough to stay in cache
+  before moving on to the next block. Evaluating e.g. "(A - B) / C * 2"
+  therefore reads and writes the data of A once instead of once per
+  operation, and needs no intermediate workspaces.
+
+  A workspace operand must have the same number of spectra and bins as the
+  workspace the expression is evaluated on, or a single spectrum applied to
+  every spectrum, or a single value. Operand workspaces are held by reference:
+  they must outlive the expression and must not be resized before it is
+  evaluated. An operand may be the workspace the expression is evaluated on.
+*/
+class MANTID_ALGORITHMS_DLL MatrixWorkspaceExpression {
+public:
+  MatrixWorkspaceExpression &add(const API::MatrixWorkspace &b);
+  MatrixWorkspaceExpression &add(const double value, const double error);
+  MatrixWorkspaceExpression &subtract(const API::MatrixWorkspace &b);
+  MatrixWorkspaceExpression &subtract(const double value, const double error);
+  MatrixWorkspaceExpression &multiply(const API::MatrixWorkspace &b);
+  MatrixWorkspaceExpression &multiply(const double value, const double error);
+  MatrixWorkspaceExpression &divide(const API::MatrixWorkspace &b);
+  MatrixWorkspaceExpression &divide(const double value, const double error);
+
+  MatrixWorkspaceExpression &power(double exponent);
+  MatrixWorkspaceExpression &log(double filler = 0.0);
+  MatrixWorkspaceExpression &log10(double filler = 0.0);
+  MatrixWorkspaceExpression &exp();
+
+  /// @return the number of steps in the expression
+  size_t size() const { return m_steps.size(); }
+  /// @return true if the expression has no steps
+  bool empty() const { return m_steps.empty(); }
+
+  void evaluate(API::MatrixWorkspace &ws) const;
+
+  /// Number of bins of a spectrum processed by all the steps before moving to the next block
+  static constexpr size_t BLOCK_SIZE = 2048;
+
+private:
+  enum class Operation { Add, Subtract, Multiply, Divide, Power, Log, Log10, Exp };
+
+  /// How a workspace operand lines up with the workspace being evaluated
+  enum class Shape { Scalar, SingleValue, SingleSpectrum, Spectra };
+
+  struct Step {
+    Operation operation;
+    /// name of the operation used in error messages
+    const char *name;
+    /// the workspace operand, or nullptr to use the scalar operand
+    const API::MatrixWorkspace *operand;
+    /// scalar operand and its error
+    double value;
+    double error;
+    /// filler or exponent
+    double parameter;
+  };
+
+  MatrixWorkspaceExpression &addStep(Operation operation, const char *name, const API::MatrixWorkspace *operand,
+                                     double value = 0, double error = 0, double parameter = 0);
+  static Shape checkOperand(const Step &step, const API::MatrixWorkspace &ws);
+  static void applyStep(const Step &step, double *y, double *e, const double *by, const double *be, double b,
+                        double db, size_t begin, size_t end);
+
+  std::vector<Step> m_steps;
+};
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -50,6 +50,8 @@ public:
   int version() const override { return 1; }
   /// Algorithm's category for identification overriding a virtual method
   const std::string category() const override { return "Transforms\\Rebin"; }
+  /// Members of a workspace group are independent and may be rebinned concurrently
+  bool supportsConcurrentGroupProcessing() const override { return true; }
   /// Algorithm's aliases
   const std::string alias() const override { return "rebin"; }
   /// Algorithm's seeAlso
@@ -23,6 +23,7 @@ struct ScatterPointStat {
   std::string name;
   int generatedPointCount;
   int usedPointCount;
+  int rejectedPointCount;
 };
 
 /**
@@ -34,11 +35,12 @@ public:
   MCInteractionStatistics(detid_t detectorID, const API::Sample &sample);
   std::string generateScatterPointStats();
   void UpdateScatterPointCounts(int componentIndex, bool pointUsed);
+  void UpdateRejectedPointCounts(int componentIndex);
   void UpdateScatterAngleStats(const Kernel::V3D &toStart, const Kernel::V3D &scatteredDirec);
 
 private:
   detid_t m_detectorID;
-  ScatterPointStat m_sampleScatterPoints = {"Sample", 0, 0};
+  ScatterPointStat m_sampleScatterPoints = {"Sample", 0, 0, 0};
   std::vector<ScatterPointStat> m_envScatterPoints;
   double m_scatterAngleMean = 0;
   double m_scatterAngleM2 = 0;
@@ -9,6 +9,8 @@
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidAlgorithms/SampleCorrections/IMCInteractionVolume.h"
 
+#include <vector>
+
 namespace Mantid {
 namespace API {
 class Sample;
@@ -28,24 +30,48 @@ class IBeamProfile;
 class MANTID_ALGORITHMS_DLL MCInteractionVolume : public IMCInteractionVolume {
 public:
   enum class ScatteringPointVicinity { SAMPLEANDENVIRONMENT, SAMPLEONLY, ENVIRONMENTONLY };
+  /// How the scattering points are spread over the components.
+  /// REJECTION: pick a component at random and a point in the whole active
+  /// region, until the point lands in the component. As every attempt covers
+  /// the same region, a component is hit in proportion to its volume within it.
+  /// STRATIFIED: pick a component with a probability proportional to its
+  /// volume within the active region and then a point inside the part of that
+  /// component in the region.
+  /// Both give points uniformly distributed over the volume of the components
+  /// within the active region.
+  enum class ScatteringPointSampling { REJECTION, STRATIFIED };
   MCInteractionVolume(const API::Sample &sample, const size_t maxScatterAttempts = 5000,
-                      const ScatteringPointVicinity pointsIn = ScatteringPointVicinity::SAMPLEANDENVIRONMENT);
+                      const ScatteringPointVicinity pointsIn = ScatteringPointVicinity::SAMPLEANDENVIRONMENT,
+                      const ScatteringPointSampling sampling = ScatteringPointSampling::REJECTION);
 
   const Geometry::BoundingBox getFullBoundingBox() const override;
   virtual TrackPair calculateBeforeAfterTrack(Kernel::PseudoRandomNumberGenerator &rng, const Kernel::V3D &startPos,
                                               const Kernel::V3D &endPos, MCInteractionStatistics &stats) const override;
-  ComponentScatterPoint generatePoint(Kernel::PseudoRandomNumberGenerator &rng) const;
+  ComponentScatterPoint generatePoint(Kernel::PseudoRandomNumberGenerator &rng,
+                                      MCInteractionStatistics *stats = nullptr) const;
   void setActiveRegion(const Geometry::BoundingBox &region) override;
+  /// @return the volume of each component within the active region, sample first, when the points are stratified
+  const std::vector<double> &componentVolumes() const { return m_componentVolumes; }
 
 private:
   int getComponentIndex(Kernel::PseudoRandomNumberGenerator &rng) const;
+  int getComponentIndexByVolume(Kernel::PseudoRandomNumberGenerator &rng) const;
+  const Geometry::IObject &getComponent(int componentIndex) const;
   boost::optional<Kernel::V3D> generatePointInObjectByIndex(int componentIndex,
                                                             Kernel::PseudoRandomNumberGenerator &rng) const;
+  void calculateComponentVolumes();
   const std::shared_ptr<Geometry::IObject> m_sample;
   const Geometry::SampleEnvironment *m_env;
   Geometry::BoundingBox m_activeRegion;
   const size_t m_maxScatterAttempts;
   const ScatteringPointVicinity m_pointsIn;
+  const ScatteringPointSampling m_sampling;
+  /// The volume of each component within the active region, indexed by component index + 1
+  std::vector<double> m_componentVolumes;
+  /// Running sums of m_componentVolumes for choosing a component
+  std::vector<double> m_cumulativeVolumes;
+  /// The part of the active region covered by each component, indexed by component index + 1
+  std::vector<Geometry::BoundingBox> m_componentRegions;
 };
 
 } // namespace Algorithms
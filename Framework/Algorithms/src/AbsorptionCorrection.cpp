@@ -7,16 +7,21 @@
 #include "MantidAlgorithms/AbsorptionCorrection.h"
 #include "MantidAPI/HistoWorkspace.h"
 #include "MantidAPI/InstrumentValidator.h"
+#include "MantidAPI/Run.h"
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
+#include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/SampleEnvironment.h"
+#include "MantidGeometry/Objects/CSGObject.h"
 #include "MantidGeometry/Objects/ShapeFactory.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidHistogramData/Interpolate.h"
+#include "MantidHistogramData/LinearGenerator.h"
+#include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CompositeValidator.h"
 #include "MantidKernel/DeltaEMode.h"
@@ -47,6 +52,11 @@ const std::string CALC_SAMPLE = "Sample";
 const std::string CALC_CONTAINER = "Container";
 const std::string CALC_ENVIRONMENT = "Environment";
 
+// logs of the path lengths workspace describing the volume elements they were calculated for
+const std::string ELEMENT_VOLUMES_LOG = "ElementVolumes";
+const std::string ELEMENT_L1S_LOG = "ElementL1s";
+const std::string SHAPE_XML_LOG = "SampleShapeXML";
+
 inline size_t findMiddle(const size_t start, const size_t stop) {
   auto half = static_cast<size_t>(floor(.5 * (static_cast<double>(stop - start))));
   return start + half;
@@ -57,6 +67,20 @@ double energyToWavelength(const double energyFixed) {
   return 2. * M_PI * std::sqrt(E_mev_toNeutronWavenumberSq / energyFixed);
 }
 
+// the XML of a CSG shape, or an empty string for other shapes
+std::string shapeXML(const IObject &shape) {
+  const auto *csgShape = dynamic_cast<const CSGObject *>(&shape);
+  return csgShape ? csgShape->getShapeXML() : "";
+}
+
+// the positions of the sample and of the source of the instrument of a workspace
+std::pair<V3D, V3D> sampleAndSourcePositions(const MatrixWorkspace &workspace) {
+  const auto instrument = workspace.getInstrument();
+  const auto sample = instrument->getSample();
+  const auto source = instrument->getSource();
+  return {sample ? sample->getPos() : V3D(), source ? source->getPos() : V3D()};
+}
+
 } // namespace
 
 AbsorptionCorrection::AbsorptionCorrection()
@@ -113,6 +137,19 @@ void AbsorptionCorrection::init() {
                   "The value of the initial or final energy, as appropriate, in meV.\n"
                   "Will be taken from the instrument definition file, if available.");
 
+  declareProperty(std::make_unique<WorkspaceProperty<>>("PathLengthsWorkspace", "", Direction::Input,
+                                                        PropertyMode::Optional),
+                  "Path lengths from the OutputPathLengthsWorkspace of an earlier run with the same geometry, "
+                  "detectors and element size. They are used instead of tracing the paths through the sample "
+                  "again, so only the material or wavelengths may differ. If the geometry does not match they "
+                  "are calculated again.");
+  declareProperty(std::make_unique<WorkspaceProperty<>>("OutputPathLengthsWorkspace", "", Direction::Output,
+                                                        PropertyMode::Optional),
+                  "If given, a workspace holding the path length through the sample from each volume element "
+                  "towards the detectors of each spectrum, for reuse with PathLengthsWorkspace. Its "
+                  "ElementVolumes, ElementL1s and SampleShapeXML logs describe the elements and shape they were "
+                  "calculated for.");
+
   // Call the virtual method for concrete algorithm to define any other
   // properties
   defineProperties();
@@ -194,6 +231,19 @@ void AbsorptionCorrection::exec() {
     throw std::runtime_error("Failed to define any initial scattering gauge volume for geometry");
   }
 
+  // The path lengths to the detectors can be reused from an earlier run with the same geometry
+  MatrixWorkspace_sptr pathLengths = getProperty("PathLengthsWorkspace");
+  const bool reusePathLengths = pathLengths && pathLengthsMatch(*pathLengths);
+  if (pathLengths && !reusePathLengths) {
+    g_log.warning("The PathLengthsWorkspace does not match the sample shape or position, detectors or volume elements. "
+                  "The path lengths will be calculated again.");
+  }
+  if (!reusePathLengths) {
+    pathLengths.reset();
+    if (!isDefault("OutputPathLengthsWorkspace"))
+      pathLengths = createPathLengthsWorkspace();
+  }
+
   const auto &spectrumInfo = m_inputWS->spectrumInfo();
   Progress prog(this, 0.0, 1.0, numHists);
   // Loop over the spectra
@@ -209,8 +259,15 @@ void AbsorptionCorrection::exec() {
     }
     const auto &det = spectrumInfo.detector(i);
 
-    std::vector<double> L2s(m_numVolumeElements);
-    calculateDistances(det, L2s);
+    std::vector<double> L2s;
+    if (reusePathLengths) {
+      L2s = pathLengths->y(i).rawData();
+    } else {
+      L2s.resize(m_numVolumeElements);
+      calculateDistances(det, L2s);
+      if (pathLengths)
+        pathLengths->mutableY(i) = L2s;
+    }
 
     // If an indirect instrument, see if there's an efixed in the parameter map
     double lambdaFixed = m_lambdaFixed;
@@ -269,6 +326,8 @@ void AbsorptionCorrection::exec() {
 
   g_log.information() << "Total number of elements in the integration was " << m_L1s.size() << '\n';
   setProperty("OutputWorkspace", correctionFactors);
+  if (!isDefault("OutputPathLengthsWorkspace"))
+    setProperty("OutputPathLengthsWorkspace", pathLengths);
 
   // Now do some cleaning-up since destructor may not be called immediately
   m_L1s.clear();
@@ -386,6 +445,74 @@ void AbsorptionCorrection::constructSample(API::Sample &sample) {
   }
 }
 
+/**
+ * Create the workspace holding the path lengths of the volume elements. It
+ * has the spectra and instrument of the input workspace and one point per
+ * element, numbered from 0. Y holds the path length inside the sample from
+ * the element towards the detectors of the spectrum, which is filled in as it
+ * is calculated. The volume of each element, its path length inside the
+ * sample from where the beam enters it and the XML of the shape are kept in
+ * the ElementVolumes, ElementL1s and SampleShapeXML logs.
+ * @return The workspace
+ */
+MatrixWorkspace_sptr AbsorptionCorrection::createPathLengthsWorkspace() const {
+  const HistogramData::Points elementIndices(m_numVolumeElements, HistogramData::LinearGenerator(0., 1.));
+  MatrixWorkspace_sptr pathLengths = create<Workspace2D>(
+      *m_inputWS,
+      HistogramData::Histogram(elementIndices, HistogramData::Counts(m_numVolumeElements, 0.),
+                               HistogramData::CountStandardDeviations(m_numVolumeElements, 0.)));
+  pathLengths->setTitle("Path lengths of " + name() + " volume elements");
+  pathLengths->setYUnitLabel("Path length (m)");
+  auto &run = pathLengths->mutableRun();
+  auto volumes = std::make_unique<ArrayProperty<double>>(ELEMENT_VOLUMES_LOG, m_elementVolumes);
+  volumes->setUnits("m^3");
+  run.addProperty(std::move(volumes), true);
+  auto l1s = std::make_unique<ArrayProperty<double>>(ELEMENT_L1S_LOG, m_L1s);
+  l1s->setUnits("m");
+  run.addProperty(std::move(l1s), true);
+  run.addProperty(SHAPE_XML_LOG, shapeXML(*m_sampleObject), true);
+  return pathLengths;
+}
+
+/**
+ * Check that path lengths from an earlier run were calculated for the volume
+ * elements of this run, in the same shape placed in the same beam, and for
+ * the same detectors in the same places
+ * @param pathLengths :: The workspace of an earlier OutputPathLengthsWorkspace
+ * @return True if the lengths to the detectors can be used for this run
+ */
+bool AbsorptionCorrection::pathLengthsMatch(const MatrixWorkspace &pathLengths) const {
+  const auto numHists = m_inputWS->getNumberHistograms();
+  if (pathLengths.getNumberHistograms() != numHists || pathLengths.blocksize() != m_numVolumeElements)
+    return false;
+  const auto &run = pathLengths.run();
+  if (!run.hasProperty(ELEMENT_VOLUMES_LOG) || !run.hasProperty(ELEMENT_L1S_LOG) || !run.hasProperty(SHAPE_XML_LOG))
+    return false;
+  // The shape, including its orientation and dimensions, and how it is split into elements
+  if (run.getPropertyValueAsType<std::string>(SHAPE_XML_LOG) != shapeXML(*m_sampleObject))
+    return false;
+  const auto sameValues = [](const std::vector<double> &lhs, const std::vector<double> &rhs) {
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend(), [](const double a, const double b) {
+      return std::abs(a - b) <= 1e-9 * std::max(std::abs(a), std::abs(b));
+    });
+  };
+  if (!sameValues(run.getPropertyValueAsType<std::vector<double>>(ELEMENT_VOLUMES_LOG), m_elementVolumes) ||
+      !sameValues(run.getPropertyValueAsType<std::vector<double>>(ELEMENT_L1S_LOG), m_L1s))
+    return false;
+  // Where the sample sits in the beam
+  if (sampleAndSourcePositions(pathLengths) != sampleAndSourcePositions(*m_inputWS))
+    return false;
+  const auto &spectrumInfo = m_inputWS->spectrumInfo();
+  const auto &pathLengthsInfo = pathLengths.spectrumInfo();
+  for (size_t i = 0; i < numHists; ++i) {
+    if (pathLengths.getSpectrum(i).getDetectorIDs() != m_inputWS->getSpectrum(i).getDetectorIDs())
+      return false;
+    if (spectrumInfo.hasDetectors(i) && !(pathLengthsInfo.position(i) == spectrumInfo.position(i)))
+      return false;
+  }
+  return true;
+}
+
 /// Calculate the distances traversed by the neutrons within the sample
 /// @param detector :: The detector we are working on
 /// @param L2s :: A vector of the sample-detector distance for  each segment of
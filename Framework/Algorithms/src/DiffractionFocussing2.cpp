@@ -363,47 +363,30 @@ void DiffractionFocussing2::execEvent() {
   prog.reset();
   prog = std::make_unique<Progress>(this, 0.3, 0.9, totalHistProcess);
 
-  if (this->m_validGroups.size() == 1) {
-    g_log.information() << "Performing focussing on a single group\n";
-    // Special case of a single group - parallelize differently
-    EventList &groupEL = out->getSpectrum(0);
-    const std::vector<size_t> &indices = this->m_wsIndices[0];
-
-    int chunkSize = 200;
-
-    int end = (totalHistProcess / chunkSize) + 1;
-
-    PRAGMA_OMP(parallel for schedule(dynamic, 1) )
-    for (int wiChunk = 0; wiChunk < end; wiChunk++) {
-      PARALLEL_START_INTERRUPT_REGION
-
-      // Perform in chunks for more efficiency
-      int max = (wiChunk + 1) * chunkSize;
-      if (max > totalHistProcess)
-        max = totalHistProcess;
-
-      // Make a blank EventList that will accumulate the chunk.
-      EventList chunkEL;
-      chunkEL.switchTo(eventWtype);
-      // chunkEL.reserve(numEventsInChunk);
-
-      // process the chunk
-      for (int i = wiChunk * chunkSize; i < max; i++) {
-        // Accumulate the chunk
-        size_t wi = indices[i];
-        chunkEL += m_eventW->getSpectrum(wi);
+  auto nValidGroups = static_cast<int>(this->m_validGroups.size());
+  if (nValidGroups < PARALLEL_GET_MAX_THREADS) {
+    g_log.information() << "Performing focussing on " << nValidGroups << " group(s)\n";
+    // Special case of a few groups - parallelize within each group instead:
+    // the event lists of the group are copied into the output concurrently
+    for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
+      const std::vector<size_t> &indices = this->m_wsIndices[iGroup];
+      std::vector<const EventList *> inputLists;
+      inputLists.reserve(indices.size());
+      for (auto wi : indices)
+        inputLists.emplace_back(&m_eventW->getSpectrum(wi));
+      out->getSpectrum(iGroup).addEventLists(inputLists);
+      prog->reportIncrement(indices.size(), "Appending Lists");
+
+      // When focussing in place, you can clear out old memory from the input
+      // one!
+      if (inPlace) {
+        for (auto wi : indices)
+          std::const_pointer_cast<EventWorkspace>(m_eventW)->getSpectrum(wi).clear();
       }
-
-      // Rejoin the chunk with the rest.
-      PARALLEL_CRITICAL(DiffractionFocussing2_JoinChunks) { groupEL += chunkEL; }
-
-      PARALLEL_END_INTERRUPT_REGION
+      interruption_point();
     }
-    PARALLEL_CHECK_INTERRUPT_REGION
   } else {
     // ------ PARALLELIZE BY GROUPS -------------------------
-
-    auto nValidGroups = static_cast<int>(this->m_validGroups.size());
     PARALLEL_FOR_IF(Kernel::threadSafe(*m_eventW))
     for (int iGroup = 0; iGroup < nValidGroups; iGroup++) {
       PARALLEL_START_INTERRUPT_REGION
@@ -26,6 +26,7 @@
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/Material.h"
 #include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/PhiloxRandomNumberGenerator.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
 
@@ -40,6 +41,8 @@ constexpr int DEFAULT_SEED = 123456789;
 constexpr int DEFAULT_NSCATTERINGS = 2;
 constexpr int DEFAULT_LATITUDINAL_DETS = 5;
 constexpr int DEFAULT_LONGITUDINAL_DETS = 10;
+// The number of paths simulated with each random number stream when the paths are simulated in parallel
+constexpr int PATHS_PER_STREAM = 64;
 
 /// These local unit conversions are used in preference to the Unit classes because they need to be as fast
 /// as possible and the sqrt function is faster than pow(x, 0.5) which is what the Unit::quickConversion uses
@@ -156,6 +159,12 @@ void DiscusMultipleScatteringCorrection::init() {
   declareProperty("SimulateEnergiesIndependently", false,
                   "For inelastic calculation, whether the results for adjacent energy transfer bins are simulated "
                   "separately. Currently applies to Direct geometry only");
+  declareProperty("ParallelisePaths", false,
+                  "Simulate the paths for each spectrum and point in parallel rather than the spectra in parallel. "
+                  "The paths are split into fixed blocks, each with its own random number stream seeded from the "
+                  "spectrum's, so the results do not depend on the number of threads. They do differ from the "
+                  "results without this option. Useful when there are fewer spectra than cores, for example with "
+                  "a SparseInstrument.");
 }
 
 /**
@@ -448,6 +457,7 @@ void DiscusMultipleScatteringCorrection::exec() {
   interpolateOpt.set(getPropertyValue("Interpolation"), false, true);
 
   m_importanceSampling = getProperty("ImportanceSampling");
+  m_parallelisePaths = getProperty("ParallelisePaths");
 
   Progress prog(this, 0.0, 1.0, nhists * nSimulationPoints);
   prog.setNotifyStep(0.01);
@@ -461,7 +471,8 @@ void DiscusMultipleScatteringCorrection::exec() {
 
   const auto &spectrumInfo = instrumentWS.spectrumInfo();
 
-  PARALLEL_FOR_IF(enableParallelFor)
+  // The paths of each spectrum are simulated in parallel instead
+  PARALLEL_FOR_IF(enableParallelFor && !m_parallelisePaths)
   for (int64_t i = 0; i < static_cast<int64_t>(nhists); ++i) { // signed int for openMP loop
     PARALLEL_START_INTERRUPT_REGION
     auto &spectrum = instrumentWS.getSpectrum(i);
@@ -635,7 +646,7 @@ void DiscusMultipleScatteringCorrection::exec() {
     for (auto &kv : m_attemptsToGenerateInitialTrack)
       g_log.information() << "Generating initial track required " + std::to_string(kv.first) + " attempts on " +
                                  std::to_string(kv.second) + " occasions.\n";
-    g_log.information() << "Calls to interceptSurface= " + std::to_string(m_callsToInterceptSurface) + "\n";
+    g_log.information() << "Calls to interceptSurface= " + std::to_string(m_callsToInterceptSurface.load()) + "\n";
   }
 }
 
@@ -1021,7 +1032,7 @@ double DiscusMultipleScatteringCorrection::interpolateGaussian(const ISpectrum &
  * @param q The momentum transfer (q) value to interpolate at
  * @return The interpolated S(Q,w) value
  */
-double DiscusMultipleScatteringCorrection::Interpolate2D(MatrixWorkspace_sptr SOfQ, double w, double q) {
+double DiscusMultipleScatteringCorrection::Interpolate2D(const MatrixWorkspace_sptr &SOfQ, double w, double q) {
   double SQ = 0.;
   int iW = -1;
   auto wAxis = dynamic_cast<NumericAxis *>(SOfQ->getAxis(1));
@@ -1067,18 +1078,35 @@ std::vector<double> DiscusMultipleScatteringCorrection::simulatePaths(
     const double kinc, const std::vector<double> &wValues, const Kernel::V3D &detPos, bool specialSingleScatterCalc) {
   double sumOfQSS = 0.;
   std::vector<double> sumOfWeights(wValues.size(), 0.);
-  int countZeroWeights = 0; // for debugging and analysis of where importance sampling may help
 
-  for (int ie = 0; ie < nPaths; ie++) {
-    auto [success, weights, QSS] = scatter(nScatters, rng, invPOfQ, kinc, wValues, detPos, specialSingleScatterCalc);
-    if (success) {
-      std::transform(weights.begin(), weights.end(), sumOfWeights.begin(), sumOfWeights.begin(), std::plus<double>());
-      sumOfQSS += QSS;
-      if (std::all_of(weights.begin(), weights.end(), [](double d) { return d == 0; }))
-        countZeroWeights++;
-    } else
-      ie--;
+  if (m_parallelisePaths) {
+    // Each block of paths has its own counter-based stream, so the paths given to each stream, and so the
+    // results, do not depend on the number of threads
+    const int nStreams = (nPaths + PATHS_PER_STREAM - 1) / PATHS_PER_STREAM;
+    const auto seed = static_cast<uint64_t>(rng.nextInt(1, std::numeric_limits<int>::max()));
+    std::vector<std::vector<double>> streamWeights(nStreams, std::vector<double>(wValues.size(), 0.));
+    std::vector<double> streamQSS(nStreams, 0.);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int stream = 0; stream < nStreams; ++stream) {
+      PARALLEL_START_INTERRUPT_REGION
+      PhiloxRandomNumberGenerator streamRng(seed, stream);
+      const int nStreamPaths = std::min(PATHS_PER_STREAM, nPaths - stream * PATHS_PER_STREAM);
+      simulatePathRange(nStreamPaths, nScatters, streamRng, invPOfQ, kinc, wValues, detPos, specialSingleScatterCalc,
+                        streamWeights[stream], streamQSS[stream]);
+      PARALLEL_END_INTERRUPT_REGION
+    }
+    PARALLEL_CHECK_INTERRUPT_REGION
+    // Add up the streams in order so the sums do not depend on the scheduling either
+    for (int stream = 0; stream < nStreams; ++stream) {
+      std::transform(streamWeights[stream].cbegin(), streamWeights[stream].cend(), sumOfWeights.cbegin(),
+                     sumOfWeights.begin(), std::plus<double>());
+      sumOfQSS += streamQSS[stream];
+    }
+  } else {
+    simulatePathRange(nPaths, nScatters, rng, invPOfQ, kinc, wValues, detPos, specialSingleScatterCalc, sumOfWeights,
+                      sumOfQSS);
   }
+
   for (size_t i = 0; i < wValues.size(); i++) {
     if (!m_importanceSampling)
       // divide by the mean of Q*S(Q) for each of the n-1 terms representing a multiple scatter
@@ -1089,6 +1117,34 @@ std::vector<double> DiscusMultipleScatteringCorrection::simulatePaths(
   return sumOfWeights;
 }
 
+/**
+ * Simulates a number of successful paths with one random number generator and
+ * adds their weights and QSS values to running sums
+ * @param nPaths The number of paths to simulate
+ * @param nScatters The number of scattering events to simulate along each path
+ * @param rng Random number generator
+ * @param invPOfQ Inverse of the cumulative prob distribution of Q (used in importance sampling)
+ * @param kinc The incident wavevector
+ * @param wValues A vector of overall energy transfers
+ * @param detPos The position of the detector we're currently calculating a correction for
+ * @param specialSingleScatterCalc Boolean indicating whether special single
+ * @param sumOfWeights The sum of the weights for each energy transfer, added to
+ * @param sumOfQSS The sum of the QSS values, added to
+ */
+void DiscusMultipleScatteringCorrection::simulatePathRange(
+    const int nPaths, const int nScatters, Kernel::PseudoRandomNumberGenerator &rng,
+    const MatrixWorkspace_sptr &invPOfQ, const double kinc, const std::vector<double> &wValues,
+    const Kernel::V3D &detPos, bool specialSingleScatterCalc, std::vector<double> &sumOfWeights, double &sumOfQSS) {
+  for (int ie = 0; ie < nPaths; ie++) {
+    auto [success, weights, QSS] = scatter(nScatters, rng, invPOfQ, kinc, wValues, detPos, specialSingleScatterCalc);
+    if (success) {
+      std::transform(weights.begin(), weights.end(), sumOfWeights.begin(), sumOfWeights.begin(), std::plus<double>());
+      sumOfQSS += QSS;
+    } else
+      ie--;
+  }
+}
+
 /**
  * Simulates a single neutron path through the sample to a specific detector
  * position containing the specified number of scattering events.
@@ -1348,6 +1404,7 @@ Geometry::Track DiscusMultipleScatteringCorrection::start_point(Kernel::PseudoRa
     if (nlinks > 0) {
       if (i > 0) {
         if (g_log.is(Kernel::Logger::Priority::PRIO_WARNING)) {
+          PARALLEL_CRITICAL(discus_initial_track_attempts)
           m_attemptsToGenerateInitialTrack[i + 1]++;
         }
       }
@@ -0,0 +1,278 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAlgorithms/EvaluateWorkspaceExpression.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/HistoWorkspace.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/WorkspaceExpressionParser.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidAlgorithms/MatrixWorkspaceExpression.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <cmath>
+#include <set>
+
+using namespace Mantid::Kernel;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+namespace Mantid::Algorithms {
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(EvaluateWorkspaceExpression)
+
+namespace {
+using Node = WorkspaceExpressionParser::Node;
+
+//----------------------------------------------------------------------------------------------
+/** A compiled sub-expression: a number, or a workspace followed by a chain of
+ * steps. The steps are only applied when the chain is materialised, to a
+ * copy of the workspace unless it may be overwritten.
+ */
+struct Chain {
+  MatrixWorkspace_sptr workspace;
+  std::string name;
+  double number = 0.0;
+  MatrixWorkspaceExpression steps;
+
+  bool isNumber() const { return !workspace; }
+  bool isWorkspace() const { return workspace && steps.empty(); }
+};
+
+/// Turns a parsed expression into chains of steps, evaluated as late as possible
+class Compiler {
+public:
+  explicit Compiler(double filler) : m_filler(filler) {}
+
+  Chain compile(const Node &node) {
+    switch (node.kind) {
+    case Node::Kind::Number: {
+      Chain chain;
+      chain.number = node.value;
+      return chain;
+    }
+    case Node::Kind::Workspace: {
+      Chain chain;
+      chain.name = node.text;
+      chain.workspace = retrieve(node.text);
+      return chain;
+    }
+    case Node::Kind::Unary:
+      if (node.text != "-")
+        unsupported(node.text);
+      return negate(compile(*node.arguments[0]));
+    case Node::Kind::Binary:
+      return binary(node.text, compile(*node.arguments[0]), compile(*node.arguments[1]));
+    case Node::Kind::Function:
+      if (node.text == "where")
+        unsupported("where()");
+      return function(node.text, compile(*node.arguments[0]));
+    }
+    throw std::logic_error("Unknown expression node");
+  }
+
+  /** Evaluate a chain.
+   * @param chain :: a chain holding a workspace
+   * @param inPlace :: if true the steps are applied to the workspace itself,
+   * unless it holds events
+   * @return the histogram workspace holding the result
+   */
+  static MatrixWorkspace_sptr materialise(Chain &chain, bool inPlace) {
+    const auto &ws = chain.workspace;
+    MatrixWorkspace_sptr result;
+    if (std::dynamic_pointer_cast<const IEventWorkspace>(ws)) {
+      result = create<HistoWorkspace>(*ws);
+      PARALLEL_FOR_IF(Kernel::threadSafe(*ws, *result))
+      for (int64_t i = 0; i < static_cast<int64_t>(ws->getNumberHistograms()); ++i)
+        result->setHistogram(i, ws->histogram(i));
+    } else if (inPlace) {
+      result = ws;
+    } else {
+      result = ws->clone();
+    }
+    chain.steps.evaluate(*result);
+    return result;
+  }
+
+  static MatrixWorkspace_sptr retrieve(const std::string &name) {
+    MatrixWorkspace_sptr ws;
+    try {
+      ws = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(name);
+    } catch (Exception::NotFoundError &) {
+      throw std::invalid_argument("Workspace " + name + " does not exist.");
+    }
+    if (!ws)
+      throw std::invalid_argument("Workspace " + name + " is not a MatrixWorkspace.");
+    if (ws->id() == "RebinnedOutput")
+      throw std::invalid_argument("Workspace " + name +
+                                  " is a RebinnedOutput workspace: use the individual algorithms instead.");
+    return ws;
+  }
+
+private:
+  [[noreturn]] static void unsupported(const std::string &operation) {
+    throw std::invalid_argument(operation + " is not supported for MatrixWorkspaces.");
+  }
+
+  /// A workspace holding the value of a chain, to be used as an operand
+  const MatrixWorkspace &operand(Chain &chain) {
+    m_operands.emplace_back(chain.isWorkspace() ? chain.workspace : materialise(chain, false));
+    return *m_operands.back();
+  }
+
+  static Chain negate(Chain arg) {
+    if (arg.isNumber())
+      arg.number = -arg.number;
+    else
+      arg.steps.multiply(-1.0, 0.0);
+    return arg;
+  }
+
+  Chain function(const std::string &name, Chain arg) {
+    if (arg.isNumber()) {
+      const double a = arg.number;
+      if (name == "exp")
+        arg.number = std::exp(a);
+      else
+        arg.number = (a <= 0) ? m_filler : ((name == "log") ? std::log(a) : std::log10(a));
+    } else if (name == "log") {
+      arg.steps.log(m_filler);
+    } else if (name == "log10") {
+      arg.steps.log10(m_filler);
+    } else {
+      arg.steps.exp();
+    }
+    return arg;
+  }
+
+  Chain binary(const std::string &op, Chain lhs, Chain rhs) {
+    if (op != "+" && op != "-" && op != "*" && op != "/" && op != "**")
+      unsupported(op);
+    if (lhs.isNumber() && rhs.isNumber()) {
+      lhs.number = fold(op, lhs.number, rhs.number);
+      return lhs;
+    }
+    if (op == "**") {
+      if (!rhs.isNumber())
+        throw std::invalid_argument("The exponent of ** must be a number.");
+      lhs.steps.power(rhs.number);
+      return lhs;
+    }
+
+    if (lhs.isNumber()) {
+      // a + B == B + a, a * B == B * a and a - B == -B + a
+      if (op == "+" || op == "*") {
+        std::swap(lhs, rhs);
+      } else if (op == "-") {
+        rhs.steps.multiply(-1.0, 0.0);
+        rhs.steps.add(lhs.number, 0.0);
+        return rhs;
+      } else {
+        throw std::invalid_argument("A number can not be on the left of " + op + " with a workspace on the right.");
+      }
+    }
+
+    auto &steps = lhs.steps;
+    if (rhs.isNumber()) {
+      const double b = rhs.number;
+      if (op == "+")
+        steps.add(b, 0.0);
+      else if (op == "-")
+        steps.subtract(b, 0.0);
+      else if (op == "*")
+        steps.multiply(b, 0.0);
+      else
+        steps.divide(b, 0.0);
+    } else {
+      const auto &b = operand(rhs);
+      if (op == "+")
+        steps.add(b);
+      else if (op == "-")
+        steps.subtract(b);
+      else if (op == "*")
+        steps.multiply(b);
+      else
+        steps.divide(b);
+    }
+    return lhs;
+  }
+
+  static double fold(const std::string &op, double a, double b) {
+    if (op == "+")
+      return a + b;
+    if (op == "-")
+      return a - b;
+    if (op == "*")
+      return a * b;
+    if (op == "/")
+      return a / b;
+    return std::pow(a, b);
+  }
+
+  const double m_filler;
+  /// The operands of the steps, including materialised sub-expressions
+  std::vector<MatrixWorkspace_sptr> m_operands;
+};
+} // namespace
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void EvaluateWorkspaceExpression::init() {
+  declareProperty("Expression", "", std::make_shared<MandatoryValidator<std::string>>(),
+                  "The expression to evaluate, e.g. \"(A - B) / C * 2\". Names refer to MatrixWorkspaces in the "
+                  "analysis data service; quote names which are not identifiers.");
+  declareProperty("Filler", 0.0, "The result of log(x) and log10(x) where x <= 0. Default 0.");
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>("OutputWorkspace", "", Direction::Output),
+                  "An output workspace holding histograms.");
+}
+
+//----------------------------------------------------------------------------------------------
+/// @return a map of property names to errors
+std::map<std::string, std::string> EvaluateWorkspaceExpression::validateInputs() {
+  std::map<std::string, std::string> errors;
+  const std::string expression = getProperty("Expression");
+  try {
+    const auto tree = WorkspaceExpressionParser::parse(expression);
+    std::multiset<std::string> names;
+    WorkspaceExpressionParser::workspaceNames(*tree, names);
+    if (names.empty())
+      errors["Expression"] = "The expression must involve at least one workspace.";
+    for (const auto &name : std::set<std::string>(names.begin(), names.end()))
+      Compiler::retrieve(name);
+  } catch (std::invalid_argument &err) {
+    errors["Expression"] = err.what();
+  }
+  return errors;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void EvaluateWorkspaceExpression::exec() {
+  const std::string expression = getProperty("Expression");
+  const auto tree = WorkspaceExpressionParser::parse(expression);
+  std::multiset<std::string> names;
+  WorkspaceExpressionParser::workspaceNames(*tree, names);
+
+  const double filler = getProperty("Filler");
+  Compiler compiler(filler);
+  auto chain = compiler.compile(*tree);
+  if (chain.isNumber())
+    throw std::invalid_argument("The expression must involve at least one workspace.");
+
+  // Work in-place when the output replaces the only reference to an input
+  const std::string outputName = getPropertyValue("OutputWorkspace");
+  const bool inPlace = chain.name == outputName && names.count(outputName) == 1;
+  setProperty("OutputWorkspace", Compiler::materialise(chain, inPlace));
+}
+
+} // namespace Mantid::Algorithms
@@ -0,0 +1,406 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAlgorithms/MatrixWorkspaceExpression.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/WorkspaceOpOverloads.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/Unit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace Mantid::API;
+
+namespace Mantid::Algorithms {
+
+namespace {
+/// @return the ID of the unit of the X axis, or "" if there is none
+std::string xUnitID(const MatrixWorkspace &ws) {
+  if (ws.axes() == 0)
+    return "";
+  const auto unit = ws.getAxis(0)->unit();
+  return unit ? unit->unitID() : "";
+}
+
+/// @return true if the spectrum is masked, as checked by BinaryOperation
+bool isMasked(const SpectrumInfo &spectrumInfo, size_t index) {
+  return spectrumInfo.hasDetectors(index) && spectrumInfo.isMasked(index);
+}
+} // namespace
+
+/// Append a step to the chain
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::addStep(Operation operation, const char *name,
+                                                              const MatrixWorkspace *operand, double value,
+                                                              double error, double parameter) {
+  m_steps.emplace_back(Step{operation, name, operand, value, error, parameter});
+  return *this;
+}
+
+/// Add a workspace. @see Plus
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::add(const MatrixWorkspace &b) {
+  return addStep(Operation::Add, "Plus", &b);
+}
+
+/// Add a value with an error. @see Plus
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::add(const double value, const double error) {
+  return addStep(Operation::Add, "Plus", nullptr, value, error);
+}
+
+/// Subtract a workspace. @see Minus
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::subtract(const MatrixWorkspace &b) {
+  return addStep(Operation::Subtract, "Minus", &b);
+}
+
+/// Subtract a value with an error. @see Minus
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::subtract(const double value, const double error) {
+  return addStep(Operation::Subtract, "Minus", nullptr, value, error);
+}
+
+/// Multiply by a workspace. @see Multiply
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::multiply(const MatrixWorkspace &b) {
+  return addStep(Operation::Multiply, "Multiply", &b);
+}
+
+/// Multiply by a value with an error. @see Multiply
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::multiply(const double value, const double error) {
+  return addStep(Operation::Multiply, "Multiply", nullptr, value, error);
+}
+
+/// Divide by a workspace. @see Divide
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::divide(const MatrixWorkspace &b) {
+  return addStep(Operation::Divide, "Divide", &b);
+}
+
+/// Divide by a value with an error. @see Divide
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::divide(const double value, const double error) {
+  return addStep(Operation::Divide, "Divide", nullptr, value, error);
+}
+
+/// Raise the values to a power. @see Power
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::power(double exponent) {
+  return addStep(Operation::Power, "Power", nullptr, 0, 0, exponent);
+}
+
+/// Natural logarithm, using filler where the value is <= 0. @see Logarithm
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::log(double filler) {
+  return addStep(Operation::Log, "Logarithm", nullptr, 0, 0, filler);
+}
+
+/// Base-10 logarithm, using filler where the value is <= 0. @see Logarithm
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::log10(double filler) {
+  return addStep(Operation::Log10, "Logarithm", nullptr, 0, 0, filler);
+}
+
+/// Exponential. @see Exponential
+MatrixWorkspaceExpression &MatrixWorkspaceExpression::exp() {
+  return addStep(Operation::Exp, "Exponential", nullptr);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Check that the operand of a step can be applied to a workspace, following
+ * BinaryOperation::checkCompatibility.
+ *
+ * @param step :: the step to check
+ * @param ws :: the workspace the expression is evaluated on
+ * @return how the operand maps onto the workspace
+ * @throw std::invalid_argument if the operand does not match the workspace
+ */
+MatrixWorkspaceExpression::Shape MatrixWorkspaceExpression::checkOperand(const Step &step,
+                                                                         const MatrixWorkspace &ws) {
+  if (!step.operand)
+    return Shape::Scalar;
+  const auto &b = *step.operand;
+  if (&b == &ws)
+    return Shape::Spectra;
+  if (b.size() == 1)
+    return Shape::SingleValue;
+
+  const auto fail = [&step](const std::string &reason) {
+    throw std::invalid_argument(std::string(step.name) + ": " + reason);
+  };
+  const auto nHist = ws.getNumberHistograms();
+  const auto bNHist = b.getNumberHistograms();
+  if (nHist == 0 || (bNHist != nHist && bNHist != 1))
+    fail("the operand must have the same number of spectra as the workspace, or a single spectrum.");
+  const auto bins = ws.getNumberBins(0);
+  if (bins > 1 && b.getNumberBins(0) > 1 && xUnitID(ws) != xUnitID(b))
+    fail("the operand has different units on the X axis.");
+  if (!WorkspaceHelpers::matchingBins(ws, b, true))
+    fail("X arrays must match when performing this operation on 2D workspaces.");
+
+  if (bNHist == 1 && nHist > 1) {
+    for (size_t i = 0; i < nHist; ++i) {
+      if (ws.getNumberBins(i) != bins)
+        fail("a single spectrum can not be applied to a ragged workspace.");
+    }
+    return Shape::SingleSpectrum;
+  }
+  for (size_t i = 0; i < nHist; ++i) {
+    if (ws.getNumberBins(i) != b.getNumberBins(i))
+      fail("number of y values not equal in spectrum " + std::to_string(i) + ".");
+  }
+  return Shape::Spectra;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Apply all the steps, in order, to a workspace.
+ *
+ * As in BinaryOperation, the bin masking of workspace operands is copied to
+ * the workspace and, for operands with one spectrum per spectrum, a spectrum
+ * masked in either the running value or the operand is zeroed and masked.
+ *
+ * @param ws :: the histogram workspace holding the initial value, overwritten
+ * by the result
+ * @throw std::invalid_argument if an operand does not match ws. The
+ * workspace is not modified in that case.
+ */
+void MatrixWorkspaceExpression::evaluate(MatrixWorkspace &ws) const {
+  // Check everything before touching the data so a bad operand leaves the
+  // workspace unchanged
+  const size_t nSteps = m_steps.size();
+  std::vector<Shape> shapes;
+  shapes.reserve(nSteps);
+  for (const auto &step : m_steps)
+    shapes.emplace_back(checkOperand(step, ws));
+  const auto nHist = ws.getNumberHistograms();
+  if (m_steps.empty() || nHist == 0)
+    return;
+
+  // The operands which are the same for every spectrum
+  bool threadSafe = ws.threadSafe();
+  bool maskSpectra = false;
+  std::vector<double> values(nSteps, 0.0);
+  std::vector<double> errors(nSteps, 0.0);
+  std::vector<HistogramData::Histogram> singleSpectra;
+  std::vector<const double *> fixedY(nSteps, nullptr);
+  std::vector<const double *> fixedE(nSteps, nullptr);
+  for (size_t j = 0; j < nSteps; ++j) {
+    const auto &step = m_steps[j];
+    const auto *operand = step.operand;
+    if (operand && operand != &ws)
+      threadSafe = threadSafe && operand->threadSafe();
+    switch (shapes[j]) {
+    case Shape::Scalar:
+      values[j] = step.value;
+      errors[j] = step.error;
+      break;
+    case Shape::SingleValue:
+      values[j] = operand->y(0)[0];
+      errors[j] = operand->e(0)[0];
+      break;
+    case Shape::SingleSpectrum:
+      singleSpectra.emplace_back(operand->histogram(0));
+      fixedY[j] = singleSpectra.back().y().rawData().data();
+      fixedE[j] = singleSpectra.back().e().rawData().data();
+      break;
+    case Shape::Spectra:
+      maskSpectra = true;
+      break;
+    }
+    if ((shapes[j] == Shape::SingleSpectrum || shapes[j] == Shape::Spectra) && operand != &ws) {
+      // Copy the bin masking of the operand first, as BinaryOperation does
+      const bool single = shapes[j] == Shape::SingleSpectrum;
+      for (size_t i = 0; i < nHist; ++i) {
+        const size_t index = single ? 0 : i;
+        if (!operand->hasMaskedBins(index))
+          continue;
+        for (const auto &mask : operand->maskedBins(index))
+          ws.flagMasked(i, mask.first, mask.second);
+      }
+    }
+  }
+
+  // The step from which each spectrum is zeroed because of masking. Once
+  // zeroed a spectrum stays masked, and is zeroed again by every later step
+  // with an operand with one spectrum per spectrum.
+  std::vector<size_t> zeroFrom(nHist, nSteps);
+  if (maskSpectra) {
+    const auto &spectrumInfo = ws.spectrumInfo();
+    for (size_t j = 0; j < nSteps; ++j) {
+      if (shapes[j] != Shape::Spectra)
+        continue;
+      const auto &operandInfo = m_steps[j].operand->spectrumInfo();
+      for (size_t i = 0; i < nHist; ++i) {
+        if (zeroFrom[i] == nSteps && (isMasked(spectrumInfo, i) || isMasked(operandInfo, i)))
+          zeroFrom[i] = j;
+      }
+    }
+  }
+
+  PARALLEL_FOR_IF(threadSafe)
+  for (int64_t wi = 0; wi < static_cast<int64_t>(nHist); ++wi) {
+    const auto i = static_cast<size_t>(wi);
+    // Break any sharing of the data before looking at the operands, one of
+    // which may share it
+    auto &y = ws.mutableY(i);
+    auto &e = ws.mutableE(i);
+    const size_t size = y.size();
+    if (size == 0)
+      continue;
+    double *yData = &y[0];
+    double *eData = &e[0];
+
+    // The values and errors of the operands with a spectrum per spectrum
+    std::vector<HistogramData::Histogram> spectra;
+    auto by = fixedY;
+    auto be = fixedE;
+    for (size_t j = 0; j < nSteps; ++j) {
+      if (shapes[j] != Shape::Spectra)
+        continue;
+      if (m_steps[j].operand == &ws) {
+        by[j] = yData;
+        be[j] = eData;
+      } else {
+        spectra.emplace_back(m_steps[j].operand->histogram(i));
+        by[j] = spectra.back().y().rawData().data();
+        be[j] = spectra.back().e().rawData().data();
+      }
+    }
+
+    for (size_t begin = 0; begin < size; begin += BLOCK_SIZE) {
+      const size_t end = std::min(begin + BLOCK_SIZE, size);
+      for (size_t j = 0; j < nSteps; ++j) {
+        if (j >= zeroFrom[i] && shapes[j] == Shape::Spectra) {
+          std::fill(yData + begin, yData + end, 0.0);
+          std::fill(eData + begin, eData + end, 0.0);
+        } else {
+          applyStep(m_steps[j], yData, eData, by[j], be[j], values[j], errors[j], begin, end);
+        }
+      }
+    }
+  }
+
+  if (maskSpectra) {
+    auto &spectrumInfo = ws.mutableSpectrumInfo();
+    for (size_t i = 0; i < nHist; ++i) {
+      if (zeroFrom[i] < nSteps)
+        spectrumInfo.setMasked(i, true);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Apply one step to a range of bins of a spectrum, with the same formulae as
+ * the algorithm of the same name. Every case is a simple loop over contiguous
+ * arrays so that the compiler can vectorise it. The operand arrays may be the
+ * arrays being updated.
+ *
+ * @param step :: the step to apply
+ * @param y :: the running values
+ * @param e :: the running errors
+ * @param by :: the values of the operand, or nullptr for a scalar operand
+ * @param be :: the errors of the operand, or nullptr for a scalar operand
+ * @param b :: the value of a scalar operand
+ * @param db :: the error of a scalar operand
+ * @param begin :: the first bin
+ * @param end :: one past the last bin
+ */
+void MatrixWorkspaceExpression::applyStep(const Step &step, double *y, double *e, const double *by,
+                                          const double *be, double b, double db, size_t begin, size_t end) {
+  switch (step.operation) {
+  case Operation::Add:
+  case Operation::Subtract: {
+    const double sign = step.operation == Operation::Add ? 1.0 : -1.0;
+    if (by) {
+      for (size_t i = begin; i < end; ++i) {
+        const double bi = by[i];
+        const double dbi = be[i];
+        const double ei = e[i];
+        y[i] += sign * bi;
+        e[i] = std::sqrt(ei * ei + dbi * dbi);
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i)
+        y[i] += sign * b;
+      // Only do E if non-zero, otherwise it is unchanged
+      if (db != 0.) {
+        const double db2 = db * db;
+        for (size_t i = begin; i < end; ++i)
+          e[i] = std::sqrt(e[i] * e[i] + db2);
+      }
+    }
+    break;
+  }
+  case Operation::Multiply:
+    // (Sc)2 = (Sa b)2 + (Sb a)2
+    if (by) {
+      for (size_t i = begin; i < end; ++i) {
+        const double a = y[i];
+        const double bi = by[i];
+        const double dbi = be[i];
+        e[i] = std::sqrt(std::pow(e[i] * bi, 2) + std::pow(dbi * a, 2));
+        y[i] = a * bi;
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        const double a = y[i];
+        e[i] = std::sqrt(std::pow(e[i] * b, 2) + std::pow(db * a, 2));
+        y[i] = a * b;
+      }
+    }
+    break;
+  case Operation::Divide:
+    // (Sc)2 = (1/b)2( (Sa)2 + (Sb a/b)2 )
+    if (by) {
+      for (size_t i = begin; i < end; ++i) {
+        const double a = y[i];
+        const double bi = by[i];
+        const double dbi = be[i];
+        e[i] = std::sqrt(std::pow(e[i], 2) + std::pow(a * dbi / bi, 2)) / std::fabs(bi);
+        y[i] = a / bi;
+      }
+    } else {
+      const double rhsFactor = std::pow(db / b, 2);
+      for (size_t i = begin; i < end; ++i) {
+        const double a = y[i];
+        e[i] = std::sqrt(std::pow(e[i], 2) + std::pow(a, 2) * rhsFactor) / std::fabs(b);
+        y[i] = a / b;
+      }
+    }
+    break;
+  case Operation::Power: {
+    const double exponent = step.parameter;
+    for (size_t i = begin; i < end; ++i) {
+      const double a = y[i];
+      const double f = std::pow(a, exponent);
+      y[i] = f;
+      e[i] = std::fabs(exponent * f * (e[i] / a));
+    }
+    break;
+  }
+  case Operation::Log:
+  case Operation::Log10: {
+    const bool natural = step.operation == Operation::Log;
+    for (size_t i = begin; i < end; ++i) {
+      const double a = y[i];
+      if (a <= 0) {
+        y[i] = step.parameter;
+        e[i] = 0;
+      } else if (natural) {
+        y[i] = std::log(a);
+        e[i] = e[i] / a;
+      } else {
+        y[i] = std::log10(a);
+        e[i] = 0.434 * e[i] / a;
+      }
+    }
+    break;
+  }
+  case Operation::Exp:
+    for (size_t i = begin; i < end; ++i) {
+      const double f = std::exp(y[i]);
+      y[i] = f;
+      e[i] = e[i] * f;
+    }
+    break;
+  }
+}
+
+} // namespace Mantid::Algorithms
@@ -146,6 +146,16 @@ void MonteCarloAbsorption::init() {
                   "Simulate the scattering point in the vicinity of the sample or its "
                   "environment or both (default).",
                   scatteringOptionValidator);
+  auto samplingOptionValidator = std::make_shared<StringListValidator>();
+  samplingOptionValidator->addAllowedValue("Rejection");
+  samplingOptionValidator->addAllowedValue("Stratified");
+  declareProperty("ScatteringPointSampling", "Rejection",
+                  "How the scattering points are spread over the sample and environment parts. Rejection "
+                  "(default) picks a part and a point in the whole beam region until the point lands in that part, "
+                  "so each part gets a share of the points proportional to its volume in the beam. Stratified picks "
+                  "a part with that probability directly and then a point within that part, which needs far fewer "
+                  "attempts for thin or small parts inside large sample environments.",
+                  samplingOptionValidator);
 }
 
 /**
@@ -167,8 +177,12 @@ void MonteCarloAbsorption::exec() {
   } else if (pointsInProperty == "EnvironmentOnly") {
     simulatePointsIn = MCInteractionVolume::ScatteringPointVicinity::ENVIRONMENTONLY;
   }
+  const auto sampling = getPropertyValue("ScatteringPointSampling") == "Stratified"
+                            ? MCInteractionVolume::ScatteringPointSampling::STRATIFIED
+                            : MCInteractionVolume::ScatteringPointSampling::REJECTION;
   auto outputWS = doSimulation(*inputWS, static_cast<size_t>(nevents), resimulateTracks, seed, interpolateOpt,
-                               useSparseInstrument, static_cast<size_t>(maxScatterPtAttempts), simulatePointsIn);
+                               useSparseInstrument, static_cast<size_t>(maxScatterPtAttempts), simulatePointsIn,
+                               sampling);
   setProperty("OutputWorkspace", std::move(outputWS));
 }
 
@@ -200,12 +214,14 @@ std::map<std::string, std::string> MonteCarloAbsorption::validateInputs() {
  * @param maxScatterPtAttempts The maximum number of tries to generate a random
  * point within the object
  * @param pointsIn Where to generate the scattering point in
+ * @param sampling How the scattering points are spread over the components
  * @return a pointer to an MCAbsorptionStrategy object
  */
 std::shared_ptr<IMCInteractionVolume>
 MonteCarloAbsorption::createInteractionVolume(const API::Sample &sample, const size_t maxScatterPtAttempts,
-                                              const MCInteractionVolume::ScatteringPointVicinity pointsIn) {
-  auto interactionVol = std::make_shared<MCInteractionVolume>(sample, maxScatterPtAttempts, pointsIn);
+                                              const MCInteractionVolume::ScatteringPointVicinity pointsIn,
+                                              const MCInteractionVolume::ScatteringPointSampling sampling) {
+  auto interactionVol = std::make_shared<MCInteractionVolume>(sample, maxScatterPtAttempts, pointsIn, sampling);
   return interactionVol;
 }
 
@@ -270,6 +286,7 @@ std::unique_ptr<InterpolationOption> MonteCarloAbsorption::createInterpolateOpti
  * @param maxScatterPtAttempts The maximum number of tries to generate a
  * scatter point within the object
  * @param pointsIn Where to simulate the scattering point in
+ * @param sampling How the scattering points are spread over the components
  * @return A new workspace containing the correction factors & errors
  */
 MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(const MatrixWorkspace &inputWS, const size_t nevents,
@@ -277,7 +294,8 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(const MatrixWorkspace &i
                                                         const InterpolationOption &interpolateOpt,
                                                         const bool useSparseInstrument,
                                                         const size_t maxScatterPtAttempts,
-                                                        const MCInteractionVolume::ScatteringPointVicinity pointsIn) {
+                                                        const MCInteractionVolume::ScatteringPointVicinity pointsIn,
+                                                        const MCInteractionVolume::ScatteringPointSampling sampling) {
   auto outputWS = createOutputWorkspace(inputWS);
   const auto inputNbins = static_cast<int>(inputWS.blocksize());
 
@@ -316,7 +334,7 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(const MatrixWorkspace &i
   const std::string reportMsg = "Computing corrections";
 
   // Configure strategy
-  auto interactionVolume = createInteractionVolume(inputWS.sample(), maxScatterPtAttempts, pointsIn);
+  auto interactionVolume = createInteractionVolume(inputWS.sample(), maxScatterPtAttempts, pointsIn, sampling);
   auto strategy = createStrategy(*interactionVolume, *beamProfile, efixed.emode(), nevents, maxScatterPtAttempts,
                                  resimulateTracksForDiffWavelengths);
 
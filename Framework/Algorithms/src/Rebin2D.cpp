@@ -122,6 +122,9 @@ void Rebin2D::exec() {
     const double vlo = oldYEdges[i];
     const double vhi = oldYEdges[i + 1];
 
+    // Gather the contributions of the whole spectrum before adding them to
+    // the output, so threads only have to wait on each other once per spectrum
+    FractionalRebinning::BinContributions contributions;
     for (size_t j = 0; j < numXBins; ++j) {
       // For each input polygon test where it intersects with
       // the output grid and assign the appropriate weights of Y/E
@@ -129,11 +132,18 @@ void Rebin2D::exec() {
       const double x_jp1 = oldXEdges[j + 1];
       Quadrilateral inputQ(x_j, x_jp1, vlo, vhi);
       if (!useFractionalArea) {
-        FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, *outputWS, newYBins.rawData());
+        FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, newXBins.rawData(), newYBins.rawData(),
+                                           contributions);
       } else {
-        FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, i, j, *outputRB, newYBins.rawData(), inputHasFA);
+        FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, i, j, newXBins.rawData(), newYBins.rawData(),
+                                                     contributions, inputHasFA);
       }
     }
+    if (!useFractionalArea) {
+      FractionalRebinning::addContributions(*outputWS, contributions);
+    } else {
+      FractionalRebinning::addContributions(*outputRB, contributions);
+    }
 
     PARALLEL_END_INTERRUPT_REGION
   }
@@ -39,7 +39,7 @@ MCInteractionStatistics::MCInteractionStatistics(const detid_t detectorID, const
 
   if (env) {
     for (size_t i = 0; i < env->nelements(); i++) {
-      m_envScatterPoints.push_back({env->getComponent(i).id(), 0, 0});
+      m_envScatterPoints.push_back({env->getComponent(i).id(), 0, 0, 0});
     }
   }
 }
@@ -66,6 +66,19 @@ void MCInteractionStatistics::UpdateScatterPointCounts(int componentIndex, bool
   }
 }
 
+/**
+ * Count an attempt to generate a scatter point in a component that missed it
+ * @param componentIndex Index of the sample/environment component where
+ * the sample is -1
+ */
+void MCInteractionStatistics::UpdateRejectedPointCounts(int componentIndex) {
+  if (componentIndex == -1) {
+    m_sampleScatterPoints.rejectedPointCount++;
+  } else {
+    m_envScatterPoints[componentIndex].rejectedPointCount++;
+  }
+}
+
 /**
  * Update the scattering angle statistics
  * @param toStart Vector from scatter point to point on beam profile where
@@ -107,6 +120,17 @@ std::string MCInteractionStatistics::generateScatterPointStats() {
   scatterPointSummary << "Total scatter points generated: " << totalScatterPointsGenerated << std::endl;
   scatterPointSummary << "Total scatter points used: " << totalScatterPointsUsed << std::endl;
 
+  // The share of the attempts to generate a point in each component that missed it
+  const auto rejectionRate = [](const ScatterPointStat &stat) {
+    const int attempts = stat.generatedPointCount + stat.rejectedPointCount;
+    return attempts > 0 ? static_cast<double>(stat.rejectedPointCount) / attempts * 100 : 0.;
+  };
+  scatterPointSummary << "Sample rejection rate: " << rejectionRate(m_sampleScatterPoints) << "%" << std::endl;
+  for (std::vector<int>::size_type i = 0; i < m_envScatterPoints.size(); i++) {
+    scatterPointSummary << "Environment part " << i << " (" << m_envScatterPoints[i].name
+                        << ") rejection rate: " << rejectionRate(m_envScatterPoints[i]) << "%" << std::endl;
+  }
+
   if (m_envScatterPoints.size() > 0) {
     double percentage = static_cast<double>(m_sampleScatterPoints.usedPointCount) / totalScatterPointsUsed * 100;
     scatterPointSummary << "Sample: " << m_sampleScatterPoints.usedPointCount << " (" << percentage << "%)"
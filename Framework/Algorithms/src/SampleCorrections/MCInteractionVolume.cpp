@@ -9,15 +9,43 @@
 #include "MantidGeometry/Instrument/SampleEnvironment.h"
 #include "MantidGeometry/Objects/CSGObject.h"
 #include "MantidGeometry/Objects/Track.h"
+#include "MantidGeometry/RandomPoint.h"
+#include "MantidKernel/MersenneTwister.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
+
+#include <algorithm>
 #include <iomanip>
+#include <numeric>
 
 namespace Mantid {
+using Geometry::BoundingBox;
 using Geometry::Track;
 using Kernel::V3D;
 
 namespace Algorithms {
 
+namespace {
+/// The number of points used to work out how much of a component lies in the active region
+constexpr size_t VOLUME_POINTS = 10000;
+/// A fixed seed for those points, so every run splits the scatter points between the components the same way
+constexpr size_t VOLUME_SEED = 123456789;
+
+/// @return the box where two bounding boxes overlap, or a null box if they do not
+BoundingBox overlap(const BoundingBox &lhs, const BoundingBox &rhs) {
+  if (lhs.isNull() || rhs.isNull())
+    return BoundingBox();
+  const double xMin = std::max(lhs.xMin(), rhs.xMin());
+  const double xMax = std::min(lhs.xMax(), rhs.xMax());
+  const double yMin = std::max(lhs.yMin(), rhs.yMin());
+  const double yMax = std::min(lhs.yMax(), rhs.yMax());
+  const double zMin = std::max(lhs.zMin(), rhs.zMin());
+  const double zMax = std::min(lhs.zMax(), rhs.zMax());
+  if (xMin > xMax || yMin > yMax || zMin > zMax)
+    return BoundingBox();
+  return BoundingBox(xMax, yMax, zMax, xMin, yMin, zMin);
+}
+} // namespace
+
 /**
  * Construct the volume encompassing the sample + any environment kit. The
  * active region defines a bounding region for the sampling of the scattering
@@ -27,11 +55,13 @@ namespace Algorithms {
  * @param maxScatterAttempts The maximum number of tries to generate a random
  * point within the object. [Default=5000]
  * @param pointsIn Where to generate the scattering point in
+ * @param sampling How the scattering points are spread over the components
  */
 MCInteractionVolume::MCInteractionVolume(const API::Sample &sample, const size_t maxScatterAttempts,
-                                         const MCInteractionVolume::ScatteringPointVicinity pointsIn)
+                                         const MCInteractionVolume::ScatteringPointVicinity pointsIn,
+                                         const MCInteractionVolume::ScatteringPointSampling sampling)
     : m_sample(sample.getShape().clone()), m_env(nullptr), m_activeRegion(getFullBoundingBox()),
-      m_maxScatterAttempts(maxScatterAttempts), m_pointsIn(pointsIn) {
+      m_maxScatterAttempts(maxScatterAttempts), m_pointsIn(pointsIn), m_sampling(sampling) {
   try {
     m_env = &sample.getEnvironment();
     assert(m_env);
@@ -55,6 +85,8 @@ MCInteractionVolume::MCInteractionVolume(const API::Sample &sample, const size_t
     throw std::invalid_argument("MCInteractionVolume() - Either the Sample or one of the "
                                 "environment parts must have a valid shape.");
   }
+  if (m_sampling == ScatteringPointSampling::STRATIFIED)
+    calculateComponentVolumes();
 }
 
 /**
@@ -71,7 +103,65 @@ const Geometry::BoundingBox MCInteractionVolume::getFullBoundingBox() const {
   return sampleBox;
 }
 
-void MCInteractionVolume::setActiveRegion(const Geometry::BoundingBox &region) { m_activeRegion = region; }
+void MCInteractionVolume::setActiveRegion(const Geometry::BoundingBox &region) {
+  m_activeRegion = region;
+  if (m_sampling == ScatteringPointSampling::STRATIFIED)
+    calculateComponentVolumes();
+}
+
+/**
+ * Work out the volume of each component within the active region, which
+ * gives the share of the scatter points each component gets when they are
+ * stratified. A component is left out if it has no valid shape or is not
+ * part of the vicinity the points are generated in.
+ */
+void MCInteractionVolume::calculateComponentVolumes() {
+  // the sample has componentIndex -1, env components are number 0 upwards
+  const int nComponents = m_env ? static_cast<int>(m_env->nelements()) : 0;
+  const int startIndex = (m_pointsIn == ScatteringPointVicinity::ENVIRONMENTONLY) ? 0 : -1;
+  const int endIndex = (m_pointsIn == ScatteringPointVicinity::SAMPLEONLY) ? -1 : nComponents - 1;
+  m_componentVolumes.assign(nComponents + 1, 0.);
+  m_componentRegions.assign(nComponents + 1, BoundingBox());
+  Kernel::MersenneTwister rng(VOLUME_SEED);
+  for (int componentIndex = startIndex; componentIndex <= endIndex; ++componentIndex) {
+    const auto &component = getComponent(componentIndex);
+    if (!component.hasValidShape())
+      continue;
+    const auto &componentBox = component.getBoundingBox();
+    auto region = overlap(componentBox, m_activeRegion);
+    if (region.isNull())
+      continue;
+    double fractionInRegion(1.);
+    if (region.minPoint() != componentBox.minPoint() || region.maxPoint() != componentBox.maxPoint()) {
+      // Only part of the component is in the active region
+      size_t generated(0), inRegion(0);
+      for (size_t i = 0; i < VOLUME_POINTS; ++i) {
+        const auto point = component.generatePointInObject(rng, m_maxScatterAttempts);
+        if (point) {
+          ++generated;
+          if (m_activeRegion.isPointInside(*point))
+            ++inRegion;
+        }
+      }
+      fractionInRegion = generated > 0 ? static_cast<double>(inRegion) / static_cast<double>(generated) : 0.;
+    }
+    m_componentVolumes[componentIndex + 1] = component.volume() * fractionInRegion;
+    m_componentRegions[componentIndex + 1] = std::move(region);
+  }
+  m_cumulativeVolumes.resize(m_componentVolumes.size());
+  std::partial_sum(m_componentVolumes.cbegin(), m_componentVolumes.cend(), m_cumulativeVolumes.begin());
+}
+
+/**
+ * @param componentIndex Index of the sample/environment component where
+ * the sample is -1
+ * @return the sample or environment component
+ */
+const Geometry::IObject &MCInteractionVolume::getComponent(int componentIndex) const {
+  if (componentIndex == -1)
+    return *m_sample;
+  return m_env->getComponent(componentIndex);
+}
 
 /**
  * Randomly select a component across the sample/environment
@@ -97,23 +187,67 @@ int MCInteractionVolume::getComponentIndex(Kernel::PseudoRandomNumberGenerator &
 }
 
 /**
- * Generate a point in an object identified by an index
+ * Randomly select a component with a probability proportional to its volume
+ * within the active region
+ * @param rng A reference to a PseudoRandomNumberGenerator where
+ * nextValue should return a flat random number between 0.0 & 1.0
+ * @return The randomly selected component index
+ */
+int MCInteractionVolume::getComponentIndexByVolume(Kernel::PseudoRandomNumberGenerator &rng) const {
+  if (m_cumulativeVolumes.empty() || !(m_cumulativeVolumes.back() > 0.)) {
+    throw std::runtime_error("MCInteractionVolume::generatePoint() - None of the "
+                             "components lies within the active region");
+  }
+  const double volume = rng.nextValue() * m_cumulativeVolumes.back();
+  const auto chosen = std::upper_bound(m_cumulativeVolumes.cbegin(), m_cumulativeVolumes.cend(), volume);
+  // the volumes are indexed by component index + 1
+  const auto index = std::min(std::distance(m_cumulativeVolumes.cbegin(), chosen),
+                              static_cast<std::ptrdiff_t>(m_cumulativeVolumes.size()) - 1);
+  return static_cast<int>(index) - 1;
+}
+
+/**
+ * Make one attempt at generating a point in an object identified by an index.
+ * Without stratification the point is drawn from the whole active region, so
+ * each component is hit in proportion to its volume within the region. With
+ * stratification it is drawn from the part of the active region covering the
+ * component, using the generator for the shape of the component if it has one.
  * @param componentIndex Index of the sample/environment component where
  * the sample is -1
  * @param rng A reference to a PseudoRandomNumberGenerator where
  * nextValue should return a flat random number between 0.0 & 1.0
- * @return The generated point
+ * @return The generated point, or none if the attempt missed the component
  */
 
 boost::optional<Kernel::V3D>
 MCInteractionVolume::generatePointInObjectByIndex(int componentIndex, Kernel::PseudoRandomNumberGenerator &rng) const {
-  boost::optional<Kernel::V3D> pointGenerated{boost::none};
-  if (componentIndex == -1) {
-    pointGenerated = m_sample->generatePointInObject(rng, m_activeRegion, 1);
-  } else {
-    pointGenerated = m_env->getComponent(componentIndex).generatePointInObject(rng, m_activeRegion, 1);
+  const auto &component = getComponent(componentIndex);
+  if (m_sampling == ScatteringPointSampling::REJECTION)
+    return component.generatePointInObject(rng, m_activeRegion, 1);
+
+  using Geometry::detail::ShapeInfo;
+  namespace RandomPoint = Geometry::RandomPoint;
+  const auto &region = m_componentRegions[componentIndex + 1];
+  V3D point;
+  switch (component.shape()) {
+  case ShapeInfo::GeometryShape::CUBOID:
+    point = RandomPoint::inCuboid(component.shapeInfo(), rng);
+    break;
+  case ShapeInfo::GeometryShape::CYLINDER:
+    point = RandomPoint::inCylinder(component.shapeInfo(), rng);
+    break;
+  case ShapeInfo::GeometryShape::HOLLOWCYLINDER:
+    point = RandomPoint::inHollowCylinder(component.shapeInfo(), rng);
+    break;
+  case ShapeInfo::GeometryShape::SPHERE:
+    point = RandomPoint::inSphere(component.shapeInfo(), rng);
+    break;
+  default:
+    return RandomPoint::bounded(component, rng, region, 1);
   }
-  return pointGenerated;
+  if (region.isPointInside(point))
+    return point;
+  return boost::none;
 }
 
 /**
@@ -123,15 +257,33 @@ MCInteractionVolume::generatePointInObjectByIndex(int componentIndex, Kernel::Ps
  * using Object::generatePointObject
  * @param rng A reference to a PseudoRandomNumberGenerator where
  * nextValue should return a flat random number between 0.0 & 1.0
+ * @param stats If given, counts the attempts that missed the chosen component
  * @return A struct containing the generated point and the index of the
  * component containing the scatter point
  */
-ComponentScatterPoint MCInteractionVolume::generatePoint(Kernel::PseudoRandomNumberGenerator &rng) const {
-  for (size_t i = 0; i < m_maxScatterAttempts; i++) {
-    int componentIndex = getComponentIndex(rng);
-    boost::optional<Kernel::V3D> pointGenerated = generatePointInObjectByIndex(componentIndex, rng);
-    if (pointGenerated) {
-      return {componentIndex, *pointGenerated};
+ComponentScatterPoint MCInteractionVolume::generatePoint(Kernel::PseudoRandomNumberGenerator &rng,
+                                                         MCInteractionStatistics *stats) const {
+  if (m_sampling == ScatteringPointSampling::STRATIFIED) {
+    // Stay with the component chosen by its volume: choosing again after a
+    // miss would favour the components that are missed least often
+    const int componentIndex = getComponentIndexByVolume(rng);
+    for (size_t i = 0; i < m_maxScatterAttempts; i++) {
+      boost::optional<Kernel::V3D> pointGenerated = generatePointInObjectByIndex(componentIndex, rng);
+      if (pointGenerated) {
+        return {componentIndex, *pointGenerated};
+      }
+      if (stats)
+        stats->UpdateRejectedPointCounts(componentIndex);
+    }
+  } else {
+    for (size_t i = 0; i < m_maxScatterAttempts; i++) {
+      const int componentIndex = getComponentIndex(rng);
+      boost::optional<Kernel::V3D> pointGenerated = generatePointInObjectByIndex(componentIndex, rng);
+      if (pointGenerated) {
+        return {componentIndex, *pointGenerated};
+      }
+      if (stats)
+        stats->UpdateRejectedPointCounts(componentIndex);
     }
   }
   throw std::runtime_error("MCInteractionVolume::generatePoint() - Unable to "
@@ -164,7 +316,7 @@ TrackPair MCInteractionVolume::calculateBeforeAfterTrack(Kernel::PseudoRandomNum
   // having to understand exactly which object the scattering occurred in.
   ComponentScatterPoint scatterPos;
 
-  scatterPos = generatePoint(rng);
+  scatterPos = generatePoint(rng, &stats);
   stats.UpdateScatterPointCounts(scatterPos.componentIndex, false);
 
   const auto toStart = normalize(startPos - scatterPos.scatterPoint);
@@ -6,9 +6,9 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAlgorithms/SmoothNeighbours.h"
 #include "MantidAPI/InstrumentValidator.h"
+#include "MantidAPI/NeighbourGraph.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
-#include "MantidAPI/WorkspaceNearestNeighbourInfo.h"
 #include "MantidDataObjects/EventList.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/OffsetsWorkspace.h"
@@ -20,6 +20,7 @@
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/ListValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 
 using namespace Mantid::Kernel;
 using namespace Mantid::Geometry;
@@ -314,25 +315,55 @@ void SmoothNeighbours::findNeighboursUbiquitous() {
   m_progress->resetNumSteps(m_inWS->getNumberHistograms(), 0.2, 0.5);
   this->progress(0.2, "Building Neighbour Map");
 
-  Instrument_const_sptr inst = m_inWS->getInstrument();
-  const spec2index_map spec2index = m_inWS->getSpectrumToWorkspaceIndexMap();
+  const auto nhist = m_inWS->getNumberHistograms();
+  std::vector<specnum_t> spectrumNumbers;
+  spectrumNumbers.reserve(nhist);
+  for (size_t i = 0; i < nhist; ++i)
+    spectrumNumbers.emplace_back(m_inWS->getSpectrum(i).getSpectrumNo());
 
   // Resize the vector we are setting
-  m_neighbours.resize(m_inWS->getNumberHistograms());
+  m_neighbours.resize(nhist);
 
   bool ignoreMaskedDetectors = getProperty("IgnoreMaskedDetectors");
-  WorkspaceNearestNeighbourInfo neighbourInfo(*m_inWS, ignoreMaskedDetectors, m_nNeighbours);
-
-  // Cull by radius
-  RadiusFilter radiusFilter(m_radius);
+  const auto graph = NeighbourGraph::get(m_nNeighbours, m_inWS->spectrumInfo(), spectrumNumbers, ignoreMaskedDetectors);
+  const auto &offsets = graph->offsets();
+  const auto &indices = graph->indices();
+  const auto &distances = graph->distances();
+
+  // The neighbours of a spectrum within the radius cut off, in spectrum number
+  // order, with the central pixel always there
+  auto neighboursOf = [&](const size_t wi) {
+    std::vector<std::pair<size_t, V3D>> neighbSpectra;
+    bool foundCentre = false;
+    for (auto i = offsets[wi]; i < offsets[wi + 1]; ++i) {
+      // There seems to be a bug in nearestNeighbours, returns distance != 0.0
+      // for the central pixel. So we force distance = 0
+      if (indices[i] == wi) {
+        neighbSpectra.emplace_back(wi, V3D(0.0, 0.0, 0.0));
+        foundCentre = true;
+      } else if (distances[i].norm() <= m_radius) {
+        neighbSpectra.emplace_back(indices[i], distances[i]);
+      }
+    }
+    if (!foundCentre) {
+      const auto position = std::lower_bound(neighbSpectra.begin(), neighbSpectra.end(), spectrumNumbers[wi],
+                                             [&](const std::pair<size_t, V3D> &neighbour, specnum_t spec) {
+                                               return spectrumNumbers[neighbour.first] < spec;
+                                             });
+      neighbSpectra.emplace(position, wi, V3D(0.0, 0.0, 0.0));
+    }
+    return neighbSpectra;
+  };
 
   // Go through every input workspace pixel
   m_outWI = 0;
   int sum = getProperty("SumNumberOfNeighbours");
   std::shared_ptr<const Geometry::IComponent> parent, neighbParent, grandparent, neighbGParent;
-  std::vector<bool> used(m_inWS->getNumberHistograms(), false);
+  std::vector<bool> used(nhist, false);
+  // Pairs of input and output workspace indices, smoothed in parallel afterwards
+  std::vector<std::pair<size_t, size_t>> toSmooth;
   const auto &detectorInfo = m_inWS->detectorInfo();
-  for (size_t wi = 0; wi < m_inWS->getNumberHistograms(); wi++) {
+  for (size_t wi = 0; wi < nhist; wi++) {
     if (sum > 1)
       if (used[wi])
         continue;
@@ -360,65 +391,69 @@ void SmoothNeighbours::findNeighboursUbiquitous() {
       continue; // skip missing detector
     }
 
-    specnum_t inSpec = m_inWS->getSpectrum(wi).getSpectrumNo();
-
-    // Step one - Get the number of specified neighbours
-    SpectraDistanceMap insideGrid = neighbourInfo.getNeighboursExact(inSpec);
-
-    // Step two - Filter the results by the radius cut off.
-    SpectraDistanceMap neighbSpectra = radiusFilter.apply(insideGrid);
-
-    // Force the central pixel to always be there
-    // There seems to be a bug in nearestNeighbours, returns distance != 0.0 for
-    // the central pixel. So we force distance = 0
-    neighbSpectra[inSpec] = V3D(0.0, 0.0, 0.0);
+    if (sum == 1) {
+      toSmooth.emplace_back(wi, m_outWI);
+      m_outWI++;
+      continue;
+    }
 
     // Neighbours and weights list
-    double totalWeight = 0;
     int noNeigh = 0;
     std::vector<weightedNeighbour> neighbours;
 
-    // Convert from spectrum numbers to workspace indices
-    for (auto &specDistance : neighbSpectra) {
-      specnum_t spec = specDistance.first;
-
+    for (const auto &neighbour : neighboursOf(wi)) {
       // Use the weighting strategy to calculate the weight.
-      double weight = m_weightedSum->weightAt(specDistance.second);
+      double weight = m_weightedSum->weightAt(neighbour.second);
 
       if (weight > 0) {
-        // Find the corresponding workspace index
-        auto mapIt = spec2index.find(spec);
-        if (mapIt != spec2index.end()) {
-          size_t neighWI = mapIt->second;
-          if (sum > 1) {
-            // Get the list of detectors in this pixel
-            const std::set<detid_t> &dets = m_inWS->getSpectrum(neighWI).getDetectorIDs();
-            const auto &det = detectorInfo.detector(*dets.begin());
-            neighbParent = det.getParent();
-            neighbGParent = neighbParent->getParent();
-            if (noNeigh >= sum || neighbParent->getName() != parent->getName() ||
-                neighbGParent->getName() != grandparent->getName() || used[neighWI])
-              continue;
-            noNeigh++;
-            used[neighWI] = true;
-          }
-          neighbours.emplace_back(neighWI, weight);
-          totalWeight += weight;
-        }
+        size_t neighWI = neighbour.first;
+        // Get the list of detectors in this pixel
+        const std::set<detid_t> &dets = m_inWS->getSpectrum(neighWI).getDetectorIDs();
+        const auto &det = detectorInfo.detector(*dets.begin());
+        neighbParent = det.getParent();
+        neighbGParent = neighbParent->getParent();
+        if (noNeigh >= sum || neighbParent->getName() != parent->getName() ||
+            neighbGParent->getName() != grandparent->getName() || used[neighWI])
+          continue;
+        noNeigh++;
+        used[neighWI] = true;
+        neighbours.emplace_back(neighWI, weight);
       }
     }
 
-    // Adjust the weights of each neighbour to normalize to unity
-    if (sum == 1)
-      for (auto &neighbour : neighbours)
-        neighbour.second /= totalWeight;
-
     // Save the list of neighbours for this output workspace index.
     m_neighbours[m_outWI] = neighbours;
     m_outWI++;
 
     m_progress->report("Finding Neighbours");
   } // each workspace index
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(toSmooth.size()); ++i) {
+    PARALLEL_START_INTERRUPT_REGION
+    // Neighbours and weights list
+    double totalWeight = 0;
+    std::vector<weightedNeighbour> neighbours;
+    for (const auto &neighbour : neighboursOf(toSmooth[i].first)) {
+      // Use the weighting strategy to calculate the weight.
+      double weight = m_weightedSum->weightAt(neighbour.second);
+      if (weight > 0) {
+        neighbours.emplace_back(neighbour.first, weight);
+        totalWeight += weight;
+      }
+    }
+
+    // Adjust the weights of each neighbour to normalize to unity
+    for (auto &neighbour : neighbours)
+      neighbour.second /= totalWeight;
+
+    // Save the list of neighbours for this output workspace index.
+    m_neighbours[toSmooth[i].second] = std::move(neighbours);
+
+    m_progress->report("Finding Neighbours");
+    PARALLEL_END_INTERRUPT_REGION
+  }
+  PARALLEL_CHECK_INTERRUPT_REGION
 }
 
 /**
@@ -349,6 +349,7 @@ void SofQWNormalisedPolygon::exec() {
     }
   }
   const auto &X = inputWS->x(0);
+  const auto &outputX = outputWS->x(0).rawData();
 
   const auto &inputIndices = inputWS->indexInfo();
   const auto &spectrumInfo = inputWS->spectrumInfo();
@@ -367,6 +368,10 @@ void SofQWNormalisedPolygon::exec() {
 
     const auto specNo = static_cast<specnum_t>(inputIndices.spectrumNumber(i));
     std::stringstream logStream;
+    // Gather the contributions of the whole spectrum before adding them to
+    // the output, so threads only have to wait on each other once per spectrum
+    FractionalRebinning::BinContributions contributions;
+    std::vector<size_t> qIndices;
     for (size_t j = 0; j < nEnergyBins; ++j) {
       m_progress->report("Computing polygon intersections");
       // For each input polygon test where it intersects with
@@ -387,18 +392,24 @@ void SofQWNormalisedPolygon::exec() {
       }
 
       using FractionalRebinning::rebinToFractionalOutput;
-      rebinToFractionalOutput(Quadrilateral(ll, lr, ur, ul), inputWS, i, j, *outputWS, m_Qout);
+      rebinToFractionalOutput(Quadrilateral(ll, lr, ur, ul), inputWS, i, j, outputX, m_Qout, contributions);
 
       // Find which q bin this point lies in
       const MantidVec::difference_type qIndex = std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) - m_Qout.begin();
       if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
-        // Add this spectra-detector pair to the mapping
-        PARALLEL_CRITICAL(SofQWNormalisedPolygon_spectramap) {
-          // Could do a more complete merge of spectrum definitions here, but
-          // historically only the ID of the first detector in the spectrum is
-          // used, so I am keeping that for now.
-          detIDMapping[qIndex - 1].add(spectrumInfo.spectrumDefinition(i)[0].first);
-        }
+        qIndices.emplace_back(qIndex - 1);
+      }
+    }
+    FractionalRebinning::addContributions(*outputWS, contributions);
+    if (!qIndices.empty()) {
+      // Add this spectra-detector pair to the mapping
+      const auto detID = spectrumInfo.spectrumDefinition(i)[0].first;
+      PARALLEL_CRITICAL(SofQWNormalisedPolygon_spectramap) {
+        // Could do a more complete merge of spectrum definitions here, but
+        // historically only the ID of the first detector in the spectrum is
+        // used, so I am keeping that for now.
+        for (const auto qIndex : qIndices)
+          detIDMapping[qIndex].add(detID);
       }
     }
     if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
@@ -55,6 +55,7 @@ void SofQWPolygon::exec() {
 
   const size_t nTheta = m_thetaPts.size();
   const auto &X = inputWS->x(0);
+  const auto &outputX = outputWS->x(0).rawData();
 
   // Holds the spectrum-detector mapping
   std::vector<SpectrumDefinition> detIDMapping(outputWS->getNumberHistograms());
@@ -76,6 +77,10 @@ void SofQWPolygon::exec() {
     const double thetaLower = theta - halfWidth;
     const double thetaUpper = theta + halfWidth;
 
+    // Gather the contributions of the whole spectrum before adding them to
+    // the output, so threads only have to wait on each other once per spectrum
+    DataObjects::FractionalRebinning::BinContributions contributions;
+    std::vector<size_t> qIndices;
     for (size_t j = 0; j < nenergyBins; ++j) {
       m_progress->report("Computing polygon intersections");
       // For each input polygon test where it intersects with
@@ -91,18 +96,24 @@ void SofQWPolygon::exec() {
       const V2D ul(dE_j, m_EmodeProperties.q(dE_j, thetaUpper, det));
       Quadrilateral inputQ = Quadrilateral(ll, lr, ur, ul);
 
-      DataObjects::FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, *outputWS, m_Qout);
+      DataObjects::FractionalRebinning::rebinToOutput(inputQ, inputWS, i, j, outputX, m_Qout, contributions);
 
       // Find which q bin this point lies in
       const MantidVec::difference_type qIndex = std::upper_bound(m_Qout.begin(), m_Qout.end(), lrQ) - m_Qout.begin();
       if (qIndex != 0 && qIndex < static_cast<int>(m_Qout.size())) {
-        // Add this spectra-detector pair to the mapping
-        PARALLEL_CRITICAL(SofQWPolygon_spectramap) {
-          // Could do a more complete merge of spectrum definitions here, but
-          // historically only the ID of the first detector in the spectrum is
-          // used, so I am keeping that for now.
-          detIDMapping[qIndex - 1].add(spectrumInfo.spectrumDefinition(i)[0].first);
-        }
+        qIndices.emplace_back(qIndex - 1);
+      }
+    }
+    DataObjects::FractionalRebinning::addContributions(*outputWS, contributions);
+    if (!qIndices.empty()) {
+      // Add this spectra-detector pair to the mapping
+      const auto detID = spectrumInfo.spectrumDefinition(i)[0].first;
+      PARALLEL_CRITICAL(SofQWPolygon_spectramap) {
+        // Could do a more complete merge of spectrum definitions here, but
+        // historically only the ID of the first detector in the spectrum is
+        // used, so I am keeping that for now.
+        for (const auto qIndex : qIndices)
+          detIDMapping[qIndex].add(detID);
       }
     }
 
@@ -568,6 +568,9 @@ void SumSpectra::execEvent(const MatrixWorkspace_sptr &outputWorkspace, Progress
   outputEL.clearDetectorIDs();
 
   const auto &spectrumInfo = inputWorkspace->spectrumInfo();
+  // The event lists to add, which are copied into the output in one go
+  std::vector<const EventList *> inputLists;
+  inputLists.reserve(m_indices.size());
   // Loop over spectra
   for (const auto i : m_indices) {
     if (spectrumInfo.hasDetectors(i)) {
@@ -582,15 +585,15 @@ void SumSpectra::execEvent(const MatrixWorkspace_sptr &outputWorkspace, Progress
     }
     numSpectra++;
 
-    // Add the event lists with the operator
     const EventList &inputEL = inputWorkspace->getSpectrum(i);
     if (inputEL.empty()) {
       ++numZeros;
     }
-    outputEL += inputEL;
+    inputLists.emplace_back(&inputEL);
 
     progress.report();
   }
+  outputEL.addEventLists(inputLists);
 }
 
 } // namespace Mantid::Algorithms
@@ -18,6 +18,7 @@
 #include "MantidGeometry/Instrument/ReferenceFrame.h"
 #include "MantidKernel/DeltaEMode.h"
 #include "MantidKernel/Material.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/UnitFactory.h"
 
@@ -193,7 +194,7 @@ public:
     }
   }
 
-  void run_flat_plate_sample_multiple_scatter(int nPaths, bool importanceSampling) {
+  void run_flat_plate_sample_multiple_scatter(int nPaths, bool importanceSampling, bool parallelisePaths = false) {
     // same set up as previous test but increase nscatter to 2
     const double THICKNESS = 0.001; // metres
     auto inputWorkspace =
@@ -211,6 +212,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg->setProperty("NeutronPathsSingle", nPaths));
     TS_ASSERT_THROWS_NOTHING(alg->setProperty("NeutronPathsMultiple", nPaths));
     TS_ASSERT_THROWS_NOTHING(alg->setProperty("ImportanceSampling", importanceSampling));
+    TS_ASSERT_THROWS_NOTHING(alg->setProperty("ParallelisePaths", parallelisePaths));
     TS_ASSERT_THROWS_NOTHING(alg->execute(););
     TS_ASSERT(alg->isExecuted());
 
@@ -228,8 +230,10 @@ public:
           inputWorkspace->spectrumInfo().twoTheta(SPECTRUMINDEXTOTEST), THICKNESS);
       const double delta(1e-05);
       TS_ASSERT_DELTA(singleScatterResult->y(SPECTRUMINDEXTOTEST)[0], analyticResult, delta);
-      // no analytical result for double scatter so just check against current result that we assume is correct
-      TS_ASSERT_DELTA(doubleScatterResult->y(SPECTRUMINDEXTOTEST)[0], 0.0019967315, delta);
+      // no analytical result for double scatter so just check against current result that we assume is correct.
+      // Parallelised paths draw other random numbers so they only agree within the statistical error
+      const double doubleScatterDelta = parallelisePaths ? 5e-05 : delta;
+      TS_ASSERT_DELTA(doubleScatterResult->y(SPECTRUMINDEXTOTEST)[0], 0.0019967315, doubleScatterDelta);
       Mantid::API::AnalysisDataService::Instance().deepRemoveGroup("MuscatResults");
     }
   }
@@ -244,6 +248,10 @@ public:
     run_flat_plate_sample_multiple_scatter(100000, true);
   }
 
+  void test_flat_plate_sample_multiple_scatter_with_parallelised_paths() {
+    run_flat_plate_sample_multiple_scatter(100000, false, true);
+  }
+
   void test_flat_plate_sample_multiple_scatter_with_bin_interp() {
     // same set up as previous test but increase nscatter to 2
     const double THICKNESS = 0.001; // metres
@@ -342,6 +350,70 @@ public:
     }
   }
 
+  void test_parallelised_paths_do_not_depend_on_the_number_of_threads() {
+    const double THICKNESS = 0.001; // metres
+    auto inputWorkspace =
+        SetupFlatPlateWorkspace(2, 1, 1.0, 1, 0.5, 1.0, 10 * THICKNESS, 10 * THICKNESS, THICKNESS, DeltaEMode::Elastic);
+    const int maxThreads = PARALLEL_GET_MAX_THREADS;
+    std::vector<std::vector<double>> results;
+    for (const int nThreads : {1, std::max(maxThreads, 2)}) {
+      PARALLEL_SET_NUM_THREADS(nThreads);
+      auto alg = createAlgorithm();
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("InputWorkspace", inputWorkspace));
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("NumberScatterings", 2));
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("NeutronPathsSingle", 1000));
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("NeutronPathsMultiple", 1000));
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("ParallelisePaths", true));
+      TS_ASSERT_THROWS_NOTHING(alg->execute(););
+      TS_ASSERT(alg->isExecuted());
+      if (alg->isExecuted()) {
+        auto output =
+            Mantid::API::AnalysisDataService::Instance().retrieveWS<Mantid::API::WorkspaceGroup>("MuscatResults");
+        std::vector<double> result;
+        for (const auto &name : {"MuscatResults_Scatter_1", "MuscatResults_Scatter_2"}) {
+          auto ws = std::dynamic_pointer_cast<Mantid::API::MatrixWorkspace>(output->getItem(name));
+          for (size_t i = 0; i < ws->getNumberHistograms(); ++i)
+            result.insert(result.end(), ws->y(i).cbegin(), ws->y(i).cend());
+        }
+        results.emplace_back(result);
+        Mantid::API::AnalysisDataService::Instance().deepRemoveGroup("MuscatResults");
+      }
+    }
+    PARALLEL_SET_NUM_THREADS(maxThreads);
+    TS_ASSERT_EQUALS(results.size(), 2);
+    if (results.size() == 2)
+      TS_ASSERT_EQUALS(results[0], results[1]);
+  }
+
+  void test_parallelised_paths_use_a_different_stream_for_each_block() {
+    const double THICKNESS = 0.001; // metres
+    auto inputWorkspace =
+        SetupFlatPlateWorkspace(2, 1, 1.0, 1, 0.5, 1.0, 10 * THICKNESS, 10 * THICKNESS, THICKNESS, DeltaEMode::Elastic);
+    // The first block of paths is the same in both runs. If the second block repeated its random numbers the mean
+    // over both blocks would equal the mean over the first
+    std::vector<double> results;
+    for (const int nPaths : {64, 128}) {
+      auto alg = createAlgorithm();
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("InputWorkspace", inputWorkspace));
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("NumberScatterings", 2));
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("NeutronPathsSingle", 64));
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("NeutronPathsMultiple", nPaths));
+      TS_ASSERT_THROWS_NOTHING(alg->setProperty("ParallelisePaths", true));
+      TS_ASSERT_THROWS_NOTHING(alg->execute(););
+      TS_ASSERT(alg->isExecuted());
+      if (alg->isExecuted()) {
+        auto output =
+            Mantid::API::AnalysisDataService::Instance().retrieveWS<Mantid::API::WorkspaceGroup>("MuscatResults");
+        auto ws = std::dynamic_pointer_cast<Mantid::API::MatrixWorkspace>(output->getItem("MuscatResults_Scatter_2"));
+        results.emplace_back(ws->y(1)[0]);
+        Mantid::API::AnalysisDataService::Instance().deepRemoveGroup("MuscatResults");
+      }
+    }
+    TS_ASSERT_EQUALS(results.size(), 2);
+    if (results.size() == 2)
+      TS_ASSERT_DIFFERS(results[0], results[1]);
+  }
+
   void test_workspace_containing_spectra_without_detectors() {
     const double THICKNESS = 0.001; // metres
     auto inputWorkspace = SetupFlatPlateWorkspace(46, 1, 1.0, 1, 0.5, 1.0, 10 * THICKNESS, 10 * THICKNESS, THICKNESS);
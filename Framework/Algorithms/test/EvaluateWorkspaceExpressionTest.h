@@ -0,0 +1,129 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAlgorithms/EvaluateWorkspaceExpression.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+
+using namespace Mantid::API;
+using namespace Mantid::Algorithms;
+using namespace Mantid::DataObjects;
+
+class EvaluateWorkspaceExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EvaluateWorkspaceExpressionTest *createSuite() { return new EvaluateWorkspaceExpressionTest(); }
+  static void destroySuite(EvaluateWorkspaceExpressionTest *suite) { delete suite; }
+
+  void setUp() override {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("ws_A", WorkspaceCreationHelper::create2DWorkspaceWithValuesAndXerror(3, 4, true, 1., 2., 2., 0.));
+    ads.addOrReplace("ws_B", WorkspaceCreationHelper::create2DWorkspaceWithValuesAndXerror(3, 4, true, 1., 3., 3., 0.));
+    ads.addOrReplace("ws_zero",
+                     WorkspaceCreationHelper::create2DWorkspaceWithValuesAndXerror(3, 4, true, 1., 0., 0., 0.));
+    ads.addOrReplace("ws-small", WorkspaceCreationHelper::create2DWorkspaceWithValuesAndXerror(2, 4, true, 1., 4., 4.,
+                                                                                               0.));
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_Init() {
+    EvaluateWorkspaceExpression alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_arithmetic() {
+    do_test("ws_A + ws_B", 5.0, std::sqrt(13.0));
+    do_test("ws_A - ws_B", -1.0, std::sqrt(13.0));
+    do_test("ws_A * ws_B", 6.0, std::sqrt(6.0 * 6.0 * 2.0));
+    do_test("(ws_A + 1) * 2.5 - 1", 6.5, 5.0);
+    do_test("ws_B / (ws_A * 2)", 0.75, std::sqrt(9.0 + 0.75 * 0.75 * 16.0) / 4.0);
+    do_test("10 - ws_A", 8.0, 2.0);
+    do_test("2 * ws_A", 4.0, 4.0);
+    do_test("-ws_A ** 2", -4.0, 8.0);
+    do_test("exp(ws_zero)", 1.0, 0.0);
+  }
+
+  void test_logarithm_uses_filler() {
+    do_test("log10(ws_zero)", -1.0, 0.0, true, "-1");
+    do_test("log(ws_A)", std::log(2.0), 1.0);
+  }
+
+  void test_quoted_names() { do_test("'ws-small' * 2", 8.0, 8.0); }
+
+  void test_inputs_are_not_modified() {
+    do_test("ws_A * ws_A + ws_A", 6.0, std::sqrt(32.0 + 4.0));
+    auto a = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("ws_A");
+    TS_ASSERT_DELTA(a->y(0)[0], 2.0, 1e-12);
+  }
+
+  void test_in_place() {
+    auto before = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("ws_A");
+    do_test("ws_A * 3", 6.0, 6.0, true, "0", "ws_A");
+    auto after = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("ws_A");
+    TS_ASSERT_EQUALS(before, after);
+  }
+
+  void test_event_workspaces_give_histograms() {
+    // two events in every bin
+    AnalysisDataService::Instance().addOrReplace("events",
+                                                 WorkspaceCreationHelper::createEventWorkspace(3, 4, 4, 0.0, 1.0, 2));
+    do_test("events * 2", 4.0, 2.0 * std::sqrt(2.0), true, "0", "events");
+    auto out = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("events");
+    TS_ASSERT_EQUALS(out->id(), "Workspace2D");
+  }
+
+  void test_bad_expressions() {
+    do_test("ws_A +", 0, 0, false);
+    do_test("ws_A < ws_B", 0, 0, false);
+    do_test("where(ws_A, ws_B, ws_A)", 0, 0, false);
+    do_test("~ws_A", 0, 0, false);
+    do_test("1 + 2", 0, 0, false);
+    do_test("2 / ws_A", 0, 0, false);
+    do_test("ws_A ** ws_B", 0, 0, false);
+    do_test("ws_A + ws_C", 0, 0, false);
+    do_test("ws_A + 'ws-small'", 0, 0, false);
+  }
+
+private:
+  void do_test(const std::string &expression, double expectedY, double expectedE, bool succeeds = true,
+               const std::string &filler = "0", const std::string &outputName = "out") {
+    EvaluateWorkspaceExpression alg;
+    alg.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Expression", expression));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filler", filler));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", outputName));
+    if (!succeeds) {
+      TSM_ASSERT_THROWS_ANYTHING(expression, alg.execute());
+      TS_ASSERT(!alg.isExecuted());
+      return;
+    }
+    TSM_ASSERT_THROWS_NOTHING(expression, alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    MatrixWorkspace_sptr out;
+    TS_ASSERT_THROWS_NOTHING(out = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(outputName));
+    TS_ASSERT(out);
+    if (!out)
+      return;
+    for (size_t i = 0; i < out->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < out->y(i).size(); ++j) {
+        TSM_ASSERT_DELTA(expression, out->y(i)[j], expectedY, 1e-9);
+        TSM_ASSERT_DELTA(expression, out->e(i)[j], expectedE, 1e-9);
+      }
+    }
+  }
+};
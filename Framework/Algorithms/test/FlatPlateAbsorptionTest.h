@@ -9,10 +9,14 @@
 #include <cxxtest/TestSuite.h>
 
 #include "MantidAPI/Axis.h"
+#include "MantidAPI/Run.h"
 #include "MantidAlgorithms/FlatPlateAbsorption.h"
 #include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidKernel/UnitFactory.h"
 
+#include <cmath>
+
 using Mantid::API::MatrixWorkspace_sptr;
 
 class FlatPlateAbsorptionTest : public CxxTest::TestSuite {
@@ -58,6 +62,108 @@ public:
     Mantid::API::AnalysisDataService::Instance().remove(outputWS);
   }
 
+  void testReusedPathLengthsGiveSameFactors() {
+    MatrixWorkspace_sptr testWS = createTestWorkspace();
+
+    // Save the path lengths with one material
+    Mantid::Algorithms::FlatPlateAbsorption first;
+    configureFlatPlate(first, testWS, "factors", "6.52", "19.876");
+    TS_ASSERT_THROWS_NOTHING(first.setPropertyValue("OutputPathLengthsWorkspace", "pathLengths"));
+    TS_ASSERT_THROWS_NOTHING(first.execute());
+    TS_ASSERT(first.isExecuted());
+    MatrixWorkspace_sptr pathLengths = first.getProperty("OutputPathLengthsWorkspace");
+    TS_ASSERT(pathLengths);
+    if (!pathLengths)
+      return;
+    TS_ASSERT_EQUALS(pathLengths->getNumberHistograms(), testWS->getNumberHistograms());
+    const auto nElements = pathLengths->blocksize();
+    TS_ASSERT_LESS_THAN(0, nElements);
+    // The points are the element indices
+    TS_ASSERT_EQUALS(pathLengths->x(1).front(), 0.);
+    TS_ASSERT_EQUALS(pathLengths->x(1).back(), static_cast<double>(nElements - 1));
+    // The element volumes fill the 2.3 x 1.8 x 1.5 cm plate
+    const auto &run = pathLengths->run();
+    const auto volumes = run.getPropertyValueAsType<std::vector<double>>("ElementVolumes");
+    TS_ASSERT_EQUALS(volumes.size(), nElements);
+    const double plateVolume = 0.023 * 0.018 * 0.015;
+    for (const auto volume : volumes)
+      TS_ASSERT_DELTA(volume, plateVolume / static_cast<double>(nElements), 1e-15);
+    // The path lengths inside the plate from where the beam enters it are the
+    // depths of the layers of elements: half a layer to the thickness less half a layer
+    const auto l1s = run.getPropertyValueAsType<std::vector<double>>("ElementL1s");
+    TS_ASSERT_EQUALS(l1s.size(), nElements);
+    const double layerThickness = 2. * l1s.front();
+    TS_ASSERT_DELTA(l1s.front() + l1s.back(), 0.015, 1e-12);
+    for (const auto l1 : l1s) {
+      const double layer = l1 / layerThickness - 0.5;
+      TS_ASSERT_DELTA(layer, std::round(layer), 1e-9);
+    }
+    TS_ASSERT(run.getPropertyValueAsType<std::string>("SampleShapeXML").find("cuboid") != std::string::npos);
+
+    // Reuse them for another material
+    Mantid::Algorithms::FlatPlateAbsorption reused;
+    configureFlatPlate(reused, testWS, "reusedFactors", "2.1", "5.1");
+    TS_ASSERT_THROWS_NOTHING(reused.setProperty("PathLengthsWorkspace", pathLengths));
+    TS_ASSERT_THROWS_NOTHING(reused.execute());
+    TS_ASSERT(reused.isExecuted());
+
+    Mantid::Algorithms::FlatPlateAbsorption recalculated;
+    configureFlatPlate(recalculated, testWS, "recalculatedFactors", "2.1", "5.1");
+    TS_ASSERT_THROWS_NOTHING(recalculated.execute());
+    TS_ASSERT(recalculated.isExecuted());
+
+    MatrixWorkspace_sptr reusedFactors = reused.getProperty("OutputWorkspace");
+    MatrixWorkspace_sptr recalculatedFactors = recalculated.getProperty("OutputWorkspace");
+    for (size_t i = 0; i < testWS->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < testWS->blocksize(); ++j)
+        TS_ASSERT_DELTA(reusedFactors->y(i)[j], recalculatedFactors->y(i)[j], 1e-12);
+    }
+
+    // The saved lengths to the detectors really are used: longer ones absorb more
+    MatrixWorkspace_sptr longerPaths = pathLengths->clone();
+    for (size_t i = 0; i < longerPaths->getNumberHistograms(); ++i)
+      longerPaths->mutableY(i) *= 2.;
+    Mantid::Algorithms::FlatPlateAbsorption longer;
+    configureFlatPlate(longer, testWS, "longerFactors", "2.1", "5.1");
+    TS_ASSERT_THROWS_NOTHING(longer.setProperty("PathLengthsWorkspace", longerPaths));
+    TS_ASSERT_THROWS_NOTHING(longer.execute());
+    TS_ASSERT(longer.isExecuted());
+    MatrixWorkspace_sptr longerFactors = longer.getProperty("OutputWorkspace");
+    for (size_t i = 0; i < testWS->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < testWS->blocksize(); ++j)
+        TS_ASSERT_LESS_THAN(longerFactors->y(i)[j], recalculatedFactors->y(i)[j]);
+    }
+
+    // Nor are they used once the sample has moved
+    MatrixWorkspace_sptr movedSample = longerPaths->clone();
+    auto &componentInfo = movedSample->mutableComponentInfo();
+    componentInfo.setPosition(componentInfo.sample(), Mantid::Kernel::V3D(0., 0., 0.01));
+    Mantid::Algorithms::FlatPlateAbsorption moved;
+    configureFlatPlate(moved, testWS, "movedFactors", "2.1", "5.1");
+    TS_ASSERT_THROWS_NOTHING(moved.setProperty("PathLengthsWorkspace", movedSample));
+    TS_ASSERT_THROWS_NOTHING(moved.execute());
+    TS_ASSERT(moved.isExecuted());
+    MatrixWorkspace_sptr movedFactors = moved.getProperty("OutputWorkspace");
+    for (size_t i = 0; i < testWS->getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < testWS->blocksize(); ++j)
+        TS_ASSERT_DELTA(movedFactors->y(i)[j], recalculatedFactors->y(i)[j], 1e-12);
+    }
+
+    // A different geometry does not use the saved lengths
+    Mantid::Algorithms::FlatPlateAbsorption thicker;
+    configureFlatPlate(thicker, testWS, "thickerFactors", "2.1", "5.1");
+    TS_ASSERT_THROWS_NOTHING(thicker.setPropertyValue("SampleThickness", "2.5"));
+    TS_ASSERT_THROWS_NOTHING(thicker.setProperty("PathLengthsWorkspace", pathLengths));
+    TS_ASSERT_THROWS_NOTHING(thicker.execute());
+    TS_ASSERT(thicker.isExecuted());
+    MatrixWorkspace_sptr thickerFactors = thicker.getProperty("OutputWorkspace");
+    TS_ASSERT_LESS_THAN(thickerFactors->y(0).back(), recalculatedFactors->y(0).back());
+
+    for (const auto &name : {"factors", "pathLengths", "reusedFactors", "recalculatedFactors", "longerFactors",
+                             "movedFactors", "thickerFactors"})
+      Mantid::API::AnalysisDataService::Instance().remove(name);
+  }
+
   void testWithoutSample() {
     // Create a small test workspace
     MatrixWorkspace_sptr testWS = createTestWorkspace();
@@ -78,6 +184,19 @@ private:
     return testWS;
   }
 
+  /// set up a flat plate sample with the given cross-sections
+  void configureFlatPlate(Mantid::Algorithms::FlatPlateAbsorption &alg, MatrixWorkspace_sptr &inputWS,
+                          const std::string &outputWSname, const std::string &attenuation,
+                          const std::string &scattering) {
+    configureAbsCommon(alg, inputWS, outputWSname);
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("SampleHeight", "2.3"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("SampleWidth", "1.8"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("SampleThickness", "1.5"));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("AttenuationXSection", attenuation));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("ScatteringXSection", scattering));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("SampleNumberDensity", "0.0093"));
+  }
+
   /// set what is used for all - intentionally skip the sample information
   void configureAbsCommon(Mantid::Algorithms::FlatPlateAbsorption &alg, MatrixWorkspace_sptr &inputWS,
                           const std::string &outputWSname) {
@@ -16,6 +16,7 @@
 #include "MonteCarloTesting.h"
 
 #include <gmock/gmock.h>
+#include <numeric>
 
 using Mantid::Algorithms::ComponentScatterPoint;
 using Mantid::Algorithms::MCInteractionStatistics;
@@ -129,6 +130,109 @@ public:
     TS_ASSERT_THROWS_NOTHING(MCInteractionVolume mcv(sample));
   }
 
+  void test_Stratified_Points_Are_Shared_Between_Components_By_Volume() {
+    auto kit = createTestKit();
+    Mantid::API::Sample sample;
+    sample.setShape(ComponentCreationHelper::createSphere(0.005));
+    sample.setEnvironment(std::make_unique<Mantid::Geometry::SampleEnvironment>(*kit));
+
+    MCInteractionVolume interactor(sample, 5000, MCInteractionVolume::ScatteringPointVicinity::SAMPLEANDENVIRONMENT,
+                                   MCInteractionVolume::ScatteringPointSampling::STRATIFIED);
+    // Every component lies fully in the default active region
+    const auto &volumes = interactor.componentVolumes();
+    TS_ASSERT_EQUALS(volumes.size(), 4);
+    TS_ASSERT_DELTA(volumes[0], sample.getShape().volume(), 1e-12);
+    for (size_t i = 0; i < kit->nelements(); ++i)
+      TS_ASSERT_DELTA(volumes[i + 1], kit->getComponent(i).volume(), 1e-12);
+
+    MersenneTwister rng(1);
+    const size_t npoints(2000);
+    std::vector<size_t> counts(4, 0);
+    for (size_t i = 0; i < npoints; ++i) {
+      const auto point = interactor.generatePoint(rng);
+      const auto &component =
+          point.componentIndex == -1 ? sample.getShape() : kit->getComponent(point.componentIndex);
+      TS_ASSERT(component.isValid(point.scatterPoint));
+      ++counts[point.componentIndex + 1];
+    }
+    const double totalVolume = std::accumulate(volumes.cbegin(), volumes.cend(), 0.);
+    for (size_t i = 0; i < counts.size(); ++i)
+      TS_ASSERT_DELTA(static_cast<double>(counts[i]) / npoints, volumes[i] / totalVolume, 0.05);
+  }
+
+  void test_Stratified_Points_Only_Use_The_Part_Of_A_Component_In_The_Active_Region() {
+    auto kit = createTestKit();
+    Mantid::API::Sample sample;
+    sample.setShape(ComponentCreationHelper::createSphere(0.005));
+    sample.setEnvironment(std::make_unique<Mantid::Geometry::SampleEnvironment>(*kit));
+
+    MCInteractionVolume interactor(sample, 5000, MCInteractionVolume::ScatteringPointVicinity::SAMPLEANDENVIRONMENT,
+                                   MCInteractionVolume::ScatteringPointSampling::STRATIFIED);
+    // Half of the sphere before the sample
+    const Mantid::Geometry::BoundingBox halfSphere(-0.25, 0.1, 0.1, -0.35, -0.1, -0.1);
+    interactor.setActiveRegion(halfSphere);
+    const auto &volumes = interactor.componentVolumes();
+    TS_ASSERT_EQUALS(volumes[0], 0.);
+    TS_ASSERT_EQUALS(volumes[1], 0.);
+    TS_ASSERT_DELTA(volumes[2], 0.5 * kit->getComponent(1).volume(), 0.02 * kit->getComponent(1).volume());
+    TS_ASSERT_EQUALS(volumes[3], 0.);
+
+    MersenneTwister rng(1);
+    for (size_t i = 0; i < 100; ++i) {
+      const auto point = interactor.generatePoint(rng);
+      TS_ASSERT_EQUALS(point.componentIndex, 1);
+      TS_ASSERT(halfSphere.isPointInside(point.scatterPoint));
+    }
+  }
+
+  void test_Rejection_And_Stratified_Points_Are_Shared_Between_Components_Alike() {
+    auto sample = createSamplePlusContainer();
+    // Silicon cylinder filling the inside of a vanadium annulus of the same height
+    const double innerRadius(0.0046), outerRadius(0.005);
+    const double expectedSampleShare = (innerRadius * innerRadius) / (outerRadius * outerRadius);
+
+    const auto sampleShare = [&sample](const MCInteractionVolume::ScatteringPointSampling sampling,
+                                       MCInteractionStatistics &stats) {
+      MCInteractionVolume interactor(sample, 5000, MCInteractionVolume::ScatteringPointVicinity::SAMPLEANDENVIRONMENT,
+                                     sampling);
+      MersenneTwister rng(1);
+      const size_t npoints(20000);
+      size_t inSample(0);
+      for (size_t i = 0; i < npoints; ++i) {
+        if (interactor.generatePoint(rng, &stats).componentIndex == -1)
+          ++inSample;
+      }
+      return static_cast<double>(inSample) / npoints;
+    };
+    MCInteractionStatistics rejectionStats(-1, sample), stratifiedStats(-1, sample);
+    const double rejectionShare = sampleShare(MCInteractionVolume::ScatteringPointSampling::REJECTION, rejectionStats);
+    const double stratifiedShare =
+        sampleShare(MCInteractionVolume::ScatteringPointSampling::STRATIFIED, stratifiedStats);
+    TS_ASSERT_DELTA(rejectionShare, expectedSampleShare, 0.01);
+    TS_ASSERT_DELTA(stratifiedShare, expectedSampleShare, 0.01);
+    TS_ASSERT_DELTA(rejectionShare, stratifiedShare, 0.015);
+
+    // The hole in the can is in its bounding box so some stratified attempts miss it
+    const auto summary = stratifiedStats.generateScatterPointStats();
+    const auto canRate = summary.find("Environment part 0");
+    TS_ASSERT(canRate != std::string::npos);
+    TS_ASSERT(summary.find("rejection rate: 0.00%", canRate) == std::string::npos);
+  }
+
+  void test_Rejected_Points_Are_Counted_Per_Component() {
+    const V3D startPos(-2.0, 0.0, 0.0), endPos(2.0, 0.0, 0.0);
+    auto sample = createTestSample(TestSampleType::ThinAnnulus);
+    MersenneTwister rng(1);
+    MCInteractionVolume interactor(sample);
+    MCInteractionStatistics trackStatistics(-1, sample);
+    for (size_t i = 0; i < 10; ++i)
+      interactor.calculateBeforeAfterTrack(rng, startPos, endPos, trackStatistics);
+    // Most points in the bounding box of a thin annulus miss it
+    const auto summary = trackStatistics.generateScatterPointStats();
+    TS_ASSERT(summary.find("Sample rejection rate: 0.00%") == std::string::npos);
+    TS_ASSERT(summary.find("Sample rejection rate: ") != std::string::npos);
+  }
+
   //----------------------------------------------------------------------------
   // Failure cases
   //----------------------------------------------------------------------------
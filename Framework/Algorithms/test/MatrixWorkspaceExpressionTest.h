@@ -0,0 +1,192 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/WorkspaceOpOverloads.h"
+#include "MantidAlgorithms/MatrixWorkspaceExpression.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+
+using namespace Mantid::API;
+using namespace Mantid::Algorithms;
+using namespace Mantid::DataObjects;
+
+class MatrixWorkspaceExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MatrixWorkspaceExpressionTest *createSuite() { return new MatrixWorkspaceExpressionTest(); }
+  static void destroySuite(MatrixWorkspaceExpressionTest *suite) { delete suite; }
+
+  void test_empty_expression_does_nothing() {
+    auto a = makeWorkspace(1.0);
+    MatrixWorkspace_sptr expected = a->clone();
+    MatrixWorkspaceExpression expression;
+    TS_ASSERT(expression.empty());
+    expression.evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_arithmetic_chain_matches_single_operations() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    auto c = makeWorkspace(3.0);
+    MatrixWorkspace_sptr expected = (a - b) / c * 2.5 + 1.0;
+
+    MatrixWorkspaceExpression expression;
+    expression.subtract(*b).divide(*c).multiply(2.5, 0.0).add(1.0, 0.0);
+    TS_ASSERT_EQUALS(expression.size(), 4);
+    expression.evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_unary_operations_match_single_operations() {
+    auto a = makeWorkspace(1.0);
+    auto expected = runAlgorithm("Power", a, {{"Exponent", "2"}});
+    expected = runAlgorithm("Logarithm", expected, {{"Filler", "-1"}, {"Natural", "0"}});
+    expected = runAlgorithm("Exponential", expected, {});
+    expected = runAlgorithm("Logarithm", expected, {{"Filler", "-2"}});
+
+    MatrixWorkspaceExpression().power(2.0).log10(-1.0).exp().log(-2.0).evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_operands_with_errors_match_single_operations() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    auto value = WorkspaceCreationHelper::createWorkspaceSingleValueWithError(3.0, 0.5);
+    MatrixWorkspace_sptr spectrum = create<Workspace2D>(1, makeWorkspace(3.0)->histogram(0));
+    spectrum->getAxis(0)->unit() = a->getAxis(0)->unit();
+    MatrixWorkspace_sptr expected = (((a * b) + value) / spectrum) - value;
+
+    MatrixWorkspaceExpression().multiply(*b).add(*value).divide(*spectrum).subtract(*value).evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_masking_matches_single_operations() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    b->mutableSpectrumInfo().setMasked(1, true);
+    a->mutableSpectrumInfo().setMasked(3, true);
+    b->flagMasked(2, 10, 0.5);
+    MatrixWorkspace_sptr expected = (a * 2.0 + b) * 3.0 - b;
+
+    MatrixWorkspaceExpression().multiply(2.0, 0.0).add(*b).multiply(3.0, 0.0).subtract(*b).evaluate(*a);
+    checkSameValues(*a, *expected);
+    const auto &spectrumInfo = a->spectrumInfo();
+    for (size_t i = 0; i < a->getNumberHistograms(); ++i)
+      TS_ASSERT_EQUALS(spectrumInfo.isMasked(i), expected->spectrumInfo().isMasked(i));
+    TS_ASSERT(spectrumInfo.isMasked(1));
+    TS_ASSERT_EQUALS(a->maskedBins(2), expected->maskedBins(2));
+  }
+
+  void test_operand_can_be_the_result() {
+    auto a = makeWorkspace(1.0);
+    MatrixWorkspace_sptr expected = a->clone();
+    expected = expected * expected;
+    expected = expected + expected;
+
+    MatrixWorkspaceExpression().multiply(*a).add(*a).evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_mismatched_operand_throws_without_changing_the_workspace() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    auto small = WorkspaceCreationHelper::create2DWorkspace123(3, 3000, true);
+    auto shorter = WorkspaceCreationHelper::create2DWorkspace123(5, 20, true);
+    MatrixWorkspace_sptr expected = a->clone();
+    TS_ASSERT_THROWS(MatrixWorkspaceExpression().add(*b).multiply(*small).evaluate(*a), const std::invalid_argument &);
+    TS_ASSERT_THROWS(MatrixWorkspaceExpression().add(*b).multiply(*shorter).evaluate(*a),
+                     const std::invalid_argument &);
+    checkSameValues(*a, *expected);
+  }
+
+private:
+  /// A workspace whose spectra are longer than a block, with values varying from bin to bin
+  static Workspace2D_sptr makeWorkspace(double offset) {
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(5, 3000);
+    TS_ASSERT_LESS_THAN(MatrixWorkspaceExpression::BLOCK_SIZE, ws->blocksize());
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      auto &y = ws->mutableY(i);
+      auto &e = ws->mutableE(i);
+      for (size_t j = 0; j < y.size(); ++j) {
+        const auto x = static_cast<double>(i * y.size() + j);
+        y[j] = 2.0 + std::sin(x + offset);
+        e[j] = 0.1 + std::cos(x * offset) * std::cos(x * offset);
+      }
+    }
+    return ws;
+  }
+
+  static MatrixWorkspace_sptr runAlgorithm(const std::string &name, const MatrixWorkspace_sptr &input,
+                                           const std::map<std::string, std::string> &properties) {
+    auto alg = AlgorithmManager::Instance().createUnmanaged(name);
+    alg->initialize();
+    alg->setChild(true);
+    alg->setRethrows(true);
+    alg->setProperty("InputWorkspace", input);
+    for (const auto &property : properties)
+      alg->setPropertyValue(property.first, property.second);
+    alg->setPropertyValue("OutputWorkspace", "unused");
+    alg->execute();
+    return alg->getProperty("OutputWorkspace");
+  }
+
+  static void checkSameValues(const MatrixWorkspace &actual, const MatrixWorkspace &expected) {
+    TS_ASSERT_EQUALS(actual.getNumberHistograms(), expected.getNumberHistograms());
+    size_t mismatches(0);
+    for (size_t i = 0; i < actual.getNumberHistograms(); ++i) {
+      for (size_t j = 0; j < actual.y(i).size(); ++j) {
+        if (!same(actual.y(i)[j], expected.y(i)[j]) || !same(actual.e(i)[j], expected.e(i)[j]))
+          ++mismatches;
+      }
+    }
+    TS_ASSERT_EQUALS(mismatches, 0);
+  }
+
+  /// Equal within rounding, including both values being NaN
+  static bool same(double a, double b) {
+    return std::fabs(a - b) <= 1e-12 * std::max(std::fabs(a), std::fabs(b)) || (std::isnan(a) && std::isnan(b));
+  }
+};
+
+class MatrixWorkspaceExpressionTestPerformance : public CxxTest::TestSuite {
+public:
+  static MatrixWorkspaceExpressionTestPerformance *createSuite() {
+    return new MatrixWorkspaceExpressionTestPerformance();
+  }
+  static void destroySuite(MatrixWorkspaceExpressionTestPerformance *suite) { delete suite; }
+
+  MatrixWorkspaceExpressionTestPerformance() {
+    m_a = WorkspaceCreationHelper::create2DWorkspaceBinned(100000, 100);
+    m_b = WorkspaceCreationHelper::create2DWorkspaceBinned(100000, 100);
+    m_c = WorkspaceCreationHelper::create2DWorkspaceBinned(100000, 100);
+  }
+
+  void test_chain_of_six_operations() {
+    MatrixWorkspaceExpression()
+        .subtract(*m_b)
+        .divide(*m_c)
+        .multiply(2.5, 0.0)
+        .add(*m_b)
+        .power(2.0)
+        .multiply(*m_c)
+        .evaluate(*m_a);
+  }
+
+private:
+  Workspace2D_sptr m_a, m_b, m_c;
+};
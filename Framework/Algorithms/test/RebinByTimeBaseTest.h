@@ -95,6 +95,7 @@ public:
   MOCK_METHOD0(resetAllXToSingleBin, void());
   MOCK_METHOD0(clearMRU, void());
   MOCK_CONST_METHOD0(clearMRU, void());
+  MOCK_CONST_METHOD0(cacheHistograms, std::size_t());
   MOCK_CONST_METHOD0(isRaggedWorkspace, bool());
   MOCK_CONST_METHOD0(blocksize, std::size_t());
   MOCK_CONST_METHOD1(getNumberBins, std::size_t(const std::size_t &));
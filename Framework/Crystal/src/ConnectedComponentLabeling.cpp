@@ -4,6 +4,8 @@
 //   NScD Oak Ridge National Laboratory, European Spallation Source,
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
+#include <atomic>
+#include <limits>
 #include <utility>
 
 #include "MantidCrystal/ConnectedComponentLabeling.h"
@@ -13,9 +15,9 @@
 #include "MantidAPI/IMDIterator.h"
 #include "MantidCrystal/BackgroundStrategy.h"
 #include "MantidCrystal/Cluster.h"
-#include "MantidCrystal/ClusterRegister.h"
 #include "MantidCrystal/ICluster.h"
 #include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
 
 using namespace Mantid::API;
 using namespace Mantid::Kernel;
@@ -23,43 +25,6 @@ using namespace Mantid::Crystal::ConnectedComponentMappingTypes;
 
 namespace Mantid::Crystal {
 namespace {
-/**
- * Perform integer power to determine the maximum number of face and edge
- * connected
- * neighbours for a given dimensionality
- * @param ws : Workspace with dimensionality
- * @return : Maximum number of possible neighbours
- */
-size_t calculateMaxNeighbours(IMDHistoWorkspace const *const ws) {
-  const size_t ndims = ws->getNumDims();
-  size_t maxNeighbours = 3;
-  for (size_t i = 1; i < ndims; ++i) {
-    maxNeighbours *= 3;
-  }
-  maxNeighbours -= 1;
-  return maxNeighbours;
-}
-
-/**
- * Get the maximum number of clusters possible in an MD space. For use as an
- * offset.
- * @param ws : Workspace to interogate
- * @param nIterators : number of equally sized iterators working on the
- * workspace
- * @return Maximum number of clusters.
- */
-size_t calculateMaxClusters(IMDHistoWorkspace const *const ws, size_t nIterators) {
-  size_t maxClusters = 1;
-  for (size_t i = 0; i < ws->getNumDims(); ++i) {
-    maxClusters *= ws->getDimension(i)->getNBins() / 2;
-  }
-  maxClusters /= nIterators;
-  if (maxClusters == 0) {
-    maxClusters = ws->getNPoints();
-  }
-  return maxClusters;
-}
-
 /**
  * Helper non-member to clone the input workspace
  * @param inWS: To clone
@@ -78,121 +43,189 @@ std::shared_ptr<Mantid::API::IMDHistoWorkspace> cloneInputWorkspace(IMDHistoWork
   return outWS;
 }
 
+Logger g_log("ConnectedComponentLabeling");
+
 /**
- * Helper function to calculate report frequecny
- * @param maxReports : Maximum number of reports wanted
- * @param maxIterations : Maximum number of possible iterations
- * @return
+ * Disjoint-set forest over the linear indexes of an image that several threads
+ * may update at once without locking. Background elements are marked empty.
+ * A union links the root with the higher index beneath the root with the lower
+ * index using compare-and-swap, and retries if another thread changed either
+ * root first. Parents therefore only ever point to lower indexes and the root
+ * of a set is always its lowest linear index.
  */
-template <typename T> T reportEvery(const T &maxReports, const T &maxIterations) {
-  T frequency = maxReports;
-  if (maxIterations >= maxReports) {
-    frequency = maxIterations / maxReports;
+template <typename IndexType> class ConcurrentDisjointSet {
+public:
+  static constexpr IndexType EMPTY = std::numeric_limits<IndexType>::max();
+
+  ConcurrentDisjointSet(size_t size, int nThreads) : m_parents(size) {
+    PRAGMA_OMP(parallel for num_threads(nThreads))
+    for (int64_t i = 0; i < static_cast<int64_t>(size); ++i) {
+      m_parents[i].store(EMPTY, std::memory_order_relaxed);
+    }
   }
-  return frequency;
-}
 
-// Helper function for determining if a set contains a specific value.
-template <typename Container>
-bool does_contain_key(const Container &container, const typename Container::key_type &value) {
-  return container.find(value) != container.end();
-}
+  /// Make the element at index the only member of a new set
+  void makeSet(IndexType index) { m_parents[index].store(index, std::memory_order_relaxed); }
+
+  /// @return true if the element at index is background
+  bool isEmpty(IndexType index) const { return parent(index) == EMPTY; }
+
+  /// @return the parent of the element at index
+  IndexType parent(IndexType index) const { return m_parents[index].load(std::memory_order_relaxed); }
+
+  /// Overwrite the parent of the element at index
+  void setParent(IndexType index, IndexType parent) { m_parents[index].store(parent, std::memory_order_relaxed); }
+
+  /// @return the root of the set containing index. Halves the path on the way.
+  IndexType find(IndexType index) {
+    while (true) {
+      IndexType parent = m_parents[index].load(std::memory_order_relaxed);
+      if (parent == index)
+        return index;
+      const IndexType grandParent = m_parents[parent].load(std::memory_order_relaxed);
+      if (grandParent == parent)
+        return parent;
+      // Losing this race to another thread only leaves the path longer
+      m_parents[index].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      index = grandParent;
+    }
+  }
 
-using EdgeIndexPair = boost::tuple<size_t, size_t>;
-using VecEdgeIndexPair = std::vector<EdgeIndexPair>;
+  /// Merge the sets containing a and b
+  void unite(IndexType a, IndexType b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b)
+        return;
+      if (a > b)
+        std::swap(a, b);
+      IndexType expected = b;
+      if (m_parents[b].compare_exchange_strong(expected, a))
+        return;
+    }
+  }
+
+private:
+  std::vector<std::atomic<IndexType>> m_parents;
+};
 
 /**
- * Free function performing the CCL implementation over a range defined by the
- *iterator.
+ * Label the connected components of an image.
+ *
+ * 1. The image is split into a contiguous block per thread and each block is
+ *    labelled independently. Links to neighbours in earlier blocks are
+ *    recorded rather than followed, as those blocks may not have been visited.
+ * 2. The links recorded across block boundaries are merged in parallel.
+ * 3. The components are numbered consecutively from startId in order of
+ *    their lowest linear index and a cluster is created for each one.
  *
- * @param iterator : Iterator giving access the the image
- * @param strategy : Strategy for identifying background
- * @param neighbourElements : Grid of DisjointElements the same size as the
- *image
+ * The labels produced do not depend on the number of threads.
+ *
+ * @param ws : Image to label
+ * @param baseStrategy : Strategy for identifying background
+ * @param startId : Label of the first cluster
+ * @param nThreads : Number of threads to use
  * @param progress : Progress object to update
- * @param maxNeighbours : Maximum number of neighbours each element may have.
- *Determined by dimensionality.
- * @param startLabelId : Start label index to increment
- * @param edgeIndexVec : Vector of edge index pairs. To identify elements across
- *iterator boundaries to resolve later.
- * @return
+ * @return Map of label ids to clusters
  */
-size_t doConnectedComponentLabeling(IMDIterator *iterator, BackgroundStrategy *const strategy,
-                                    VecElements &neighbourElements, Progress &progress, size_t maxNeighbours,
-                                    size_t startLabelId, VecEdgeIndexPair &edgeIndexVec) {
-  size_t currentLabelCount = startLabelId;
-  strategy->configureIterator(iterator); // Set up such things as desired Normalization.
-  do {
-    if (!strategy->isBackground(iterator)) {
-
-      size_t currentIndex = iterator->getLinearIndex();
-      progress.report();
-      // Linear indexes of neighbours
-      VecIndexes neighbourIndexes = iterator->findNeighbourIndexes();
-      VecIndexes nonEmptyNeighbourIndexes;
-      nonEmptyNeighbourIndexes.reserve(maxNeighbours);
-      SetIds neighbourIds;
-      // Discover non-empty neighbours
-      for (auto neighIndex : neighbourIndexes) {
-        if (!iterator->isWithinBounds(neighIndex)) {
-          /* Record labels which appear to belong to the same cluster, but
-           cannot be combined in this
-           pass and will later need to be conjoined and resolved. As Labels
-           cannot be guarnteed to be
-           correcly provided for all neighbours until the end. We must store
-           indexes instead.
-           */
-          edgeIndexVec.emplace_back(currentIndex, neighIndex);
-          continue;
-        }
-
-        const DisjointElement &neighbourElement = neighbourElements[neighIndex];
-
-        if (!neighbourElement.isEmpty()) {
-          nonEmptyNeighbourIndexes.emplace_back(neighIndex);
-          neighbourIds.insert(neighbourElement.getId());
-        }
-      }
-
-      if (nonEmptyNeighbourIndexes.empty()) {
-        DisjointElement &element = neighbourElements[currentIndex];
-        element.setId(static_cast<int>(currentLabelCount));
-        ++currentLabelCount;
-      } else if (neighbourIds.size() == 1) // Do we have a single unique id amongst all neighbours.
-      {
-        neighbourElements[currentIndex] = neighbourElements[nonEmptyNeighbourIndexes.front()]; // Copy
-                                                                                               // non-empty
-                                                                                               // neighbour
-      } else {
-        // Choose the lowest neighbour index as the parent.
-        size_t candidateSourceParentIndex = nonEmptyNeighbourIndexes[0];
-        for (size_t i = 1; i < nonEmptyNeighbourIndexes.size(); ++i) {
-          size_t neighIndex = nonEmptyNeighbourIndexes[i];
-          if (neighbourElements[neighIndex].getRoot() < neighbourElements[candidateSourceParentIndex].getRoot()) {
-            candidateSourceParentIndex = neighIndex;
-          }
-        }
-        // Get the chosen parent
-        DisjointElement &parentElement = neighbourElements[candidateSourceParentIndex];
-        // Union remainder parents with the chosen parent
-        for (auto neighIndex : nonEmptyNeighbourIndexes) {
-          if (neighIndex != candidateSourceParentIndex) {
-            neighbourElements[neighIndex].unionWith(&parentElement);
+template <typename IndexType>
+ClusterMap labelComponents(const IMDHistoWorkspace &ws, BackgroundStrategy *const baseStrategy, size_t startId,
+                           int nThreads, Progress &progress) {
+  using IndexPair = std::pair<IndexType, IndexType>;
+  const size_t nPoints = ws.getNPoints();
+  ConcurrentDisjointSet<IndexType> forest(nPoints, nThreads);
+
+  auto iterators = ws.createIterators(nThreads);
+  const int nBlocks = static_cast<int>(iterators.size());
+  std::vector<std::vector<IndexPair>> boundaryLinks(nBlocks);
+  progress.resetNumSteps(nBlocks + 1, 0.0, 0.8);
+
+  // ------------- Stage One. Local CCL in parallel.
+  g_log.debug("Parallel solve local CCL");
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) num_threads(nThreads))
+  for (int i = 0; i < nBlocks; ++i) {
+    API::IMDIterator *iterator = iterators[i].get();
+    std::unique_ptr<BackgroundStrategy> strategy(baseStrategy->clone()); // local strategy
+    strategy->configureIterator(iterator); // Set up such things as desired Normalization.
+    auto &links = boundaryLinks[i];
+    if (iterator->valid()) {
+      do {
+        if (!strategy->isBackground(iterator)) {
+          const auto currentIndex = static_cast<IndexType>(iterator->getLinearIndex());
+          forest.makeSet(currentIndex);
+          // Neighbours with higher indexes link back to this element when they are visited.
+          for (const auto neighbourIndex : iterator->findNeighbourIndexes()) {
+            if (neighbourIndex >= currentIndex) {
+              continue;
+            }
+            const auto neighbour = static_cast<IndexType>(neighbourIndex);
+            if (!iterator->isWithinBounds(neighbourIndex)) {
+              links.emplace_back(currentIndex, neighbour);
+            } else if (!forest.isEmpty(neighbour)) {
+              forest.unite(currentIndex, neighbour);
+            }
           }
         }
+      } while (iterator->next());
+    }
+    progress.report();
+  }
 
-        neighbourElements[currentIndex].unionWith(&parentElement);
+  // -------------------- Stage 2 --- Merge across block boundaries.
+  g_log.debug("Merge clusters across block boundaries");
+  for (const auto &links : boundaryLinks) {
+    PRAGMA_OMP(parallel for num_threads(nThreads))
+    for (int64_t i = 0; i < static_cast<int64_t>(links.size()); ++i) {
+      const IndexPair &link = links[i];
+      if (!forest.isEmpty(link.second)) {
+        forest.unite(link.first, link.second);
       }
     }
-  } while (iterator->next());
+  }
 
-  return currentLabelCount;
+  // Point every element directly at its root.
+  PRAGMA_OMP(parallel for num_threads(nThreads))
+  for (int64_t i = 0; i < static_cast<int64_t>(nPoints); ++i) {
+    const auto index = static_cast<IndexType>(i);
+    if (!forest.isEmpty(index)) {
+      forest.setParent(index, forest.find(index));
+    }
+  }
+  progress.report();
+
+  // -------------------- Stage 3 --- Number the clusters.
+  // A root is the first element of its cluster to be visited, so its entry
+  // can be reused to hold the cluster number for the elements that follow.
+  ClusterMap clusterMap;
+  std::vector<std::shared_ptr<Cluster>> clusters;
+  for (size_t i = 0; i < nPoints; ++i) {
+    const auto index = static_cast<IndexType>(i);
+    if (forest.isEmpty(index)) {
+      continue;
+    }
+    const IndexType root = forest.parent(index);
+    if (root == index) {
+      const size_t labelId = startId + clusters.size();
+      forest.setParent(index, static_cast<IndexType>(clusters.size()));
+      clusters.emplace_back(std::make_shared<Cluster>(labelId));
+      clusterMap.emplace_hint(clusterMap.end(), labelId, clusters.back());
+    }
+    clusters[forest.parent(root)]->addIndex(i);
+  }
+  return clusterMap;
 }
 
-Logger g_log("ConnectedComponentLabeling");
+/**
+ * @param nPoints : Number of elements in the image
+ * @return true if the disjoint set for the image can use 32 bit indexes
+ */
+bool fitsCompactIndexes(size_t nPoints) { return nPoints < std::numeric_limits<uint32_t>::max(); }
 
 void memoryCheck(size_t nPoints) {
+  // The output image and the disjoint set.
   size_t sizeOfElement = (3 * sizeof(signal_t)) + sizeof(bool);
+  sizeOfElement += fitsCompactIndexes(nPoints) ? sizeof(uint32_t) : sizeof(uint64_t);
 
   MemoryStats memoryStats;
   const size_t freeMemory = memoryStats.availMem();         // in kB
@@ -252,7 +285,7 @@ int ConnectedComponentLabeling::getNThreads() const {
 /**
  * Perform the work of the CCL algorithm
  * - Pre filtering of background
- * - Labeling using DisjointElements
+ * - Labeling using a concurrent disjoint set
  *
  * @param ws : MDHistoWorkspace to run CCL algorithm on
  * @param baseStrategy : Background strategy
@@ -262,110 +295,13 @@ int ConnectedComponentLabeling::getNThreads() const {
 ClusterMap ConnectedComponentLabeling::calculateDisjointTree(const IMDHistoWorkspace_sptr &ws,
                                                              BackgroundStrategy *const baseStrategy,
                                                              Progress &progress) const {
-  std::map<size_t, std::shared_ptr<ICluster>> clusterMap;
-  VecElements neighbourElements(ws->getNPoints());
-
-  const size_t maxNeighbours = calculateMaxNeighbours(ws.get());
-
   progress.doReport("Identifying clusters");
-  auto frequency = reportEvery<size_t>(10000, ws->getNPoints());
-  progress.resetNumSteps(frequency, 0.0, 0.8);
-
-  // For each process maintains pair of index from within process bounds to
-  // index outside process bounds
-  const int nThreadsToUse = getNThreads();
-
-  if (nThreadsToUse > 1) {
-    auto iterators = ws->createIterators(nThreadsToUse);
-    const size_t maxClustersPossible = calculateMaxClusters(ws.get(), nThreadsToUse);
-
-    std::vector<VecEdgeIndexPair> parallelEdgeVec(nThreadsToUse);
-
-    std::vector<std::map<size_t, std::shared_ptr<Cluster>>> parallelClusterMapVec(nThreadsToUse);
-
-    // ------------- Stage One. Local CCL in parallel.
-    g_log.debug("Parallel solve local CCL");
-    // PARALLEL_FOR_NO_WSP_CHECK()
-    for (int i = 0; i < nThreadsToUse; ++i) {
-      API::IMDIterator *iterator = iterators[i].get();
-      boost::scoped_ptr<BackgroundStrategy> strategy(baseStrategy->clone()); // local strategy
-      VecEdgeIndexPair &edgeVec = parallelEdgeVec[i];                        // local edge indexes
-
-      const size_t startLabel = m_startId + (i * maxClustersPossible); // Ensure that label ids are
-                                                                       // totally unique within each
-                                                                       // parallel unit.
-      const size_t endLabel = doConnectedComponentLabeling(iterator, strategy.get(), neighbourElements, progress,
-                                                           maxNeighbours, startLabel, edgeVec);
-
-      // Create clusters from labels.
-      std::map<size_t, std::shared_ptr<Cluster>> &localClusterMap = parallelClusterMapVec[i]; // local cluster map.
-      for (size_t labelId = startLabel; labelId != endLabel; ++labelId) {
-        auto cluster = std::make_shared<Cluster>(labelId); // Create a cluster for the label and key it by the label.
-        localClusterMap[labelId] = cluster;
-      }
-
-      // Associate the member DisjointElements with a cluster. Involves looping
-      // back over iterator.
-      iterator->jumpTo(0); // Reset
-      do {
-        if (!baseStrategy->isBackground(iterator)) {
-          // Second pass smoothing step
-          const size_t currentIndex = iterator->getLinearIndex();
-
-          const size_t &labelAtIndex = neighbourElements[currentIndex].getRoot();
-          localClusterMap[labelAtIndex]->addIndex(currentIndex);
-        }
-      } while (iterator->next());
-    }
-
-    // -------------------- Stage 2 --- Preparation stage for combining
-    // equivalent clusters. Must be done in sequence.
-    // Combine cluster maps processed by each thread.
-    ClusterRegister clusterRegister;
-    for (const auto &parallelClusterMap : parallelClusterMapVec) {
-      for (const auto &cluster : parallelClusterMap) {
-        clusterRegister.add(cluster.first, cluster.second);
-      }
-    }
-
-    // Percolate minimum label across boundaries for indexes where there is
-    // ambiguity.
-    g_log.debug("Percolate minimum label across boundaries");
-
-    for (auto &indexPairVec : parallelEdgeVec) {
-      for (auto &iit : indexPairVec) {
-        DisjointElement &a = neighbourElements[iit.get<0>()];
-        DisjointElement &b = neighbourElements[iit.get<1>()];
-        clusterRegister.merge(a, b);
-      }
-    }
-    clusterMap = clusterRegister.clusters(neighbourElements);
-
-  } else {
-    auto iterator = ws->createIterator(nullptr);
-    VecEdgeIndexPair edgeIndexPair; // This should never get filled in a single
-                                    // threaded situation.
-    size_t endLabelId = doConnectedComponentLabeling(iterator.get(), baseStrategy, neighbourElements, progress,
-                                                     maxNeighbours, m_startId, edgeIndexPair);
-
-    // Create clusters from labels.
-    for (size_t labelId = m_startId; labelId != endLabelId; ++labelId) {
-      auto cluster = std::make_shared<Cluster>(labelId); // Create a cluster for the label and key it by the label.
-      clusterMap[labelId] = cluster;
-    }
-
-    // Associate the member DisjointElements with a cluster. Involves looping
-    // back over iterator.
-    iterator->jumpTo(0); // Reset
-    do {
-      const size_t currentIndex = iterator->getLinearIndex();
-      if (!baseStrategy->isBackground(iterator.get())) {
-        const int labelAtIndex = neighbourElements[currentIndex].getRoot();
-        clusterMap[labelAtIndex]->addIndex(currentIndex);
-      }
-    } while (iterator->next());
+  const int nThreadsToUse = std::max(getNThreads(), 1);
+  // Half the memory of 64 bit indexes wherever the image allows it
+  if (fitsCompactIndexes(ws->getNPoints())) {
+    return labelComponents<uint32_t>(*ws, baseStrategy, m_startId, nThreadsToUse, progress);
   }
-  return clusterMap;
+  return labelComponents<uint64_t>(*ws, baseStrategy, m_startId, nThreadsToUse, progress);
 }
 
 /**
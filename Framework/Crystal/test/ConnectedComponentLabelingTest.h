@@ -580,6 +580,39 @@ public:
   void test_brige_link_schenario_single_threaded() { do_test_brige_link_schenario(1); }
 
   void test_brige_link_schenario_multi_threaded() { do_test_brige_link_schenario(3); }
+
+  void test_labels_do_not_depend_on_number_of_threads() {
+    // A pseudo-random image with many clusters spanning the thread boundaries.
+    IMDHistoWorkspace_sptr inWS = MDEventsTestHelper::makeFakeMDHistoWorkspace(0, 3, 20);
+    for (size_t i = 0; i < inWS->getNPoints(); ++i) {
+      inWS->setSignalAt(i, ((i * 7919) % 13) < 4 ? 1 : 0);
+    }
+    HardThresholdBackground backgroundStrategy(0.5, NoNormalization);
+    const size_t labelingId = 3;
+    Progress prog;
+
+    auto expected = ConnectedComponentLabeling(labelingId, 1).executeAndFetchClusters(inWS, &backgroundStrategy, prog);
+    const auto &expectedClusters = expected.get<1>();
+    auto expectedWS = expected.get<0>();
+    TS_ASSERT_LESS_THAN(10, expectedClusters.size());
+    // Labels are consecutive from the start id.
+    TS_ASSERT_EQUALS(labelingId, expectedClusters.begin()->first);
+    TS_ASSERT_EQUALS(labelingId + expectedClusters.size() - 1, expectedClusters.rbegin()->first);
+
+    for (int nThreads : {2, 3, 7}) {
+      ConnectedComponentLabeling ccl(labelingId, nThreads);
+      auto actual = ccl.executeAndFetchClusters(inWS, &backgroundStrategy, prog);
+      TS_ASSERT_EQUALS(expectedClusters.size(), actual.get<1>().size());
+      auto actualWS = actual.get<0>();
+      size_t mismatches = 0;
+      for (size_t i = 0; i < inWS->getNPoints(); ++i) {
+        if (actualWS->getSignalAt(i) != expectedWS->getSignalAt(i)) {
+          ++mismatches;
+        }
+      }
+      TSM_ASSERT_EQUALS("Threads: " + std::to_string(nThreads), 0, mismatches);
+    }
+  }
 };
 
 //=====================================================================================
@@ -0,0 +1,90 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/// How the time-of-flight axis is divided into bins when compressing events while loading
+enum class CompressBinningMode { LINEAR, LOGARITHMIC };
+
+/** CompressEventAccumulator combines the events of one spectrum into
+  compressed events as they are read, so the uncompressed events of the
+  spectrum are never all held in memory.
+
+  The time-of-flight axis is divided into fixed bins, either tolerance
+  microseconds wide (linear) or with edges at (1 + tolerance)^k microseconds
+  (logarithmic). All the events in a bin become one weighted event at their
+  average time-of-flight. If a wall-clock tolerance is given the events are
+  also split by pulse time into windows of that many seconds, and each
+  compressed event keeps the average pulse time of its events.
+
+  Events are buffered and folded into the sorted bins whenever the buffer
+  grows as large as the bins, so the memory used stays proportional to the
+  number of compressed events.
+*/
+class MANTID_DATAHANDLING_DLL CompressEventAccumulator {
+public:
+  CompressEventAccumulator(const double tolerance, const CompressBinningMode mode,
+                           const double wallClockTolerance = 0.);
+
+  /// Add an event
+  void addEvent(const double tof, const Types::Core::DateAndTime &pulseTime, const float weight = 1.f,
+                const float errorSquared = 1.f) {
+    m_buffer.emplace_back(tof, pulseTime, weight, errorSquared);
+    if (m_buffer.size() >= std::max(MIN_BUFFER_SIZE, m_bins.size()))
+      fold();
+  }
+  /// @return true if no events have been added
+  bool empty() const { return m_buffer.empty() && m_bins.empty(); }
+  /// @return true if the compressed events keep their pulse times
+  bool keepsPulseTimes() const { return m_wallClockTolerance > 0; }
+
+  void createEvents(std::vector<DataObjects::WeightedEventNoTime> &events);
+  void createEvents(std::vector<DataObjects::WeightedEvent> &events);
+
+  /// The fewest events buffered before they are folded into the bins
+  static constexpr size_t MIN_BUFFER_SIZE = 128;
+
+private:
+  /// The sums for the events in one bin
+  struct Bin {
+    int64_t pulseBin;
+    int64_t tofBin;
+    double tofSum;
+    double pulseOffsetSum;
+    double weight;
+    double errorSquared;
+    double norm;
+  };
+
+  int64_t tofBin(const double tof) const;
+  double logBinEdge(const int64_t bin) const;
+  int64_t pulseBin(const Types::Core::DateAndTime &pulseTime) const;
+  void fold();
+
+  /// Width of the linear bins or relative width of the logarithmic ones
+  double m_tolerance;
+  /// log(1 + tolerance) for logarithmic bins
+  double m_logStep;
+  CompressBinningMode m_mode;
+  /// Width of the pulse time windows in nanoseconds, or 0 to ignore pulse times
+  int64_t m_wallClockTolerance;
+  /// Events not yet folded into the bins
+  std::vector<DataObjects::WeightedEvent> m_buffer;
+  /// The bins with events, sorted by pulse time window and time-of-flight
+  std::vector<Bin> m_bins;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -0,0 +1,78 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** HistogramEventAccumulator adds the events of a range of detector IDs
+  straight into time-of-flight histograms as they are read, so the events
+  themselves are never stored.
+
+  Each row is the histogram of one detector ID and is only allocated once an
+  event lands in it. Once all the events have been added the rows are added
+  into the histograms of the output spectra, which lets the loading tasks
+  fill their own rows without locking and only synchronise when merging.
+
+  For unweighted events the squared errors equal the counts so only weighted
+  events keep them separately.
+*/
+class MANTID_DATAHANDLING_DLL HistogramEventAccumulator {
+public:
+  HistogramEventAccumulator(const std::vector<double> &edges, const size_t numRows, const bool weighted);
+
+  /// Add an unweighted event to a row
+  void addEvent(const size_t row, const double tof) {
+    const auto bin = findBin(tof);
+    if (bin < m_numBins)
+      counts(row)[bin] += 1.;
+  }
+  /// Add a weighted event to a row
+  void addEvent(const size_t row, const double tof, const double weight, const double errorSquared) {
+    const auto bin = findBin(tof);
+    if (bin < m_numBins) {
+      counts(row)[bin] += weight;
+      errorsSquared(row)[bin] += errorSquared;
+    }
+  }
+  /// @return true if no event has been added to the row
+  bool empty(const size_t row) const { return m_counts[row].empty(); }
+
+  void addTo(const size_t row, std::vector<double> &counts, std::vector<double> &errorsSquared);
+  size_t findBin(const double tof) const;
+
+private:
+  std::vector<double> &counts(const size_t row) {
+    if (m_counts[row].empty())
+      m_counts[row].assign(m_numBins, 0.);
+    return m_counts[row];
+  }
+  std::vector<double> &errorsSquared(const size_t row) {
+    if (m_errorsSquared[row].empty())
+      m_errorsSquared[row].assign(m_numBins, 0.);
+    return m_errorsSquared[row];
+  }
+
+  /// The bin edges
+  const std::vector<double> &m_edges;
+  size_t m_numBins;
+  /// Whether the bins all have the same width, so the bin can be calculated
+  bool m_linear;
+  /// 1 / bin width for linear bins
+  double m_inverseWidth;
+  /// The histogram of each row, empty until an event is added to it
+  std::vector<std::vector<double>> m_counts;
+  /// The squared errors of each row, only used for weighted events
+  std::vector<std::vector<double>> m_errorsSquared;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
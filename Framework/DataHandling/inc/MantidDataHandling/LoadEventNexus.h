@@ -11,6 +11,7 @@
 #include "MantidAPI/NexusFileLoader.h"
 #include "MantidAPI/WorkspaceGroup.h"
 #include "MantidDataHandling/BankPulseTimes.h"
+#include "MantidDataHandling/CompressEventAccumulator.h"
 #include "MantidDataHandling/EventWorkspaceCollection.h"
 #include "MantidDataHandling/LoadGeometry.h"
 #include "MantidDataObjects/EventList.h"
@@ -190,6 +191,28 @@ public:
 
   /// Tolerance for CompressEvents; use -1 to mean don't compress.
   double compressTolerance;
+  /// Add the events straight into compressed bins rather than compressing
+  /// each spectrum after it has been loaded
+  bool compressOnLoad{false};
+  /// How the time-of-flight axis is binned when compressing on load
+  CompressBinningMode compressBinningMode{CompressBinningMode::LINEAR};
+  /// Width in seconds of the pulse time windows when compressing on load, 0
+  /// to drop the pulse times
+  double compressWallClockTolerance{0.};
+
+  /// Bin edges to histogram the events into while loading, empty to load the
+  /// events themselves
+  std::vector<double> histogramEdges;
+  /// Offset added to each time-of-flight before it is histogrammed
+  double histogramTofOffset{0.};
+  /// Counts of each period and workspace index when histogramming on load,
+  /// empty for a spectrum without any counts
+  std::vector<std::vector<std::vector<double>>> histogramCounts;
+  /// Squared errors of each period and workspace index, only filled for
+  /// weighted events
+  std::vector<std::vector<std::vector<double>>> histogramErrorsSquared;
+  /// Mutex protecting the histograms
+  std::mutex m_histogramMutex;
 
   /// Pulse times for ALL banks, taken from proton_charge log.
   std::shared_ptr<BankPulseTimes> m_allBanksPulseTimes;
@@ -209,6 +232,9 @@ private:
   /// Intialisation code
   void init() override;
 
+  /// Cross-check the compression properties
+  std::map<std::string, std::string> validateInputs() override;
+
   /// Execution code
   void execLoader() override;
 
@@ -218,6 +244,8 @@ private:
   DataObjects::EventWorkspace_sptr createEmptyEventWorkspace();
 
   void loadEvents(API::Progress *const prog, const bool monitors);
+  void setupHistogramming();
+  API::Workspace_sptr createHistogramWorkspaces();
   void createSpectraMapping(const std::string &nxsfile, const bool monitorsOnly,
                             const std::vector<std::string> &bankNames = std::vector<std::string>());
   void deleteBanks(const EventWorkspaceCollection_sptr &workspace, const std::vector<std::string> &bankNames);
@@ -247,6 +275,8 @@ private:
   bool loadlogs;
   /// True if the event_id is spectrum no not pixel ID
   bool event_id_is_spec;
+  /// The output histograms of each period when histogramming on load
+  std::vector<API::MatrixWorkspace_sptr> m_histogramWorkspaces;
 };
 
 //-----------------------------------------------------------------------------
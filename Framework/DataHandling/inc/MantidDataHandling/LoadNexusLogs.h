@@ -8,6 +8,7 @@
 
 #include "MantidAPI/NexusFileLoader.h"
 #include <nexus/NeXusFile.hpp>
+#include <set>
 #include <vector>
 
 namespace Mantid {
@@ -88,6 +89,13 @@ private:
    */
   void loadSELog(::NeXus::File &file, const std::string &absolute_entry_name,
                  const std::shared_ptr<API::MatrixWorkspace> &workspace) const;
+  /// Does the log entry have a value_valid field
+  bool hasValidityEntry(const std::string &absolute_entry_name) const;
+  /// Add an NXlog that is read on first use, or queue it for prefetching
+  void deferNXLog(const std::string &absolute_entry_name, const std::string &propName,
+                  const std::shared_ptr<API::MatrixWorkspace> &workspace, bool overwrite) const;
+  /// Load the logs queued for prefetching
+  void prefetchLogs(::NeXus::File &file, const std::shared_ptr<API::MatrixWorkspace> &workspace) const;
   void loadVetoPulses(::NeXus::File &file, const std::shared_ptr<API::MatrixWorkspace> &workspace) const;
   void loadNPeriods(::NeXus::File &file, const std::shared_ptr<API::MatrixWorkspace> &workspace) const;
 
@@ -99,6 +107,13 @@ private:
   std::string freqStart;
 
   mutable std::vector<std::string> m_logsWithInvalidValues;
+
+  /// Read time series logs when they are first used
+  bool m_loadOnDemand = false;
+  /// Logs read while loading when loading on demand
+  std::set<std::string> m_prefetchNames;
+  /// Names and locations of the logs waiting to be prefetched
+  mutable std::vector<std::pair<std::string, std::string>> m_logsToPrefetch;
 };
 
 } // namespace DataHandling
@@ -0,0 +1,176 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/CompressEventAccumulator.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::DataObjects::WeightedEventNoTime;
+using Mantid::Types::Core::DateAndTime;
+
+namespace Mantid::DataHandling {
+
+namespace {
+/// The weight of an event in the average time-of-flight and pulse time, as in EventList::compressEvents.
+/// Events without an error count as one.
+inline double calcNorm(const float errorSquared) {
+  if (errorSquared == 1.f || errorSquared == 0.f)
+    return 1.;
+  return 1. / std::sqrt(static_cast<double>(errorSquared));
+}
+
+/// Integer division rounding towards negative infinity
+inline int64_t floorDivide(const int64_t numerator, const int64_t denominator) {
+  const auto quotient = numerator / denominator;
+  return (numerator % denominator != 0 && numerator < 0) ? quotient - 1 : quotient;
+}
+} // namespace
+
+/**
+ * Constructor
+ * @param tolerance :: Width of the linear bins in microseconds, or relative width of the logarithmic bins
+ * @param mode :: Whether the time-of-flight bins are linear or logarithmic
+ * @param wallClockTolerance :: Width of the pulse time windows in seconds, or 0 to ignore the pulse times
+ * @throw std::invalid_argument if the tolerance is not positive
+ */
+CompressEventAccumulator::CompressEventAccumulator(const double tolerance, const CompressBinningMode mode,
+                                                   const double wallClockTolerance)
+    : m_tolerance(tolerance), m_logStep(std::log1p(tolerance)), m_mode(mode),
+      m_wallClockTolerance(static_cast<int64_t>(std::llround(wallClockTolerance * 1.e9))) {
+  if (!(tolerance > 0.))
+    throw std::invalid_argument("CompressEventAccumulator: the tolerance must be positive");
+  if (wallClockTolerance < 0.)
+    throw std::invalid_argument("CompressEventAccumulator: the wall-clock tolerance can not be negative");
+}
+
+/**
+ * Give the compressed events, ignoring their pulse times. The accumulator is
+ * left empty.
+ * @param events :: Replaced by the compressed events, sorted by time-of-flight
+ * unless the pulse times were kept
+ */
+void CompressEventAccumulator::createEvents(std::vector<WeightedEventNoTime> &events) {
+  fold();
+  events.clear();
+  events.reserve(m_bins.size());
+  for (const auto &bin : m_bins)
+    events.emplace_back(bin.tofSum / bin.norm, bin.weight, bin.errorSquared);
+  std::vector<Bin>().swap(m_bins);
+}
+
+/**
+ * Give the compressed events with their average pulse times. The accumulator
+ * is left empty.
+ * @param events :: Replaced by the compressed events
+ */
+void CompressEventAccumulator::createEvents(std::vector<WeightedEvent> &events) {
+  fold();
+  events.clear();
+  events.reserve(m_bins.size());
+  for (const auto &bin : m_bins) {
+    const int64_t pulseTime = bin.pulseBin * m_wallClockTolerance + std::llround(bin.pulseOffsetSum / bin.norm);
+    events.emplace_back(bin.tofSum / bin.norm, DateAndTime(pulseTime), bin.weight, bin.errorSquared);
+  }
+  std::vector<Bin>().swap(m_bins);
+}
+
+/// @return the index of the time-of-flight bin holding the given time-of-flight
+int64_t CompressEventAccumulator::tofBin(const double tof) const {
+  if (m_mode == CompressBinningMode::LINEAR)
+    return static_cast<int64_t>(std::floor(tof / m_tolerance));
+  if (tof <= 0.)
+    return std::numeric_limits<int64_t>::lowest();
+  // The logarithm only estimates the bin: rounding can put a time-of-flight on
+  // or next to an edge into a neighbouring bin, so check against the edges
+  auto bin = static_cast<int64_t>(std::floor(std::log(tof) / m_logStep));
+  if (tof < logBinEdge(bin))
+    --bin;
+  else if (tof >= logBinEdge(bin + 1))
+    ++bin;
+  return bin;
+}
+
+/// @return the lower edge, (1 + tolerance)^bin, of a logarithmic time-of-flight bin
+double CompressEventAccumulator::logBinEdge(const int64_t bin) const {
+  return std::pow(1. + m_tolerance, static_cast<double>(bin));
+}
+
+/// @return the index of the window holding the given pulse time, or 0 if pulse times are ignored
+int64_t CompressEventAccumulator::pulseBin(const DateAndTime &pulseTime) const {
+  if (m_wallClockTolerance == 0)
+    return 0;
+  return floorDivide(pulseTime.totalNanoseconds(), m_wallClockTolerance);
+}
+
+/// Fold the buffered events into the bins
+void CompressEventAccumulator::fold() {
+  if (m_buffer.empty())
+    return;
+
+  // Sort the new events so they can be merged with the sorted bins in one pass
+  if (keepsPulseTimes()) {
+    std::sort(m_buffer.begin(), m_buffer.end(), [this](const WeightedEvent &lhs, const WeightedEvent &rhs) {
+      const auto lhsPulse = pulseBin(lhs.pulseTime());
+      const auto rhsPulse = pulseBin(rhs.pulseTime());
+      return lhsPulse < rhsPulse || (lhsPulse == rhsPulse && lhs.tof() < rhs.tof());
+    });
+  } else {
+    std::sort(m_buffer.begin(), m_buffer.end(),
+              [](const WeightedEvent &lhs, const WeightedEvent &rhs) { return lhs.tof() < rhs.tof(); });
+  }
+
+  std::vector<Bin> folded;
+  for (const auto &event : m_buffer) {
+    const auto pulse = pulseBin(event.pulseTime());
+    const auto tof = tofBin(event.tof());
+    if (folded.empty() || folded.back().pulseBin != pulse || folded.back().tofBin != tof)
+      folded.push_back({pulse, tof, 0., 0., 0., 0., 0.});
+    auto &bin = folded.back();
+    const double norm = calcNorm(event.errorSquared());
+    bin.tofSum += event.tof() * norm;
+    if (keepsPulseTimes())
+      bin.pulseOffsetSum +=
+          static_cast<double>(event.pulseTime().totalNanoseconds() - pulse * m_wallClockTolerance) * norm;
+    bin.weight += event.weight();
+    bin.errorSquared += event.errorSquared();
+    bin.norm += norm;
+  }
+  m_buffer.clear();
+
+  if (m_bins.empty()) {
+    m_bins.swap(folded);
+    return;
+  }
+
+  std::vector<Bin> merged;
+  merged.reserve(m_bins.size() + folded.size());
+  auto lhs = m_bins.cbegin();
+  auto rhs = folded.cbegin();
+  while (lhs != m_bins.cend() && rhs != folded.cend()) {
+    const auto lhsKey = std::tie(lhs->pulseBin, lhs->tofBin);
+    const auto rhsKey = std::tie(rhs->pulseBin, rhs->tofBin);
+    if (lhsKey < rhsKey) {
+      merged.emplace_back(*lhs++);
+    } else if (rhsKey < lhsKey) {
+      merged.emplace_back(*rhs++);
+    } else {
+      merged.push_back({lhs->pulseBin, lhs->tofBin, lhs->tofSum + rhs->tofSum,
+                        lhs->pulseOffsetSum + rhs->pulseOffsetSum, lhs->weight + rhs->weight,
+                        lhs->errorSquared + rhs->errorSquared, lhs->norm + rhs->norm});
+      ++lhs;
+      ++rhs;
+    }
+  }
+  merged.insert(merged.end(), lhs, m_bins.cend());
+  merged.insert(merged.end(), rhs, folded.cend());
+  m_bins.swap(merged);
+}
+
+} // namespace Mantid::DataHandling
@@ -1022,17 +1022,16 @@ size_t GroupDetectors2::formGroupsEvent(const DataObjects::EventWorkspace_const_
     size_t nonMaskedSpectra(0);
     beh->mutableX(outIndex)[0] = 0.0;
     beh->mutableE(outIndex)[0] = 0.0;
+    std::vector<const EventList *> fromLists;
+    fromLists.reserve(it->second.size());
     for (auto originalWI : it->second) {
-      const EventList &fromEL = inputWS->getSpectrum(originalWI);
-      // Add the event lists with the operator
-      outEL += fromEL;
-
-      // detectors to add to the output spectrum
-      outEL.addDetectorIDs(fromEL.getDetectorIDs());
+      fromLists.emplace_back(&inputWS->getSpectrum(originalWI));
       if (!spectrumInfo.hasDetectors(originalWI) || !spectrumInfo.isMasked(originalWI)) {
         ++nonMaskedSpectra;
       }
     }
+    // Add the events and detectors of the event lists to the output spectrum
+    outEL.addEventLists(fromLists);
     if (nonMaskedSpectra == 0)
       ++nonMaskedSpectra; // Avoid possible divide by zero
     if (!requireDivide)
@@ -0,0 +1,91 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/HistogramEventAccumulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace Mantid::DataHandling {
+
+namespace {
+/// @return true if all the bins are as wide as the first one
+bool hasConstantWidth(const std::vector<double> &edges) {
+  const double width = edges[1] - edges[0];
+  for (size_t i = 2; i < edges.size(); ++i)
+    if (std::abs((edges[i] - edges[i - 1]) - width) > 1e-9 * std::abs(width))
+      return false;
+  return true;
+}
+} // namespace
+
+/**
+ * Constructor
+ * @param edges :: The bin edges, which must outlive the accumulator
+ * @param numRows :: The number of histograms, one per detector ID
+ * @param weighted :: Whether the events are weighted, so the squared errors are kept separately
+ * @throw std::invalid_argument if there are fewer than two edges
+ */
+HistogramEventAccumulator::HistogramEventAccumulator(const std::vector<double> &edges, const size_t numRows,
+                                                     const bool weighted)
+    : m_edges(edges), m_numBins(edges.size() > 1 ? edges.size() - 1 : 0), m_linear(false), m_inverseWidth(0.),
+      m_counts(numRows), m_errorsSquared(weighted ? numRows : 0) {
+  if (m_numBins == 0)
+    throw std::invalid_argument("HistogramEventAccumulator: at least two bin edges are needed");
+  m_linear = hasConstantWidth(edges);
+  m_inverseWidth = 1. / (edges[1] - edges[0]);
+}
+
+/**
+ * Find the bin holding a time-of-flight. Bins include their lower edge.
+ * @param tof :: The time-of-flight
+ * @return the index of the bin, or the number of bins if the time-of-flight is outside the edges
+ */
+size_t HistogramEventAccumulator::findBin(const double tof) const {
+  if (!(tof >= m_edges.front() && tof < m_edges.back()))
+    return m_numBins;
+  if (m_linear) {
+    auto bin = std::min(static_cast<size_t>((tof - m_edges.front()) * m_inverseWidth), m_numBins - 1);
+    // Correct for rounding in the calculated bin
+    if (tof < m_edges[bin])
+      --bin;
+    else if (tof >= m_edges[bin + 1])
+      ++bin;
+    return bin;
+  }
+  return static_cast<size_t>(std::upper_bound(m_edges.cbegin(), m_edges.cend(), tof) - m_edges.cbegin()) - 1;
+}
+
+/**
+ * Add a row into the histogram of a spectrum and free it.
+ * @param row :: The row to add
+ * @param counts :: The counts of the spectrum, allocated if it is empty
+ * @param errorsSquared :: The squared errors of the spectrum, only used for weighted events
+ */
+void HistogramEventAccumulator::addTo(const size_t row, std::vector<double> &counts,
+                                      std::vector<double> &errorsSquared) {
+  if (empty(row))
+    return;
+  if (counts.empty()) {
+    counts.swap(m_counts[row]);
+  } else {
+    std::transform(counts.cbegin(), counts.cend(), m_counts[row].cbegin(), counts.begin(), std::plus<double>());
+    std::vector<double>().swap(m_counts[row]);
+  }
+  if (m_errorsSquared.empty() || m_errorsSquared[row].empty())
+    return;
+  if (errorsSquared.empty()) {
+    errorsSquared.swap(m_errorsSquared[row]);
+  } else {
+    std::transform(errorsSquared.cbegin(), errorsSquared.cend(), m_errorsSquared[row].cbegin(),
+                   errorsSquared.begin(), std::plus<double>());
+    std::vector<double>().swap(m_errorsSquared[row]);
+  }
+}
+
+} // namespace Mantid::DataHandling
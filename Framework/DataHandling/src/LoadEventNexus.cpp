@@ -18,6 +18,8 @@
 #include "MantidDataHandling/LoadHelper.h"
 #include "MantidDataHandling/ParallelEventLoader.h"
 #include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Goniometer.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
@@ -27,9 +29,11 @@
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/VectorHelper.h"
 #include "MantidKernel/VisibleWhenProperty.h"
 #include "MantidNexus/NexusIOHelper.h"
 
@@ -174,6 +178,20 @@ void LoadEventNexus::init() {
                   "This specified the tolerance to use (in microseconds) when "
                   "compressing.");
 
+  const std::vector<std::string> compressBinningModes{"Default", "Linear", "Logarithmic"};
+  declareProperty("CompressBinningMode", "Default", std::make_shared<StringListValidator>(compressBinningModes),
+                  "How the events are compressed when CompressTolerance is set. Default compresses each spectrum "
+                  "once all its events have been loaded. Linear and Logarithmic add the events straight into "
+                  "compressed bins, CompressTolerance microseconds wide or of relative width CompressTolerance, "
+                  "as they are read so the uncompressed events are never all held in memory.");
+  auto mustBeNonNegative = std::make_shared<BoundedValidator<double>>();
+  mustBeNonNegative->setLower(0.);
+  declareProperty("CompressWallClockTolerance", EMPTY_DBL(), mustBeNonNegative,
+                  "Only with a Linear or Logarithmic CompressBinningMode: keep the pulse times by compressing the "
+                  "events separately in windows of this many seconds (optional).");
+  setPropertySettings("CompressWallClockTolerance",
+                      std::make_unique<VisibleWhenProperty>("CompressBinningMode", IS_NOT_DEFAULT));
+
   auto mustBePositive = std::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
   declareProperty("ChunkNumber", EMPTY_INT(), mustBePositive,
@@ -187,11 +205,27 @@ void LoadEventNexus::init() {
   // validation
   setPropertySettings("TotalChunks", std::make_unique<VisibleWhenProperty>("ChunkNumber", IS_NOT_DEFAULT));
 
+  declareProperty(std::make_unique<ArrayProperty<double>>("HistogramBinning",
+                                                         std::make_shared<RebinParamsValidator>(true)),
+                  "Histogram the events while loading them, without storing any events, and output a Workspace2D "
+                  "(optional). A comma separated list of first bin boundary, width, last bin boundary as in "
+                  "Rebin, where a negative width gives logarithmic bins. The events are filtered by "
+                  "FilterByTofMin and FilterByTofMax and are not compressed; those recorded while the run was "
+                  "paused are kept.");
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>(
+                      "HistogramBinningWorkspace", "", Direction::Input, PropertyMode::Optional),
+                  "Histogram the events while loading them into the bins of the first spectrum of this workspace "
+                  "(optional). Used in the same way as HistogramBinning.");
+
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("CompressBinningMode", grp3);
+  setPropertyGroup("CompressWallClockTolerance", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
+  setPropertyGroup("HistogramBinning", grp3);
+  setPropertyGroup("HistogramBinningWorkspace", grp3);
 
   declareProperty(std::make_unique<PropertyWithValue<bool>>("LoadMonitors", false, Direction::Input),
                   "Load the monitors from the file (optional, default False).");
@@ -288,6 +322,46 @@ void LoadEventNexus::init() {
                                                                                 Direction::Input),
                   "If specified, these logs will NOT be loaded from the file (each "
                   "separated by a space).");
+  declareProperty("LoadLogsOnDemand", false,
+                  "If true, the values of time series logs are only read from the file when they are first used. "
+                  "The file must remain available until then.");
+  declareProperty(std::make_unique<PropertyWithValue<std::vector<std::string>>>(
+                      "PrefetchLogs", std::vector<std::string>(), Direction::Input),
+                  "With LoadLogsOnDemand, these logs are still read while loading (each separated by a comma).");
+}
+
+//----------------------------------------------------------------------------------------------
+/** Check that compressing while loading has a tolerance to compress with,
+ * and that histogramming while loading is not combined with options needing
+ * the events.
+ * @return a map of property names to problems with them
+ */
+std::map<std::string, std::string> LoadEventNexus::validateInputs() {
+  std::map<std::string, std::string> issues;
+  const std::string compressBinning = getProperty("CompressBinningMode");
+  if (compressBinning != "Default") {
+    const double tolerance = getProperty("CompressTolerance");
+    if (tolerance <= 0.)
+      issues["CompressTolerance"] = "A positive tolerance is needed to compress with the " + compressBinning +
+                                    " CompressBinningMode";
+  }
+
+  const bool histogramParams = !isDefault("HistogramBinning");
+  if (histogramParams && !isDefault("HistogramBinningWorkspace"))
+    issues["HistogramBinningWorkspace"] = "Give either HistogramBinning or HistogramBinningWorkspace, not both";
+  if (histogramParams || !isDefault("HistogramBinningWorkspace")) {
+    const std::string histogramProperty = histogramParams ? "HistogramBinning" : "HistogramBinningWorkspace";
+    if (!isDefault("FilterByTimeStart") || !isDefault("FilterByTimeStop"))
+      issues[histogramProperty] = "Filtering by time needs the events, which are not kept when histogramming";
+    if (!isDefault("CompressTolerance") || compressBinning != "Default")
+      issues[histogramProperty] = "Events can not be compressed when histogramming while loading";
+    if (!histogramParams) {
+      MatrixWorkspace_const_sptr binningWS = getProperty("HistogramBinningWorkspace");
+      if (binningWS && (!binningWS->isHistogramData() || binningWS->getNumberHistograms() == 0))
+        issues["HistogramBinningWorkspace"] = "The workspace must hold at least one histogram";
+    }
+  }
+  return issues;
 }
 
 //----------------------------------------------------------------------------------------------
@@ -393,6 +467,22 @@ void LoadEventNexus::execLoader() {
   m_filename = getPropertyValue("Filename");
 
   compressTolerance = getProperty("CompressTolerance");
+  const std::string compressBinning = getProperty("CompressBinningMode");
+  compressOnLoad = compressTolerance >= 0 && compressBinning != "Default";
+  compressBinningMode =
+      compressBinning == "Logarithmic" ? CompressBinningMode::LOGARITHMIC : CompressBinningMode::LINEAR;
+  compressWallClockTolerance = 0.;
+  if (!isDefault("CompressWallClockTolerance"))
+    compressWallClockTolerance = getProperty("CompressWallClockTolerance");
+
+  histogramEdges.clear();
+  if (!isDefault("HistogramBinning")) {
+    const std::vector<double> params = getProperty("HistogramBinning");
+    VectorHelper::createAxisFromRebinParams(params, histogramEdges);
+  } else if (!isDefault("HistogramBinningWorkspace")) {
+    MatrixWorkspace_const_sptr binningWS = getProperty("HistogramBinningWorkspace");
+    histogramEdges = binningWS->x(0).rawData();
+  }
 
   loadlogs = getProperty("LoadLogs");
 
@@ -426,12 +516,16 @@ void LoadEventNexus::execLoader() {
 
   // If the run was paused at any point, filter out those events (SNS only, I
   // think)
-  filterDuringPause(m_ws->getSingleHeldWorkspace());
+  if (histogramEdges.empty())
+    filterDuringPause(m_ws->getSingleHeldWorkspace());
 
   // add filename
   m_ws->mutableRun().addProperty("Filename", m_filename);
   // Save output
-  this->setProperty("OutputWorkspace", m_ws->combinedWorkspace());
+  if (histogramEdges.empty())
+    this->setProperty("OutputWorkspace", m_ws->combinedWorkspace());
+  else
+    this->setProperty("OutputWorkspace", createHistogramWorkspaces());
 
   // close the file since LoadNexusMonitors will take care of its own file
   // handle
@@ -561,6 +655,11 @@ LoadEventNexus::runLoadNexusLogs(const std::string &nexusfilename, T localWorksp
       loadLogs->setPropertyValue("NXentryName", alg.getPropertyValue("NXentryName"));
     } catch (...) {
     }
+    try {
+      loadLogs->setPropertyValue("LoadLogsOnDemand", alg.getPropertyValue("LoadLogsOnDemand"));
+      loadLogs->setPropertyValue("PrefetchLogs", alg.getPropertyValue("PrefetchLogs"));
+    } catch (...) {
+    }
 
     loadLogs->execute();
 
@@ -665,6 +764,11 @@ std::shared_ptr<BankPulseTimes> LoadEventNexus::runLoadNexusLogs(
       loadLogs->setPropertyValue("NXentryName", alg.getPropertyValue("NXentryName"));
     } catch (...) {
     }
+    try {
+      loadLogs->setPropertyValue("LoadLogsOnDemand", alg.getPropertyValue("LoadLogsOnDemand"));
+      loadLogs->setPropertyValue("PrefetchLogs", alg.getPropertyValue("PrefetchLogs"));
+    } catch (...) {
+    }
 
     loadLogs->execute();
 
@@ -1153,7 +1257,19 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
 
     safeOpenFile(m_filename);
   }
+  // Use T0 offset from TOPAZ Parameter file if it exists
+  double mT0 = 0.;
+  if (m_ws->getInstrument()->hasParameter("T0")) {
+    std::vector<double> instrumentT0 = m_ws->getInstrument()->getNumberParameter("T0", true);
+    if (!instrumentT0.empty())
+      mT0 = instrumentT0.front();
+  }
+
   if (!loaded) {
+    if (!histogramEdges.empty()) {
+      setupHistogramming();
+      histogramTofOffset = mT0;
+    }
     bool precount = getProperty("Precount");
     int chunk = getProperty("ChunkNumber");
     int totalChunks = getProperty("TotalChunks");
@@ -1176,26 +1292,20 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
                        "may indicate errors in the raw "
                        "TOF data.\n";
 
-  // Use T0 offset from TOPAZ Parameter file if it exists
-  if (m_ws->getInstrument()->hasParameter("T0")) {
-    std::vector<double> instrumentT0 = m_ws->getInstrument()->getNumberParameter("T0", true);
-    if (!instrumentT0.empty()) {
-      const double mT0 = instrumentT0.front();
-      if (mT0 != 0.0) {
-        auto numHistograms = static_cast<int64_t>(m_ws->getNumberHistograms());
-        PARALLEL_FOR_IF(Kernel::threadSafe(*m_ws))
-        for (int64_t i = 0; i < numHistograms; ++i) {
-          PARALLEL_START_INTERRUPT_REGION
-          // Do the offsetting
-          m_ws->getSpectrum(i).addTof(mT0);
-          PARALLEL_END_INTERRUPT_REGION
-        }
-        PARALLEL_CHECK_INTERRUPT_REGION
-        // set T0 in the run parameters
-        API::Run &run = m_ws->mutableRun();
-        run.addProperty<double>("T0", mT0, true);
-      }
+  // Offset the events by T0. Histogramming on load has already added it.
+  if (mT0 != 0.0) {
+    auto numHistograms = static_cast<int64_t>(m_ws->getNumberHistograms());
+    PARALLEL_FOR_IF(Kernel::threadSafe(*m_ws))
+    for (int64_t i = 0; i < numHistograms; ++i) {
+      PARALLEL_START_INTERRUPT_REGION
+      // Do the offsetting
+      m_ws->getSpectrum(i).addTof(mT0);
+      PARALLEL_END_INTERRUPT_REGION
     }
+    PARALLEL_CHECK_INTERRUPT_REGION
+    // set T0 in the run parameters
+    API::Run &run = m_ws->mutableRun();
+    run.addProperty<double>("T0", mT0, true);
   }
   // Now, create a default X-vector for histogramming, with just 2 bins.
   if (eventsLoaded > 0) {
@@ -1221,6 +1331,66 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
   }
 }
 
+//-----------------------------------------------------------------------------
+/** Make an empty histogram for each period and workspace index, for the
+ * events to be added into while loading.
+ */
+void LoadEventNexus::setupHistogramming() {
+  const auto numHistograms = m_ws->getNumberHistograms();
+  histogramCounts.assign(m_ws->nPeriods(), std::vector<std::vector<double>>(numHistograms));
+  histogramErrorsSquared.assign(m_ws->nPeriods(), std::vector<std::vector<double>>(numHistograms));
+}
+
+//-----------------------------------------------------------------------------
+/** Create the output histograms from the counts added while loading. Each
+ * takes the instrument, logs and spectra of the period's event workspace,
+ * which holds no events.
+ * @return the histograms, grouped if there are several periods
+ */
+API::Workspace_sptr LoadEventNexus::createHistogramWorkspaces() {
+  const HistogramData::BinEdges edges(histogramEdges);
+  auto eventWorkspaces = m_ws->combinedWorkspace();
+  auto group = std::dynamic_pointer_cast<WorkspaceGroup>(eventWorkspaces);
+  std::vector<EventWorkspace_sptr> periods;
+  if (group) {
+    for (size_t period = 0; period < static_cast<size_t>(group->getNumberOfEntries()); ++period)
+      periods.emplace_back(std::dynamic_pointer_cast<EventWorkspace>(group->getItem(period)));
+  } else {
+    periods.emplace_back(std::dynamic_pointer_cast<EventWorkspace>(eventWorkspaces));
+  }
+
+  m_histogramWorkspaces.clear();
+  for (size_t period = 0; period < periods.size(); ++period) {
+    MatrixWorkspace_sptr outputWS = create<Workspace2D>(*periods[period], edges);
+    const auto numHistograms = static_cast<int64_t>(outputWS->getNumberHistograms());
+    if (period < histogramCounts.size()) {
+      auto &counts = histogramCounts[period];
+      auto &errorsSquared = histogramErrorsSquared[period];
+      PARALLEL_FOR_IF(Kernel::threadSafe(*outputWS))
+      for (int64_t i = 0; i < numHistograms; ++i) {
+        if (counts[i].empty())
+          continue;
+        // Unweighted events only kept their counts, which are their squared errors
+        const auto &variances = errorsSquared[i].empty() ? counts[i] : errorsSquared[i];
+        auto &e = outputWS->mutableE(i);
+        std::transform(variances.cbegin(), variances.cend(), e.begin(), static_cast<double (*)(double)>(std::sqrt));
+        outputWS->setCounts(i, HistogramData::Counts(std::move(counts[i])));
+        std::vector<double>().swap(errorsSquared[i]);
+      }
+    }
+    m_histogramWorkspaces.emplace_back(outputWS);
+  }
+  histogramCounts.clear();
+  histogramErrorsSquared.clear();
+
+  if (m_histogramWorkspaces.size() == 1)
+    return m_histogramWorkspaces.front();
+  auto output = std::make_shared<WorkspaceGroup>();
+  for (const auto &outputWS : m_histogramWorkspaces)
+    output->addWorkspace(outputWS);
+  return output;
+}
+
 //-----------------------------------------------------------------------------
 /** Load the instrument from the nexus file
  *
@@ -1440,6 +1610,8 @@ void LoadEventNexus::runLoadMonitors() {
   if (mons) {
     // Set the internal monitor workspace pointer as well
     m_ws->setMonitorWorkspace(mons);
+    for (const auto &histogramWS : m_histogramWorkspaces)
+      histogramWS->setMonitorWorkspace(mons);
 
     filterDuringPause(mons);
   } else {
@@ -1639,6 +1811,7 @@ LoadEventNexus::LoaderType LoadEventNexus::defineLoaderType(const bool haveWeigh
   noParallelConstrictions &= !((!isDefault("CompressTolerance") || !isDefault("SpectrumMin") ||
                                 !isDefault("SpectrumMax") || !isDefault("SpectrumList") || !isDefault("ChunkNumber")));
   noParallelConstrictions &= !(classType != "NXevent_data");
+  noParallelConstrictions &= histogramEdges.empty();
 
   if (!noParallelConstrictions)
     return LoaderType::DEFAULT;
@@ -9,6 +9,7 @@
 #include "MantidAPI/LogManager.h"
 #include "MantidAPI/Run.h"
 #include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include <locale>
 #include <nexus/NeXusException.hpp>
@@ -20,6 +21,7 @@
 #include <Poco/Path.h>
 
 #include "MantidDataHandling/LoadTOFRawNexus.h"
+#include <boost/optional.hpp>
 #include <boost/scoped_array.hpp>
 
 #include <algorithm>
@@ -124,20 +126,31 @@ bool isControlValue(const char &c, const std::string &propName, Kernel::Logger &
   }
 }
 
+/// The contents of an NXlog, read from the file before its time series is built
+struct TimeSeriesData {
+  enum class ValueType { Int, Char, Double };
+
+  DateAndTime start;
+  std::vector<double> times;
+  ValueType type = ValueType::Double;
+  std::vector<int> intValues;
+  std::vector<double> doubleValues;
+  std::string charValues;
+  int64_t itemLength = 0;
+  std::string units;
+};
+
 /**
- * Creates a time series property from the currently opened log entry. It is
- * assumed to
- * have been checked to have a time field and the value entry's name is given
- * as an argument
+ * Reads the time and value entries of the currently opened log entry. It is
+ * assumed to have been checked to have a time field and a value field.
  * @param file :: A reference to the file handle
- * @param propName :: The name of the property
  * @param freqStart :: A string containing the start time of the frequency log
  * on SNAP
  * @param log :: Reference to logger to print out to
- * @returns A pointer to a new property containing the time series
+ * @returns The contents of the log entry
  */
-std::unique_ptr<Kernel::Property> createTimeSeries(::NeXus::File &file, const std::string &propName,
-                                                   const std::string &freqStart, Kernel::Logger &log) {
+TimeSeriesData readTimeSeries(::NeXus::File &file, const std::string &freqStart, Kernel::Logger &log) {
+  TimeSeriesData data;
   file.openData("time");
   //----- Start time is an ISO8601 string date and time. ------
   std::string start;
@@ -158,7 +171,7 @@ std::unique_ptr<Kernel::Property> createTimeSeries(::NeXus::File &file, const st
   }
 
   // Convert to date and time
-  Types::Core::DateAndTime start_time = Types::Core::DateAndTime(start);
+  data.start = Types::Core::DateAndTime(start);
   std::string time_units;
   file.getAttr("units", time_units);
   if (time_units.compare("second") < 0 && time_units != "s" &&
@@ -168,9 +181,8 @@ std::unique_ptr<Kernel::Property> createTimeSeries(::NeXus::File &file, const st
     throw ::NeXus::Exception("Unsupported time unit '" + time_units + "'");
   }
   //--- Load the seconds into a double array ---
-  std::vector<double> time_double;
   try {
-    file.getDataCoerce(time_double);
+    file.getDataCoerce(data.times);
   } catch (::NeXus::Exception &e) {
     log.warning() << "Log entry's time field could not be loaded: '" << e.what() << "'.\n";
     file.closeData();
@@ -182,91 +194,144 @@ std::unique_ptr<Kernel::Property> createTimeSeries(::NeXus::File &file, const st
   // Convert to seconds if needed
   if (time_units == "minutes") {
     using std::placeholders::_1;
-    std::transform(time_double.begin(), time_double.end(), time_double.begin(),
+    std::transform(data.times.begin(), data.times.end(), data.times.begin(),
                    std::bind(std::multiplies<double>(), _1, 60.0));
   }
 
   // Now the values: Could be a string, int or double
   file.openData("value");
   // Get the units of the property
-  std::string value_units;
   try {
-    file.getAttr("units", value_units);
+    file.getAttr("units", data.units);
   } catch (::NeXus::Exception &) {
     // Ignore missing units field.
-    value_units = "";
+    data.units = "";
   }
 
   // Now the actual data
   ::NeXus::Info info = file.getInfo();
   // Check the size
-  if (size_t(info.dims[0]) != time_double.size()) {
+  if (size_t(info.dims[0]) != data.times.size()) {
     file.closeData();
     throw ::NeXus::Exception("Invalid value entry for time series");
   }
   if (file.isDataInt()) // Int type
   {
-    std::vector<int> values;
+    data.type = TimeSeriesData::ValueType::Int;
     try {
-      file.getDataCoerce(values);
+      file.getDataCoerce(data.intValues);
       file.closeData();
     } catch (::NeXus::Exception &) {
       file.closeData();
       throw;
     }
-    // Make an int TSP
-    auto tsp = std::make_unique<TimeSeriesProperty<int>>(propName);
-    tsp->create(start_time, time_double, values);
-    tsp->setUnits(value_units);
-    log.debug() << "   done reading \"value\" array\n";
-    return tsp;
   } else if (info.type == ::NeXus::CHAR) {
-    std::string values;
-    const int64_t item_length = info.dims[1];
+    data.type = TimeSeriesData::ValueType::Char;
+    data.itemLength = info.dims[1];
     try {
       const int64_t nitems = info.dims[0];
-      const int64_t total_length = nitems * item_length;
+      const int64_t total_length = nitems * data.itemLength;
       boost::scoped_array<char> val_array(new char[total_length]);
       file.getData(val_array.get());
       file.closeData();
-      values = std::string(val_array.get(), total_length);
+      data.charValues = std::string(val_array.get(), total_length);
     } catch (::NeXus::Exception &) {
       file.closeData();
       throw;
     }
+  } else if (info.type == ::NeXus::FLOAT32 || info.type == ::NeXus::FLOAT64) {
+    data.type = TimeSeriesData::ValueType::Double;
+    try {
+      file.getDataCoerce(data.doubleValues);
+      file.closeData();
+    } catch (::NeXus::Exception &) {
+      file.closeData();
+      throw;
+    }
+  } else {
+    throw ::NeXus::Exception("Invalid value type for time series. Only int, double or strings are "
+                             "supported");
+  }
+  log.debug() << "   done reading \"value\" array\n";
+  return data;
+}
+
+/**
+ * Creates a time series property from the contents of a log entry. Does not
+ * touch the file, so may be called for several logs at once.
+ * @param data :: The contents of the log entry
+ * @param propName :: The name of the property
+ * @param log :: Reference to logger to print out to
+ * @returns A pointer to a new property containing the time series
+ */
+std::unique_ptr<Kernel::Property> createTimeSeries(TimeSeriesData data, const std::string &propName,
+                                                   Kernel::Logger &log) {
+  switch (data.type) {
+  case TimeSeriesData::ValueType::Int: {
+    // Make an int TSP
+    auto tsp = std::make_unique<TimeSeriesProperty<int>>(propName);
+    tsp->create(data.start, data.times, data.intValues);
+    tsp->setUnits(data.units);
+    return tsp;
+  }
+  case TimeSeriesData::ValueType::Char: {
+    std::string &values = data.charValues;
     // The string may contain non-printable (i.e. control) characters, replace
     // these
     std::replace_if(
         values.begin(), values.end(), [&](const char &c) { return isControlValue(c, propName, log); }, ' ');
     auto tsp = std::make_unique<TimeSeriesProperty<std::string>>(propName);
     std::vector<DateAndTime> times;
-    DateAndTime::createVector(start_time, time_double, times);
+    DateAndTime::createVector(data.start, data.times, times);
     const size_t ntimes = times.size();
     for (size_t i = 0; i < ntimes; ++i) {
-      std::string value_i = std::string(values.data() + i * item_length, item_length);
+      std::string value_i = std::string(values.data() + i * data.itemLength, data.itemLength);
       tsp->addValue(times[i], value_i);
     }
-    tsp->setUnits(value_units);
-    log.debug() << "   done reading \"value\" array\n";
+    tsp->setUnits(data.units);
     return tsp;
-  } else if (info.type == ::NeXus::FLOAT32 || info.type == ::NeXus::FLOAT64) {
-    std::vector<double> values;
-    try {
-      file.getDataCoerce(values);
-      file.closeData();
-    } catch (::NeXus::Exception &) {
-      file.closeData();
-      throw;
-    }
+  }
+  default: {
     auto tsp = std::make_unique<TimeSeriesProperty<double>>(propName);
-    tsp->create(start_time, time_double, values);
-    tsp->setUnits(value_units);
-    log.debug() << "   done reading \"value\" array\n";
+    tsp->create(data.start, data.times, data.doubleValues);
+    tsp->setUnits(data.units);
     return tsp;
-  } else {
-    throw ::NeXus::Exception("Invalid value type for time series. Only int, double or strings are "
-                             "supported");
   }
+  }
+}
+
+/**
+ * Creates a time series property from the currently opened log entry. It is
+ * assumed to
+ * have been checked to have a time field and the value entry's name is given
+ * as an argument
+ * @param file :: A reference to the file handle
+ * @param propName :: The name of the property
+ * @param freqStart :: A string containing the start time of the frequency log
+ * on SNAP
+ * @param log :: Reference to logger to print out to
+ * @returns A pointer to a new property containing the time series
+ */
+std::unique_ptr<Kernel::Property> createTimeSeries(::NeXus::File &file, const std::string &propName,
+                                                   const std::string &freqStart, Kernel::Logger &log) {
+  return createTimeSeries(readTimeSeries(file, freqStart, log), propName, log);
+}
+
+/**
+ * Reads the time and value entries of the log entry at the given absolute path
+ * @param file :: A reference to the file handle
+ * @param path :: The absolute path of the log entry
+ * @param freqStart :: A string containing the start time of the frequency log
+ * on SNAP
+ * @param log :: Reference to logger to print out to
+ * @returns The contents of the log entry
+ */
+TimeSeriesData readTimeSeries(::NeXus::File &file, const std::string &path, const std::string &freqStart,
+                              Kernel::Logger &log) {
+  file.openPath(path);
+  auto data = readTimeSeries(file, freqStart, log);
+  file.closeGroup();
+  return data;
 }
 
 /**
@@ -353,23 +418,42 @@ std::unique_ptr<Kernel::Property> createTimeSeriesValidityFilter(::NeXus::File &
  * log is the same as the end time the property is left unmodified.
  *
  * @param prop :: a pointer to a TimeSeriesProperty to modify
- * @param run :: handle to the run object containing the end time.
+ * @param endTime :: the end time of the run.
  */
-void appendEndTimeLog(Kernel::Property *prop, const API::Run &run) {
-  try {
-    auto tsLog = dynamic_cast<TimeSeriesProperty<double> *>(prop);
-    const auto endTime = run.endTime();
+void appendEndTimeLog(Kernel::Property *prop, const DateAndTime &endTime) {
+  auto tsLog = dynamic_cast<TimeSeriesProperty<double> *>(prop);
 
-    // First check if it is valid to add a additional log entry
-    if (!tsLog || tsLog->size() == 0 || endTime <= tsLog->lastTime() || prop->name() == "proton_charge")
-      return;
+  // First check if it is valid to add a additional log entry
+  if (!tsLog || tsLog->size() == 0 || endTime <= tsLog->lastTime() || prop->name() == "proton_charge")
+    return;
+
+  tsLog->addValue(endTime, tsLog->lastValue());
+}
 
-    tsLog->addValue(endTime, tsLog->lastValue());
+/**
+ * @param run :: handle to the run object containing the end time.
+ * @return the end time of the run, if it has one
+ */
+boost::optional<DateAndTime> runEndTime(const API::Run &run) {
+  try {
+    return run.endTime();
   } catch (const Exception::NotFoundError &) {
     // pass
   } catch (const std::runtime_error &) {
     // pass
   }
+  return boost::none;
+}
+
+/**
+ * Overload of appendEndTimeLog taking the end time from the run.
+ * @param prop :: a pointer to a TimeSeriesProperty to modify
+ * @param run :: handle to the run object containing the end time.
+ */
+void appendEndTimeLog(Kernel::Property *prop, const API::Run &run) {
+  if (const auto endTime = runEndTime(run)) {
+    appendEndTimeLog(prop, *endTime);
+  }
 }
 
 /**
@@ -392,6 +476,38 @@ void readStartAndEndTime(::NeXus::File &file, API::Run &run) {
   }
 }
 
+/// Logger for logs loaded after the algorithm has finished
+Kernel::Logger g_deferredLog("LoadNexusLogs");
+
+/**
+ * Reads an NXlog from the file the first time the log is accessed. Holds
+ * only the location of the log, so is cheap to copy along with the run.
+ */
+class DeferredNXLog {
+public:
+  DeferredNXLog(std::string filename, std::string path, std::string name, std::string freqStart,
+                boost::optional<DateAndTime> endTime)
+      : m_filename(std::move(filename)), m_path(std::move(path)), m_name(std::move(name)),
+        m_freqStart(std::move(freqStart)), m_endTime(std::move(endTime)) {}
+
+  std::unique_ptr<Kernel::Property> operator()() const {
+    ::NeXus::File file(m_filename);
+    auto prop = createTimeSeries(readTimeSeries(file, m_path, m_freqStart, g_deferredLog), m_name, g_deferredLog);
+    if (m_endTime) {
+      appendEndTimeLog(prop.get(), *m_endTime);
+    }
+    return prop;
+  }
+
+private:
+  std::string m_filename;
+  /// absolute path of the NXlog group
+  std::string m_path;
+  std::string m_name;
+  std::string m_freqStart;
+  boost::optional<DateAndTime> m_endTime;
+};
+
 } // End of anonymous namespace
 
 /// Empty default constructor
@@ -418,6 +534,13 @@ void LoadNexusLogs::init() {
                                                                                 Direction::Input),
                   "If specified, logs matching one of the patterns will NOT be loaded from the file (each "
                   "separated by a comma).");
+  declareProperty(std::make_unique<PropertyWithValue<bool>>("LoadLogsOnDemand", false, Direction::Input),
+                  "If true, the values of time series logs are only read from the file when they are first used. "
+                  "The file must stay in place until then.");
+  declareProperty(std::make_unique<PropertyWithValue<std::vector<std::string>>>(
+                      "PrefetchLogs", std::vector<std::string>(), Direction::Input),
+                  "With LoadLogsOnDemand, these logs are read while loading rather than when they are first used, "
+                  "building several logs at once (each separated by a comma).");
 }
 
 /** Executes the algorithm. Reading in the file and creating and populating
@@ -436,6 +559,13 @@ void LoadNexusLogs::execLoader() {
   std::vector<std::string> allow_list = getProperty("AllowList");
   std::vector<std::string> block_list = getProperty("BlockList");
 
+  m_loadOnDemand = getProperty("LoadLogsOnDemand");
+  const std::vector<std::string> prefetch_list = getProperty("PrefetchLogs");
+  m_logsToPrefetch.clear();
+  m_prefetchNames = std::set<std::string>(prefetch_list.begin(), prefetch_list.end());
+  // Logs that are always needed when loading events
+  m_prefetchNames.insert({"proton_charge", "proton_log"});
+
   // Find the entry name to use (normally "entry" for SNS, "raw_data_1" for
   // ISIS) if entry name is empty
   if (entry_name.empty()) {
@@ -536,6 +666,11 @@ void LoadNexusLogs::execLoader() {
   lf_LoadLogsByName("DASlogs");
   lf_LoadLogsByName("framelog");
 
+  if (!m_logsToPrefetch.empty()) {
+    prefetchLogs(file, workspace);
+    file.openPath("/" + entry_name);
+  }
+
   // If there's measurement information, load that info as logs.
   loadAndApplyMeasurementInfo(&file, *workspace);
   // If there's title information, load that info as logs.
@@ -867,6 +1002,15 @@ void LoadNexusLogs::loadNXLog(::NeXus::File &file, const std::string &absolute_e
 
   // whether or not to overwrite logs on workspace
   bool overwritelogs = this->getProperty("OverwriteLogs");
+  if (m_loadOnDemand && !hasValidityEntry(absolute_entry_name)) {
+    // Only the location is recorded. Logs with a validity filter are loaded
+    // straight away so that the filter log exists alongside them.
+    if (overwritelogs || !(workspace->run().hasProperty(entry_name))) {
+      deferNXLog(absolute_entry_name, entry_name, workspace, overwritelogs);
+    }
+    file.closeGroup();
+    return;
+  }
   try {
     if (overwritelogs || !(workspace->run().hasProperty(entry_name))) {
       auto logValue = createTimeSeries(file, entry_name, freqStart, g_log);
@@ -888,6 +1032,86 @@ void LoadNexusLogs::loadNXLog(::NeXus::File &file, const std::string &absolute_e
   file.closeGroup();
 }
 
+/**
+ * @param absolute_entry_name :: The name of the log entry
+ * @return true if the log entry has a value_valid field
+ */
+bool LoadNexusLogs::hasValidityEntry(const std::string &absolute_entry_name) const {
+  const std::string validEntry = absolute_entry_name + "/value_valid";
+  const std::map<std::string, std::set<std::string>> &allEntries = getFileInfo()->getAllEntries();
+  return std::any_of(allEntries.cbegin(), allEntries.cend(),
+                     [&validEntry](const auto &entries) { return entries.second.count(validEntry) == 1; });
+}
+
+/**
+ * Add an NXlog to the run without reading it. It is read when it is first
+ * used, or before the algorithm finishes if it is to be prefetched.
+ * @param absolute_entry_name :: The name of the log entry
+ * @param propName :: The name of the log in the run
+ * @param workspace :: A pointer to the workspace to store the logs
+ * @param overwrite :: Whether an existing log of the same name is replaced
+ */
+void LoadNexusLogs::deferNXLog(const std::string &absolute_entry_name, const std::string &propName,
+                               const std::shared_ptr<API::MatrixWorkspace> &workspace, bool overwrite) const {
+  if (m_prefetchNames.count(propName) == 1) {
+    auto queued = std::find_if(m_logsToPrefetch.begin(), m_logsToPrefetch.end(),
+                               [&propName](const auto &log) { return log.first == propName; });
+    if (queued == m_logsToPrefetch.end()) {
+      m_logsToPrefetch.emplace_back(propName, absolute_entry_name);
+    } else if (overwrite) {
+      queued->second = absolute_entry_name;
+    }
+    return;
+  }
+  const std::string filename = getPropertyValue("Filename");
+  workspace->mutableRun().addDeferredProperty(
+      propName, DeferredNXLog(filename, absolute_entry_name, propName, freqStart, runEndTime(workspace->run())),
+      overwrite);
+}
+
+/**
+ * Load the logs queued for prefetching. The file is read one log at a time,
+ * but their time series are built in parallel.
+ * @param file :: A reference to the NeXus file handle
+ * @param workspace :: A pointer to the workspace to store the logs
+ */
+void LoadNexusLogs::prefetchLogs(::NeXus::File &file, const std::shared_ptr<API::MatrixWorkspace> &workspace) const {
+  const auto nLogs = static_cast<int>(m_logsToPrefetch.size());
+  std::vector<boost::optional<TimeSeriesData>> data(nLogs);
+  for (int i = 0; i < nLogs; ++i) {
+    const auto &log = m_logsToPrefetch[i];
+    try {
+      data[i] = readTimeSeries(file, log.second, freqStart, g_log);
+    } catch (std::exception &e) {
+      // prefetching is best-effort: the log is skipped like any unreadable log
+      g_log.warning() << "NXlog entry " << log.first << " gave an error when loading:'" << e.what() << "'.\n";
+    }
+  }
+
+  std::vector<std::unique_ptr<Kernel::Property>> logValues(nLogs);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < nLogs; ++i) {
+    if (!data[i]) {
+      continue;
+    }
+    try {
+      logValues[i] = createTimeSeries(std::move(*data[i]), m_logsToPrefetch[i].first, g_log);
+    } catch (std::exception &e) {
+      g_log.warning() << "NXlog entry " << m_logsToPrefetch[i].first << " gave an error when loading:'" << e.what()
+                      << "'.\n";
+    }
+  }
+
+  const bool overwritelogs = this->getProperty("OverwriteLogs");
+  for (auto &logValue : logValues) {
+    if (logValue && (overwritelogs || !workspace->run().hasProperty(logValue->name()))) {
+      appendEndTimeLog(logValue.get(), workspace->run());
+      workspace->mutableRun().addProperty(std::move(logValue), overwritelogs);
+    }
+  }
+  m_logsToPrefetch.clear();
+}
+
 void LoadNexusLogs::loadSELog(::NeXus::File &file, const std::string &absolute_entry_name,
                               const std::shared_ptr<API::MatrixWorkspace> &workspace) const {
   // Open the entry
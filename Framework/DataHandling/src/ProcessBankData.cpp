@@ -6,7 +6,9 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include <utility>
 
+#include "MantidDataHandling/CompressEventAccumulator.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
+#include "MantidDataHandling/HistogramEventAccumulator.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
 
@@ -54,6 +56,33 @@ inline size_t getPulseIndex(const size_t event_index, const size_t last_pulse_in
   }
   return std::distance(event_index_vec->cbegin(), event_index_iter);
 }
+
+/// Move the events of an accumulator into an event list, after any events it already has
+template <typename EventType>
+void appendCompressedEvents(CompressEventAccumulator &accumulator, std::vector<EventType> &events) {
+  if (events.empty()) {
+    accumulator.createEvents(events);
+    return;
+  }
+  std::vector<EventType> compressed;
+  accumulator.createEvents(compressed);
+  events.insert(events.end(), compressed.cbegin(), compressed.cend());
+}
+
+/// Fill an event list with the compressed events of an accumulator
+void createCompressedEvents(CompressEventAccumulator &accumulator, EventList &el) {
+  // Several detector IDs may share a spectrum so it might already have events
+  const bool wasEmpty = el.empty();
+  if (accumulator.keepsPulseTimes()) {
+    el.switchTo(API::WEIGHTED);
+    appendCompressedEvents(accumulator, el.getWeightedEvents());
+    el.setSortOrder(UNSORTED);
+  } else {
+    el.switchTo(API::WEIGHTED_NOTIME);
+    appendCompressedEvents(accumulator, el.getWeightedEventsNoTime());
+    el.setSortOrder(wasEmpty ? TOF_SORT : UNSORTED);
+  }
+}
 } // namespace
 
 /** Run the data processing
@@ -71,7 +100,11 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
+  // Compressing or histogramming while loading never holds the uncompressed
+  // events so nothing needs to be reserved
+  const bool compressOnLoad = alg->compressOnLoad;
+  const bool histogramOnLoad = !alg->histogramEdges.empty();
+  if (m_loader.precount && !compressOnLoad && !histogramOnLoad) {
 
     std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
     for (size_t i = 0; i < numEvents; i++) {
@@ -119,6 +152,28 @@ void ProcessBankData::run() { // override {
   std::vector<bool> usedDetIds;
   usedDetIds.assign(m_max_id - m_min_id + 1, false);
 
+  // One accumulator per period and detector ID when compressing while loading.
+  // Each detector ID is only processed by one task so these are not shared.
+  std::vector<std::vector<CompressEventAccumulator>> accumulators;
+  if (compressOnLoad) {
+    const auto nPeriods = have_weight ? m_loader.weightedEventVectors.size() : m_loader.eventVectors.size();
+    accumulators.resize(nPeriods);
+    for (auto &periodAccumulators : accumulators)
+      periodAccumulators.assign(m_max_id - m_min_id + 1,
+                                CompressEventAccumulator(alg->compressTolerance, alg->compressBinningMode,
+                                                         alg->compressWallClockTolerance));
+  }
+
+  // One histogram per period and detector ID when histogramming while loading.
+  // These are added into the output spectra once all the events are read.
+  std::vector<HistogramEventAccumulator> histograms;
+  if (histogramOnLoad) {
+    const auto nPeriods = have_weight ? m_loader.weightedEventVectors.size() : m_loader.eventVectors.size();
+    for (size_t period = 0; period < nPeriods; ++period)
+      histograms.emplace_back(alg->histogramEdges, m_max_id - m_min_id + 1, have_weight);
+  }
+  const double histogramTofOffset = alg->histogramTofOffset;
+
   const double TOF_MIN = alg->filter_tof_min;
   const double TOF_MAX = alg->filter_tof_max;
 
@@ -160,7 +215,13 @@ void ProcessBankData::run() { // override {
             if (eventVector) {
               const auto weight = static_cast<double>((*event_weight)[eventIndex]);
               const double errorSq = weight * weight;
-              eventVector->emplace_back(tof, pulsetime, weight, errorSq);
+              if (histogramOnLoad)
+                histograms[periodIndex].addEvent(detId - m_min_id, tof + histogramTofOffset, weight, errorSq);
+              else if (compressOnLoad)
+                accumulators[periodIndex][detId - m_min_id].addEvent(tof, pulsetime, static_cast<float>(weight),
+                                                                     static_cast<float>(errorSq));
+              else
+                eventVector->emplace_back(tof, pulsetime, weight, errorSq);
             } else {
               ++my_discarded_events;
             }
@@ -169,7 +230,12 @@ void ProcessBankData::run() { // override {
             auto *eventVector = m_loader.eventVectors[periodIndex][detId];
             // NULL eventVector indicates a bad spectrum lookup
             if (eventVector) {
-              eventVector->emplace_back(tof, pulsetime);
+              if (histogramOnLoad)
+                histograms[periodIndex].addEvent(detId - m_min_id, tof + histogramTofOffset);
+              else if (compressOnLoad)
+                accumulators[periodIndex][detId - m_min_id].addEvent(tof, pulsetime);
+              else
+                eventVector->emplace_back(tof, pulsetime);
             } else {
               ++my_discarded_events;
             }
@@ -207,11 +273,29 @@ void ProcessBankData::run() { // override {
   //------------ Compress Events (or set sort order) ------------------
   // Do it on all the detector IDs we touched
   const size_t numEventLists = outputWS.getNumberHistograms();
+  // Several detector IDs, possibly from other tasks, may share a spectrum so
+  // the histograms are merged one task at a time
+  std::unique_lock<std::mutex> histogramLock(alg->m_histogramMutex, std::defer_lock);
+  if (histogramOnLoad)
+    histogramLock.lock();
   for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
     if (usedDetIds[pixID - m_min_id]) {
       // Find the the workspace index corresponding to that pixel ID
       size_t wi = getWorkspaceIndexFromPixelID(pixID);
-      if (wi < numEventLists) {
+      if (wi >= numEventLists)
+        continue;
+      if (histogramOnLoad) {
+        for (size_t period = 0; period < histograms.size(); ++period) {
+          histograms[period].addTo(pixID - m_min_id, alg->histogramCounts[period][wi],
+                                   alg->histogramErrorsSquared[period][wi]);
+        }
+      } else if (compressOnLoad) {
+        for (size_t period = 0; period < accumulators.size(); ++period) {
+          auto &accumulator = accumulators[period][pixID - m_min_id];
+          if (!accumulator.empty())
+            createCompressedEvents(accumulator, outputWS.getSpectrum(wi, period));
+        }
+      } else {
         auto &el = outputWS.getSpectrum(wi);
         if (compress)
           el.compressEvents(alg->compressTolerance, &el);
@@ -224,6 +308,8 @@ void ProcessBankData::run() { // override {
       }
     }
   }
+  if (histogramLock.owns_lock())
+    histogramLock.unlock();
   prog->report(entry_name + ": filled events");
 
   alg->getLogger().debug() << entry_name << (pulsetimesincreasing ? " had " : " DID NOT have ")
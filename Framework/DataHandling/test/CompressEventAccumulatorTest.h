@@ -0,0 +1,121 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/CompressEventAccumulator.h"
+
+#include <cmath>
+
+using namespace Mantid::DataHandling;
+using Mantid::DataObjects::WeightedEvent;
+using Mantid::DataObjects::WeightedEventNoTime;
+using Mantid::Types::Core::DateAndTime;
+
+class CompressEventAccumulatorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompressEventAccumulatorTest *createSuite() { return new CompressEventAccumulatorTest(); }
+  static void destroySuite(CompressEventAccumulatorTest *suite) { delete suite; }
+
+  void test_invalid_tolerances_throw() {
+    TS_ASSERT_THROWS(CompressEventAccumulator(0., CompressBinningMode::LINEAR), const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompressEventAccumulator(-1., CompressBinningMode::LOGARITHMIC), const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompressEventAccumulator(1., CompressBinningMode::LINEAR, -1.), const std::invalid_argument &);
+  }
+
+  void test_linear_bins_combine_events() {
+    CompressEventAccumulator accumulator(10., CompressBinningMode::LINEAR);
+    TS_ASSERT(accumulator.empty());
+    TS_ASSERT(!accumulator.keepsPulseTimes());
+    for (const double tof : {25., 1., 9., 5., 21.})
+      accumulator.addEvent(tof, DateAndTime(0));
+    TS_ASSERT(!accumulator.empty());
+
+    std::vector<WeightedEventNoTime> events;
+    accumulator.createEvents(events);
+    TS_ASSERT(accumulator.empty());
+    TS_ASSERT_EQUALS(events.size(), 2);
+    TS_ASSERT_DELTA(events[0].tof(), 5., 1e-12);
+    TS_ASSERT_DELTA(events[0].weight(), 3., 1e-6);
+    TS_ASSERT_DELTA(events[0].errorSquared(), 3., 1e-6);
+    TS_ASSERT_DELTA(events[1].tof(), 23., 1e-12);
+    TS_ASSERT_DELTA(events[1].weight(), 2., 1e-6);
+  }
+
+  void test_logarithmic_bins_widen_with_time_of_flight() {
+    // Bin edges at 1, 2, 4, 8, ... microseconds
+    CompressEventAccumulator accumulator(1., CompressBinningMode::LOGARITHMIC);
+    for (const double tof : {1.5, 1.9, 2.5, 3.5, 100., 127.})
+      accumulator.addEvent(tof, DateAndTime(0));
+
+    std::vector<WeightedEventNoTime> events;
+    accumulator.createEvents(events);
+    TS_ASSERT_EQUALS(events.size(), 3);
+    TS_ASSERT_DELTA(events[0].tof(), 1.7, 1e-12);
+    TS_ASSERT_DELTA(events[1].tof(), 3., 1e-12);
+    TS_ASSERT_DELTA(events[2].tof(), 113.5, 1e-12);
+  }
+
+  void test_logarithmic_bin_edges_belong_to_the_bin_above() {
+    // log(1.01^9) / log(1.01) rounds to just below 9
+    const double edge = std::pow(1.01, 9);
+    CompressEventAccumulator accumulator(0.01, CompressBinningMode::LOGARITHMIC);
+    for (const double tof : {edge * 0.999, edge, edge * 1.001})
+      accumulator.addEvent(tof, DateAndTime(0));
+
+    std::vector<WeightedEventNoTime> events;
+    accumulator.createEvents(events);
+    TS_ASSERT_EQUALS(events.size(), 2);
+    TS_ASSERT_DELTA(events[0].tof(), edge * 0.999, 1e-12);
+    TS_ASSERT_DELTA(events[0].weight(), 1., 1e-6);
+    TS_ASSERT_DELTA(events[1].tof(), edge * 1.0005, 1e-12);
+    TS_ASSERT_DELTA(events[1].weight(), 2., 1e-6);
+  }
+
+  void test_bins_are_merged_across_buffer_folds() {
+    CompressEventAccumulator accumulator(1., CompressBinningMode::LINEAR);
+    const size_t nEvents = 10 * CompressEventAccumulator::MIN_BUFFER_SIZE + 3;
+    double weight(0.);
+    for (size_t i = 0; i < nEvents; ++i) {
+      // Cycle through the bins so every fold adds to existing ones
+      accumulator.addEvent(static_cast<double>(i % 50) + 0.5, DateAndTime(0), 2.f, 4.f);
+      weight += 2.;
+    }
+
+    std::vector<WeightedEventNoTime> events;
+    accumulator.createEvents(events);
+    TS_ASSERT_EQUALS(events.size(), 50);
+    double totalWeight(0.), totalError(0.);
+    for (size_t i = 0; i < events.size(); ++i) {
+      TS_ASSERT_DELTA(events[i].tof(), static_cast<double>(i) + 0.5, 1e-9);
+      totalWeight += events[i].weight();
+      totalError += events[i].errorSquared();
+    }
+    TS_ASSERT_DELTA(totalWeight, weight, 1e-3);
+    TS_ASSERT_DELTA(totalError, 2. * weight, 1e-3);
+  }
+
+  void test_wall_clock_tolerance_keeps_pulse_times() {
+    const DateAndTime start("2022-01-01T00:00:00");
+    CompressEventAccumulator accumulator(10., CompressBinningMode::LINEAR, 1.);
+    TS_ASSERT(accumulator.keepsPulseTimes());
+    accumulator.addEvent(5., start + 0.1);
+    accumulator.addEvent(5., start + 0.3);
+    accumulator.addEvent(5., start + 1.5);
+
+    std::vector<WeightedEvent> events;
+    accumulator.createEvents(events);
+    TS_ASSERT_EQUALS(events.size(), 2);
+    TS_ASSERT_DELTA(events[0].weight(), 2., 1e-6);
+    TS_ASSERT_EQUALS(events[0].pulseTime(), start + 0.2);
+    TS_ASSERT_DELTA(events[1].weight(), 1., 1e-6);
+    TS_ASSERT_EQUALS(events[1].pulseTime(), start + 1.5);
+  }
+};
@@ -0,0 +1,80 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/HistogramEventAccumulator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace Mantid::DataHandling;
+
+class HistogramEventAccumulatorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static HistogramEventAccumulatorTest *createSuite() { return new HistogramEventAccumulatorTest(); }
+  static void destroySuite(HistogramEventAccumulatorTest *suite) { delete suite; }
+
+  void test_too_few_edges_throw() {
+    const std::vector<double> edges{1.};
+    TS_ASSERT_THROWS(HistogramEventAccumulator(edges, 1, false), const std::invalid_argument &);
+  }
+
+  void test_find_bin_matches_binary_search() {
+    const std::vector<double> linear{0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7};
+    const std::vector<double> logarithmic{1., 2., 4., 8., 16.};
+    for (const auto *edges : {&linear, &logarithmic}) {
+      HistogramEventAccumulator accumulator(*edges, 1, false);
+      const double width = (edges->back() - edges->front()) / 1000.;
+      for (double tof = edges->front() - 10. * width; tof < edges->back() + 10. * width; tof += width) {
+        size_t expected = edges->size() - 1;
+        if (tof >= edges->front() && tof < edges->back())
+          expected = std::upper_bound(edges->cbegin(), edges->cend(), tof) - edges->cbegin() - 1;
+        TS_ASSERT_EQUALS(accumulator.findBin(tof), expected);
+      }
+      // Bins include their lower edge only
+      for (size_t i = 0; i + 1 < edges->size(); ++i)
+        TS_ASSERT_EQUALS(accumulator.findBin((*edges)[i]), i);
+      TS_ASSERT_EQUALS(accumulator.findBin(edges->back()), edges->size() - 1);
+    }
+  }
+
+  void test_unweighted_events_are_counted() {
+    const std::vector<double> edges{0., 10., 20., 30.};
+    HistogramEventAccumulator accumulator(edges, 2, false);
+    for (const double tof : {-1., 5., 15., 16., 29.9, 30.})
+      accumulator.addEvent(1, tof);
+    TS_ASSERT(accumulator.empty(0));
+    TS_ASSERT(!accumulator.empty(1));
+
+    std::vector<double> counts, errorsSquared;
+    accumulator.addTo(0, counts, errorsSquared);
+    TS_ASSERT(counts.empty());
+    accumulator.addTo(1, counts, errorsSquared);
+    TS_ASSERT_EQUALS(counts, std::vector<double>({1., 2., 1.}));
+    TS_ASSERT(errorsSquared.empty());
+    // The row is freed once added
+    TS_ASSERT(accumulator.empty(1));
+  }
+
+  void test_weighted_rows_add_into_a_spectrum() {
+    const std::vector<double> edges{0., 10., 20.};
+    HistogramEventAccumulator accumulator(edges, 2, true);
+    accumulator.addEvent(0, 5., 2., 4.);
+    accumulator.addEvent(1, 6., 0.5, 0.25);
+    accumulator.addEvent(1, 15., 3., 9.);
+
+    std::vector<double> counts, errorsSquared;
+    accumulator.addTo(0, counts, errorsSquared);
+    accumulator.addTo(1, counts, errorsSquared);
+    TS_ASSERT_EQUALS(counts, std::vector<double>({2.5, 3.}));
+    TS_ASSERT_EQUALS(errorsSquared, std::vector<double>({4.25, 9.}));
+  }
+};
@@ -29,6 +29,8 @@
 #include "Poco/Path.h"
 #include <cxxtest/TestSuite.h>
 
+#include <numeric>
+
 using namespace Mantid;
 using namespace Mantid::Geometry;
 using namespace Mantid::API;
@@ -699,6 +701,59 @@ public:
     TS_ASSERT_EQUALS(monWS, ads.retrieveWS<MatrixWorkspace>(wsSpecFilterAndEventMonitors)->monitorWorkspace());
   }
 
+  void test_Load_As_Histogram() {
+    LoadEventNexus eventLoader;
+    eventLoader.initialize();
+    eventLoader.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    eventLoader.setPropertyValue("OutputWorkspace", "cncs_events");
+    eventLoader.setProperty<bool>("LoadLogs", false);
+    eventLoader.execute();
+    TS_ASSERT(eventLoader.isExecuted());
+
+    LoadEventNexus histogramLoader;
+    histogramLoader.initialize();
+    histogramLoader.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    histogramLoader.setPropertyValue("OutputWorkspace", "cncs_histogram");
+    histogramLoader.setProperty<bool>("LoadLogs", false);
+    histogramLoader.setPropertyValue("HistogramBinning", "40000,-0.01,70000");
+    histogramLoader.execute();
+    TS_ASSERT(histogramLoader.isExecuted());
+
+    const auto eventWS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("cncs_events");
+    const auto histogramWS = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("cncs_histogram");
+    // No events are kept
+    TS_ASSERT(!std::dynamic_pointer_cast<EventWorkspace>(histogramWS));
+    TS_ASSERT_EQUALS(histogramWS->getNumberHistograms(), eventWS->getNumberHistograms());
+    TS_ASSERT_EQUALS(histogramWS->getSpectrum(0).getDetectorIDs(), eventWS->getSpectrum(0).getDetectorIDs());
+
+    const auto &edges = histogramWS->x(0).rawData();
+    TS_ASSERT_DELTA(edges.front(), 40000., 1e-9);
+    TS_ASSERT_DELTA(edges.back(), 70000., 1e-9);
+    double total(0.);
+    MantidVec y, e;
+    for (size_t wi = 0; wi < eventWS->getNumberHistograms(); ++wi) {
+      eventWS->getSpectrum(wi).generateHistogram(edges, y, e);
+      TS_ASSERT_EQUALS(histogramWS->y(wi).rawData(), y);
+      TS_ASSERT_EQUALS(histogramWS->e(wi).rawData(), e);
+      total += std::accumulate(y.cbegin(), y.cend(), 0.);
+    }
+    TS_ASSERT_LESS_THAN(0., total);
+
+    AnalysisDataService::Instance().remove("cncs_events");
+    AnalysisDataService::Instance().remove("cncs_histogram");
+  }
+
+  void test_Load_As_Histogram_rejects_time_filtering() {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_histogram");
+    ld.setPropertyValue("HistogramBinning", "40000,100,70000");
+    ld.setProperty("FilterByTimeStart", 60.);
+    ld.setRethrows(true);
+    TS_ASSERT_THROWS(ld.execute(), const std::runtime_error &);
+  }
+
   void test_Load_And_CompressEvents() {
     Mantid::API::FrameworkManager::Instance();
     LoadEventNexus ld;
@@ -759,6 +814,42 @@ public:
     TS_ASSERT_EQUALS(WS, ads.retrieveWS<MatrixWorkspace>("cncs_compressed")->monitorWorkspace());
   }
 
+  void test_Load_And_Compress_On_Load_Matches_CompressEvents() {
+    const auto plain = loadCNCSForCompression("Default", "-1");
+    auto compress = AlgorithmManager::Instance().createUnmanaged("CompressEvents");
+    compress->initialize();
+    compress->setChild(true);
+    compress->setProperty("InputWorkspace", plain);
+    compress->setPropertyValue("OutputWorkspace", "unused_for_child");
+    compress->setProperty("Tolerance", 0.05);
+    compress->execute();
+    EventWorkspace_sptr compressed = compress->getProperty("OutputWorkspace");
+
+    const auto linear = loadCNCSForCompression("Linear", "0.05");
+    const auto logarithmic = loadCNCSForCompression("Logarithmic", "0.0001");
+    TS_ASSERT_EQUALS(linear->getNumberHistograms(), plain->getNumberHistograms());
+    TS_ASSERT_EQUALS(logarithmic->getNumberHistograms(), plain->getNumberHistograms());
+    for (size_t wi = 0; wi < plain->getNumberHistograms(); ++wi) {
+      const auto nEvents = plain->getSpectrum(wi).getNumberEvents();
+      const auto weight = static_cast<double>(nEvents);
+      // CompressEvents groups events greedily from the first one of each group
+      // so a group spans at most two of the fixed bins, and no fixed bin holds
+      // the start of two groups
+      const auto nCompressed = compressed->getSpectrum(wi).getNumberEvents();
+      TS_ASSERT_LESS_THAN_EQUALS(nCompressed, linear->getSpectrum(wi).getNumberEvents());
+      TS_ASSERT_LESS_THAN_EQUALS(linear->getSpectrum(wi).getNumberEvents(), 2 * nCompressed);
+      TS_ASSERT_DELTA(sumWeights(linear->getSpectrum(wi)), weight, 1e-6);
+      TS_ASSERT_DELTA(sumWeights(compressed->getSpectrum(wi)), weight, 1e-6);
+      TS_ASSERT_LESS_THAN_EQUALS(logarithmic->getSpectrum(wi).getNumberEvents(), nEvents);
+      TS_ASSERT_DELTA(sumWeights(logarithmic->getSpectrum(wi)), weight, 1e-6);
+      if (nEvents > 0) {
+        TS_ASSERT_EQUALS(linear->getSpectrum(wi).getEventType(), WEIGHTED_NOTIME);
+        TS_ASSERT_EQUALS(logarithmic->getSpectrum(wi).getEventType(), WEIGHTED_NOTIME);
+      }
+    }
+    TS_ASSERT_LESS_THAN(logarithmic->getNumberEvents(), plain->getNumberEvents());
+  }
+
   void doTestSingleBank(bool SingleBankPixelsOnly, bool Precount, const std::string &BankName = "bank36",
                         bool willFail = false) {
     Mantid::API::FrameworkManager::Instance();
@@ -1123,6 +1214,29 @@ public:
   }
 
 private:
+  /// Load CNCS_7860_event.nxs without logs or monitors with the given compression
+  static EventWorkspace_sptr loadCNCSForCompression(const std::string &binningMode, const std::string &tolerance) {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setChild(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "unused_for_child");
+    ld.setPropertyValue("CompressTolerance", tolerance);
+    ld.setPropertyValue("CompressBinningMode", binningMode);
+    ld.setProperty<bool>("LoadMonitors", false);
+    ld.setProperty<bool>("LoadLogs", false);
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+    Workspace_sptr ws = ld.getProperty("OutputWorkspace");
+    return std::dynamic_pointer_cast<EventWorkspace>(ws);
+  }
+
+  /// @return the sum of the weights of the events of a spectrum
+  static double sumWeights(const EventList &events) {
+    const auto weights = events.getWeights();
+    return std::accumulate(weights.cbegin(), weights.cend(), 0.);
+  }
+
   std::string wsSpecFilterAndEventMonitors;
 };
 
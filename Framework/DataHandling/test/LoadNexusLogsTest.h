@@ -430,6 +430,45 @@ public:
     TS_ASSERT_EQUALS(properties.size(), 94);
   }
 
+  void test_load_logs_on_demand() {
+    auto eagerWS = createTestWorkspace();
+    LoadNexusLogs eager;
+    eager.initialize();
+    eager.setPropertyValue("Filename", "REF_L_32035.nxs");
+    eager.setProperty("Workspace", eagerWS);
+    eager.execute();
+    TS_ASSERT(eager.isExecuted());
+
+    auto ws = createTestWorkspace();
+    LoadNexusLogs ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "REF_L_32035.nxs");
+    ld.setProperty("Workspace", ws);
+    ld.setProperty("LoadLogsOnDemand", true);
+    ld.setPropertyValue("PrefetchLogs", "Phase1,Speed3");
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+
+    const Run &run = ws->run();
+    TS_ASSERT(run.hasProperty("PhaseRequest1"));
+    TS_ASSERT(run.isDeferredProperty("PhaseRequest1"));
+    TS_ASSERT(!run.isDeferredProperty("Phase1"));
+    TS_ASSERT(!run.isDeferredProperty("Speed3"));
+
+    // A deferred log is the same as one loaded straight away, including the
+    // entry appended at the end time of the run
+    const Run &eagerRun = eagerWS->run();
+    for (const std::string name : {"PhaseRequest1", "Phase1", "Speed3"}) {
+      Property *log = run.getLogData(name);
+      Property *expected = eagerRun.getLogData(name);
+      TS_ASSERT_EQUALS(log->value(), expected->value());
+      TS_ASSERT_EQUALS(log->size(), expected->size());
+      TS_ASSERT_EQUALS(log->units(), expected->units());
+    }
+    TS_ASSERT(!run.isDeferredProperty("PhaseRequest1"));
+    TS_ASSERT_EQUALS(run.getLogData().size(), eagerRun.getLogData().size());
+  }
+
 private:
   API::MatrixWorkspace_sptr createTestWorkspace() {
     return WorkspaceFactory::Instance().create("Workspace2D", 1, 1, 1);
@@ -8,9 +8,12 @@
 
 #include "MantidAPI/BoxController.h"
 #include "MantidAPI/IBoxControllerIO.h"
+#include "MantidDataObjects/MDEventBlockCache.h"
+#include "MantidDataObjects/MDEventDatasetReader.h"
 #include "MantidKernel/DiskBuffer.h"
 #include <nexus/NeXusFile.hpp>
 
+#include <atomic>
 #include <mutex>
 
 namespace Mantid {
@@ -46,6 +49,11 @@ public:
   void flushData() const override;
   void closeFile() override;
 
+  bool supportsConcurrentReads() const;
+  void setReadCacheSize(const size_t cacheSize);
+  /// @return the number of bytes the cache of loaded blocks may hold
+  size_t getReadCacheSize() const { return m_readCache.capacity(); }
+
   ~BoxControllerNeXusIO() override;
   // Auxiliary functions. Used to change default state of this object which is
   // not fully supported. Should be replaced by some IBoxControllerIO factory
@@ -130,6 +138,15 @@ private:
   std::vector<int64_t> m_BlockSize;
   /// lock Nexus file operations as Nexus is not thread safe
   mutable std::mutex m_fileMutex;
+  /// reader of the events dataset which does not need the file lock. Reset
+  /// when the file is modified and recreated by the first read after the
+  /// changes are flushed, so it is always accessed atomically
+  mutable std::shared_ptr<const MDEventDatasetReader> m_datasetReader;
+  /// true if the next read should create the dataset reader. Changed with the
+  /// file lock held
+  mutable std::atomic<bool> m_datasetReaderPending{false};
+  /// recently loaded blocks, used together with the dataset reader
+  mutable MDEventBlockCache m_readCache;
 
   // Mainly static information which may be split into different IO classes
   // selected through chein of responsibility.
@@ -194,6 +211,10 @@ private:
   */
   template <typename Type>
   void loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition, const size_t nPoints) const;
+  bool loadRawBlock(const MDEventDatasetReader &reader, char *destination, const uint64_t blockPosition,
+                    const size_t nPoints, const size_t nBytes) const;
+  std::shared_ptr<const MDEventDatasetReader> datasetReader() const;
+  void invalidateDatasetReader() const;
 };
 } // namespace DataObjects
 } // namespace Mantid
\ No newline at end of file
@@ -38,6 +38,16 @@ enum EventSortType {
   TIMEATSAMPLE_SORT
 };
 
+/** Where one field of the events of an EventList is stored: the value for
+ * event i is at the address data + i * stride bytes. A stride of zero means
+ * every event has the same value. Only valid until the list is modified.
+ */
+struct EventColumn {
+  const void *data;
+  std::size_t stride;
+  std::size_t size;
+};
+
 //==========================================================================================
 /** @class Mantid::DataObjects::EventList
 
@@ -89,6 +99,8 @@ public:
 
   EventList &operator+=(const EventList &more_events);
 
+  EventList &addEventLists(const std::vector<const EventList *> &eventLists);
+
   EventList &operator-=(const EventList &more_events);
 
   bool operator==(const EventList &rhs) const;
@@ -254,6 +266,15 @@ public:
 
   std::vector<Mantid::Types::Core::DateAndTime> getPulseTimes() const override;
 
+  /// The TOF of the events as doubles, without copying them
+  EventColumn tofColumn() const;
+  /// The pulse times of the events as int64 nanoseconds, without copying them
+  EventColumn pulseTimeColumn() const;
+  /// The weights of the events as floats, without copying them
+  EventColumn weightColumn() const;
+  /// The squared errors of the weights as floats, without copying them
+  EventColumn errorSquaredColumn() const;
+
   void setTofs(const MantidVec &tofs) override;
 
   void reverse();
@@ -377,6 +398,9 @@ private:
   // helper functions are all internal to simplify the code
   template <class T1, class T2> static void minusHelper(std::vector<T1> &events, const std::vector<T2> &more_events);
   template <class T>
+  static void addEventListsHelper(std::vector<T> &events, const std::vector<const EventList *> &eventLists,
+                                  const bool mergeSorted);
+  template <class T>
   static void compressEventsHelper(const std::vector<T> &events, std::vector<WeightedEventNoTime> &out,
                                    double tolerance);
   template <class T>
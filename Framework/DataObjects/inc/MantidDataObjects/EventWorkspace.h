@@ -138,6 +138,8 @@ public:
 
   void clearMRU() const override;
 
+  std::size_t cacheHistograms() const override;
+
   EventSortType getSortType() const;
 
   // Sort all event lists. Uses a parallelized algorithm
@@ -15,7 +15,9 @@
 
 #include "Poco/RWLock.h"
 
+#include <atomic>
 #include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace Mantid {
@@ -57,6 +59,11 @@ public:
 //============================================================================
 /** This is a container for the MRU (most-recently-used) list
  * of generated histograms.
+ *
+ * Next to the per-thread MRU lists it holds the histograms generated for
+ * many spectra at once by EventWorkspace::cacheHistograms(), which are
+ * shared by all threads and kept until the spectrum is changed or the whole
+ * container is cleared.
  */
 class DLLExport EventWorkspaceMRU {
 public:
@@ -80,6 +87,10 @@ public:
   void insertY(size_t thread_num, YType data, const EventList *index);
   void insertE(size_t thread_num, EType data, const EventList *index);
 
+  void insertHistograms(const std::vector<const EventList *> &indices, std::vector<YType> &y, std::vector<EType> &e);
+  bool hasHistogram(const EventList *index) const;
+  size_t getHistogramCacheMemorySize() const;
+
   void deleteIndex(const EventList *index);
 
   /** Return how many entries in the Y MRU list are used.
@@ -97,6 +108,13 @@ protected:
   /// Mutex when adding entries in the MRU list
   mutable Poco::RWLock m_changeMruListsMutexE;
   mutable Poco::RWLock m_changeMruListsMutexY;
+
+  /// Histograms generated for many spectra at once, shared by all threads
+  std::unordered_map<const EventList *, std::pair<YType, EType>> m_cachedHistograms;
+  /// True if m_cachedHistograms may hold entries, to skip locking when it is empty
+  std::atomic<bool> m_hasCachedHistograms{false};
+  /// Mutex guarding m_cachedHistograms
+  mutable Poco::RWLock m_cachedHistogramsMutex;
 };
 
 } // namespace DataObjects
@@ -33,6 +33,22 @@ namespace DataObjects {
 
 namespace FractionalRebinning {
 
+/// The share of an input bin given to one output bin
+struct BinContribution {
+  /// Workspace index of the output bin
+  size_t wsIndex;
+  /// Bin index of the output bin
+  size_t binIndex;
+  /// Signal to add to the output bin
+  double signal;
+  /// Variance to add to the output bin
+  double variance;
+  /// Fractional area to add to the output bin, if it is a RebinnedOutput
+  double fraction;
+};
+/// Contributions gathered without locking, to be added to the output in one go
+using BinContributions = std::vector<BinContribution>;
+
 /// Find the intersect region on the output grid
 MANTID_DATAOBJECTS_DLL bool getIntersectionRegion(const std::vector<double> &xAxis,
                                                   const std::vector<double> &verticalAxis,
@@ -57,6 +73,27 @@ MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(const Geometry::Quadrilatera
                                                     const std::vector<double> &verticalAxis,
                                                     const DataObjects::RebinnedOutput_const_sptr &inputRB = nullptr);
 
+/// Gather the shares of the input quadrilateral for the output grid without writing to the output
+MANTID_DATAOBJECTS_DLL void rebinToOutput(const Geometry::Quadrilateral &inputQ,
+                                          const API::MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                                          const size_t j, const std::vector<double> &xAxis,
+                                          const std::vector<double> &verticalAxis, BinContributions &contributions);
+
+/// Gather the shares of the input quadrilateral for the fractional output grid without writing to the output
+MANTID_DATAOBJECTS_DLL void rebinToFractionalOutput(const Geometry::Quadrilateral &inputQ,
+                                                    const API::MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                                                    const size_t j, const std::vector<double> &xAxis,
+                                                    const std::vector<double> &verticalAxis,
+                                                    BinContributions &contributions,
+                                                    const DataObjects::RebinnedOutput_const_sptr &inputRB = nullptr);
+
+/// Add gathered contributions to the signal and variance of the output
+MANTID_DATAOBJECTS_DLL void addContributions(API::MatrixWorkspace &outputWS, const BinContributions &contributions);
+
+/// Add gathered contributions to the signal, variance and fractional area of the output
+MANTID_DATAOBJECTS_DLL void addContributions(DataObjects::RebinnedOutput &outputWS,
+                                             const BinContributions &contributions);
+
 /// Set finalize flag after fractional rebinning loop
 MANTID_DATAOBJECTS_DLL void finalizeFractionalRebin(DataObjects::RebinnedOutput &outputWS);
 
@@ -0,0 +1,68 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** A thread-safe, least-recently-used cache of raw event data blocks read
+  from a file-backed MD workspace.
+
+  Blocks are identified by their position in the events dataset and their
+  length in events. The total size of the cached blocks is bounded by the
+  capacity, in bytes; the least recently used blocks are dropped first. Cached
+  blocks are immutable and shared, so a block returned by find() stays valid
+  even if it is evicted while it is being used.
+*/
+class MANTID_DATAOBJECTS_DLL MDEventBlockCache {
+public:
+  using Block = std::shared_ptr<const std::vector<char>>;
+
+  explicit MDEventBlockCache(size_t capacity = 0);
+
+  void setCapacity(size_t capacity);
+  /// @return the maximum number of bytes held by the cache
+  size_t capacity() const;
+  /// @return the number of bytes currently held by the cache
+  size_t size() const;
+  /// @return the number of blocks currently held by the cache
+  size_t numberOfBlocks() const;
+
+  Block find(uint64_t blockPosition, size_t nPoints);
+  void insert(uint64_t blockPosition, size_t nPoints, Block block);
+  void clear();
+
+private:
+  using Key = std::pair<uint64_t, size_t>;
+  struct Entry {
+    Key key;
+    Block block;
+  };
+  using EntryList = std::list<Entry>;
+
+  void evict();
+
+  /// cached blocks, the most recently used first
+  EntryList m_entries;
+  /// the position of every block in the list of entries
+  std::map<Key, EntryList::iterator> m_index;
+  size_t m_capacity;
+  size_t m_size;
+  mutable std::mutex m_mutex;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,81 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fstream>
+#include <mutex>
+#endif
+
+namespace Mantid {
+namespace DataObjects {
+
+/** Reads rows of the two dimensional "event_data" dataset of a file-backed MD
+  workspace concurrently.
+
+  The layout of the dataset is inspected once through HDF5: the file offsets of
+  the contiguous storage or of every chunk are recorded, after which the HDF5
+  handles are closed and rows are served by positional reads on a plain file
+  descriptor. Reads do not take any lock (on Windows they are serialised on a
+  single stream) and therefore scale with the number of reading threads.
+
+  The direct path is only available for uncompressed, unfiltered datasets of
+  native floating point type whose chunks span all the columns; create()
+  returns nullptr otherwise and the caller must use the NeXus API instead.
+  Locating the chunks of large datasets efficiently requires HDF5 1.14; with
+  older versions only datasets with up to a few thousand chunks are handled.
+*/
+class MANTID_DATAOBJECTS_DLL MDEventDatasetReader {
+public:
+  static std::unique_ptr<MDEventDatasetReader> create(const std::string &fileName, const std::string &datasetPath);
+  ~MDEventDatasetReader();
+  MDEventDatasetReader(const MDEventDatasetReader &) = delete;
+  MDEventDatasetReader &operator=(const MDEventDatasetReader &) = delete;
+
+  /// @return the size in bytes of a single value stored in the dataset
+  size_t elementSize() const { return m_elementSize; }
+  /// @return the number of values in every row of the dataset
+  size_t numberOfColumns() const { return m_nColumns; }
+  /// @return the number of rows in the dataset
+  uint64_t numberOfRows() const { return m_nRows; }
+
+  bool readRows(uint64_t firstRow, size_t nRows, void *destination) const;
+
+  /// A range of rows stored contiguously in the file
+  struct Extent {
+    uint64_t firstRow;
+    uint64_t nRows;
+    uint64_t fileOffset;
+  };
+
+private:
+  MDEventDatasetReader(const std::string &fileName, std::vector<Extent> extents, size_t elementSize, size_t nColumns,
+                       uint64_t nRows);
+  bool readBytes(uint64_t fileOffset, size_t nBytes, char *destination) const;
+
+  /// row ranges sorted by their first row
+  const std::vector<Extent> m_extents;
+  const size_t m_elementSize;
+  const size_t m_nColumns;
+  const uint64_t m_nRows;
+#ifdef _WIN32
+  mutable std::ifstream m_stream;
+  mutable std::mutex m_streamMutex;
+#else
+  int m_fileDescriptor;
+#endif
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -443,6 +443,8 @@ private:
 
   signal_t getNormalizationFactor(const API::MDNormalization &normalize, size_t linearIndex) const;
 
+  friend class MDHistoWorkspaceExpression;
+
 protected:
   LinePlot getLinePoints(const Mantid::Kernel::VMD &start, const Mantid::Kernel::VMD &end,
                          Mantid::API::MDNormalization normalize, const bool bin_centres) const;
@@ -0,0 +1,118 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidGeometry/MDGeometry/MDTypes.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class MDHistoWorkspace;
+
+/** A chain of element-wise operations on the signal, error squared and number
+  of events arrays of a MDHistoWorkspace.
+
+  Each step updates the running value of every bin exactly as the
+  MDHistoWorkspace method of the same name does. evaluate() applies the whole
+  chain in a single pass: the arrays are split into blocks small enough to
+  stay in cache, every step is applied to a block before moving on to the
+  next one and the blocks are shared out between threads. Evaluating
+  e.g. "(A - B) * C / D" therefore reads and writes the arrays of A once
+  instead of once per operation, and needs no intermediate workspaces.
+
+  Operand workspaces are held by reference: they must outlive the expression
+  and must not be resized before it is evaluated. An operand may be the
+  workspace the expression is evaluated on.
+*/
+class MANTID_DATAOBJECTS_DLL MDHistoWorkspaceExpression {
+public:
+  MDHistoWorkspaceExpression &add(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &add(const signal_t signal, const signal_t error);
+  MDHistoWorkspaceExpression &subtract(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &subtract(const signal_t signal, const signal_t error);
+  MDHistoWorkspaceExpression &multiply(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &multiply(const signal_t signal, const signal_t error);
+  MDHistoWorkspaceExpression &divide(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &divide(const signal_t signal, const signal_t error);
+
+  MDHistoWorkspaceExpression &log(double filler = 0.0);
+  MDHistoWorkspaceExpression &log10(double filler = 0.0);
+  MDHistoWorkspaceExpression &exp();
+  MDHistoWorkspaceExpression &power(double exponent);
+
+  MDHistoWorkspaceExpression &operatorAnd(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &operatorOr(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &operatorXor(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &operatorNot();
+
+  MDHistoWorkspaceExpression &lessThan(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &lessThan(const signal_t signal);
+  MDHistoWorkspaceExpression &greaterThan(const MDHistoWorkspace &b);
+  MDHistoWorkspaceExpression &greaterThan(const signal_t signal);
+  MDHistoWorkspaceExpression &equalTo(const MDHistoWorkspace &b, const signal_t tolerance = 1e-5);
+  MDHistoWorkspaceExpression &equalTo(const signal_t signal, const signal_t tolerance = 1e-5);
+
+  MDHistoWorkspaceExpression &setUsingMask(const MDHistoWorkspace &mask, const MDHistoWorkspace &values);
+  MDHistoWorkspaceExpression &setUsingMask(const MDHistoWorkspace &mask, const signal_t signal, const signal_t error);
+
+  /// @return the number of steps in the expression
+  size_t size() const { return m_steps.size(); }
+  /// @return true if the expression has no steps
+  bool empty() const { return m_steps.empty(); }
+
+  void evaluate(MDHistoWorkspace &ws) const;
+
+  /// Number of bins processed by all the steps before moving to the next block
+  static constexpr size_t BLOCK_SIZE = 2048;
+
+private:
+  enum class Operation {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Log,
+    Log10,
+    Exp,
+    Power,
+    And,
+    Or,
+    Xor,
+    Not,
+    LessThan,
+    GreaterThan,
+    EqualTo,
+    SetUsingMask
+  };
+
+  struct Step {
+    Operation operation;
+    /// name of the operation used in error messages
+    const char *name;
+    /// the workspace operand, or nullptr to use the scalar operand
+    const MDHistoWorkspace *operand;
+    /// the mask of SetUsingMask
+    const MDHistoWorkspace *mask;
+    /// scalar operand
+    signal_t signal;
+    signal_t errorSquared;
+    /// filler, exponent or tolerance
+    double parameter;
+  };
+
+  MDHistoWorkspaceExpression &addStep(Operation operation, const char *name, const MDHistoWorkspace *operand,
+                                      signal_t signal = 0, signal_t errorSquared = 0, double parameter = 0,
+                                      const MDHistoWorkspace *mask = nullptr);
+  static void applyStep(const Step &step, MDHistoWorkspace &ws, size_t begin, size_t end);
+
+  std::vector<Step> m_steps;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -160,6 +160,8 @@ bool BoxControllerNeXusIO::openFile(const std::string &fileName, const std::stri
     prepareNxSdata_CurVersion();
   else
     prepareNxSToWrite_CurVersion();
+  // the dataset reader is created by the first read of a file opened for reading
+  m_datasetReaderPending = m_ReadOnly;
 
   return true;
 }
@@ -317,6 +319,8 @@ void BoxControllerNeXusIO::saveGenericBlock(const std::vector<Type> &DataBlock,
     if (blockPosition + dims[0] > this->getFileLength())
       this->setFileLength(blockPosition + dims[0]);
   }
+  // the new data may still be held by HDF5 rather than be in the file
+  invalidateDatasetReader();
 }
 
 /** Save float data block on specific position within properly opened NeXus data
@@ -486,14 +490,85 @@ void BoxControllerNeXusIO::loadGenericBlock(std::vector<Type> &Block, const uint
   size[0] = static_cast<int64_t>(nPoints);
   size[1] = dataEventCount(); // data item count per event in the Nexus file
 
-  std::lock_guard<std::mutex> _lock(m_fileMutex);
-
   Block.resize(size[0] * size[1]);
+  const auto reader = datasetReader();
+  if (reader && reader->elementSize() == sizeof(Type) && reader->numberOfColumns() == static_cast<size_t>(size[1]) &&
+      loadRawBlock(*reader, reinterpret_cast<char *>(Block.data()), blockPosition, nPoints,
+                   Block.size() * sizeof(Type))) {
+    adjustEventDataBlock(Block, "READ"); // insert goniometer info if necessary
+    return;
+  }
+
+  std::lock_guard<std::mutex> _lock(m_fileMutex);
   m_File->getSlab(&Block[0], start, size);
 
   adjustEventDataBlock(Block, "READ"); // insert goniometer info if necessary
 }
 
+/** Load a block of events in their file representation through the dataset
+  reader, without locking the NeXus file. Recently loaded blocks are served
+  from the read cache.
+  *@param reader        -- the reader of the events dataset
+  *@param destination   -- memory to place nBytes of data into
+  *@param blockPosition -- The starting place to read data from
+  *@param nPoints       -- number of data points (events) to read
+  *@param nBytes        -- the size of the block in bytes
+
+  *@returns false if the block can not be read this way
+*/
+bool BoxControllerNeXusIO::loadRawBlock(const MDEventDatasetReader &reader, char *destination,
+                                        const uint64_t blockPosition, const size_t nPoints,
+                                        const size_t nBytes) const {
+  if (const auto cached = m_readCache.find(blockPosition, nPoints)) {
+    if (cached->size() == nBytes) {
+      std::copy(cached->cbegin(), cached->cend(), destination);
+      return true;
+    }
+  }
+  if (!reader.readRows(blockPosition, nPoints, destination))
+    return false;
+  if (nBytes <= m_readCache.capacity())
+    m_readCache.insert(blockPosition, nPoints,
+                       std::make_shared<const std::vector<char>>(destination, destination + nBytes));
+  return true;
+}
+
+/**@return true if blocks can currently be loaded from several threads at
+ * once. For files open for writing this is the case only while all the
+ * changes to the events data have been flushed. */
+bool BoxControllerNeXusIO::supportsConcurrentReads() const { return datasetReader() != nullptr; }
+
+/** @return the reader of the events dataset, or null if blocks have to be
+ * read through the NeXus API. The reader is created on the first call after
+ * the file is opened or flushed, so flushing alone never reopens the file. */
+std::shared_ptr<const MDEventDatasetReader> BoxControllerNeXusIO::datasetReader() const {
+  auto reader = std::atomic_load(&m_datasetReader);
+  if (reader || !m_datasetReaderPending)
+    return reader;
+  std::lock_guard<std::mutex> _lock(m_fileMutex);
+  if (m_datasetReaderPending) {
+    m_datasetReaderPending = false;
+    reader = MDEventDatasetReader::create(m_fileName, "/MDEventWorkspace/" + g_EventGroupName + "/event_data");
+    m_readCache.clear();
+    std::atomic_store(&m_datasetReader, reader);
+    return reader;
+  }
+  return std::atomic_load(&m_datasetReader);
+}
+
+/** Stop reading through the dataset reader until the file is flushed. Expects
+ * the file lock to be held. */
+void BoxControllerNeXusIO::invalidateDatasetReader() const {
+  m_datasetReaderPending = false;
+  std::atomic_store(&m_datasetReader, std::shared_ptr<const MDEventDatasetReader>());
+  m_readCache.clear();
+}
+
+/** Set the number of bytes of recently loaded event blocks which are kept in
+ * memory. The cache is emptied whenever the file is modified.
+ *@param cacheSize -- the cache size in bytes. 0 disables the cache */
+void BoxControllerNeXusIO::setReadCacheSize(const size_t cacheSize) { m_readCache.setCapacity(cacheSize); }
+
 /** Helper funcion which allows to convert one data fomat into another */
 template <typename FROM, typename TO> void convertFormats(const std::vector<FROM> &inData, std::vector<TO> &outData) {
   outData.reserve(inData.size());
@@ -554,6 +629,10 @@ void BoxControllerNeXusIO::loadBlock(std::vector<double> &Block, const uint64_t
 void BoxControllerNeXusIO::flushData() const {
   std::lock_guard<std::mutex> _lock(m_fileMutex);
   m_File->flush();
+  // everything written so far is now in the file: the next read may use a
+  // new dataset reader if there is none
+  if (!m_ReadOnly && !std::atomic_load(&m_datasetReader))
+    m_datasetReaderPending = true;
 }
 /** flush disk buffer data from memory and close underlying NeXus file*/
 void BoxControllerNeXusIO::closeFile() {
@@ -580,6 +659,7 @@ void BoxControllerNeXusIO::closeFile() {
     m_File->closeGroup(); // close workspace group
     m_File->close();      // close NeXus file
     m_File = nullptr;
+    invalidateDatasetReader();
   }
 }
 
@@ -18,6 +18,8 @@
 // qualifier applied to function type has no meaning; ignored
 #pragma warning(disable : 4180)
 #endif
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
 #include "tbb/parallel_sort.h"
 #ifdef _MSC_VER
 #pragma warning(default : 4180)
@@ -29,6 +31,7 @@
 #include <functional>
 #include <limits>
 #include <stdexcept>
+#include <type_traits>
 
 using std::ostream;
 using std::runtime_error;
@@ -83,6 +86,83 @@ public:
     return (tAtSample1 < tAtSample2);
   }
 };
+
+/// Below this many events a merge is not split between threads
+constexpr size_t MERGE_GRAIN_SIZE = 32768;
+
+/**
+ * Copy events into place, converting them to the type of the destination.
+ * Lists are only ever converted to a type with less information (see
+ * EventList::switchTo), so the other conversions cannot happen.
+ * @param source :: the events to copy
+ * @param out :: where to copy them to
+ */
+template <class T, class Source> void copyEventsInto(const std::vector<Source> &source, T *out) {
+  if constexpr (std::is_constructible<T, const Source &>::value) {
+    std::transform(source.cbegin(), source.cend(), out, [](const auto &event) { return T(event); });
+  } else {
+    throw std::logic_error("Cannot convert events to a type that holds more information.");
+  }
+}
+
+/**
+ * Merge the TOF sorted ranges [first1, last1) and [first2, last2) into out.
+ * The longer range is split at its middle and the other at the matching
+ * TOF, and the two halves are merged concurrently. Equal events from the
+ * first range come first, as with std::merge.
+ */
+template <class T> void parallelMerge(const T *first1, const T *last1, const T *first2, const T *last2, T *out) {
+  const auto size1 = static_cast<size_t>(last1 - first1);
+  const auto size2 = static_cast<size_t>(last2 - first2);
+  if (size1 + size2 < MERGE_GRAIN_SIZE) {
+    std::merge(first1, last1, first2, last2, out);
+    return;
+  }
+  const T *middle1, *middle2;
+  if (size1 >= size2) {
+    middle1 = first1 + size1 / 2;
+    middle2 = std::lower_bound(first2, last2, *middle1);
+  } else {
+    middle2 = first2 + size2 / 2;
+    middle1 = std::upper_bound(first1, last1, *middle2);
+  }
+  T *outMiddle = out + (middle1 - first1) + (middle2 - first2);
+  tbb::parallel_invoke([=] { parallelMerge(first1, middle1, first2, middle2, out); },
+                       [=] { parallelMerge(middle1, last1, middle2, last2, outMiddle); });
+}
+
+/**
+ * Merge adjacent TOF sorted runs of events, pairwise, until one run is left.
+ * @param events :: the events; sorted on output
+ * @param bounds :: the start of each run followed by the end of the last one
+ */
+template <class T> void mergeSortedRuns(std::vector<T> &events, std::vector<size_t> bounds) {
+  bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+  if (bounds.size() <= 2)
+    return;
+  std::vector<T> buffer(events.size());
+  T *source = events.data();
+  T *destination = buffer.data();
+  while (bounds.size() > 2) {
+    const size_t numPairs = (bounds.size() - 1) / 2;
+    tbb::parallel_for(size_t(0), numPairs, [&](const size_t pair) {
+      const size_t begin = bounds[2 * pair], middle = bounds[2 * pair + 1], end = bounds[2 * pair + 2];
+      parallelMerge(source + begin, source + middle, source + middle, source + end, destination + begin);
+    });
+    // An unpaired last run is carried over unchanged
+    if ((bounds.size() - 1) % 2 == 1)
+      std::copy(source + bounds[bounds.size() - 2], source + bounds.back(), destination + bounds[bounds.size() - 2]);
+    std::vector<size_t> merged;
+    for (size_t i = 0; i < bounds.size(); i += 2)
+      merged.emplace_back(bounds[i]);
+    if (merged.back() != bounds.back())
+      merged.emplace_back(bounds.back());
+    bounds.swap(merged);
+    std::swap(source, destination);
+  }
+  if (source != events.data())
+    events.swap(buffer);
+}
 } // namespace
 //==========================================================================
 /// --------------------- TofEvent Comparators
@@ -489,6 +569,90 @@ EventList &EventList::operator+=(const EventList &more_events) {
   return *this;
 }
 
+// --------------------------------------------------------------------------
+/** Append several event lists to this one.
+ * The result is the same as adding each list in turn with operator+=, but
+ * the events are only moved once: the list is resized to its final size up
+ * front and each input is copied into its own slice in parallel. If this
+ * list and all the inputs are sorted by TOF, the slices are then merged in
+ * parallel so that the result is also sorted by TOF.
+ *
+ * @param eventLists :: the event lists to append. They must not include this
+ *                      list.
+ * @return reference to this
+ * */
+EventList &EventList::addEventLists(const std::vector<const EventList *> &eventLists) {
+  // The type that adding the lists one at a time would end up with
+  EventType newType = this->eventType;
+  bool allSorted = (this->order == TOF_SORT || this->empty());
+  for (const auto *eventList : eventLists) {
+    if (eventList == this)
+      throw std::invalid_argument("EventList::addEventLists() cannot append an event list to itself");
+    newType = std::max(newType, eventList->getEventType());
+    allSorted = allSorted && (eventList->order == TOF_SORT || eventList->empty());
+  }
+
+  this->switchTo(newType);
+  switch (newType) {
+  case TOF:
+    addEventListsHelper(this->events, eventLists, allSorted);
+    break;
+  case WEIGHTED:
+    addEventListsHelper(this->weightedEvents, eventLists, allSorted);
+    break;
+  case WEIGHTED_NOTIME:
+    addEventListsHelper(this->weightedEventsNoTime, eventLists, allSorted);
+    break;
+  }
+
+  this->order = allSorted ? TOF_SORT : UNSORTED;
+  for (const auto *eventList : eventLists)
+    addDetectorIDs(eventList->getDetectorIDs());
+
+  return *this;
+}
+
+/** Copy the events of several event lists to the end of events, each into
+ * its own slice, in parallel.
+ *
+ * @param events :: the events being appended to
+ * @param eventLists :: the event lists to append
+ * @param mergeSorted :: if true, all the lists and events are sorted by TOF
+ *                       and the result is merged to keep it sorted
+ * */
+template <class T>
+void EventList::addEventListsHelper(std::vector<T> &events, const std::vector<const EventList *> &eventLists,
+                                    const bool mergeSorted) {
+  // Where each list starts in the output, followed by the end of the last
+  std::vector<size_t> bounds(1, events.size());
+  bounds.reserve(eventLists.size() + 1);
+  for (const auto *eventList : eventLists)
+    bounds.emplace_back(bounds.back() + eventList->getNumberEvents());
+  events.resize(bounds.back());
+
+  tbb::parallel_for(size_t(0), eventLists.size(), [&](const size_t i) {
+    const auto *eventList = eventLists[i];
+    T *out = events.data() + bounds[i];
+    switch (eventList->getEventType()) {
+    case TOF:
+      copyEventsInto(eventList->events, out);
+      break;
+    case WEIGHTED:
+      copyEventsInto(eventList->weightedEvents, out);
+      break;
+    case WEIGHTED_NOTIME:
+      copyEventsInto(eventList->weightedEventsNoTime, out);
+      break;
+    }
+  });
+
+  if (mergeSorted) {
+    // The events already in the list are the first run
+    bounds.insert(bounds.begin(), 0);
+    mergeSortedRuns(events, std::move(bounds));
+  }
+}
+
 // --------------------------------------------------------------------------
 /** SUBTRACT another EventList from this event list.
  * The event lists are concatenated, but the weights of the incoming
@@ -2889,6 +3053,92 @@ std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
   return times;
 }
 
+// --------------------------------------------------------------------------
+namespace {
+/// The weight and squared error of events without weights
+const float UNIT_WEIGHT = 1.0f;
+/// The pulse time of events without pulse times
+const int64_t NO_PULSE_TIME = 0;
+
+static_assert(sizeof(Mantid::Types::Core::DateAndTime) == sizeof(int64_t),
+              "DateAndTime must be stored as int64 nanoseconds for pulseTimeColumn()");
+
+/// A column made of one field of each of the events
+template <class T, class Owner, class Field>
+EventColumn makeColumn(const std::vector<T> &events, Field Owner::*field) {
+  return {events.empty() ? nullptr : &(events.front().*field), sizeof(T), events.size()};
+}
+
+/// A column giving the same value for each of the events
+template <class Field> EventColumn makeConstantColumn(const Field &value, const std::size_t size) {
+  return {&value, 0, size};
+}
+} // namespace
+
+/** Get the TOF of the events without copying them. The column holds doubles.
+ * @return a view of the TOF, valid until the list is modified
+ */
+EventColumn EventList::tofColumn() const {
+  switch (eventType) {
+  case TOF:
+    return makeColumn(events, &TofEvent::m_tof);
+  case WEIGHTED:
+    return makeColumn(weightedEvents, &WeightedEvent::m_tof);
+  case WEIGHTED_NOTIME:
+    return makeColumn(weightedEventsNoTime, &WeightedEventNoTime::m_tof);
+  }
+  throw std::runtime_error("EventList::tofColumn() called on an EventList of unknown type");
+}
+
+/** Get the pulse times of the events without copying them. The column holds
+ * int64 nanoseconds since the DateAndTime epoch. Events without pulse times
+ * report zero, as for getPulseTimes().
+ * @return a view of the pulse times, valid until the list is modified
+ */
+EventColumn EventList::pulseTimeColumn() const {
+  switch (eventType) {
+  case TOF:
+    return makeColumn(events, &TofEvent::m_pulsetime);
+  case WEIGHTED:
+    return makeColumn(weightedEvents, &WeightedEvent::m_pulsetime);
+  case WEIGHTED_NOTIME:
+    return makeConstantColumn(NO_PULSE_TIME, weightedEventsNoTime.size());
+  }
+  throw std::runtime_error("EventList::pulseTimeColumn() called on an EventList of unknown type");
+}
+
+/** Get the weights of the events without copying them. The column holds
+ * floats. Unweighted events report a weight of 1.
+ * @return a view of the weights, valid until the list is modified
+ */
+EventColumn EventList::weightColumn() const {
+  switch (eventType) {
+  case TOF:
+    return makeConstantColumn(UNIT_WEIGHT, events.size());
+  case WEIGHTED:
+    return makeColumn(weightedEvents, &WeightedEvent::m_weight);
+  case WEIGHTED_NOTIME:
+    return makeColumn(weightedEventsNoTime, &WeightedEventNoTime::m_weight);
+  }
+  throw std::runtime_error("EventList::weightColumn() called on an EventList of unknown type");
+}
+
+/** Get the squared errors of the weights of the events without copying them.
+ * The column holds floats. Unweighted events report 1.
+ * @return a view of the squared errors, valid until the list is modified
+ */
+EventColumn EventList::errorSquaredColumn() const {
+  switch (eventType) {
+  case TOF:
+    return makeConstantColumn(UNIT_WEIGHT, events.size());
+  case WEIGHTED:
+    return makeColumn(weightedEvents, &WeightedEvent::m_errorSquared);
+  case WEIGHTED_NOTIME:
+    return makeColumn(weightedEventsNoTime, &WeightedEventNoTime::m_errorSquared);
+  }
+  throw std::runtime_error("EventList::errorSquaredColumn() called on an EventList of unknown type");
+}
+
 // --------------------------------------------------------------------------
 /**
  * @return The minimum tof value for the list of the events.
@@ -17,6 +17,7 @@
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/FunctionTask.h"
@@ -483,14 +484,56 @@ size_t EventWorkspace::MRUSize() const { return mru->MRUSize(); }
 /** Clears the MRU lists */
 void EventWorkspace::clearMRU() const { mru->clear(); }
 
+/** Histogram in one parallel sweep all the spectra whose histogram is not
+ * cached yet, and keep the histograms until the spectrum or its binning
+ * changes, or clearMRU() is called. Later calls to y() and e() of any spectrum
+ * from any thread then use the cached data instead of histogramming it again.
+ *
+ * The memory used by the cache is limited by the
+ * EventWorkspace.HistogramCacheMB setting: spectra beyond the limit are left
+ * to the usual per-thread MRU lists.
+ * @return the number of spectra histogrammed
+ */
+size_t EventWorkspace::cacheHistograms() const {
+  const double limitMB =
+      ConfigService::Instance().getValue<double>("EventWorkspace.HistogramCacheMB").get_value_or(1024.);
+  const auto maxBins = static_cast<size_t>(limitMB * 1024. * 1024. / (2. * sizeof(double)));
+
+  std::vector<const EventList *> toHistogram;
+  size_t bins = 0;
+  for (const auto &eventList : data) {
+    bins += eventList->readX().size();
+    if (bins > maxBins)
+      break;
+    if (!mru->hasHistogram(eventList.get()))
+      toHistogram.emplace_back(eventList.get());
+  }
+
+  std::vector<EventWorkspaceMRU::YType> y(toHistogram.size());
+  std::vector<EventWorkspaceMRU::EType> e(toHistogram.size());
+  PARALLEL_FOR_IF(Kernel::threadSafe(*this))
+  for (int64_t i = 0; i < static_cast<int64_t>(toHistogram.size()); ++i) {
+    MantidVec Y;
+    MantidVec E;
+    toHistogram[i]->generateHistogram(toHistogram[i]->readX(), Y, E);
+    y[i] = Kernel::make_cow<HistogramData::HistogramY>(std::move(Y));
+    e[i] = Kernel::make_cow<HistogramData::HistogramE>(std::move(E));
+  }
+  mru->insertHistograms(toHistogram, y, e);
+  return toHistogram.size();
+}
+
 /// Returns the amount of memory used in bytes
 size_t EventWorkspace::getMemorySize() const {
-  // TODO: Add the MRU buffer
+  // TODO: Add the per-thread MRU buffers
 
   // Add the memory from all the event lists
   size_t total = std::accumulate(data.begin(), data.end(), size_t{0},
                                  [](size_t total, auto &list) { return total + list->getMemorySize(); });
 
+  // Histograms kept by cacheHistograms()
+  total += mru->getHistogramCacheMemorySize();
+
   total += run().getMemorySize();
 
   total += this->getMemorySizeForXAxes();
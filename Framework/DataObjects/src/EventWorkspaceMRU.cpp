@@ -61,6 +61,11 @@ void EventWorkspaceMRU::ensureEnoughBuffersY(size_t thread_num) const {
 //---------------------------------------------------------------------------
 /// Clear all the data in the MRU buffers
 void EventWorkspaceMRU::clear() {
+  {
+    Poco::ScopedWriteRWLock _lock(m_cachedHistogramsMutex);
+    m_cachedHistograms.clear();
+    m_hasCachedHistograms = false;
+  }
   {
     // Make sure you free up the memory in the MRUs
     Poco::ScopedWriteRWLock _lock(m_changeMruListsMutexY);
@@ -87,6 +92,12 @@ void EventWorkspaceMRU::clear() {
  * @return pointer to the TypeWithMarker that has the data; NULL if not found.
  */
 Kernel::cow_ptr<HistogramData::HistogramY> EventWorkspaceMRU::findY(size_t thread_num, const EventList *index) {
+  if (m_hasCachedHistograms) {
+    Poco::ScopedReadRWLock _lock(m_cachedHistogramsMutex);
+    const auto cached = m_cachedHistograms.find(index);
+    if (cached != m_cachedHistograms.end())
+      return cached->second.first;
+  }
   Poco::ScopedReadRWLock _lock(m_changeMruListsMutexY);
   auto result = m_bufferedDataY[thread_num]->find(reinterpret_cast<std::uintptr_t>(index));
   if (result)
@@ -101,6 +112,12 @@ Kernel::cow_ptr<HistogramData::HistogramY> EventWorkspaceMRU::findY(size_t threa
  * @return pointer to the TypeWithMarker that has the data; NULL if not found.
  */
 Kernel::cow_ptr<HistogramData::HistogramE> EventWorkspaceMRU::findE(size_t thread_num, const EventList *index) {
+  if (m_hasCachedHistograms) {
+    Poco::ScopedReadRWLock _lock(m_cachedHistogramsMutex);
+    const auto cached = m_cachedHistograms.find(index);
+    if (cached != m_cachedHistograms.end())
+      return cached->second.second;
+  }
   Poco::ScopedReadRWLock _lock(m_changeMruListsMutexE);
   auto result = m_bufferedDataE[thread_num]->find(reinterpret_cast<std::uintptr_t>(index));
   if (result)
@@ -136,11 +153,57 @@ void EventWorkspaceMRU::insertE(size_t thread_num, EType data, const EventList *
   // And clear up the memory of the old one, if it is dropping out.
 }
 
+/** Keep histograms generated for many spectra until the spectra change.
+ * They are found by all threads.
+ *
+ * @param indices :: the event lists the histograms belong to
+ * @param y :: the Y histograms, moved into the cache
+ * @param e :: the E histograms, moved into the cache
+ */
+void EventWorkspaceMRU::insertHistograms(const std::vector<const EventList *> &indices, std::vector<YType> &y,
+                                         std::vector<EType> &e) {
+  Poco::ScopedWriteRWLock _lock(m_cachedHistogramsMutex);
+  m_cachedHistograms.reserve(m_cachedHistograms.size() + indices.size());
+  for (size_t i = 0; i < indices.size(); ++i)
+    m_cachedHistograms[indices[i]] = std::make_pair(std::move(y[i]), std::move(e[i]));
+  m_hasCachedHistograms = !m_cachedHistograms.empty();
+}
+
+/** Check whether the histogram of an event list is held by insertHistograms()
+ *
+ * @param index :: the event list
+ * @return true if its histogram is cached
+ */
+bool EventWorkspaceMRU::hasHistogram(const EventList *index) const {
+  if (!m_hasCachedHistograms)
+    return false;
+  Poco::ScopedReadRWLock _lock(m_cachedHistogramsMutex);
+  return m_cachedHistograms.count(index) > 0;
+}
+
+/** Return the memory used by the histograms kept by insertHistograms()
+ *
+ * @return the size in bytes of their Y and E data
+ */
+size_t EventWorkspaceMRU::getHistogramCacheMemorySize() const {
+  if (!m_hasCachedHistograms)
+    return 0;
+  Poco::ScopedReadRWLock _lock(m_cachedHistogramsMutex);
+  size_t total = 0;
+  for (const auto &cached : m_cachedHistograms)
+    total += (cached.second.first->size() + cached.second.second->size()) * sizeof(double);
+  return total;
+}
+
 /** Delete any entries in the MRU at the given index
  *
  * @param index :: index to delete.
  */
 void EventWorkspaceMRU::deleteIndex(const EventList *index) {
+  if (m_hasCachedHistograms) {
+    Poco::ScopedWriteRWLock _lock(m_cachedHistogramsMutex);
+    m_cachedHistograms.erase(index);
+  }
   {
     Poco::ScopedReadRWLock _lock1(m_changeMruListsMutexE);
     for (auto &data : m_bufferedDataE) {
@@ -503,18 +503,74 @@ void normaliseOutput(const MatrixWorkspace_sptr &outputWS, const MatrixWorkspace
  */
 void rebinToOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
                    const size_t j, MatrixWorkspace &outputWS, const std::vector<double> &verticalAxis) {
+  BinContributions contributions;
+  rebinToOutput(inputQ, inputWS, i, j, outputWS.x(0).rawData(), verticalAxis, contributions);
+  addContributions(outputWS, contributions);
+}
+
+/**
+ * Find the contributions of the input quadrilateral to the output grid
+ * without touching the output workspace, so that the contributions of many
+ * input bins can be added with a single call to addContributions().
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be Clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The index in the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param X A vector containing the output horizontal axis bin boundaries
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ * @param contributions The contributions to the output bins are appended to
+ * this
+ */
+void rebinToOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                   const size_t j, const std::vector<double> &X, const std::vector<double> &verticalAxis,
+                   BinContributions &contributions) {
   const auto &inY = inputWS->y(i);
   // Check once whether the signal
   if (std::isnan(inY[j])) {
     return;
   }
 
-  const auto &X = outputWS.x(0).rawData();
   size_t qstart(0), qend(verticalAxis.size() - 1), x_start(0), x_end(X.size() - 1);
   if (!getIntersectionRegion(X, verticalAxis, inputQ, qstart, qend, x_start, x_end))
     return;
 
   const auto &inE = inputWS->e(i);
+  const bool isDistribution = inputWS->isDistribution();
+  // The intersection overlap algorithm is relatively costly. If the inputQ is
+  // rectangular, or trapezoidal when the overlap widths are not needed, and
+  // lies within the output grid the overlap areas can be calculated directly.
+  const QuadrilateralType inputQType = getQuadrilateralType(inputQ);
+  const bool insideGrid = inputQ.minX() >= X.front() && inputQ.maxX() <= X.back() &&
+                          inputQ.minY() >= verticalAxis.front() && inputQ.maxY() <= verticalAxis.back();
+  if (insideGrid && (inputQType == QuadrilateralType::Rectangle ||
+                     (inputQType == QuadrilateralType::TrapezoidY && !isDistribution))) {
+    std::vector<AreaInfo> areaInfos;
+    if (inputQType == QuadrilateralType::Rectangle) {
+      calcRectangleIntersections(X, verticalAxis, inputQ, qstart, qend, x_start, x_end, areaInfos);
+    } else {
+      calcTrapezoidYIntersections(X, verticalAxis, inputQ, qstart, qend, x_start, x_end, areaInfos);
+    }
+    const double inputQArea = inputQ.area();
+    for (const auto &ai : areaInfos) {
+      if (ai.weight == 0.) {
+        continue;
+      }
+      const double weight = ai.weight / inputQArea;
+      double yValue = inY[j] * weight;
+      double eValue = inE[j];
+      if (isDistribution) {
+        const double overlapWidth =
+            std::min(X[ai.binIndex + 1], inputQ.maxX()) - std::max(X[ai.binIndex], inputQ.minX());
+        yValue *= overlapWidth;
+        eValue *= overlapWidth;
+      }
+      contributions.push_back({ai.wsIndex, ai.binIndex, yValue, eValue * eValue * weight, 0.});
+    }
+    return;
+  }
+
   // It seems to be more efficient to construct this once and clear it before
   // each calculation in the loop
   ConvexPolygon intersectOverlap;
@@ -533,19 +589,13 @@ void rebinToOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr
         double yValue = inY[j];
         yValue *= weight;
         double eValue = inE[j];
-        if (inputWS->isDistribution()) {
+        if (isDistribution) {
           const double overlapWidth = intersectOverlap.maxX() - intersectOverlap.minX();
           yValue *= overlapWidth;
           eValue *= overlapWidth;
         }
         eValue = eValue * eValue * weight;
-        PARALLEL_CRITICAL(overlap_sum) {
-          // The mutable calls must be in the critical section
-          // so that any calls from omp sections can write to the
-          // output workspace safely
-          outputWS.mutableY(y)[xi] += yValue;
-          outputWS.mutableE(y)[xi] += eValue;
-        }
+        contributions.push_back({y, xi, yValue, eValue, 0.});
       }
     }
   }
@@ -571,6 +621,31 @@ void rebinToOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr
 void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
                              const size_t j, RebinnedOutput &outputWS, const std::vector<double> &verticalAxis,
                              const RebinnedOutput_const_sptr &inputRB) {
+  BinContributions contributions;
+  rebinToFractionalOutput(inputQ, inputWS, i, j, outputWS.x(0).rawData(), verticalAxis, contributions, inputRB);
+  addContributions(outputWS, contributions);
+}
+
+/**
+ * Find the contributions of the input quadrilateral to a fractional output
+ * grid without touching the output workspace, so that the contributions of
+ * many input bins can be added with a single call to addContributions().
+ * The quadrilateral must have a CLOCKWISE winding.
+ * @param inputQ The input polygon (Polygon winding must be clockwise)
+ * @param inputWS The input workspace containing the input intensity values
+ * @param i The index in the vertical axis direction that inputQ references
+ * @param j The index in the horizontal axis direction that inputQ references
+ * @param X A vector containing the output horizontal axis bin boundaries
+ * @param verticalAxis A vector containing the output vertical axis bin
+ * boundaries
+ * @param contributions The contributions to the output bins are appended to
+ * this. The variances are added to the errors of the output.
+ * @param inputRB A pointer, of RebinnedOutput type, to the input workspace.
+ * This can be null to indicate that the input was a standard 2D workspace.
+ */
+void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_const_sptr &inputWS, const size_t i,
+                             const size_t j, const std::vector<double> &X, const std::vector<double> &verticalAxis,
+                             BinContributions &contributions, const RebinnedOutput_const_sptr &inputRB) {
   const auto &inX = inputWS->binEdges(i);
   const auto &inY = inputWS->y(i);
   const auto &inE = inputWS->e(i);
@@ -578,7 +653,6 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_
   if (std::isnan(signal))
     return;
 
-  const auto &X = outputWS.x(0).rawData();
   size_t qstart(0), qend(verticalAxis.size() - 1), x_start(0), x_end(X.size() - 1);
   if (!getIntersectionRegion(X, verticalAxis, inputQ, qstart, qend, x_start, x_end))
     return;
@@ -633,13 +707,47 @@ void rebinToFractionalOutput(const Quadrilateral &inputQ, const MatrixWorkspace_
       continue;
     }
     const double weight = ai.weight / inputQArea;
-    PARALLEL_CRITICAL(overlap) {
-      // The mutable calls must be in the critical section
-      // so that any calls from omp sections can write to the
-      // output workspace safely
-      outputWS.mutableY(ai.wsIndex)[ai.binIndex] += signal * weight;
-      outputWS.mutableE(ai.wsIndex)[ai.binIndex] += variance * weight;
-      outputWS.dataF(ai.wsIndex)[ai.binIndex] += weight * inputWeight;
+    contributions.push_back({ai.wsIndex, ai.binIndex, signal * weight, variance * weight, weight * inputWeight});
+  }
+}
+
+/**
+ * Add the contributions found by rebinToOutput() to the output workspace.
+ * This may be called from several threads at once.
+ * @param outputWS The output workspace that accumulates the data
+ * @param contributions The contributions to add
+ */
+void addContributions(MatrixWorkspace &outputWS, const BinContributions &contributions) {
+  if (contributions.empty())
+    return;
+  PARALLEL_CRITICAL(overlap_sum) {
+    // The mutable calls must be in the critical section
+    // so that any calls from omp sections can write to the
+    // output workspace safely
+    for (const auto &contribution : contributions) {
+      outputWS.mutableY(contribution.wsIndex)[contribution.binIndex] += contribution.signal;
+      outputWS.mutableE(contribution.wsIndex)[contribution.binIndex] += contribution.variance;
+    }
+  }
+}
+
+/**
+ * Add the contributions found by rebinToFractionalOutput() to the output
+ * workspace. This may be called from several threads at once.
+ * @param outputWS The output workspace that accumulates the data
+ * @param contributions The contributions to add
+ */
+void addContributions(RebinnedOutput &outputWS, const BinContributions &contributions) {
+  if (contributions.empty())
+    return;
+  PARALLEL_CRITICAL(overlap) {
+    // The mutable calls must be in the critical section
+    // so that any calls from omp sections can write to the
+    // output workspace safely
+    for (const auto &contribution : contributions) {
+      outputWS.mutableY(contribution.wsIndex)[contribution.binIndex] += contribution.signal;
+      outputWS.mutableE(contribution.wsIndex)[contribution.binIndex] += contribution.variance;
+      outputWS.dataF(contribution.wsIndex)[contribution.binIndex] += contribution.fraction;
     }
   }
 }
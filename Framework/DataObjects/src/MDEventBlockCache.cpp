@@ -0,0 +1,98 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDEventBlockCache.h"
+
+namespace Mantid::DataObjects {
+
+/**
+ * @param capacity :: the maximum number of bytes to cache. A capacity of 0
+ * disables the cache
+ */
+MDEventBlockCache::MDEventBlockCache(size_t capacity) : m_capacity(capacity), m_size(0) {}
+
+/// Change the capacity in bytes, dropping blocks if the cache is too large
+void MDEventBlockCache::setCapacity(size_t capacity) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_capacity = capacity;
+  evict();
+}
+
+size_t MDEventBlockCache::capacity() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_capacity;
+}
+
+size_t MDEventBlockCache::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_size;
+}
+
+size_t MDEventBlockCache::numberOfBlocks() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+/**
+ * Look up a block and mark it as the most recently used one.
+ * @param blockPosition :: the position of the first event of the block
+ * @param nPoints :: the number of events in the block
+ * @return the cached block or an empty pointer if it is not in the cache
+ */
+MDEventBlockCache::Block MDEventBlockCache::find(uint64_t blockPosition, size_t nPoints) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_index.find(Key(blockPosition, nPoints));
+  if (it == m_index.end())
+    return Block();
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->block;
+}
+
+/**
+ * Add a block to the cache, replacing any block cached for the same range.
+ * Blocks larger than the capacity are not cached.
+ * @param blockPosition :: the position of the first event of the block
+ * @param nPoints :: the number of events in the block
+ * @param block :: the block data
+ */
+void MDEventBlockCache::insert(uint64_t blockPosition, size_t nPoints, Block block) {
+  if (!block)
+    return;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (block->size() > m_capacity)
+    return;
+  const Key key(blockPosition, nPoints);
+  auto it = m_index.find(key);
+  if (it != m_index.end()) {
+    m_size -= it->second->block->size();
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+  m_size += block->size();
+  m_entries.emplace_front(Entry{key, std::move(block)});
+  m_index.emplace(key, m_entries.begin());
+  evict();
+}
+
+/// Remove all blocks from the cache
+void MDEventBlockCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_size = 0;
+}
+
+/// Drop the least recently used blocks until the cache fits its capacity
+void MDEventBlockCache::evict() {
+  while (m_size > m_capacity && !m_entries.empty()) {
+    const auto &last = m_entries.back();
+    m_size -= last.block->size();
+    m_index.erase(last.key);
+    m_entries.pop_back();
+  }
+}
+
+} // namespace Mantid::DataObjects
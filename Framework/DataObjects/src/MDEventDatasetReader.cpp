@@ -0,0 +1,269 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDEventDatasetReader.h"
+#include "MantidKernel/Logger.h"
+
+#include <hdf5.h>
+
+#include <algorithm>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Mantid::DataObjects {
+
+namespace {
+/// static logger
+Kernel::Logger g_log("MDEventDatasetReader");
+
+/// Closes an HDF5 identifier when going out of scope
+class H5Id {
+public:
+  H5Id(hid_t id, herr_t (*closer)(hid_t)) : m_id(id), m_closer(closer) {}
+  ~H5Id() {
+    if (m_id >= 0)
+      m_closer(m_id);
+  }
+  H5Id(const H5Id &) = delete;
+  H5Id &operator=(const H5Id &) = delete;
+  operator hid_t() const { return m_id; }
+  bool valid() const { return m_id >= 0; }
+
+private:
+  hid_t m_id;
+  herr_t (*m_closer)(hid_t);
+};
+
+#if H5_VERSION_GE(1, 14, 0)
+/// Collects the file locations of the chunks visited by H5Dchunk_iter
+int addChunkExtent(const hsize_t *offset, unsigned /*filterMask*/, haddr_t address, hsize_t /*size*/, void *data) {
+  auto *extents = static_cast<std::vector<MDEventDatasetReader::Extent> *>(data);
+  extents->emplace_back(MDEventDatasetReader::Extent{offset[0], 0, address});
+  return H5_ITER_CONT;
+}
+#elif H5_VERSION_GE(1, 10, 5)
+/// Before H5Dchunk_iter was available every chunk lookup visits all the chunks
+/// preceding it, so only datasets with a modest number of chunks are indexed
+constexpr hsize_t MAX_CHUNKS_INDEXED = 2048;
+#endif
+
+/**
+ * Find the file location of every allocated chunk of a dataset.
+ * @param dataset :: the dataset
+ * @param dataSpace :: the dataspace of the dataset
+ * @param chunkRows :: the number of rows in a chunk
+ * @param nRows :: the number of rows in the dataset
+ * @param extents :: filled with the rows stored in each chunk, sorted by their
+ * first row. Unallocated chunks are left as gaps.
+ * @return false if the chunk locations can not be obtained
+ */
+bool chunkExtents(hid_t dataset, hid_t dataSpace, hsize_t chunkRows, uint64_t nRows,
+                  std::vector<MDEventDatasetReader::Extent> &extents) {
+#if H5_VERSION_GE(1, 14, 0)
+  UNUSED_ARG(dataSpace);
+  if (H5Dchunk_iter(dataset, H5P_DEFAULT, addChunkExtent, &extents) < 0)
+    return false;
+#elif H5_VERSION_GE(1, 10, 5)
+  hsize_t nChunks(0);
+  if (H5Dget_num_chunks(dataset, dataSpace, &nChunks) < 0 || nChunks > MAX_CHUNKS_INDEXED)
+    return false;
+  extents.reserve(nChunks);
+  for (hsize_t i = 0; i < nChunks; ++i) {
+    hsize_t offset[2];
+    unsigned filterMask(0);
+    haddr_t address(HADDR_UNDEF);
+    hsize_t size(0);
+    if (H5Dget_chunk_info(dataset, dataSpace, i, offset, &filterMask, &address, &size) < 0)
+      return false;
+    extents.emplace_back(MDEventDatasetReader::Extent{offset[0], 0, address});
+  }
+#else
+  UNUSED_ARG(dataset);
+  UNUSED_ARG(dataSpace);
+  return false;
+#endif
+  // chunks beyond the current extent of the dataset hold no rows
+  extents.erase(std::remove_if(extents.begin(), extents.end(),
+                               [nRows](const auto &extent) {
+                                 return extent.firstRow >= nRows || extent.fileOffset == HADDR_UNDEF;
+                               }),
+                extents.end());
+  for (auto &extent : extents)
+    extent.nRows = std::min<uint64_t>(chunkRows, nRows - extent.firstRow);
+  std::sort(extents.begin(), extents.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.firstRow < rhs.firstRow; });
+  return true;
+}
+} // namespace
+
+/**
+ * Inspect the layout of a dataset and create a reader for it.
+ * @param fileName :: full path to the HDF5 file
+ * @param datasetPath :: absolute path of the two dimensional dataset
+ * @return the reader, or nullptr if the dataset cannot be read directly
+ */
+std::unique_ptr<MDEventDatasetReader> MDEventDatasetReader::create(const std::string &fileName,
+                                                                   const std::string &datasetPath) {
+  // Do not let HDF5 print its error stack; a failure simply disables the
+  // direct read path
+  H5E_auto2_t errorFunction;
+  void *errorData;
+  H5Eget_auto2(H5E_DEFAULT, &errorFunction, &errorData);
+  H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+  struct RestoreErrorHandler {
+    H5E_auto2_t function;
+    void *data;
+    ~RestoreErrorHandler() { H5Eset_auto2(H5E_DEFAULT, function, data); }
+  } restoreErrorHandler{errorFunction, errorData};
+
+  // HDF5 refuses to open a file a second time with a different close degree
+  // and the NeXus API opens its files with H5F_CLOSE_STRONG. Closing this
+  // handle only closes the objects opened through it.
+  H5Id fileAccess(H5Pcreate(H5P_FILE_ACCESS), H5Pclose);
+  if (!fileAccess.valid() || H5Pset_fclose_degree(fileAccess, H5F_CLOSE_STRONG) < 0)
+    return nullptr;
+  H5Id file(H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, fileAccess), H5Fclose);
+  if (!file.valid())
+    return nullptr;
+  H5Id fileCreation(H5Fget_create_plist(file), H5Pclose);
+  hsize_t userBlock(0);
+  if (!fileCreation.valid() || H5Pget_userblock(fileCreation, &userBlock) < 0 || userBlock != 0)
+    return nullptr;
+
+  H5Id dataset(H5Dopen2(file, datasetPath.c_str(), H5P_DEFAULT), H5Dclose);
+  if (!dataset.valid())
+    return nullptr;
+
+  // native floating point values only, as they are copied without conversion
+  H5Id dataType(H5Dget_type(dataset), H5Tclose);
+  size_t elementSize(0);
+  if (H5Tequal(dataType, H5T_NATIVE_FLOAT) > 0)
+    elementSize = sizeof(float);
+  else if (H5Tequal(dataType, H5T_NATIVE_DOUBLE) > 0)
+    elementSize = sizeof(double);
+  else
+    return nullptr;
+
+  H5Id dataSpace(H5Dget_space(dataset), H5Sclose);
+  if (H5Sget_simple_extent_ndims(dataSpace) != 2)
+    return nullptr;
+  hsize_t dims[2];
+  H5Sget_simple_extent_dims(dataSpace, dims, nullptr);
+  const uint64_t nRows = dims[0];
+  const size_t nColumns = static_cast<size_t>(dims[1]);
+
+  H5Id creation(H5Dget_create_plist(dataset), H5Pclose);
+  if (H5Pget_nfilters(creation) != 0)
+    return nullptr;
+
+  std::vector<Extent> extents;
+  const auto layout = H5Pget_layout(creation);
+  if (layout == H5D_CONTIGUOUS) {
+    const haddr_t offset = H5Dget_offset(dataset);
+    if (offset == HADDR_UNDEF)
+      return nullptr;
+    extents.emplace_back(Extent{0, nRows, offset});
+  } else if (layout == H5D_CHUNKED) {
+    hsize_t chunkDims[2];
+    if (H5Pget_chunk(creation, 2, chunkDims) != 2 || chunkDims[1] != dims[1] ||
+        !chunkExtents(dataset, dataSpace, chunkDims[0], nRows, extents))
+      return nullptr;
+  } else {
+    return nullptr;
+  }
+
+  try {
+    return std::unique_ptr<MDEventDatasetReader>(
+        new MDEventDatasetReader(fileName, std::move(extents), elementSize, nColumns, nRows));
+  } catch (std::runtime_error &err) {
+    g_log.debug() << err.what() << '\n';
+    return nullptr;
+  }
+}
+
+MDEventDatasetReader::MDEventDatasetReader(const std::string &fileName, std::vector<Extent> extents,
+                                           size_t elementSize, size_t nColumns, uint64_t nRows)
+    : m_extents(std::move(extents)), m_elementSize(elementSize), m_nColumns(nColumns), m_nRows(nRows) {
+#ifdef _WIN32
+  m_stream.open(fileName, std::ios::binary);
+  if (!m_stream)
+    throw std::runtime_error("MDEventDatasetReader: can not open " + fileName);
+#else
+  m_fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+  if (m_fileDescriptor < 0)
+    throw std::runtime_error("MDEventDatasetReader: can not open " + fileName);
+#endif
+}
+
+MDEventDatasetReader::~MDEventDatasetReader() {
+#ifndef _WIN32
+  ::close(m_fileDescriptor);
+#endif
+}
+
+/**
+ * Read a range of rows. Safe to call from several threads at once.
+ * @param firstRow :: the first row to read
+ * @param nRows :: the number of rows to read
+ * @param destination :: memory for nRows * numberOfColumns() values
+ * @return false if the rows are not stored in the file, e.g. they were never
+ * written, in which case the destination content is undefined
+ */
+bool MDEventDatasetReader::readRows(uint64_t firstRow, size_t nRows, void *destination) const {
+  if (firstRow + nRows > m_nRows)
+    return false;
+  const size_t rowSize = m_nColumns * m_elementSize;
+  auto *output = static_cast<char *>(destination);
+  // the last extent starting at or before the first row
+  auto extent = std::upper_bound(m_extents.cbegin(), m_extents.cend(), firstRow,
+                                 [](const uint64_t row, const Extent &ext) { return row < ext.firstRow; });
+  uint64_t row = firstRow;
+  const uint64_t endRow = firstRow + nRows;
+  while (row < endRow) {
+    if (extent == m_extents.cbegin())
+      return false;
+    const auto &current = *(extent - 1);
+    if (row < current.firstRow || row >= current.firstRow + current.nRows)
+      return false; // a gap, e.g. an unallocated chunk
+    const uint64_t rowsToRead = std::min(endRow, current.firstRow + current.nRows) - row;
+    const uint64_t offset = current.fileOffset + (row - current.firstRow) * rowSize;
+    if (!readBytes(offset, static_cast<size_t>(rowsToRead * rowSize), output))
+      return false;
+    output += rowsToRead * rowSize;
+    row += rowsToRead;
+    ++extent;
+  }
+  return true;
+}
+
+/// Positional read of a number of bytes from the file
+bool MDEventDatasetReader::readBytes(uint64_t fileOffset, size_t nBytes, char *destination) const {
+#ifdef _WIN32
+  std::lock_guard<std::mutex> lock(m_streamMutex);
+  m_stream.clear();
+  m_stream.seekg(static_cast<std::streamoff>(fileOffset));
+  m_stream.read(destination, static_cast<std::streamsize>(nBytes));
+  return static_cast<bool>(m_stream);
+#else
+  while (nBytes > 0) {
+    const auto nRead = ::pread(m_fileDescriptor, destination, nBytes, static_cast<off_t>(fileOffset));
+    if (nRead < 0 && errno == EINTR)
+      continue;
+    if (nRead <= 0)
+      return false;
+    destination += nRead;
+    fileOffset += static_cast<uint64_t>(nRead);
+    nBytes -= static_cast<size_t>(nRead);
+  }
+  return true;
+#endif
+}
+
+} // namespace Mantid::DataObjects
@@ -8,6 +8,7 @@
 #include "MantidAPI/IMDIterator.h"
 #include "MantidAPI/IMDWorkspace.h"
 #include "MantidDataObjects/MDFramesToSpecialCoordinateSystem.h"
+#include "MantidDataObjects/MDHistoWorkspaceExpression.h"
 #include "MantidDataObjects/MDHistoWorkspaceIterator.h"
 #include "MantidGeometry/MDGeometry/IMDDimension.h"
 #include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
@@ -716,15 +717,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator+=(const MDHistoWorkspace &b) {
  *
  * @param b :: workspace on the RHS of the operation
  * */
-void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
-  checkWorkspaceSize(b, "add");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] += b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
-  }
-  m_nEventsContributed += b.m_nEventsContributed;
-}
+void MDHistoWorkspace::add(const MDHistoWorkspace &b) { MDHistoWorkspaceExpression().add(b).evaluate(*this); }
 
 //----------------------------------------------------------------------------------------------
 /** Perform the += operation with a scalar as the RHS argument
@@ -733,11 +726,7 @@ void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
  * @param error :: error (not squared) to apply
  * */
 void MDHistoWorkspace::add(const signal_t signal, const signal_t error) {
-  signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] += signal;
-    m_errorsSquared[i] += errorSquared;
-  }
+  MDHistoWorkspaceExpression().add(signal, error).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -755,15 +744,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator-=(const MDHistoWorkspace &b) {
  *
  * @param b :: workspace on the RHS of the operation
  * */
-void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
-  checkWorkspaceSize(b, "subtract");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] -= b.m_signals[i];
-    m_errorsSquared[i] += b.m_errorsSquared[i];
-    m_numEvents[i] += b.m_numEvents[i];
-  }
-  m_nEventsContributed += b.m_nEventsContributed;
-}
+void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) { MDHistoWorkspaceExpression().subtract(b).evaluate(*this); }
 
 //----------------------------------------------------------------------------------------------
 /** Perform the -= operation with a scalar as the RHS argument
@@ -772,11 +753,7 @@ void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
  * @param error :: error (not squared) to apply
  * */
 void MDHistoWorkspace::subtract(const signal_t signal, const signal_t error) {
-  signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] -= signal;
-    m_errorsSquared[i] += errorSquared;
-  }
+  MDHistoWorkspaceExpression().subtract(signal, error).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -804,20 +781,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator*=(const MDHistoWorkspace &b_ws) {
  * @param b_ws :: workspace on the RHS of the operation
  * */
 void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
-  checkWorkspaceSize(b_ws, "multiply");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t b = b_ws.m_signals[i];
-    signal_t db2 = b_ws.m_errorsSquared[i];
-
-    signal_t f = a * b;
-    signal_t df2 = da2 * b * b + db2 * a * a;
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+  MDHistoWorkspaceExpression().multiply(b_ws).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -833,19 +797,7 @@ void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
  * @param error :: error (not squared) to apply
  * @return *this after operation */
 void MDHistoWorkspace::multiply(const signal_t signal, const signal_t error) {
-  signal_t b = signal;
-  signal_t db2 = error * error;
-
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t f = a * b;
-    signal_t df2 = da2 * b * b + db2 * a * a;
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+  MDHistoWorkspaceExpression().multiply(signal, error).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -873,20 +825,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator/=(const MDHistoWorkspace &b_ws) {
  * @param b_ws :: workspace on the RHS of the operation
  **/
 void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
-  checkWorkspaceSize(b_ws, "divide");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t b = b_ws.m_signals[i];
-    signal_t db2 = b_ws.m_errorsSquared[i];
-
-    signal_t f = a / b;
-    signal_t df2 = da2 / (b * b) + db2 * f * f / (b * b);
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+  MDHistoWorkspaceExpression().divide(b_ws).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -902,19 +841,7 @@ void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
  * @param error :: error (not squared) to apply
  **/
 void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
-  signal_t b = signal;
-  signal_t db2 = error * error;
-  signal_t db2_relative = db2 / (b * b);
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-
-    signal_t f = a / b;
-    signal_t df2 = da2 / (b * b) + db2_relative * f * f;
-
-    m_signals[i] = f;
-    m_errorsSquared[i] = df2;
-  }
+  MDHistoWorkspaceExpression().divide(signal, error).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -923,19 +850,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
  * Error propagation of \f$ f = ln(a) \f$  is given by:
  * \f$ df^2 = a^2 / da^2 \f$
  */
-void MDHistoWorkspace::log(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-    if (a <= 0) {
-      m_signals[i] = filler;
-      m_errorsSquared[i] = 0;
-    } else {
-      m_signals[i] = std::log(a);
-      m_errorsSquared[i] = da2 / (a * a);
-    }
-  }
-}
+void MDHistoWorkspace::log(double filler) { MDHistoWorkspaceExpression().log(filler).evaluate(*this); }
 
 //----------------------------------------------------------------------------------------------
 /** Perform the base-10 logarithm on each signal in the workspace.
@@ -943,19 +858,7 @@ void MDHistoWorkspace::log(double filler) {
  * Error propagation of \f$ f = ln(a) \f$  is given by:
  * \f$ df^2 = (ln(10)^-2) * a^2 / da^2 \f$
  */
-void MDHistoWorkspace::log10(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t da2 = m_errorsSquared[i];
-    if (a <= 0) {
-      m_signals[i] = filler;
-      m_errorsSquared[i] = 0;
-    } else {
-      m_signals[i] = std::log10(a);
-      m_errorsSquared[i] = 0.1886117 * da2 / (a * a); // 0.1886117  = ln(10)^-2
-    }
-  }
-}
+void MDHistoWorkspace::log10(double filler) { MDHistoWorkspaceExpression().log10(filler).evaluate(*this); }
 
 //----------------------------------------------------------------------------------------------
 /** Perform the exp() function on each signal in the workspace.
@@ -963,14 +866,7 @@ void MDHistoWorkspace::log10(double filler) {
  * Error propagation of \f$ f = exp(a) \f$  is given by:
  * \f$ df^2 = f^2 * da^2 \f$
  */
-void MDHistoWorkspace::exp() {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t f = std::exp(m_signals[i]);
-    signal_t da2 = m_errorsSquared[i];
-    m_signals[i] = f;
-    m_errorsSquared[i] = f * f * da2;
-  }
-}
+void MDHistoWorkspace::exp() { MDHistoWorkspaceExpression().exp().evaluate(*this); }
 
 //----------------------------------------------------------------------------------------------
 /** Perform the power function (signal^exponent) on each signal S in the
@@ -979,16 +875,7 @@ void MDHistoWorkspace::exp() {
  * Error propagation of \f$ f = a^b \f$  is given by:
  * \f$ df^2 = f^2 * b^2 * (da^2 / a^2) \f$
  */
-void MDHistoWorkspace::power(double exponent) {
-  double exponent_squared = exponent * exponent;
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t a = m_signals[i];
-    signal_t f = std::pow(a, exponent);
-    signal_t da2 = m_errorsSquared[i];
-    m_signals[i] = f;
-    m_errorsSquared[i] = f * f * exponent_squared * da2 / (a * a);
-  }
-}
+void MDHistoWorkspace::power(double exponent) { MDHistoWorkspaceExpression().power(exponent).evaluate(*this); }
 
 //==============================================================================================
 //============================== BOOLEAN OPERATIONS
@@ -1005,11 +892,7 @@ void MDHistoWorkspace::power(double exponent) {
  * @param b :: workspace on the RHS of the operation
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
-  checkWorkspaceSize(b, "&= (and)");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) && (b.m_signals[i] != 0 && !b.m_masks[i])) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  MDHistoWorkspaceExpression().operatorAnd(b).evaluate(*this);
   return *this;
 }
 /// @endcond DOXYGEN_BUG
@@ -1022,11 +905,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
  * @param b :: workspace on the RHS of the operation
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
-  checkWorkspaceSize(b, "|= (or)");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) || (b.m_signals[i] != 0 && !b.m_masks[i])) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  MDHistoWorkspaceExpression().operatorOr(b).evaluate(*this);
   return *this;
 }
 
@@ -1039,11 +918,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
  * @param b :: workspace on the RHS of the operation
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
-  checkWorkspaceSize(b, "^= (xor)");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) ^ (b.m_signals[i] != 0 && !b.m_masks[i])) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  MDHistoWorkspaceExpression().operatorXor(b).evaluate(*this);
   return *this;
 }
 
@@ -1053,12 +928,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
  *
  * 0.0 is "false", all other values are "true". All errors are set to 0.
  */
-void MDHistoWorkspace::operatorNot() {
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] == 0.0 || m_masks[i]);
-    m_errorsSquared[i] = 0;
-  }
-}
+void MDHistoWorkspace::operatorNot() { MDHistoWorkspaceExpression().operatorNot().evaluate(*this); }
 
 //----------------------------------------------------------------------------------------------
 /** Turn this workspace into a boolean workspace, where
@@ -1068,13 +938,7 @@ void MDHistoWorkspace::operatorNot() {
  *
  * @param b :: workspace on the RHS of the comparison.
  */
-void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
-  checkWorkspaceSize(b, "lessThan");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] < b.m_signals[i]) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
-}
+void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) { MDHistoWorkspaceExpression().lessThan(b).evaluate(*this); }
 
 //----------------------------------------------------------------------------------------------
 /** Turn this workspace into a boolean workspace, where
@@ -1085,10 +949,7 @@ void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::lessThan(const signal_t signal) {
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] < signal) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  MDHistoWorkspaceExpression().lessThan(signal).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1100,11 +961,7 @@ void MDHistoWorkspace::lessThan(const signal_t signal) {
  * @param b :: workspace on the RHS of the comparison.
  */
 void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
-  checkWorkspaceSize(b, "greaterThan");
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] > b.m_signals[i]) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  MDHistoWorkspaceExpression().greaterThan(b).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1116,10 +973,7 @@ void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::greaterThan(const signal_t signal) {
-  for (size_t i = 0; i < m_length; ++i) {
-    m_signals[i] = (m_signals[i] > signal) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  MDHistoWorkspaceExpression().greaterThan(signal).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1132,12 +986,7 @@ void MDHistoWorkspace::greaterThan(const signal_t signal) {
  * @param tolerance :: accept this deviation from a perfect equality
  */
 void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b, const signal_t tolerance) {
-  checkWorkspaceSize(b, "equalTo");
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t diff = fabs(m_signals[i] - b.m_signals[i]);
-    m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  MDHistoWorkspaceExpression().equalTo(b, tolerance).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1150,11 +999,7 @@ void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b, const signal_t toleran
  * @param tolerance :: accept this deviation from a perfect equality
  */
 void MDHistoWorkspace::equalTo(const signal_t signal, const signal_t tolerance) {
-  for (size_t i = 0; i < m_length; ++i) {
-    signal_t diff = fabs(m_signals[i] - signal);
-    m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
-    m_errorsSquared[i] = 0;
-  }
+  MDHistoWorkspaceExpression().equalTo(signal, tolerance).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1174,14 +1019,7 @@ void MDHistoWorkspace::equalTo(const signal_t signal, const signal_t tolerance)
  * @param values :: MDHistoWorkspace of values to copy.
  */
 void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask, const MDHistoWorkspace &values) {
-  checkWorkspaceSize(mask, "setUsingMask");
-  checkWorkspaceSize(values, "setUsingMask");
-  for (size_t i = 0; i < m_length; ++i) {
-    if (mask.m_signals[i] != 0.0) {
-      m_signals[i] = values.m_signals[i];
-      m_errorsSquared[i] = values.m_errorsSquared[i];
-    }
-  }
+  MDHistoWorkspaceExpression().setUsingMask(mask, values).evaluate(*this);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1202,14 +1040,7 @@ void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask, const MDHistoW
  * @param error :: error (not squared) to set everywhere mask is true
  */
 void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask, const signal_t signal, const signal_t error) {
-  signal_t errorSquared = error * error;
-  checkWorkspaceSize(mask, "setUsingMask");
-  for (size_t i = 0; i < m_length; ++i) {
-    if (mask.m_signals[i] != 0.0) {
-      m_signals[i] = signal;
-      m_errorsSquared[i] = errorSquared;
-    }
-  }
+  MDHistoWorkspaceExpression().setUsingMask(mask, signal, error).evaluate(*this);
 }
 
 /**
@@ -0,0 +1,387 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MDHistoWorkspaceExpression.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Mantid::DataObjects {
+
+/// Append a step to the chain
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::addStep(Operation operation, const char *name,
+                                                                const MDHistoWorkspace *operand, signal_t signal,
+                                                                signal_t errorSquared, double parameter,
+                                                                const MDHistoWorkspace *mask) {
+  m_steps.emplace_back(Step{operation, name, operand, mask, signal, errorSquared, parameter});
+  return *this;
+}
+
+/// Add a workspace, element-by-element. @see MDHistoWorkspace::add
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::add(const MDHistoWorkspace &b) {
+  return addStep(Operation::Add, "add", &b);
+}
+
+/// Add a scalar; the error is not squared. @see MDHistoWorkspace::add
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::add(const signal_t signal, const signal_t error) {
+  return addStep(Operation::Add, "add", nullptr, signal, error * error);
+}
+
+/// Subtract a workspace, element-by-element. @see MDHistoWorkspace::subtract
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::subtract(const MDHistoWorkspace &b) {
+  return addStep(Operation::Subtract, "subtract", &b);
+}
+
+/// Subtract a scalar; the error is not squared. @see MDHistoWorkspace::subtract
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::subtract(const signal_t signal, const signal_t error) {
+  return addStep(Operation::Subtract, "subtract", nullptr, signal, error * error);
+}
+
+/// Multiply by a workspace, element-by-element. @see MDHistoWorkspace::multiply
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::multiply(const MDHistoWorkspace &b) {
+  return addStep(Operation::Multiply, "multiply", &b);
+}
+
+/// Multiply by a scalar; the error is not squared. @see MDHistoWorkspace::multiply
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::multiply(const signal_t signal, const signal_t error) {
+  return addStep(Operation::Multiply, "multiply", nullptr, signal, error * error);
+}
+
+/// Divide by a workspace, element-by-element. @see MDHistoWorkspace::divide
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::divide(const MDHistoWorkspace &b) {
+  return addStep(Operation::Divide, "divide", &b);
+}
+
+/// Divide by a scalar; the error is not squared. @see MDHistoWorkspace::divide
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::divide(const signal_t signal, const signal_t error) {
+  return addStep(Operation::Divide, "divide", nullptr, signal, error * error);
+}
+
+/// Natural logarithm, using filler where the signal is <= 0. @see MDHistoWorkspace::log
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::log(double filler) {
+  return addStep(Operation::Log, "log", nullptr, 0, 0, filler);
+}
+
+/// Base-10 logarithm, using filler where the signal is <= 0. @see MDHistoWorkspace::log10
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::log10(double filler) {
+  return addStep(Operation::Log10, "log10", nullptr, 0, 0, filler);
+}
+
+/// Exponential. @see MDHistoWorkspace::exp
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::exp() { return addStep(Operation::Exp, "exp", nullptr); }
+
+/// Raise the signal to a power. @see MDHistoWorkspace::power
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::power(double exponent) {
+  return addStep(Operation::Power, "power", nullptr, 0, 0, exponent);
+}
+
+/// Boolean and with a workspace. @see MDHistoWorkspace::operator&=
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::operatorAnd(const MDHistoWorkspace &b) {
+  return addStep(Operation::And, "&= (and)", &b);
+}
+
+/// Boolean or with a workspace. @see MDHistoWorkspace::operator|=
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::operatorOr(const MDHistoWorkspace &b) {
+  return addStep(Operation::Or, "|= (or)", &b);
+}
+
+/// Boolean xor with a workspace. @see MDHistoWorkspace::operator^=
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::operatorXor(const MDHistoWorkspace &b) {
+  return addStep(Operation::Xor, "^= (xor)", &b);
+}
+
+/// Boolean not. @see MDHistoWorkspace::operatorNot
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::operatorNot() {
+  return addStep(Operation::Not, "not", nullptr);
+}
+
+/// Compare with a workspace, element-by-element. @see MDHistoWorkspace::lessThan
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::lessThan(const MDHistoWorkspace &b) {
+  return addStep(Operation::LessThan, "lessThan", &b);
+}
+
+/// Compare with a scalar. @see MDHistoWorkspace::lessThan
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::lessThan(const signal_t signal) {
+  return addStep(Operation::LessThan, "lessThan", nullptr, signal);
+}
+
+/// Compare with a workspace, element-by-element. @see MDHistoWorkspace::greaterThan
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::greaterThan(const MDHistoWorkspace &b) {
+  return addStep(Operation::GreaterThan, "greaterThan", &b);
+}
+
+/// Compare with a scalar. @see MDHistoWorkspace::greaterThan
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::greaterThan(const signal_t signal) {
+  return addStep(Operation::GreaterThan, "greaterThan", nullptr, signal);
+}
+
+/// Compare with a workspace, element-by-element. @see MDHistoWorkspace::equalTo
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::equalTo(const MDHistoWorkspace &b, const signal_t tolerance) {
+  return addStep(Operation::EqualTo, "equalTo", &b, 0, 0, tolerance);
+}
+
+/// Compare with a scalar. @see MDHistoWorkspace::equalTo
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::equalTo(const signal_t signal, const signal_t tolerance) {
+  return addStep(Operation::EqualTo, "equalTo", nullptr, signal, 0, tolerance);
+}
+
+/// Copy the values of a workspace where the mask is non-zero. @see MDHistoWorkspace::setUsingMask
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::setUsingMask(const MDHistoWorkspace &mask,
+                                                                     const MDHistoWorkspace &values) {
+  return addStep(Operation::SetUsingMask, "setUsingMask", &values, 0, 0, 0, &mask);
+}
+
+/// Set a value where the mask is non-zero; the error is not squared. @see MDHistoWorkspace::setUsingMask
+MDHistoWorkspaceExpression &MDHistoWorkspaceExpression::setUsingMask(const MDHistoWorkspace &mask,
+                                                                     const signal_t signal, const signal_t error) {
+  return addStep(Operation::SetUsingMask, "setUsingMask", nullptr, signal, error * error, 0, &mask);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Apply all the steps, in order, to a workspace.
+ *
+ * @param ws :: the workspace holding the initial value, overwritten by the result
+ * @throw std::invalid_argument if an operand does not have the size of ws. The
+ * workspace is not modified in that case.
+ */
+void MDHistoWorkspaceExpression::evaluate(MDHistoWorkspace &ws) const {
+  // Check everything before touching the data so a bad operand leaves the
+  // workspace unchanged
+  for (const auto &step : m_steps) {
+    if (step.mask)
+      ws.checkWorkspaceSize(*step.mask, step.name);
+    if (step.operand)
+      ws.checkWorkspaceSize(*step.operand, step.name);
+  }
+  if (m_steps.empty())
+    return;
+
+  const auto nBlocks = static_cast<int64_t>((ws.m_length + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  PARALLEL_FOR_IF(nBlocks > 1)
+  for (int64_t block = 0; block < nBlocks; ++block) {
+    const size_t begin = static_cast<size_t>(block) * BLOCK_SIZE;
+    const size_t end = std::min(begin + BLOCK_SIZE, ws.m_length);
+    for (const auto &step : m_steps)
+      applyStep(step, ws, begin, end);
+  }
+
+  // The number of contributing events only changes through addition and
+  // subtraction of workspaces, in the same way as for the single operations
+  for (const auto &step : m_steps) {
+    if (step.operand && (step.operation == Operation::Add || step.operation == Operation::Subtract))
+      ws.m_nEventsContributed += step.operand->m_nEventsContributed;
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Apply one step to a range of bins. Every case is a simple loop over
+ * contiguous arrays so that the compiler can vectorise it.
+ *
+ * @param step :: the step to apply
+ * @param ws :: the workspace holding the running value
+ * @param begin :: the first bin
+ * @param end :: one past the last bin
+ */
+void MDHistoWorkspaceExpression::applyStep(const Step &step, MDHistoWorkspace &ws, size_t begin, size_t end) {
+  signal_t *signals = ws.m_signals.data();
+  signal_t *errorsSquared = ws.m_errorsSquared.data();
+  const bool *masks = ws.m_masks.get();
+
+  const signal_t *bSignals = step.operand ? step.operand->m_signals.data() : nullptr;
+  const signal_t *bErrorsSquared = step.operand ? step.operand->m_errorsSquared.data() : nullptr;
+  const signal_t b = step.signal;
+  const signal_t db2 = step.errorSquared;
+
+  switch (step.operation) {
+  case Operation::Add:
+    if (bSignals) {
+      signal_t *numEvents = ws.m_numEvents.data();
+      const signal_t *bNumEvents = step.operand->m_numEvents.data();
+      for (size_t i = begin; i < end; ++i) {
+        signals[i] += bSignals[i];
+        errorsSquared[i] += bErrorsSquared[i];
+        numEvents[i] += bNumEvents[i];
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        signals[i] += b;
+        errorsSquared[i] += db2;
+      }
+    }
+    break;
+  case Operation::Subtract:
+    if (bSignals) {
+      signal_t *numEvents = ws.m_numEvents.data();
+      const signal_t *bNumEvents = step.operand->m_numEvents.data();
+      for (size_t i = begin; i < end; ++i) {
+        signals[i] -= bSignals[i];
+        errorsSquared[i] += bErrorsSquared[i];
+        numEvents[i] += bNumEvents[i];
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        signals[i] -= b;
+        errorsSquared[i] += db2;
+      }
+    }
+    break;
+  case Operation::Multiply:
+    // df^2 = b^2 da^2 + a^2 db^2
+    if (bSignals) {
+      for (size_t i = begin; i < end; ++i) {
+        const signal_t a = signals[i];
+        const signal_t bi = bSignals[i];
+        signals[i] = a * bi;
+        errorsSquared[i] = errorsSquared[i] * bi * bi + bErrorsSquared[i] * a * a;
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        const signal_t a = signals[i];
+        signals[i] = a * b;
+        errorsSquared[i] = errorsSquared[i] * b * b + db2 * a * a;
+      }
+    }
+    break;
+  case Operation::Divide:
+    // df^2 = da^2 / b^2 + db^2 f^2 / b^2
+    if (bSignals) {
+      for (size_t i = begin; i < end; ++i) {
+        const signal_t bi = bSignals[i];
+        const signal_t f = signals[i] / bi;
+        signals[i] = f;
+        errorsSquared[i] = errorsSquared[i] / (bi * bi) + bErrorsSquared[i] * f * f / (bi * bi);
+      }
+    } else {
+      const signal_t db2Relative = db2 / (b * b);
+      for (size_t i = begin; i < end; ++i) {
+        const signal_t f = signals[i] / b;
+        signals[i] = f;
+        errorsSquared[i] = errorsSquared[i] / (b * b) + db2Relative * f * f;
+      }
+    }
+    break;
+  case Operation::Log:
+  case Operation::Log10: {
+    const bool natural = step.operation == Operation::Log;
+    // 0.1886117 = ln(10)^-2
+    const signal_t errorScale = natural ? 1.0 : 0.1886117;
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t a = signals[i];
+      if (a <= 0) {
+        signals[i] = step.parameter;
+        errorsSquared[i] = 0;
+      } else {
+        signals[i] = natural ? std::log(a) : std::log10(a);
+        errorsSquared[i] = errorScale * errorsSquared[i] / (a * a);
+      }
+    }
+    break;
+  }
+  case Operation::Exp:
+    // df^2 = f^2 da^2
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t f = std::exp(signals[i]);
+      signals[i] = f;
+      errorsSquared[i] = f * f * errorsSquared[i];
+    }
+    break;
+  case Operation::Power: {
+    // df^2 = f^2 * p^2 * (da^2 / a^2)
+    const double exponent = step.parameter;
+    const double exponentSquared = exponent * exponent;
+    for (size_t i = begin; i < end; ++i) {
+      const signal_t a = signals[i];
+      const signal_t f = std::pow(a, exponent);
+      signals[i] = f;
+      errorsSquared[i] = f * f * exponentSquared * errorsSquared[i] / (a * a);
+    }
+    break;
+  }
+  case Operation::And: {
+    const bool *bMasks = step.operand->m_masks.get();
+    for (size_t i = begin; i < end; ++i) {
+      signals[i] = ((signals[i] != 0 && !masks[i]) && (bSignals[i] != 0 && !bMasks[i])) ? 1.0 : 0.0;
+      errorsSquared[i] = 0;
+    }
+    break;
+  }
+  case Operation::Or: {
+    const bool *bMasks = step.operand->m_masks.get();
+    for (size_t i = begin; i < end; ++i) {
+      signals[i] = ((signals[i] != 0 && !masks[i]) || (bSignals[i] != 0 && !bMasks[i])) ? 1.0 : 0.0;
+      errorsSquared[i] = 0;
+    }
+    break;
+  }
+  case Operation::Xor: {
+    const bool *bMasks = step.operand->m_masks.get();
+    for (size_t i = begin; i < end; ++i) {
+      signals[i] = ((signals[i] != 0 && !masks[i]) ^ (bSignals[i] != 0 && !bMasks[i])) ? 1.0 : 0.0;
+      errorsSquared[i] = 0;
+    }
+    break;
+  }
+  case Operation::Not:
+    for (size_t i = begin; i < end; ++i) {
+      signals[i] = (signals[i] == 0.0 || masks[i]);
+      errorsSquared[i] = 0;
+    }
+    break;
+  case Operation::LessThan:
+    if (bSignals) {
+      for (size_t i = begin; i < end; ++i)
+        signals[i] = (signals[i] < bSignals[i]) ? 1.0 : 0.0;
+    } else {
+      for (size_t i = begin; i < end; ++i)
+        signals[i] = (signals[i] < b) ? 1.0 : 0.0;
+    }
+    std::fill(errorsSquared + begin, errorsSquared + end, 0.0);
+    break;
+  case Operation::GreaterThan:
+    if (bSignals) {
+      for (size_t i = begin; i < end; ++i)
+        signals[i] = (signals[i] > bSignals[i]) ? 1.0 : 0.0;
+    } else {
+      for (size_t i = begin; i < end; ++i)
+        signals[i] = (signals[i] > b) ? 1.0 : 0.0;
+    }
+    std::fill(errorsSquared + begin, errorsSquared + end, 0.0);
+    break;
+  case Operation::EqualTo: {
+    const signal_t tolerance = step.parameter;
+    if (bSignals) {
+      for (size_t i = begin; i < end; ++i)
+        signals[i] = (std::fabs(signals[i] - bSignals[i]) < tolerance) ? 1.0 : 0.0;
+    } else {
+      for (size_t i = begin; i < end; ++i)
+        signals[i] = (std::fabs(signals[i] - b) < tolerance) ? 1.0 : 0.0;
+    }
+    std::fill(errorsSquared + begin, errorsSquared + end, 0.0);
+    break;
+  }
+  case Operation::SetUsingMask: {
+    const signal_t *maskSignals = step.mask->m_signals.data();
+    if (bSignals) {
+      for (size_t i = begin; i < end; ++i) {
+        const bool set = maskSignals[i] != 0.0;
+        signals[i] = set ? bSignals[i] : signals[i];
+        errorsSquared[i] = set ? bErrorsSquared[i] : errorsSquared[i];
+      }
+    } else {
+      for (size_t i = begin; i < end; ++i) {
+        const bool set = maskSignals[i] != 0.0;
+        signals[i] = set ? b : signals[i];
+        errorsSquared[i] = set ? db2 : errorsSquared[i];
+      }
+    }
+    break;
+  }
+  }
+}
+
+} // namespace Mantid::DataObjects
@@ -9,7 +9,9 @@
 #include "MantidAPI/FileFinder.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidFrameworkTestHelpers/MDEventsTestHelper.h"
+#include "MantidKernel/MultiThreaded.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 
@@ -250,6 +252,47 @@ public:
 
   void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
 
+  void test_concurrent_reads_from_file_opened_for_reading() {
+    using Mantid::DataObjects::BoxControllerNeXusIO;
+
+    std::unique_ptr<BoxControllerNeXusIO> pSaver(createTestBoxController());
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    TSM_ASSERT("Files open for writing are read through NeXus", !pSaver->supportsConcurrentReads());
+    const std::string FullPathFile = pSaver->getFileName();
+
+    const size_t nEvents = 1000;
+    const size_t nColumns = pSaver->getNDataColums();
+    std::vector<float> toWrite(nColumns * nEvents);
+    for (size_t i = 0; i < toWrite.size(); i++)
+      toWrite[i] = static_cast<float>(i);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(FullPathFile, "r"));
+    TS_ASSERT(pSaver->supportsConcurrentReads());
+    pSaver->setReadCacheSize(100 * nColumns * sizeof(float));
+
+    const size_t blockSize = 10;
+    const size_t nBlocks = nEvents / blockSize;
+    // read every block twice so that some reads are served from the cache
+    std::vector<int> matches(2 * nBlocks, 0);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < static_cast<int>(matches.size()); ++i) {
+      const size_t block = static_cast<size_t>(i) % nBlocks;
+      std::vector<float> toRead;
+      pSaver->loadBlock(toRead, block * blockSize, blockSize);
+      matches[i] = toRead.size() == blockSize * nColumns &&
+                   std::equal(toRead.cbegin(), toRead.cend(), toWrite.cbegin() + block * blockSize * nColumns);
+    }
+    TS_ASSERT_EQUALS(std::count(matches.cbegin(), matches.cend(), 1), matches.size());
+
+    TS_ASSERT_THROWS_NOTHING(pSaver->closeFile());
+    TS_ASSERT(!pSaver->supportsConcurrentReads());
+    if (Poco::File(FullPathFile).exists())
+      Poco::File(FullPathFile).remove();
+  }
+
   void test_dataEventCount() {
     using Mantid::DataObjects::BoxControllerNeXusIO;
     using EDV = BoxControllerNeXusIO::EventDataVersion;
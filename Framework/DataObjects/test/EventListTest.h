@@ -16,6 +16,7 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <algorithm>
 #include <boost/scoped_ptr.hpp>
 #include <cmath>
 
@@ -278,6 +279,93 @@ public:
     TS_ASSERT(!el2.hasDetectorID(0));
   }
 
+  void test_addEventLists_matches_adding_one_at_a_time() {
+    EventList weighted;
+    weighted += WeightedEvent(7.0, 8, 2.0, 4.0);
+    weighted.addDetectorID(5);
+    EventList noTime;
+    noTime.switchTo(WEIGHTED_NOTIME);
+    noTime.getWeightedEventsNoTime().emplace_back(9.0, 3.0, 9.0);
+    noTime.addDetectorID(6);
+    EventList tof;
+    tof += TofEvent(11.0, 12);
+    tof.addDetectorID(5);
+
+    EventList expected(el);
+    expected += weighted;
+    expected += noTime;
+    expected += tof;
+
+    el.addEventLists({&weighted, &noTime, &tof});
+    TS_ASSERT_EQUALS(el.getEventType(), expected.getEventType());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), 6);
+    TS_ASSERT_EQUALS(el.getWeightedEventsNoTime(), expected.getWeightedEventsNoTime());
+    TS_ASSERT_EQUALS(el.getSortType(), UNSORTED);
+    TS_ASSERT_EQUALS(el.getDetectorIDs(), expected.getDetectorIDs());
+  }
+
+  void test_addEventLists_keeps_sorted_lists_sorted() {
+    std::vector<EventList> lists(5);
+    for (size_t i = 0; i < lists.size(); ++i) {
+      for (size_t j = 0; j < 1000 * i; ++j)
+        lists[i] += TofEvent(static_cast<double>((j * 7919 + i * 31) % 5003), static_cast<int64_t>(i));
+      lists[i].sortTof();
+    }
+    EventList expected;
+    for (const auto &list : lists)
+      expected += list;
+    expected.sortTof();
+
+    EventList result(lists[1]);
+    result.addEventLists({&lists[0], &lists[2], &lists[3], &lists[4]});
+    TS_ASSERT(result.isSortedByTof());
+    TS_ASSERT_EQUALS(result.getNumberEvents(), expected.getNumberEvents());
+    const auto &events = result.getEvents();
+    TS_ASSERT(std::is_sorted(events.cbegin(), events.cend(),
+                             [](const auto &a, const auto &b) { return a.tof() < b.tof(); }));
+    const auto &expectedEvents = expected.getEvents();
+    TS_ASSERT(std::equal(events.cbegin(), events.cend(), expectedEvents.cbegin(),
+                         [](const auto &a, const auto &b) { return a.tof() == b.tof(); }));
+  }
+
+  void test_addEventLists_to_itself_throws() {
+    EventList other(el);
+    TS_ASSERT_THROWS(el.addEventLists({&other, &el}), const std::invalid_argument &);
+  }
+
+  template <typename T> static std::vector<T> readColumn(const EventColumn &column) {
+    std::vector<T> values(column.size);
+    const auto *bytes = static_cast<const char *>(column.data);
+    for (size_t i = 0; i < column.size; ++i)
+      values[i] = *reinterpret_cast<const T *>(bytes + i * column.stride);
+    return values;
+  }
+
+  void test_columns_view_the_events() {
+    const auto tofColumn = el.tofColumn();
+    TS_ASSERT_EQUALS(tofColumn.data, &el.getEvents().front());
+    TS_ASSERT_EQUALS(readColumn<double>(tofColumn), el.getTofs());
+    const auto pulseTimes = readColumn<int64_t>(el.pulseTimeColumn());
+    TS_ASSERT_EQUALS(pulseTimes, std::vector<int64_t>({200, 400, 60}));
+    TS_ASSERT_EQUALS(readColumn<float>(el.weightColumn()), std::vector<float>(3, 1.0f));
+    TS_ASSERT_EQUALS(el.weightColumn().stride, 0);
+
+    el.switchTo(WEIGHTED);
+    el.getWeightedEvents()[1] = WeightedEvent(3.5, 400, 2.0, 5.0);
+    TS_ASSERT_EQUALS(readColumn<double>(el.tofColumn()), el.getTofs());
+    TS_ASSERT_EQUALS(readColumn<int64_t>(el.pulseTimeColumn()), pulseTimes);
+    TS_ASSERT_EQUALS(readColumn<float>(el.weightColumn()), std::vector<float>({1.0f, 2.0f, 1.0f}));
+    TS_ASSERT_EQUALS(readColumn<float>(el.errorSquaredColumn()), std::vector<float>({1.0f, 5.0f, 1.0f}));
+
+    el.switchTo(WEIGHTED_NOTIME);
+    TS_ASSERT_EQUALS(readColumn<double>(el.tofColumn()), el.getTofs());
+    TS_ASSERT_EQUALS(readColumn<int64_t>(el.pulseTimeColumn()), std::vector<int64_t>(3, 0));
+    TS_ASSERT_EQUALS(readColumn<float>(el.weightColumn()), std::vector<float>({1.0f, 2.0f, 1.0f}));
+
+    el.clear();
+    TS_ASSERT_EQUALS(el.tofColumn().size, 0);
+  }
+
   //==================================================================================
   //--- Switching to Weighted Events ----
   //==================================================================================
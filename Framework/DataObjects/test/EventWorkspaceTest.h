@@ -19,6 +19,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include <string>
+#include <thread>
 
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/SpectrumInfo.h"
@@ -27,6 +28,7 @@
 #include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
 #include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
 #include "MantidHistogramData/LinearGenerator.h"
+#include "MantidKernel/ConfigService.h"
 #include "MantidKernel/Memory.h"
 #include "MantidKernel/Timer.h"
 #include "PropertyManagerHelper.h"
@@ -45,6 +47,7 @@ using namespace boost::posix_time;
 using Mantid::HistogramData::BinEdges;
 using Mantid::HistogramData::Histogram;
 using Mantid::HistogramData::HistogramX;
+using Mantid::HistogramData::HistogramY;
 using Mantid::HistogramData::LinearGenerator;
 using Mantid::Types::Core::DateAndTime;
 using Mantid::Types::Event::TofEvent;
@@ -836,6 +839,60 @@ public:
     TS_ASSERT_DIFFERS(&(ws->y(0)), &yOld1);
   }
 
+  void test_cacheHistograms_histograms_every_spectrum_once() {
+    auto ws = createEventWorkspace(true, true);
+    TS_ASSERT_EQUALS(ws->cacheHistograms(), NUMPIXELS);
+    TS_ASSERT_EQUALS(ws->cacheHistograms(), 0);
+
+    MantidVec Y, E;
+    ws->getSpectrum(3).generateHistogram(ws->x(3).rawData(), Y, E);
+    TS_ASSERT_EQUALS(ws->y(3).rawData(), Y);
+    TS_ASSERT_EQUALS(ws->e(3).rawData(), E);
+    TS_ASSERT_EQUALS(ws->sharedY(3).use_count(), 2);
+    // Found by every thread without histogramming again
+    const auto *cachedY = &ws->y(3);
+    std::vector<const HistogramY *> foundY(4, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < foundY.size(); ++i)
+      threads.emplace_back([&ws, &foundY, i]() { foundY[i] = &ws->y(3); });
+    for (auto &thread : threads)
+      thread.join();
+    for (const auto *y : foundY)
+      TS_ASSERT_EQUALS(y, cachedY);
+
+    // Only changed spectra are histogrammed again
+    ws->getSpectrum(3).clear(false);
+    TS_ASSERT_EQUALS(ws->cacheHistograms(), 1);
+    TS_ASSERT_EQUALS(ws->y(3)[0], 0.);
+    ws->setAllX(BinEdges(10, LinearGenerator(0.0, BIN_DELTA)));
+    TS_ASSERT_EQUALS(ws->cacheHistograms(), NUMPIXELS);
+    TS_ASSERT_EQUALS(ws->y(0).size(), 9);
+    ws->clearMRU();
+    TS_ASSERT_EQUALS(ws->cacheHistograms(), NUMPIXELS);
+  }
+
+  void test_cacheHistograms_is_counted_in_the_memory_size() {
+    auto ws = createEventWorkspace(true, true);
+    const auto before = ws->getMemorySize();
+    ws->cacheHistograms();
+    TS_ASSERT_EQUALS(ws->getMemorySize(), before + NUMPIXELS * 2 * (NUMBINS - 1) * sizeof(double));
+    ws->clearMRU();
+    TS_ASSERT_EQUALS(ws->getMemorySize(), before);
+  }
+
+  void test_cacheHistograms_respects_the_memory_limit() {
+    auto &config = Mantid::Kernel::ConfigService::Instance();
+    const auto oldLimit = config.getString("EventWorkspace.HistogramCacheMB");
+    // Room for 100 spectra of 1025 bin edges
+    config.setString("EventWorkspace.HistogramCacheMB",
+                     std::to_string(100. * NUMBINS * 2. * sizeof(double) / (1024. * 1024.)));
+    auto ws = createEventWorkspace(true, true);
+    TS_ASSERT_EQUALS(ws->cacheHistograms(), 100);
+    config.setString("EventWorkspace.HistogramCacheMB", oldLimit);
+    // The remaining spectra are still histogrammed on access
+    TS_ASSERT_EQUALS(ws->y(NUMPIXELS - 1).size(), NUMBINS - 1);
+  }
+
   void test_deleting_spectra_removes_them_from_MRU() {
     auto ws = WorkspaceCreationHelper::createRandomEventWorkspace(2, 1);
     auto y = ws->sharedY(0);
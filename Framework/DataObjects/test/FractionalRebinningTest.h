@@ -0,0 +1,102 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/FractionalRebinning.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid::DataObjects;
+using Mantid::Geometry::Quadrilateral;
+using Mantid::Kernel::V2D;
+
+class FractionalRebinningTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static FractionalRebinningTest *createSuite() { return new FractionalRebinningTest(); }
+  static void destroySuite(FractionalRebinningTest *suite) { delete suite; }
+
+  void test_rectangle_inside_the_grid_is_shared_by_area() {
+    const auto inputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(1, 1);
+    FractionalRebinning::BinContributions contributions;
+    FractionalRebinning::rebinToOutput(Quadrilateral(0.5, 1.5, 0.5, 1.5), inputWS, 0, 0, m_axis, m_axis,
+                                       contributions);
+
+    TS_ASSERT_EQUALS(contributions.size(), 4);
+    for (const auto &contribution : contributions) {
+      TS_ASSERT(contribution.wsIndex == 0 || contribution.wsIndex == 1);
+      TS_ASSERT(contribution.binIndex == 0 || contribution.binIndex == 1);
+      TS_ASSERT_DELTA(contribution.signal, 0.5, 1e-12);
+      TS_ASSERT_DELTA(contribution.variance, 0.5, 1e-12);
+    }
+  }
+
+  void test_contributions_conserve_the_signal_of_a_general_quadrilateral() {
+    const auto inputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(1, 1);
+    const Quadrilateral inputQ(V2D(0.2, 0.3), V2D(2.1, 0.9), V2D(2.6, 2.4), V2D(0.4, 1.8));
+    FractionalRebinning::BinContributions contributions;
+    FractionalRebinning::rebinToFractionalOutput(inputQ, inputWS, 0, 0, m_axis, m_axis, contributions);
+
+    TS_ASSERT_LESS_THAN(4, contributions.size());
+    double signal(0.), variance(0.), fraction(0.);
+    for (const auto &contribution : contributions) {
+      signal += contribution.signal;
+      variance += contribution.variance;
+      fraction += contribution.fraction;
+    }
+    TS_ASSERT_DELTA(signal, 2.0, 1e-12);
+    TS_ASSERT_DELTA(variance, 2.0, 1e-12);
+    TS_ASSERT_DELTA(fraction, 1.0, 1e-12);
+  }
+
+  void test_adding_contributions_gives_the_overlap_areas() {
+    // Y = 2 and E = sqrt(2) in both input bins
+    const auto inputWS = WorkspaceCreationHelper::create2DWorkspaceBinned(1, 2);
+    // A unit square centred on a grid corner, spread evenly over four bins
+    const Quadrilateral square(0.5, 1.5, 0.5, 1.5);
+    // A parallelogram of area 2 sheared by x = y / 2. The overlaps with the
+    // bins it crosses are 3/4, 1/4 in the first row and 1/4, 3/4 in the second.
+    const Quadrilateral sheared(V2D(1., 0.), V2D(2., 0.), V2D(3., 2.), V2D(2., 2.));
+    // Weighted by overlap area / input area and summed per output bin
+    const std::vector<std::vector<double>> expected{{0.5, 0.5 + 0.75, 0.25}, {0.5, 0.5 + 0.25, 0.75}, {0., 0., 0.}};
+
+    FractionalRebinning::BinContributions contributions;
+    FractionalRebinning::rebinToOutput(square, inputWS, 0, 0, m_axis, m_axis, contributions);
+    FractionalRebinning::rebinToOutput(sheared, inputWS, 0, 1, m_axis, m_axis, contributions);
+    auto gathered = createEmptyOutput();
+    FractionalRebinning::addContributions(*gathered, contributions);
+
+    auto direct = createEmptyOutput();
+    FractionalRebinning::rebinToOutput(square, inputWS, 0, 0, *direct, m_axis);
+    FractionalRebinning::rebinToOutput(sheared, inputWS, 0, 1, *direct, m_axis);
+
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        // The signal is 2 and the variance 2, so the fractions of both are equal
+        TS_ASSERT_DELTA(gathered->y(i)[j], expected[i][j], 1e-12);
+        TS_ASSERT_DELTA(gathered->e(i)[j], expected[i][j], 1e-12);
+        TS_ASSERT_DELTA(direct->y(i)[j], expected[i][j], 1e-12);
+        TS_ASSERT_DELTA(direct->e(i)[j], expected[i][j], 1e-12);
+      }
+    }
+  }
+
+private:
+  /// @return a 3x3 workspace on m_axis holding no signal
+  static Mantid::API::MatrixWorkspace_sptr createEmptyOutput() {
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceBinned(3, 3);
+    for (size_t i = 0; i < 3; ++i) {
+      ws->mutableY(i).assign(3, 0.);
+      ws->mutableE(i).assign(3, 0.);
+    }
+    return ws;
+  }
+
+  const std::vector<double> m_axis{0., 1., 2., 3.};
+};
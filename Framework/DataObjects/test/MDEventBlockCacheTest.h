@@ -0,0 +1,119 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDEventBlockCache.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <thread>
+
+using Mantid::DataObjects::MDEventBlockCache;
+
+class MDEventBlockCacheTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDEventBlockCacheTest *createSuite() { return new MDEventBlockCacheTest(); }
+  static void destroySuite(MDEventBlockCacheTest *suite) { delete suite; }
+
+  void test_disabled_cache_stores_nothing() {
+    MDEventBlockCache cache;
+    cache.insert(0, 10, makeBlock(40, 'a'));
+    TS_ASSERT_EQUALS(cache.numberOfBlocks(), 0);
+    TS_ASSERT(!cache.find(0, 10));
+  }
+
+  void test_find_returns_the_inserted_block() {
+    MDEventBlockCache cache(100);
+    cache.insert(5, 10, makeBlock(40, 'a'));
+    auto block = cache.find(5, 10);
+    TS_ASSERT(block);
+    TS_ASSERT_EQUALS(block->size(), 40);
+    TS_ASSERT_EQUALS((*block)[0], 'a');
+    TSM_ASSERT("Blocks of a different length are different entries", !cache.find(5, 11));
+    TS_ASSERT_EQUALS(cache.size(), 40);
+  }
+
+  void test_least_recently_used_block_is_evicted() {
+    MDEventBlockCache cache(100);
+    cache.insert(0, 1, makeBlock(40, 'a'));
+    cache.insert(1, 1, makeBlock(40, 'b'));
+    // touch the first block so the second becomes the least recently used
+    TS_ASSERT(cache.find(0, 1));
+    cache.insert(2, 1, makeBlock(40, 'c'));
+
+    TS_ASSERT_EQUALS(cache.numberOfBlocks(), 2);
+    TS_ASSERT_EQUALS(cache.size(), 80);
+    TS_ASSERT(cache.find(0, 1));
+    TS_ASSERT(!cache.find(1, 1));
+    TS_ASSERT(cache.find(2, 1));
+  }
+
+  void test_reinserting_a_block_replaces_it() {
+    MDEventBlockCache cache(100);
+    cache.insert(0, 1, makeBlock(40, 'a'));
+    cache.insert(0, 1, makeBlock(20, 'b'));
+    TS_ASSERT_EQUALS(cache.numberOfBlocks(), 1);
+    TS_ASSERT_EQUALS(cache.size(), 20);
+    TS_ASSERT_EQUALS((*cache.find(0, 1))[0], 'b');
+  }
+
+  void test_blocks_larger_than_the_capacity_are_not_cached() {
+    MDEventBlockCache cache(100);
+    cache.insert(0, 1, makeBlock(40, 'a'));
+    cache.insert(1, 1, makeBlock(101, 'b'));
+    TS_ASSERT_EQUALS(cache.numberOfBlocks(), 1);
+    TS_ASSERT(cache.find(0, 1));
+  }
+
+  void test_reducing_the_capacity_evicts_blocks() {
+    MDEventBlockCache cache(100);
+    cache.insert(0, 1, makeBlock(40, 'a'));
+    auto evicted = cache.find(0, 1);
+    cache.insert(1, 1, makeBlock(40, 'b'));
+    cache.setCapacity(50);
+    TS_ASSERT_EQUALS(cache.numberOfBlocks(), 1);
+    TS_ASSERT(cache.find(1, 1));
+    TSM_ASSERT("An evicted block stays valid while it is used", evicted && (*evicted)[39] == 'a');
+
+    cache.clear();
+    TS_ASSERT_EQUALS(cache.numberOfBlocks(), 0);
+    TS_ASSERT_EQUALS(cache.size(), 0);
+  }
+
+  void test_concurrent_access_keeps_the_cache_consistent() {
+    MDEventBlockCache cache(1000);
+    // cxxtest assertions are not thread safe, so count the bad blocks found
+    // by each thread and check them once the threads have finished
+    std::vector<size_t> wrongBlocks(4, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&cache, &wrongBlocks, i]() {
+        for (uint64_t position = 0; position < 1000; ++position) {
+          cache.insert(position, i, makeBlock(10, static_cast<char>(i)));
+          if (auto block = cache.find(position, i)) {
+            if (block->size() != 10 || (*block)[0] != static_cast<char>(i))
+              ++wrongBlocks[i];
+          }
+        }
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+    for (const auto wrong : wrongBlocks) {
+      TS_ASSERT_EQUALS(wrong, 0);
+    }
+    TS_ASSERT_LESS_THAN_EQUALS(cache.size(), 1000);
+    TS_ASSERT_EQUALS(cache.size(), 10 * cache.numberOfBlocks());
+  }
+
+private:
+  static MDEventBlockCache::Block makeBlock(size_t size, char value) {
+    return std::make_shared<const std::vector<char>>(size, value);
+  }
+};
@@ -0,0 +1,171 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidDataObjects/MDHistoWorkspaceExpression.h"
+#include "MantidFrameworkTestHelpers/MDEventsTestHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+
+class MDHistoWorkspaceExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDHistoWorkspaceExpressionTest *createSuite() { return new MDHistoWorkspaceExpressionTest(); }
+  static void destroySuite(MDHistoWorkspaceExpressionTest *suite) { delete suite; }
+
+  void test_empty_expression_does_nothing() {
+    auto a = makeWorkspace(1.0);
+    auto expected = a->clone();
+    MDHistoWorkspaceExpression expression;
+    TS_ASSERT(expression.empty());
+    expression.evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_arithmetic_chain_matches_single_operations() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    auto expected = a->clone();
+    expected->add(*b);
+    expected->multiply(2.5, 0.5);
+    expected->subtract(1.0, 0.1);
+    expected->divide(*b);
+    expected->power(2.0);
+    expected->log(-1.0);
+
+    MDHistoWorkspaceExpression expression;
+    expression.add(*b).multiply(2.5, 0.5).subtract(1.0, 0.1).divide(*b).power(2.0).log(-1.0);
+    TS_ASSERT_EQUALS(expression.size(), 6);
+    expression.evaluate(*a);
+    checkSameValues(*a, *expected);
+    TS_ASSERT_EQUALS(a->getNEvents(), expected->getNEvents());
+  }
+
+  void test_masking_chain_matches_single_operations() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    auto mask = makeWorkspace(3.0);
+    mask->lessThan(0.0);
+    auto expected = a->clone();
+    expected->setUsingMask(*mask, *b);
+    expected->greaterThan(0.5);
+    *expected ^= *b;
+    expected->operatorNot();
+    expected->setUsingMask(*mask, 7.0, 2.0);
+
+    MDHistoWorkspaceExpression()
+        .setUsingMask(*mask, *b)
+        .greaterThan(0.5)
+        .operatorXor(*b)
+        .operatorNot()
+        .setUsingMask(*mask, 7.0, 2.0)
+        .evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_boolean_operations_use_masking() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    for (size_t i = 0; i < a->getNPoints(); i += 3)
+      a->setMDMaskAt(i, true);
+    for (size_t i = 0; i < b->getNPoints(); i += 5)
+      b->setMDMaskAt(i, true);
+    auto expected = a->clone();
+    *expected &= *b;
+    *expected |= *b;
+
+    MDHistoWorkspaceExpression().operatorAnd(*b).operatorOr(*b).evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_operand_can_be_the_result() {
+    auto a = makeWorkspace(1.0);
+    auto expected = a->clone();
+    expected->multiply(*expected);
+    expected->add(*expected);
+
+    MDHistoWorkspaceExpression().multiply(*a).add(*a).evaluate(*a);
+    checkSameValues(*a, *expected);
+  }
+
+  void test_mismatched_operand_throws_without_changing_the_workspace() {
+    auto a = makeWorkspace(1.0);
+    auto b = makeWorkspace(2.0);
+    auto small = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0, 2, 5);
+    auto expected = a->clone();
+    TS_ASSERT_THROWS(MDHistoWorkspaceExpression().add(*b).equalTo(*small).evaluate(*a), const std::invalid_argument &);
+    checkSameValues(*a, *expected);
+  }
+
+private:
+  /// A workspace spanning several blocks with values varying from bin to bin
+  static MDHistoWorkspace_sptr makeWorkspace(double offset) {
+    auto ws = MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 3, 20);
+    TS_ASSERT_LESS_THAN(2 * MDHistoWorkspaceExpression::BLOCK_SIZE, ws->getNPoints());
+    for (size_t i = 0; i < ws->getNPoints(); ++i) {
+      const auto x = static_cast<double>(i);
+      ws->setSignalAt(i, std::sin(x + offset) * 10.0);
+      ws->setErrorSquaredAt(i, 1.0 + std::cos(x * offset) * std::cos(x * offset));
+      ws->setNumEventsAt(i, static_cast<double>(i % 7));
+    }
+    ws->updateSum();
+    return ws;
+  }
+
+  static void checkSameValues(const MDHistoWorkspace &actual, const MDHistoWorkspace &expected) {
+    TS_ASSERT_EQUALS(actual.getNPoints(), expected.getNPoints());
+    size_t mismatches(0);
+    for (size_t i = 0; i < actual.getNPoints(); ++i) {
+      if (!same(actual.getSignalAt(i), expected.getSignalAt(i)) ||
+          !same(actual.getErrorSquaredArray()[i], expected.getErrorSquaredArray()[i]) ||
+          actual.getNumEventsAt(i) != expected.getNumEventsAt(i) ||
+          actual.getIsMaskedAt(i) != expected.getIsMaskedAt(i))
+        ++mismatches;
+    }
+    TS_ASSERT_EQUALS(mismatches, 0);
+  }
+
+  /// Equal, including both values being NaN
+  static bool same(double a, double b) { return a == b || (std::isnan(a) && std::isnan(b)); }
+};
+
+class MDHistoWorkspaceExpressionTestPerformance : public CxxTest::TestSuite {
+public:
+  static MDHistoWorkspaceExpressionTestPerformance *createSuite() {
+    return new MDHistoWorkspaceExpressionTestPerformance();
+  }
+  static void destroySuite(MDHistoWorkspaceExpressionTestPerformance *suite) { delete suite; }
+
+  MDHistoWorkspaceExpressionTestPerformance() {
+    m_a = MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0, 3, 200, 10.0, 1.0);
+    m_b = MDEventsTestHelper::makeFakeMDHistoWorkspace(3.0, 3, 200, 10.0, 1.0);
+    m_mask = MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 3, 200, 10.0, 0.0);
+  }
+
+  void test_chain_of_ten_operations() {
+    MDHistoWorkspaceExpression()
+        .add(*m_b)
+        .multiply(0.5, 0.0)
+        .subtract(*m_b)
+        .divide(*m_b)
+        .add(1.0, 0.0)
+        .power(2.0)
+        .multiply(*m_b)
+        .setUsingMask(*m_mask, 0.0, 0.0)
+        .log(0.0)
+        .exp()
+        .evaluate(*m_a);
+  }
+
+private:
+  MDHistoWorkspace_sptr m_a, m_b, m_mask;
+};
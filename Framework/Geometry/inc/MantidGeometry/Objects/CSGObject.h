@@ -11,6 +11,7 @@
 //----------------------------------------------------------------------
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidGeometry/Objects/CompiledRule.h"
 #include "MantidGeometry/Objects/IObject.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
@@ -104,6 +105,8 @@ public:
 
   bool isValid(const Kernel::V3D &) const override; ///< Check if a point is valid
   bool isValid(const std::map<int, int> &) const;   ///< Check if a set of surfaces are valid.
+  void isValid(const std::vector<Kernel::V3D> &points,
+               std::vector<bool> &valid) const; ///< Check if each of a block of points is valid
   bool isOnSide(const Kernel::V3D &) const override;
   Mantid::Geometry::TrackDirection calcValidType(const Kernel::V3D &Pt, const Kernel::V3D &uVec) const;
   Mantid::Geometry::TrackDirection calcValidTypeBy3Points(const Kernel::V3D &prePt, const Kernel::V3D &curPt,
@@ -202,6 +205,8 @@ private:
   double singleShotMonteCarloVolume(const int shotSize, const size_t seed) const;
   /// Top rule [ Geometric scope of object]
   std::unique_ptr<Rule> m_topRule;
+  /// The top rule compiled for testing points, empty until the surface list is created
+  CompiledRule m_compiledRule;
   /// Object's bounding box
   BoundingBox m_boundingBox;
   // -- DEPRECATED --
@@ -0,0 +1,84 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+class Rule;
+class Surface;
+
+/**
+CompiledRule holds the Rule tree of a CSGObject compiled into a flat program,
+so testing if a point is inside the object is a loop over an array rather
+than virtual calls down the tree.
+
+Each instruction tests one leaf of the tree, usually the side of a surface
+from the dense list of the object's surfaces, and names the instruction to
+continue from for either result. Intersections, unions and complements only
+decide where the tests of their leaves go next, so they cost nothing when a
+point is tested and the short-circuit evaluation of the tree is kept. Rules
+the program has no instruction for are evaluated through the tree.
+*/
+class MANTID_GEOMETRY_DLL CompiledRule {
+public:
+  CompiledRule() = default;
+  CompiledRule(const Rule &topRule, const std::vector<const Surface *> &surfaces);
+
+  /// @return true if nothing has been compiled
+  bool empty() const { return m_start == NOT_COMPILED; }
+  /// @return the number of instructions in the program
+  size_t size() const { return m_program.size(); }
+
+  bool isValid(const Kernel::V3D &point) const;
+  void isValid(const std::vector<Kernel::V3D> &points, std::vector<bool> &valid) const;
+
+private:
+  /// Targets past the end of the program that end it with a result
+  static constexpr uint32_t RESULT_TRUE = std::numeric_limits<uint32_t>::max();
+  static constexpr uint32_t RESULT_FALSE = RESULT_TRUE - 1;
+  static constexpr uint32_t NOT_COMPILED = RESULT_TRUE - 2;
+
+  enum class OpCode : uint8_t {
+    SURFACE, ///< Point is on the side of surface operand given by sign
+    RULE     ///< Rule operand is valid for the point
+  };
+  struct Instruction {
+    OpCode code;
+    int sign;
+    uint32_t operand;
+    /// The instruction to continue from if the test is true
+    uint32_t onTrue;
+    /// The instruction to continue from if the test is false
+    uint32_t onFalse;
+  };
+
+  uint32_t compile(const Rule *rule, const uint32_t onTrue, const uint32_t onFalse,
+                   std::unordered_map<const Surface *, uint32_t> &surfaceIndex);
+  uint32_t append(const OpCode code, const uint32_t operand, const int sign, const uint32_t onTrue,
+                  const uint32_t onFalse);
+  template <typename SurfaceTest> bool run(const Kernel::V3D &point, SurfaceTest &&surfaceTest) const;
+
+  /// The program
+  std::vector<Instruction> m_program;
+  /// The instruction the program starts from, or a result if it is constant
+  uint32_t m_start{NOT_COMPILED};
+  /// The surfaces the SURFACE instructions refer to
+  std::vector<const Surface *> m_surfaces;
+  /// The rules the RULE instructions refer to
+  std::vector<const Rule *> m_rules;
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -0,0 +1,149 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/**
+MeshBVH is a bounding volume hierarchy over the triangles of a closed mesh.
+It lets a ray find the few triangles it may hit without testing every
+triangle of the mesh.
+
+The tree is built top down, splitting each node where the surface area
+heuristic (SAH) estimates the cheapest traversal, and is stored depth first
+in a single array: the first child of a node follows it and the node keeps
+the index of its second child. Leaves refer to a range of the reordered
+triangle indices.
+*/
+class MANTID_GEOMETRY_DLL MeshBVH {
+public:
+  MeshBVH(const std::vector<uint32_t> &triangles, const std::vector<Kernel::V3D> &vertices);
+
+  /**
+   * Visit the triangles whose leaves the ray from start along direction
+   * passes through, nearest leaves first. The visitor is called with the
+   * index of each triangle and returns the distance along the ray beyond
+   * which no more triangles are of interest, e.g. the distance to the nearest
+   * intersection found so far, or the maximum double to visit all of them.
+   * @param start :: Start point of the ray
+   * @param direction :: Direction of the ray
+   * @param visit :: Callable as double(size_t triangleIndex)
+   */
+  template <typename Visitor>
+  void traverse(const Kernel::V3D &start, const Kernel::V3D &direction, Visitor &&visit) const {
+    if (m_nodes.empty())
+      return;
+    const std::array<double, 3> origin{{start.X(), start.Y(), start.Z()}};
+    const std::array<double, 3> dir{{direction.X(), direction.Y(), direction.Z()}};
+    const std::array<double, 3> inverse{{1. / dir[0], 1. / dir[1], 1. / dir[2]}};
+    double maxDistance = std::numeric_limits<double>::max();
+    std::array<uint32_t, MAX_DEPTH + 1> stack;
+    size_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+      const uint32_t index = stack[--stackSize];
+      const Node &node = m_nodes[index];
+      if (!intersects(node, origin, dir, inverse, maxDistance))
+        continue;
+      if (node.count > 0) {
+        for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+          const double distance = visit(static_cast<size_t>(m_order[i]));
+          if (distance < maxDistance)
+            maxDistance = distance;
+        }
+      } else if (dir[node.axis] < 0.) {
+        // The second child is on the near side of the split
+        stack[stackSize++] = index + 1;
+        stack[stackSize++] = node.offset;
+      } else {
+        stack[stackSize++] = node.offset;
+        stack[stackSize++] = index + 1;
+      }
+    }
+  }
+
+  /// @return the number of nodes in the tree
+  size_t numberOfNodes() const { return m_nodes.size(); }
+  /// @return the largest number of triangles in a leaf
+  size_t maxLeafSize() const;
+
+private:
+  /// A node of the tree, 64 bytes so a node fits one cache line
+  struct Node {
+    std::array<double, 3> lower;
+    std::array<double, 3> upper;
+    /// Leaves: the first entry in m_order. Interior nodes: the index of the second child
+    uint32_t offset;
+    /// Number of triangles in a leaf, zero for interior nodes
+    uint32_t count;
+    /// The axis interior nodes are split along
+    uint32_t axis;
+  };
+  struct TriangleBounds {
+    std::array<double, 3> lower;
+    std::array<double, 3> upper;
+    std::array<double, 3> centroid;
+  };
+
+  /// Deepest level of the tree. Nodes at this depth are leaves whatever their size
+  static constexpr size_t MAX_DEPTH = 64;
+
+  uint32_t build(const std::vector<TriangleBounds> &bounds, const size_t begin, const size_t end, const size_t depth);
+
+  /**
+   * Check if the ray passes through a node closer than maxDistance
+   * @param node :: The node to test
+   * @param origin :: Start point of the ray
+   * @param dir :: Direction of the ray
+   * @param inverse :: Inverse of each component of the direction
+   * @param maxDistance :: The node is missed if it starts beyond this distance
+   * @return true if the ray passes through the node
+   */
+  bool intersects(const Node &node, const std::array<double, 3> &origin, const std::array<double, 3> &dir,
+                  const std::array<double, 3> &inverse, const double maxDistance) const {
+    double tNear = -m_tolerance;
+    double tFar = maxDistance;
+    for (size_t axis = 0; axis < 3; ++axis) {
+      if (dir[axis] == 0.) {
+        if (origin[axis] < node.lower[axis] || origin[axis] > node.upper[axis])
+          return false;
+        continue;
+      }
+      double t1 = (node.lower[axis] - origin[axis]) * inverse[axis];
+      double t2 = (node.upper[axis] - origin[axis]) * inverse[axis];
+      if (t1 > t2)
+        std::swap(t1, t2);
+      tNear = std::max(tNear, t1);
+      tFar = std::min(tFar, t2);
+      if (tNear > tFar)
+        return false;
+    }
+    return true;
+  }
+
+  /// The nodes, depth first
+  std::vector<Node> m_nodes;
+  /// Triangle indices in the order of the leaves
+  std::vector<uint32_t> m_order;
+  /// Padding of the node bounds and the distance behind the start of a ray
+  /// where intersections are still accepted, as rayIntersectsTriangle does
+  double m_tolerance{0.};
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -18,6 +18,7 @@
 #include "MantidKernel/Matrix.h"
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace Mantid {
 //----------------------------------------------------------------------
@@ -31,6 +32,7 @@ class V3D;
 namespace Geometry {
 class CompGrp;
 class GeometryHandler;
+class MeshBVH;
 class Track;
 class vtkGeometryCacheReader;
 class vtkGeometryCacheWriter;
@@ -46,6 +48,9 @@ Mesh Object of Triangles assumed to form one or more
 non-intersecting closed surfaces enclosing separate volumes.
 The number of vertices is limited to 2^32 based on index type. For 2D Meshes see
 Mesh2DObject
+
+Rays are tested against the triangles through a bounding volume hierarchy,
+built the first time it is needed and again after the mesh is transformed.
 */
 class MANTID_GEOMETRY_DLL MeshObject : public IObject {
 public:
@@ -144,6 +149,13 @@ private:
   void getIntersections(const Kernel::V3D &start, const Kernel::V3D &direction,
                         std::vector<Kernel::V3D> &intersectionPoints,
                         std::vector<Mantid::Geometry::TrackDirection> &entryExitFlags) const;
+  /// Get the intersection nearest to the start of a ray
+  bool getNearestIntersection(const Kernel::V3D &start, const Kernel::V3D &direction, Kernel::V3D &intersection,
+                              TrackDirection &entryExit) const;
+  /// Get the bounding volume hierarchy of the triangles
+  const MeshBVH &bvh() const;
+  /// Discard the bounding volume hierarchy after the vertices have moved
+  void resetBVH();
 
   /// Get triangle
   bool getTriangle(const size_t index, Kernel::V3D &v1, Kernel::V3D &v2, Kernel::V3D &v3) const;
@@ -152,6 +164,10 @@ private:
 
   /// Cache for object's bounding box
   mutable BoundingBox m_boundingBox;
+  /// Bounding volume hierarchy of the triangles, built on first use
+  mutable std::shared_ptr<const MeshBVH> m_bvh;
+  /// Mutex to build the bounding volume hierarchy only once
+  mutable std::mutex m_bvhMutex;
 
   /// Tolerence distance
   const double M_TOLERANCE = 0.000001;
@@ -34,6 +34,7 @@
 #include <boost/accumulators/statistics/stats.hpp>
 #include <memory>
 
+#include <algorithm>
 #include <array>
 #include <deque>
 #include <random>
@@ -428,6 +429,7 @@ CSGObject &CSGObject::operator=(const CSGObject &A) {
     m_id = A.m_id;
     m_material = std::make_unique<Material>(A.material());
 
+    m_compiledRule = CompiledRule();
     if (m_topRule)
       createSurfaceList();
   }
@@ -785,9 +787,30 @@ int CSGObject::checkSurfaceValid(const Kernel::V3D &point, const Kernel::V3D &di
 bool CSGObject::isValid(const Kernel::V3D &point) const {
   if (!m_topRule)
     return false;
+  if (!m_compiledRule.empty())
+    return m_compiledRule.isValid(point);
   return m_topRule->isValid(point);
 }
 
+/**
+ * Determines if each of a block of points is within the object or on the
+ * surface
+ * @param points :: Points to be tested
+ * @param valid :: On exit, true for each point within the object or on the
+ * surface
+ */
+void CSGObject::isValid(const std::vector<Kernel::V3D> &points, std::vector<bool> &valid) const {
+  if (!m_topRule) {
+    valid.assign(points.size(), false);
+  } else if (!m_compiledRule.empty()) {
+    m_compiledRule.isValid(points, valid);
+  } else {
+    valid.resize(points.size());
+    std::transform(points.cbegin(), points.cend(), valid.begin(),
+                   [this](const auto &point) { return m_topRule->isValid(point); });
+  }
+}
+
 /**
  * Determines is group of surface maps are valid
  * @param SMap :: map of SurfaceNumber : status
@@ -838,6 +861,7 @@ int CSGObject::createSurfaceList(const int outFlag) {
     };
   });
   m_surList.erase(newEnd, m_surList.end());
+  m_compiledRule = CompiledRule(*m_topRule, m_surList);
 
   if (outFlag) {
 
@@ -938,6 +962,7 @@ void CSGObject::print() const {
 void CSGObject::makeComplement() {
   std::unique_ptr<Rule> NCG = procComp(std::move(m_topRule));
   m_topRule = std::move(NCG);
+  m_compiledRule = CompiledRule();
 }
 
 /**
@@ -994,6 +1019,7 @@ void CSGObject::write(std::ostream &outStream) const {
  */
 int CSGObject::procString(const std::string &lineStr) {
   m_topRule = nullptr;
+  m_compiledRule = CompiledRule();
   std::map<int, std::unique_ptr<Rule>> RuleList; // List for the rules
   int Ridx = 0;                                  // Current index (not necessary size of RuleList
   // SURFACE REPLACEMENT
@@ -0,0 +1,125 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/CompiledRule.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Surfaces/Surface.h"
+
+namespace Mantid::Geometry {
+
+/**
+ * Compile a rule tree
+ * @param topRule :: The top rule of the tree
+ * @param surfaces :: The surfaces of the tree, without duplicates
+ */
+CompiledRule::CompiledRule(const Rule &topRule, const std::vector<const Surface *> &surfaces) : m_surfaces(surfaces) {
+  std::unordered_map<const Surface *, uint32_t> surfaceIndex;
+  for (size_t i = 0; i < m_surfaces.size(); ++i)
+    surfaceIndex.emplace(m_surfaces[i], static_cast<uint32_t>(i));
+  m_start = compile(&topRule, RESULT_TRUE, RESULT_FALSE, surfaceIndex);
+}
+
+/**
+ * Run the program for a point
+ * @param point :: Point to test
+ * @param surfaceTest :: Callable giving the side of surface index the point
+ * is on, as Surface::side does
+ * @return the result the program ends with
+ */
+template <typename SurfaceTest> bool CompiledRule::run(const Kernel::V3D &point, SurfaceTest &&surfaceTest) const {
+  uint32_t next = m_start;
+  while (next < RESULT_FALSE) {
+    const auto &instruction = m_program[next];
+    bool value;
+    if (instruction.code == OpCode::SURFACE)
+      value = (surfaceTest(instruction.operand) * instruction.sign) >= 0;
+    else
+      value = m_rules[instruction.operand]->isValid(point);
+    next = value ? instruction.onTrue : instruction.onFalse;
+  }
+  return next == RESULT_TRUE;
+}
+
+/**
+ * Determines if a point is valid, giving the same result as the rule tree
+ * @param point :: Point to test
+ * @return true if the point is within the object or on its surface
+ */
+bool CompiledRule::isValid(const Kernel::V3D &point) const {
+  return run(point, [this, &point](const uint32_t surface) { return m_surfaces[surface]->side(point); });
+}
+
+/**
+ * Determines if each of a block of points is valid
+ * @param points :: Points to test
+ * @param valid :: On exit, whether each point is within the object or on its
+ * surface
+ */
+void CompiledRule::isValid(const std::vector<Kernel::V3D> &points, std::vector<bool> &valid) const {
+  valid.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+    valid[i] = isValid(points[i]);
+}
+
+/**
+ * Append the instructions of a rule to the program. The leaves of the rule
+ * are compiled in reverse so the targets of each are known when it is added.
+ * @param rule :: The rule to compile, may be null
+ * @param onTrue :: Where to continue if the rule is valid
+ * @param onFalse :: Where to continue if the rule is not valid
+ * @param surfaceIndex :: The index of each surface in m_surfaces
+ * @return where to start to evaluate the rule
+ */
+uint32_t CompiledRule::compile(const Rule *rule, const uint32_t onTrue, const uint32_t onFalse,
+                               std::unordered_map<const Surface *, uint32_t> &surfaceIndex) {
+  if (!rule)
+    return onFalse;
+  if (const auto *intersection = dynamic_cast<const Intersection *>(rule)) {
+    if (!intersection->leaf(0) || !intersection->leaf(1))
+      return onFalse;
+    const uint32_t second = compile(intersection->leaf(1), onTrue, onFalse, surfaceIndex);
+    return compile(intersection->leaf(0), second, onFalse, surfaceIndex);
+  }
+  if (const auto *unionRule = dynamic_cast<const Union *>(rule)) {
+    // A missing leaf of a union counts as false
+    const uint32_t second = compile(unionRule->leaf(1), onTrue, onFalse, surfaceIndex);
+    return compile(unionRule->leaf(0), onTrue, second, surfaceIndex);
+  }
+  if (const auto *complement = dynamic_cast<const CompGrp *>(rule)) {
+    if (!complement->leaf(0))
+      return onTrue;
+    return compile(complement->leaf(0), onFalse, onTrue, surfaceIndex);
+  }
+  if (const auto *surfacePoint = dynamic_cast<const SurfPoint *>(rule)) {
+    const Surface *surface = surfacePoint->getKey();
+    if (!surface)
+      return onFalse;
+    // Add surfaces missing from the list given
+    const auto it = surfaceIndex.emplace(surface, static_cast<uint32_t>(m_surfaces.size())).first;
+    if (it->second == m_surfaces.size())
+      m_surfaces.emplace_back(surface);
+    return append(OpCode::SURFACE, it->second, surfacePoint->getSign(), onTrue, onFalse);
+  }
+  m_rules.emplace_back(rule);
+  return append(OpCode::RULE, static_cast<uint32_t>(m_rules.size() - 1), 0, onTrue, onFalse);
+}
+
+/**
+ * Append an instruction to the program
+ * @param code :: The test
+ * @param operand :: Surface or rule index
+ * @param sign :: The sign of the side of a surface that is valid
+ * @param onTrue :: Where to continue if the test is true
+ * @param onFalse :: Where to continue if the test is false
+ * @return the index of the instruction
+ */
+uint32_t CompiledRule::append(const OpCode code, const uint32_t operand, const int sign, const uint32_t onTrue,
+                              const uint32_t onFalse) {
+  m_program.emplace_back(Instruction{code, sign, operand, onTrue, onFalse});
+  return static_cast<uint32_t>(m_program.size() - 1);
+}
+
+} // namespace Mantid::Geometry
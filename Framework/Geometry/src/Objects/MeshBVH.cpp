@@ -0,0 +1,207 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/MeshBVH.h"
+
+#include <cmath>
+#include <numeric>
+
+namespace Mantid::Geometry {
+
+namespace {
+/// Leaves hold at most this many triangles, unless the tree is too deep
+constexpr size_t MAX_LEAF_SIZE = 4;
+/// Number of bins the centroids are sorted into to evaluate the SAH
+constexpr size_t NUMBER_OF_BINS = 16;
+/// Cost of traversing a node relative to testing a triangle
+constexpr double TRAVERSAL_COST = 1.0;
+
+struct Bounds {
+  std::array<double, 3> lower{{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                               std::numeric_limits<double>::max()}};
+  std::array<double, 3> upper{{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                               std::numeric_limits<double>::lowest()}};
+
+  void grow(const std::array<double, 3> &lowerPoint, const std::array<double, 3> &upperPoint) {
+    for (size_t axis = 0; axis < 3; ++axis) {
+      lower[axis] = std::min(lower[axis], lowerPoint[axis]);
+      upper[axis] = std::max(upper[axis], upperPoint[axis]);
+    }
+  }
+  void grow(const Bounds &other) { grow(other.lower, other.upper); }
+  /// Half the surface area, which is all the SAH needs
+  double halfArea() const {
+    if (lower[0] > upper[0])
+      return 0.;
+    const double dx = upper[0] - lower[0];
+    const double dy = upper[1] - lower[1];
+    const double dz = upper[2] - lower[2];
+    return dx * dy + dy * dz + dz * dx;
+  }
+};
+
+struct Bin {
+  Bounds bounds;
+  size_t count{0};
+};
+
+/// The bin of a centroid coordinate, for bins starting at lower of width 1 / scale
+size_t binIndex(const double centroid, const double lower, const double scale) {
+  return std::min(NUMBER_OF_BINS - 1, static_cast<size_t>((centroid - lower) * scale));
+}
+} // namespace
+
+/**
+ * Build the tree over the triangles of a mesh
+ * @param triangles :: Indices into vertices, three per triangle
+ * @param vertices :: The vertices of the mesh
+ */
+MeshBVH::MeshBVH(const std::vector<uint32_t> &triangles, const std::vector<Kernel::V3D> &vertices) {
+  const size_t numberOfTriangles = triangles.size() / 3;
+  if (numberOfTriangles == 0)
+    return;
+
+  std::vector<TriangleBounds> bounds(numberOfTriangles);
+  Bounds meshBounds;
+  for (size_t i = 0; i < numberOfTriangles; ++i) {
+    auto &triangle = bounds[i];
+    triangle.lower = {{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                       std::numeric_limits<double>::max()}};
+    triangle.upper = {{std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+                       std::numeric_limits<double>::lowest()}};
+    for (size_t corner = 0; corner < 3; ++corner) {
+      const auto &vertex = vertices[triangles[3 * i + corner]];
+      for (size_t axis = 0; axis < 3; ++axis) {
+        triangle.lower[axis] = std::min(triangle.lower[axis], vertex[axis]);
+        triangle.upper[axis] = std::max(triangle.upper[axis], vertex[axis]);
+      }
+    }
+    for (size_t axis = 0; axis < 3; ++axis)
+      triangle.centroid[axis] = 0.5 * (triangle.lower[axis] + triangle.upper[axis]);
+    meshBounds.grow(triangle.lower, triangle.upper);
+  }
+  // No triangle edge is longer than the diagonal of the mesh
+  const double dx = meshBounds.upper[0] - meshBounds.lower[0];
+  const double dy = meshBounds.upper[1] - meshBounds.lower[1];
+  const double dz = meshBounds.upper[2] - meshBounds.lower[2];
+  m_tolerance = 1e-7 * std::sqrt(dx * dx + dy * dy + dz * dz);
+
+  m_order.resize(numberOfTriangles);
+  std::iota(m_order.begin(), m_order.end(), 0);
+  m_nodes.reserve(2 * numberOfTriangles / MAX_LEAF_SIZE + 1);
+  build(bounds, 0, numberOfTriangles, 0);
+}
+
+/// @return the largest number of triangles in a leaf
+size_t MeshBVH::maxLeafSize() const {
+  size_t maxSize(0);
+  for (const auto &node : m_nodes)
+    maxSize = std::max(maxSize, static_cast<size_t>(node.count));
+  return maxSize;
+}
+
+/**
+ * Create the node for a range of m_order and, recursively, its children
+ * @param bounds :: The bounds of every triangle
+ * @param begin :: Start of the range of m_order in the node
+ * @param end :: End of the range of m_order in the node
+ * @param depth :: Depth of the node in the tree
+ * @return the index of the node
+ */
+uint32_t MeshBVH::build(const std::vector<TriangleBounds> &bounds, const size_t begin, const size_t end,
+                        const size_t depth) {
+  const auto index = static_cast<uint32_t>(m_nodes.size());
+  m_nodes.emplace_back();
+
+  Bounds nodeBounds, centroidBounds;
+  for (size_t i = begin; i < end; ++i) {
+    const auto &triangle = bounds[m_order[i]];
+    nodeBounds.grow(triangle.lower, triangle.upper);
+    centroidBounds.grow(triangle.centroid, triangle.centroid);
+  }
+  for (size_t axis = 0; axis < 3; ++axis) {
+    m_nodes[index].lower[axis] = nodeBounds.lower[axis] - m_tolerance;
+    m_nodes[index].upper[axis] = nodeBounds.upper[axis] + m_tolerance;
+  }
+
+  const size_t count = end - begin;
+  const auto makeLeaf = [this, index, begin, count]() {
+    m_nodes[index].offset = static_cast<uint32_t>(begin);
+    m_nodes[index].count = static_cast<uint32_t>(count);
+    m_nodes[index].axis = 0;
+    return index;
+  };
+  if (count <= MAX_LEAF_SIZE || depth + 2 >= MAX_DEPTH)
+    return makeLeaf();
+
+  // Find the cheapest split between the bins of the centroids on any axis
+  double bestCost = std::numeric_limits<double>::max();
+  size_t bestAxis(0), bestSplit(0);
+  for (size_t axis = 0; axis < 3; ++axis) {
+    const double extent = centroidBounds.upper[axis] - centroidBounds.lower[axis];
+    if (extent <= 0.)
+      continue;
+    std::array<Bin, NUMBER_OF_BINS> bins;
+    const double scale = static_cast<double>(NUMBER_OF_BINS) / extent;
+    for (size_t i = begin; i < end; ++i) {
+      const auto &triangle = bounds[m_order[i]];
+      const auto bin = binIndex(triangle.centroid[axis], centroidBounds.lower[axis], scale);
+      bins[bin].bounds.grow(triangle.lower, triangle.upper);
+      ++bins[bin].count;
+    }
+    // Sweep from the right to get the cost of each right hand side
+    std::array<double, NUMBER_OF_BINS> rightCost{};
+    Bounds right;
+    size_t rightCount(0);
+    for (size_t bin = NUMBER_OF_BINS - 1; bin > 0; --bin) {
+      right.grow(bins[bin].bounds);
+      rightCount += bins[bin].count;
+      rightCost[bin] = right.halfArea() * static_cast<double>(rightCount);
+    }
+    Bounds left;
+    size_t leftCount(0);
+    for (size_t split = 1; split < NUMBER_OF_BINS; ++split) {
+      left.grow(bins[split - 1].bounds);
+      leftCount += bins[split - 1].count;
+      if (leftCount == 0 || leftCount == count)
+        continue;
+      const double cost = left.halfArea() * static_cast<double>(leftCount) + rightCost[split];
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestAxis = axis;
+        bestSplit = split;
+      }
+    }
+  }
+
+  size_t middle;
+  if (bestSplit == 0) {
+    // All centroids coincide: split the range in half to keep the tree shallow
+    middle = begin + count / 2;
+  } else {
+    const double leafCost = static_cast<double>(count);
+    const double splitCost = TRAVERSAL_COST + bestCost / nodeBounds.halfArea();
+    if (splitCost >= leafCost && count <= 4 * MAX_LEAF_SIZE)
+      return makeLeaf();
+    const double lowerCentroid = centroidBounds.lower[bestAxis];
+    const double scale = static_cast<double>(NUMBER_OF_BINS) /
+                         (centroidBounds.upper[bestAxis] - centroidBounds.lower[bestAxis]);
+    const auto it = std::partition(m_order.begin() + begin, m_order.begin() + end,
+                                   [&bounds, bestAxis, bestSplit, lowerCentroid, scale](const uint32_t triangle) {
+                                     return binIndex(bounds[triangle].centroid[bestAxis], lowerCentroid, scale) <
+                                            bestSplit;
+                                   });
+    middle = static_cast<size_t>(it - m_order.begin());
+  }
+
+  m_nodes[index].count = 0;
+  m_nodes[index].axis = static_cast<uint32_t>(bestAxis);
+  build(bounds, begin, middle, depth + 1);
+  m_nodes[index].offset = build(bounds, middle, end, depth + 1);
+  return index;
+}
+
+} // namespace Mantid::Geometry
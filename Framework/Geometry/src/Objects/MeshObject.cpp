@@ -5,6 +5,7 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidGeometry/Objects/MeshObject.h"
+#include "MantidGeometry/Objects/MeshBVH.h"
 #include "MantidGeometry/Objects/MeshObjectCommon.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/RandomPoint.h"
@@ -15,7 +16,9 @@
 #include "MantidKernel/Material.h"
 
 #include <algorithm>
+#include <limits>
 #include <memory>
+#include <tuple>
 #include <utility>
 
 namespace Mantid::Geometry {
@@ -76,32 +79,19 @@ bool MeshObject::isValid(const Kernel::V3D &point) const {
   }
 
   Kernel::V3D direction(0.0, 0.0, 1.0); // direction to look for intersections
-  std::vector<Kernel::V3D> intersectionPoints;
-  std::vector<TrackDirection> entryExitFlags;
-
-  getIntersections(point, direction, intersectionPoints, entryExitFlags);
+  Kernel::V3D intersection;
+  TrackDirection entryExit;
 
-  if (intersectionPoints.empty()) {
+  if (!getNearestIntersection(point, direction, intersection, entryExit)) {
     return false;
   }
 
   // True if point is on surface
-  const auto it = std::find_if(
-      intersectionPoints.cbegin(), intersectionPoints.cend(),
-      [this, &point](const auto &intersectionPoint) { return point.distance(intersectionPoint) < M_TOLERANCE; });
-  if (it != intersectionPoints.cend())
+  if (point.distance(intersection) < M_TOLERANCE)
     return true;
 
-  // Look for nearest point then check its entry-exit flag
-  double nearestPointDistance = point.distance(intersectionPoints[0]);
-  size_t nearestPointIndex = 0;
-  for (size_t i = 1; i < intersectionPoints.size(); ++i) {
-    if (point.distance(intersectionPoints[i]) < nearestPointDistance) {
-      nearestPointDistance = point.distance(intersectionPoints[i]);
-      nearestPointIndex = i;
-    }
-  }
-  return (entryExitFlags[nearestPointIndex] == TrackDirection::LEAVING);
+  // Otherwise check the entry-exit flag of the nearest point
+  return (entryExit == TrackDirection::LEAVING);
 }
 
 /**
@@ -174,13 +164,22 @@ int MeshObject::interceptSurface(Geometry::Track &UT) const {
  * @throws std::runtime_error if no intersection was found
  */
 double MeshObject::distance(const Track &track) const {
-  Kernel::V3D vertex1, vertex2, vertex3, intersection;
+  // Use the intersection with the lowest triangle index, as a scan of the
+  // triangles in order would find
+  size_t firstTriangle = numberOfTriangles();
+  Kernel::V3D vertex1, vertex2, vertex3, intersection, firstIntersection;
   TrackDirection unused;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
-    if (MeshObjectCommon::rayIntersectsTriangle(track.startPoint(), track.direction(), vertex1, vertex2, vertex3,
+  bvh().traverse(track.startPoint(), track.direction(), [&](const size_t i) {
+    if (i < firstTriangle && getTriangle(i, vertex1, vertex2, vertex3) &&
+        MeshObjectCommon::rayIntersectsTriangle(track.startPoint(), track.direction(), vertex1, vertex2, vertex3,
                                                 intersection, unused)) {
-      return track.startPoint().distance(intersection);
+      firstTriangle = i;
+      firstIntersection = intersection;
     }
+    return std::numeric_limits<double>::max();
+  });
+  if (firstTriangle < numberOfTriangles()) {
+    return track.startPoint().distance(firstIntersection);
   }
   std::ostringstream os;
   os << "Unable to find intersection with object with track starting at " << track.startPoint() << " in direction "
@@ -201,15 +200,79 @@ void MeshObject::getIntersections(const Kernel::V3D &start, const Kernel::V3D &d
 
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   TrackDirection entryExit;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  std::vector<std::tuple<size_t, Kernel::V3D, TrackDirection>> intersections;
+  bvh().traverse(start, direction, [&](const size_t i) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(start, direction, vertex1, vertex2, vertex3, intersection, entryExit)) {
-      intersectionPoints.emplace_back(intersection);
-      entryExitFlags.emplace_back(entryExit);
+      intersections.emplace_back(i, intersection, entryExit);
     }
+    return std::numeric_limits<double>::max();
+  });
+  // Keep the order of the triangles, which decides which of the duplicate
+  // points on shared edges a Track keeps
+  std::sort(intersections.begin(), intersections.end(),
+            [](const auto &lhs, const auto &rhs) { return std::get<0>(lhs) < std::get<0>(rhs); });
+  for (const auto &[i, point, flag] : intersections) {
+    intersectionPoints.emplace_back(point);
+    entryExitFlags.emplace_back(flag);
   }
   // still need to deal with edge cases
 }
 
+/**
+ * Get the intersection nearest to the start of a ray. Of several at the same
+ * distance, the one with the lowest triangle index is used.
+ * @param start :: Start point of ray
+ * @param direction :: Unit vector in the direction of the ray
+ * @param intersection :: The nearest intersection point, if there is one
+ * @param entryExit :: Whether the ray enters or leaves at the nearest point
+ * @returns true if the ray intersects the mesh
+ */
+bool MeshObject::getNearestIntersection(const Kernel::V3D &start, const Kernel::V3D &direction,
+                                        Kernel::V3D &intersection, TrackDirection &entryExit) const {
+  size_t nearestTriangle = numberOfTriangles();
+  double nearestDistance = std::numeric_limits<double>::max();
+  Kernel::V3D vertex1, vertex2, vertex3, point;
+  TrackDirection flag;
+  bvh().traverse(start, direction, [&](const size_t i) {
+    getTriangle(i, vertex1, vertex2, vertex3);
+    if (MeshObjectCommon::rayIntersectsTriangle(start, direction, vertex1, vertex2, vertex3, point, flag)) {
+      const double distance = start.distance(point);
+      if (distance < nearestDistance || (distance == nearestDistance && i < nearestTriangle)) {
+        nearestTriangle = i;
+        nearestDistance = distance;
+        intersection = point;
+        entryExit = flag;
+      }
+    }
+    return nearestDistance;
+  });
+  return nearestTriangle < numberOfTriangles();
+}
+
+/**
+ * Get the bounding volume hierarchy of the triangles, building it on first use
+ * @returns The bounding volume hierarchy
+ */
+const MeshBVH &MeshObject::bvh() const {
+  auto bvh = std::atomic_load(&m_bvh);
+  if (!bvh) {
+    std::lock_guard<std::mutex> lock(m_bvhMutex);
+    bvh = std::atomic_load(&m_bvh);
+    if (!bvh) {
+      bvh = std::make_shared<const MeshBVH>(m_triangles, m_vertices);
+      std::atomic_store(&m_bvh, bvh);
+    }
+  }
+  return *bvh;
+}
+
+/**
+ * Discard the bounding volume hierarchy so it is built again for the moved
+ * vertices. This must not be called while the object is used by other threads.
+ */
+void MeshObject::resetBVH() { std::atomic_store(&m_bvh, std::shared_ptr<const MeshBVH>()); }
+
 /*
  * Get a triangle - useful for iterating over triangles
  * @param index :: Index of triangle in MeshObject
@@ -476,6 +539,7 @@ std::shared_ptr<GeometryHandler> MeshObject::getGeometryHandler() const {
 void MeshObject::rotate(const Kernel::Matrix<double> &rotationMatrix) {
   std::for_each(m_vertices.begin(), m_vertices.end(),
                 [&rotationMatrix](auto &vertex) { vertex.rotate(rotationMatrix); });
+  resetBVH();
 }
 
 /**
@@ -485,6 +549,7 @@ void MeshObject::rotate(const Kernel::Matrix<double> &rotationMatrix) {
 void MeshObject::translate(const Kernel::V3D &translationVector) {
   std::transform(m_vertices.cbegin(), m_vertices.cend(), m_vertices.begin(),
                  [&translationVector](const auto &vertex) { return vertex + translationVector; });
+  resetBVH();
 }
 
 /**
@@ -494,6 +559,7 @@ void MeshObject::translate(const Kernel::V3D &translationVector) {
 void MeshObject::scale(const double scaleFactor) {
   std::transform(m_vertices.cbegin(), m_vertices.cend(), m_vertices.begin(),
                  [&scaleFactor](const auto &vertex) { return vertex * scaleFactor; });
+  resetBVH();
 }
 
 /**
@@ -519,6 +585,7 @@ void MeshObject::multiply(const Kernel::Matrix<double> &matrix) {
     Kernel::V3D newvertex(vertexout[0], vertexout[1], vertexout[2]);
     vertex = newvertex;
   }
+  resetBVH();
 }
 
 /**
@@ -189,6 +189,29 @@ public:
     TS_ASSERT_EQUALS(geom_obj->isValid(V3D(-3.3, 0, 0)), false);
   }
 
+  void testIsValidBlockOfPointsMatchesRules() {
+    auto shell_ptr = ComponentCreationHelper::createHollowShell(0.5, 1.0);
+    auto shell = dynamic_cast<CSGObject *>(shell_ptr.get());
+    std::vector<V3D> points;
+    for (double x = -1.2; x < 1.25; x += 0.1) {
+      for (double y = -1.2; y < 1.25; y += 0.1) {
+        points.emplace_back(x, y, 0.);
+      }
+    }
+    // Points on the inner and outer surfaces
+    points.emplace_back(0.5, 0., 0.);
+    points.emplace_back(0., -1., 0.);
+    std::vector<bool> valid;
+    shell->isValid(points, valid);
+    TS_ASSERT_EQUALS(valid.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      TS_ASSERT_EQUALS(valid[i], shell->topRule()->isValid(points[i]));
+      TS_ASSERT_EQUALS(valid[i], shell->isValid(points[i]));
+    }
+    TS_ASSERT_EQUALS(valid[valid.size() - 2], true);
+    TS_ASSERT_EQUALS(valid.back(), true);
+  }
+
   void testIsOnSideSphere() {
     auto geom_obj = ComponentCreationHelper::createSphere(4.1);
     // inside
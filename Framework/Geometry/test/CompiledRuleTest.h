@@ -0,0 +1,148 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/Objects/CompiledRule.h"
+#include "MantidGeometry/Objects/Rules.h"
+#include "MantidGeometry/Surfaces/Cylinder.h"
+#include "MantidGeometry/Surfaces/Plane.h"
+#include "MantidGeometry/Surfaces/Sphere.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid::Geometry;
+using Mantid::Kernel::V3D;
+
+namespace {
+std::unique_ptr<SurfPoint> createSurfPoint(const std::shared_ptr<Surface> &surface, const int keyN) {
+  auto surfPoint = std::make_unique<SurfPoint>();
+  surfPoint->setKey(surface);
+  surfPoint->setKeyN(keyN);
+  return surfPoint;
+}
+} // namespace
+
+class CompiledRuleTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompiledRuleTest *createSuite() { return new CompiledRuleTest(); }
+  static void destroySuite(CompiledRuleTest *suite) { delete suite; }
+
+  CompiledRuleTest() {
+    m_cylinder = std::make_shared<Cylinder>();
+    m_cylinder->setSurface("cz 1.0");
+    m_bottom = std::make_shared<Plane>();
+    m_bottom->setSurface("pz -1.0");
+    m_top = std::make_shared<Plane>();
+    m_top->setSurface("pz 1.0");
+    m_sphere = std::make_shared<Sphere>();
+    m_sphere->setSurface("so 0.5");
+    m_surfaces = {m_cylinder.get(), m_bottom.get(), m_top.get(), m_sphere.get()};
+  }
+
+  void testDefaultConstructedIsEmpty() {
+    CompiledRule compiled;
+    TS_ASSERT(compiled.empty());
+    TS_ASSERT_EQUALS(compiled.size(), 0);
+  }
+
+  void testSurfPointMatchesRule() {
+    const auto rule = createSurfPoint(m_sphere, -4);
+    CompiledRule compiled(*rule, m_surfaces);
+    TS_ASSERT(!compiled.empty());
+    TS_ASSERT_EQUALS(compiled.size(), 1);
+    TS_ASSERT(compiled.isValid(V3D(0, 0, 0)));
+    TS_ASSERT(compiled.isValid(V3D(0.5, 0, 0)));
+    TS_ASSERT(!compiled.isValid(V3D(0.6, 0, 0)));
+  }
+
+  void testCompositeRuleMatchesRuleTree() {
+    const auto rule = createCompositeRule();
+    CompiledRule compiled(*rule, m_surfaces);
+    // One instruction per surface point, none for the operators
+    TS_ASSERT_EQUALS(compiled.size(), 6);
+    Mantid::Kernel::MersenneTwister rng(1234);
+    for (size_t i = 0; i < 10000; ++i) {
+      const V3D point(rng.nextValue(-2., 2.), rng.nextValue(-2., 2.), rng.nextValue(-2., 2.));
+      TS_ASSERT_EQUALS(compiled.isValid(point), rule->isValid(point));
+    }
+    // Points on the surfaces
+    for (const auto &point : {V3D(1, 0, 0), V3D(0, 0, 1), V3D(0, 0, -1), V3D(0, 0.5, 0), V3D(0, 0.5, -1)}) {
+      TS_ASSERT_EQUALS(compiled.isValid(point), rule->isValid(point));
+    }
+  }
+
+  void testBlockOfPointsMatchesSinglePoints() {
+    const auto rule = createCompositeRule();
+    CompiledRule compiled(*rule, m_surfaces);
+    Mantid::Kernel::MersenneTwister rng(5678);
+    std::vector<V3D> points;
+    for (size_t i = 0; i < 1000; ++i)
+      points.emplace_back(rng.nextValue(-2., 2.), rng.nextValue(-2., 2.), rng.nextValue(-2., 2.));
+    std::vector<bool> valid{true};
+    compiled.isValid(points, valid);
+    TS_ASSERT_EQUALS(valid.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      TS_ASSERT_EQUALS(valid[i], compiled.isValid(points[i]));
+    }
+  }
+
+  void testMissingLeavesMatchRuleTree() {
+    const V3D origin(0, 0, 0);
+    const Intersection intersection(createSurfPoint(m_sphere, -4), nullptr);
+    TS_ASSERT_EQUALS(CompiledRule(intersection, m_surfaces).isValid(origin), false);
+    const Union unionRule(nullptr, createSurfPoint(m_sphere, -4));
+    TS_ASSERT_EQUALS(CompiledRule(unionRule, m_surfaces).isValid(origin), true);
+    const Union emptyUnion;
+    TS_ASSERT_EQUALS(CompiledRule(emptyUnion, m_surfaces).isValid(origin), false);
+    const CompGrp complement;
+    CompiledRule compiledComplement(complement, m_surfaces);
+    TS_ASSERT(!compiledComplement.empty());
+    TS_ASSERT_EQUALS(compiledComplement.size(), 0);
+    TS_ASSERT_EQUALS(compiledComplement.isValid(origin), true);
+  }
+
+  void testUnknownRulesAreEvaluatedThroughTheTree() {
+    auto alwaysTrue = std::make_unique<BoolValue>();
+    alwaysTrue->setStatus(1);
+    const Intersection rule(createSurfPoint(m_sphere, -4), std::move(alwaysTrue));
+    CompiledRule compiled(rule, m_surfaces);
+    TS_ASSERT_EQUALS(compiled.size(), 2);
+    TS_ASSERT(compiled.isValid(V3D(0, 0, 0)));
+    TS_ASSERT(!compiled.isValid(V3D(1, 0, 0)));
+  }
+
+  void testSurfacesMissingFromTheListAreAdded() {
+    const auto rule = createCompositeRule();
+    CompiledRule compiled(*rule, {});
+    Mantid::Kernel::MersenneTwister rng(91011);
+    for (size_t i = 0; i < 1000; ++i) {
+      const V3D point(rng.nextValue(-2., 2.), rng.nextValue(-2., 2.), rng.nextValue(-2., 2.));
+      TS_ASSERT_EQUALS(compiled.isValid(point), rule->isValid(point));
+    }
+  }
+
+private:
+  /// (-cylinder bottom -top) #(-sphere) : (-sphere : -bottom)
+  std::unique_ptr<Rule> createCompositeRule() const {
+    auto body = std::make_unique<Intersection>(
+        createSurfPoint(m_cylinder, -1),
+        std::make_unique<Intersection>(createSurfPoint(m_bottom, 2), createSurfPoint(m_top, -3)));
+    auto hole = std::make_unique<CompGrp>(nullptr, createSurfPoint(m_sphere, -4));
+    return std::make_unique<Union>(
+        std::make_unique<Intersection>(std::move(body), std::move(hole)),
+        std::make_unique<Union>(createSurfPoint(m_sphere, -4), createSurfPoint(m_bottom, -2)));
+  }
+
+  std::shared_ptr<Cylinder> m_cylinder;
+  std::shared_ptr<Plane> m_bottom;
+  std::shared_ptr<Plane> m_top;
+  std::shared_ptr<Sphere> m_sphere;
+  std::vector<const Surface *> m_surfaces;
+};
@@ -0,0 +1,157 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/Objects/MeshBVH.h"
+#include "MantidGeometry/Objects/MeshObjectCommon.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+#include <limits>
+#include <set>
+
+using Mantid::Geometry::MeshBVH;
+using Mantid::Geometry::TrackDirection;
+using Mantid::Kernel::V3D;
+
+namespace {
+/// A sphere of the given radius made of 2 * nTheta * nPhi triangles
+void createSphere(const double radius, const size_t nTheta, const size_t nPhi, std::vector<uint32_t> &triangles,
+                  std::vector<V3D> &vertices) {
+  for (size_t i = 0; i <= nTheta; ++i) {
+    const double theta = M_PI * static_cast<double>(i) / static_cast<double>(nTheta);
+    for (size_t j = 0; j < nPhi; ++j) {
+      const double phi = 2. * M_PI * static_cast<double>(j) / static_cast<double>(nPhi);
+      vertices.emplace_back(radius * std::sin(theta) * std::cos(phi), radius * std::sin(theta) * std::sin(phi),
+                            radius * std::cos(theta));
+    }
+  }
+  for (size_t i = 0; i < nTheta; ++i) {
+    for (size_t j = 0; j < nPhi; ++j) {
+      const auto a = static_cast<uint32_t>(i * nPhi + j);
+      const auto b = static_cast<uint32_t>(i * nPhi + (j + 1) % nPhi);
+      const auto c = static_cast<uint32_t>((i + 1) * nPhi + j);
+      const auto d = static_cast<uint32_t>((i + 1) * nPhi + (j + 1) % nPhi);
+      triangles.insert(triangles.end(), {a, c, b, b, c, d});
+    }
+  }
+}
+
+bool intersects(const std::vector<uint32_t> &triangles, const std::vector<V3D> &vertices, const size_t i,
+                const V3D &start, const V3D &direction, V3D &intersection) {
+  TrackDirection unused;
+  return Mantid::Geometry::MeshObjectCommon::rayIntersectsTriangle(
+      start, direction, vertices[triangles[3 * i]], vertices[triangles[3 * i + 1]], vertices[triangles[3 * i + 2]],
+      intersection, unused);
+}
+} // namespace
+
+class MeshBVHTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MeshBVHTest *createSuite() { return new MeshBVHTest(); }
+  static void destroySuite(MeshBVHTest *suite) { delete suite; }
+
+  MeshBVHTest() { createSphere(2., 30, 60, m_triangles, m_vertices); }
+
+  void test_Empty_Mesh_Visits_Nothing() {
+    MeshBVH bvh({}, {});
+    TS_ASSERT_EQUALS(bvh.numberOfNodes(), 0);
+    size_t visited(0);
+    bvh.traverse(V3D(0, 0, 0), V3D(1, 0, 0), [&visited](const size_t) {
+      ++visited;
+      return std::numeric_limits<double>::max();
+    });
+    TS_ASSERT_EQUALS(visited, 0);
+  }
+
+  void test_Tree_Has_Small_Leaves() {
+    MeshBVH bvh(m_triangles, m_vertices);
+    TS_ASSERT_LESS_THAN(1, bvh.numberOfNodes());
+    TS_ASSERT_LESS_THAN_EQUALS(bvh.maxLeafSize(), 16);
+  }
+
+  void test_Traverse_Visits_Every_Intersected_Triangle_Once() {
+    MeshBVH bvh(m_triangles, m_vertices);
+    Mantid::Kernel::MersenneTwister rng(87423);
+    const size_t numberOfTriangles = m_triangles.size() / 3;
+    size_t totalVisited(0);
+    for (size_t ray = 0; ray < 200; ++ray) {
+      const V3D start(rng.nextValue(-3., 3.), rng.nextValue(-3., 3.), rng.nextValue(-3., 3.));
+      V3D direction(rng.nextValue(-1., 1.), rng.nextValue(-1., 1.), rng.nextValue(-1., 1.));
+      direction.normalize();
+      std::multiset<size_t> visited;
+      bvh.traverse(start, direction, [&visited](const size_t i) {
+        visited.insert(i);
+        return std::numeric_limits<double>::max();
+      });
+      V3D intersection;
+      for (size_t i = 0; i < numberOfTriangles; ++i) {
+        if (intersects(m_triangles, m_vertices, i, start, direction, intersection)) {
+          TS_ASSERT_EQUALS(visited.count(i), 1);
+        }
+      }
+      totalVisited += visited.size();
+    }
+    // The point of the tree: far fewer triangles are tested than a scan
+    TS_ASSERT_LESS_THAN(totalVisited, 200 * numberOfTriangles / 10);
+  }
+
+  void test_Axis_Aligned_Rays_Find_Their_Triangles() {
+    MeshBVH bvh(m_triangles, m_vertices);
+    const size_t numberOfTriangles = m_triangles.size() / 3;
+    // Zero direction components and starts on the poles and the equator
+    for (const auto &start : {V3D(0, 0, 0), V3D(0, 0, 2), V3D(2, 0, 0), V3D(0.3, -0.4, -5)}) {
+      for (const auto &direction : {V3D(1, 0, 0), V3D(0, -1, 0), V3D(0, 0, 1), V3D(0, 0, -1)}) {
+        std::set<size_t> visited;
+        bvh.traverse(start, direction, [&visited](const size_t i) {
+          visited.insert(i);
+          return std::numeric_limits<double>::max();
+        });
+        V3D intersection;
+        for (size_t i = 0; i < numberOfTriangles; ++i) {
+          if (intersects(m_triangles, m_vertices, i, start, direction, intersection)) {
+            TS_ASSERT_EQUALS(visited.count(i), 1);
+          }
+        }
+      }
+    }
+  }
+
+  void test_Pruned_Traversal_Finds_The_Nearest_Intersection() {
+    MeshBVH bvh(m_triangles, m_vertices);
+    Mantid::Kernel::MersenneTwister rng(3321);
+    const size_t numberOfTriangles = m_triangles.size() / 3;
+    for (size_t ray = 0; ray < 200; ++ray) {
+      const V3D start(rng.nextValue(-1., 1.), rng.nextValue(-1., 1.), rng.nextValue(-1., 1.));
+      V3D direction(rng.nextValue(-1., 1.), rng.nextValue(-1., 1.), rng.nextValue(-1., 1.));
+      direction.normalize();
+      V3D intersection;
+      double expected = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < numberOfTriangles; ++i) {
+        if (intersects(m_triangles, m_vertices, i, start, direction, intersection))
+          expected = std::min(expected, start.distance(intersection));
+      }
+      double nearest = std::numeric_limits<double>::max();
+      bvh.traverse(start, direction, [&](const size_t i) {
+        if (intersects(m_triangles, m_vertices, i, start, direction, intersection))
+          nearest = std::min(nearest, start.distance(intersection));
+        return nearest;
+      });
+      // Every start is inside the sphere so there is always a hit
+      TS_ASSERT_LESS_THAN(expected, 4.);
+      TS_ASSERT_EQUALS(nearest, expected);
+    }
+  }
+
+private:
+  std::vector<uint32_t> m_triangles;
+  std::vector<V3D> m_vertices;
+};
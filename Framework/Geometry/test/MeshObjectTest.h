@@ -899,6 +899,15 @@ public:
     auto moved = octahedron->getVertices();
     TS_ASSERT_DELTA(moved, checkVector, 1e-8);
   }
+
+  void testDistanceAfterTranslationUsesMovedTriangles() {
+    auto cube = createCube(2.0, V3D(0.0, 0.0, 0.0));
+    // Trace a ray first so the triangles are sorted into a tree
+    TS_ASSERT_DELTA(cube->distance(Track(V3D(-5, 0, 0), V3D(1, 0, 0))), 4.0, 1e-8);
+    cube->translate(V3D(0, 5, 0));
+    TS_ASSERT_DELTA(cube->distance(Track(V3D(-5, 5, 0), V3D(1, 0, 0))), 4.0, 1e-8);
+    TS_ASSERT_THROWS(cube->distance(Track(V3D(-5, 0, 0), V3D(1, 0, 0))), const std::runtime_error &);
+  }
 };
 
 // -----------------------------------------------------------------------------
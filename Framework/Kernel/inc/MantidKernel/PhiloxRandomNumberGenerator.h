@@ -0,0 +1,105 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/PseudoRandomNumberGenerator.h"
+
+#include <array>
+#include <cstdint>
+
+namespace Mantid {
+namespace Kernel {
+/**
+  This implements the Philox4x32-10 counter-based pseudo-random number
+  generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3",
+  SC11) as a specialization of the PseudoRandomNumberGenerator interface.
+
+  Each random number is a pure function of a key and a counter, so a
+  generator is fully described by its (seed, stream, substream) triple and
+  its position in that stream. Any number of independent streams can be
+  created in any order, for example one per (spectrum, chunk of events), and
+  every one of them gives the same numbers whichever thread draws them. This
+  makes Monte Carlo results independent of the number of threads without
+  having to seed the streams in a fixed order first.
+
+  Each stream holds 2^33 doubles before it repeats.
+*/
+class MANTID_KERNEL_DLL PhiloxRandomNumberGenerator final : public PseudoRandomNumberGenerator {
+public:
+  using Block = std::array<uint32_t, 4>;
+  using Key = std::array<uint32_t, 2>;
+
+  /// Construct the generator for a stream with the range [0.0, 1.0)
+  explicit PhiloxRandomNumberGenerator(const uint64_t seed, const uint64_t stream = 0, const uint32_t substream = 0);
+  /// Construct the generator for a stream with the given range
+  PhiloxRandomNumberGenerator(const uint64_t seed, const uint64_t stream, const uint32_t substream, const double start,
+                              const double end);
+
+  PhiloxRandomNumberGenerator(const PhiloxRandomNumberGenerator &) = delete;
+  PhiloxRandomNumberGenerator &operator=(const PhiloxRandomNumberGenerator &) = delete;
+
+  /// Set the random number seed, keeping the stream, and restart the stream
+  void setSeed(const size_t seedValue) override;
+  /// Sets the range of the subsequent calls to nextValue()
+  void setRange(const double start, const double end) override;
+  /// Generate the next random number in the sequence within the default range
+  inline double nextValue() override { return m_start + (m_end - m_start) * nextUnitValue(); }
+  /// Generate the next random number in the sequence within the given range
+  inline double nextValue(double start, double end) override { return start + (end - start) * nextUnitValue(); }
+  /// Return the next integer in the sequence within the given range
+  int nextInt(int start, int end) override;
+  /// Fill values with the next n random numbers within the default range
+  void generate(double *values, const size_t n);
+  /// Resets the generator to the start of its stream
+  void restart() override;
+  /// Saves the current state of the generator
+  void save() override;
+  /// Restores the generator to the last saved point, or the beginning if
+  /// nothing has been saved
+  void restore() override;
+  /// Return the minimum value of the range
+  double min() const override { return m_start; }
+  /// Return the maximum value of the range
+  double max() const override { return m_end; }
+
+  /// Apply the Philox4x32-10 bijection to a counter
+  static Block philox(Block counter, Key key);
+
+private:
+  /// Number of doubles made from one block of the generator
+  static constexpr uint32_t VALUES_PER_BLOCK = 2;
+
+  /// @return the next random number in [0, 1)
+  inline double nextUnitValue() {
+    if (m_next == VALUES_PER_BLOCK)
+      fillBuffer();
+    return m_buffer[m_next++];
+  }
+  void fillBuffer();
+  /// The counter of the given block of this stream
+  Block counter(const uint32_t block) const { return {block, m_substream, m_streamLow, m_streamHigh}; }
+
+  Key m_key;
+  uint32_t m_substream;
+  uint32_t m_streamLow;
+  uint32_t m_streamHigh;
+  /// Minimum in range
+  double m_start;
+  /// Maximum in range
+  double m_end;
+  /// The next block to generate
+  uint32_t m_block{0};
+  /// The numbers of the last block generated, in [0, 1)
+  std::array<double, VALUES_PER_BLOCK> m_buffer{};
+  /// Index of the next number in the buffer
+  uint32_t m_next{VALUES_PER_BLOCK};
+  /// Position saved by save()
+  uint32_t m_savedBlock{0};
+  uint32_t m_savedNext{VALUES_PER_BLOCK};
+};
+} // namespace Kernel
+} // namespace Mantid
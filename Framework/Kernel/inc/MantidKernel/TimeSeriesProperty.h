@@ -14,8 +14,11 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 // Forward declare
 namespace NeXus {
@@ -97,6 +100,7 @@ public:
   explicit TimeSeriesProperty(const std::string &name);
   TimeSeriesProperty(const std::string &name, const std::vector<Types::Core::DateAndTime> &times,
                      const std::vector<TYPE> &values);
+  TimeSeriesProperty(const TimeSeriesProperty &other);
 
   /// Virtual destructor
   ~TimeSeriesProperty() override;
@@ -312,6 +316,10 @@ private:
   bool isTimeFiltered(const Types::Core::DateAndTime &time) const;
   /// Time weighted mean and standard deviation
   std::pair<double, double> timeAverageValueAndStdDev() const;
+  /// Build the cached times and value integral if they are out of date
+  void buildTimeIndex() const;
+  /// Mark the cached times and value integral as out of date
+  void invalidateTimeIndex() const { m_timeIndexValid = false; }
 
   /// Holds the time series data
   mutable std::vector<TimeValueUnit<TYPE>> m_values;
@@ -329,6 +337,15 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+
+  /// Cached copy of the sorted times, in nanoseconds, for searching
+  mutable std::vector<int64_t> m_indexTimes;
+  /// Cached integral of the value over time (value x seconds) from the first time up to each time
+  mutable std::vector<double> m_valueIntegral;
+  /// True if m_indexTimes and m_valueIntegral match m_values
+  mutable std::atomic<bool> m_timeIndexValid;
+  /// Serialises building m_indexTimes and m_valueIntegral from const methods
+  mutable std::mutex m_timeIndexMutex;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
@@ -0,0 +1,178 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidKernel/PhiloxRandomNumberGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Mantid::Kernel {
+
+namespace {
+// Constants of Philox4x32 from Salmon et al.
+constexpr uint32_t PHILOX_M0 = 0xD2511F53;
+constexpr uint32_t PHILOX_M1 = 0xCD9E8D57;
+constexpr uint32_t PHILOX_W0 = 0x9E3779B9;
+constexpr uint32_t PHILOX_W1 = 0xBB67AE85;
+constexpr int PHILOX_ROUNDS = 10;
+
+/// A double in [0, 1) made from the 53 high bits of two 32 bit integers
+inline double toUnitValue(const uint32_t high, const uint32_t low) {
+  return (static_cast<double>(high >> 5) * 67108864. + static_cast<double>(low >> 6)) * (1. / 9007199254740992.);
+}
+} // namespace
+
+//------------------------------------------------------------------------------
+// Public member functions
+//------------------------------------------------------------------------------
+
+/**
+ * Constructor for a stream with the range [0.0, 1.0)
+ * @param seed :: The seed shared by all the streams of a calculation
+ * @param stream :: The stream, e.g. a spectrum number
+ * @param substream :: The part of the stream, e.g. a chunk of events
+ */
+PhiloxRandomNumberGenerator::PhiloxRandomNumberGenerator(const uint64_t seed, const uint64_t stream,
+                                                         const uint32_t substream)
+    : PhiloxRandomNumberGenerator(seed, stream, substream, 0.0, 1.0) {}
+
+/**
+ * Constructor for a stream with a range
+ * @param seed :: The seed shared by all the streams of a calculation
+ * @param stream :: The stream, e.g. a spectrum number
+ * @param substream :: The part of the stream, e.g. a chunk of events
+ * @param start :: The minimum value a generated number should take
+ * @param end :: The maximum value a generated number should take
+ */
+PhiloxRandomNumberGenerator::PhiloxRandomNumberGenerator(const uint64_t seed, const uint64_t stream,
+                                                         const uint32_t substream, const double start,
+                                                         const double end)
+    : m_key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}, m_substream(substream),
+      m_streamLow(static_cast<uint32_t>(stream)), m_streamHigh(static_cast<uint32_t>(stream >> 32)), m_start(start),
+      m_end(end) {}
+
+/**
+ * (Re-)seed the generator and go back to the start of the stream. This resets
+ * the current saved state
+ * @param seedValue :: A seed for the generator
+ */
+void PhiloxRandomNumberGenerator::setSeed(const size_t seedValue) {
+  const auto seed = static_cast<uint64_t>(seedValue);
+  m_key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+  restart();
+  save();
+}
+
+/**
+ * Sets the range of the subsequent calls to nextValue()
+ * @param start :: The lowest value a call to nextValue() will produce
+ * @param end :: The largest value a call to nextValue() will produce
+ */
+void PhiloxRandomNumberGenerator::setRange(const double start, const double end) {
+  m_start = start;
+  m_end = end;
+}
+
+/**
+ * Returns the next integer in the stream
+ * @param start Start of the requested range
+ * @param end End of the requested range, included
+ * @return An integer in the defined range
+ */
+int PhiloxRandomNumberGenerator::nextInt(int start, int end) {
+  if (end < start)
+    throw std::invalid_argument("PhiloxRandomNumberGenerator::nextInt: end must not be less than start");
+  const auto range = static_cast<int64_t>(end) - static_cast<int64_t>(start) + 1;
+  const auto offset = static_cast<int64_t>(std::floor(nextUnitValue() * static_cast<double>(range)));
+  return static_cast<int>(start + std::min(offset, range - 1));
+}
+
+/**
+ * Fill an array with the next random numbers of the stream, within the
+ * default range. This gives the same numbers as calling nextValue() n times,
+ * but the whole blocks are generated in a loop the compiler can vectorise.
+ * @param values :: The start of an array of at least n values
+ * @param n :: The number of values to generate
+ */
+void PhiloxRandomNumberGenerator::generate(double *values, const size_t n) {
+  size_t i = 0;
+  for (; i < n && m_next < VALUES_PER_BLOCK; ++i)
+    values[i] = nextValue();
+
+  const double width = m_end - m_start;
+  const size_t nBlocks = (n - i) / VALUES_PER_BLOCK;
+  for (size_t block = 0; block < nBlocks; ++block) {
+    const auto random = philox(counter(m_block + static_cast<uint32_t>(block)), m_key);
+    values[i + VALUES_PER_BLOCK * block] = m_start + width * toUnitValue(random[0], random[1]);
+    values[i + VALUES_PER_BLOCK * block + 1] = m_start + width * toUnitValue(random[2], random[3]);
+  }
+  m_block += static_cast<uint32_t>(nBlocks);
+  i += VALUES_PER_BLOCK * nBlocks;
+
+  for (; i < n; ++i)
+    values[i] = nextValue();
+}
+
+/**
+ * Resets the generator to the start of its stream
+ */
+void PhiloxRandomNumberGenerator::restart() {
+  m_block = 0;
+  m_next = VALUES_PER_BLOCK;
+}
+
+/// Saves the current state of the generator
+void PhiloxRandomNumberGenerator::save() {
+  m_savedBlock = m_block;
+  m_savedNext = m_next;
+}
+
+/// Restores the generator to the last saved point, or the beginning if nothing
+/// has been saved
+void PhiloxRandomNumberGenerator::restore() {
+  m_block = m_savedBlock;
+  if (m_savedNext < VALUES_PER_BLOCK) {
+    // The saved point was part way through the block before
+    --m_block;
+    fillBuffer();
+  }
+  m_next = m_savedNext;
+}
+
+/**
+ * Apply the ten rounds of Philox4x32 to a counter. This is a bijection of the
+ * counter for each key.
+ * @param counter :: The counter to encrypt
+ * @param key :: The key to encrypt it with
+ * @return The four random 32 bit integers for this counter
+ */
+PhiloxRandomNumberGenerator::Block PhiloxRandomNumberGenerator::philox(Block counter, Key key) {
+  for (int round = 0; round < PHILOX_ROUNDS; ++round) {
+    if (round > 0) {
+      key[0] += PHILOX_W0;
+      key[1] += PHILOX_W1;
+    }
+    const uint64_t product0 = static_cast<uint64_t>(PHILOX_M0) * counter[0];
+    const uint64_t product1 = static_cast<uint64_t>(PHILOX_M1) * counter[2];
+    counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+  }
+  return counter;
+}
+
+//------------------------------------------------------------------------------
+// Private member functions
+//------------------------------------------------------------------------------
+
+/// Generate the next block of the stream into the buffer
+void PhiloxRandomNumberGenerator::fillBuffer() {
+  const auto random = philox(counter(m_block++), m_key);
+  m_buffer = {toUnitValue(random[0], random[1]), toUnitValue(random[2], random[3])};
+  m_next = 0;
+}
+
+} // namespace Mantid::Kernel
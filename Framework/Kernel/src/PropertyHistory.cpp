@@ -13,21 +13,49 @@
 #include "MantidKernel/Strings.h"
 
 #include <algorithm>
+#include <array>
 #include <boost/lexical_cast.hpp>
 #include <cstdint>
+#include <mutex>
 #include <ostream>
+#include <unordered_set>
 #include <utility>
 
 namespace Mantid::Kernel {
+namespace {
+/// Number of independently locked parts of the table of interned strings
+constexpr size_t N_INTERN_SHARDS = 64;
+
+/// A part of the table of interned strings with its own lock
+struct InternShard {
+  std::mutex mutex;
+  std::unordered_set<std::string> strings;
+};
+
+/**
+ * Every history record repeats the names and types of its algorithm's
+ * properties, so a single copy of each distinct string is kept. The strings
+ * are spread over several tables by hash so that threads recording histories
+ * concurrently rarely wait for the same lock.
+ * @param str :: The string to look up
+ * @returns A pointer to the stored copy of the string, valid for the lifetime of the program
+ */
+const std::string *intern(std::string str) {
+  static std::array<InternShard, N_INTERN_SHARDS> shards;
+  auto &shard = shards[std::hash<std::string>{}(str) % N_INTERN_SHARDS];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  return &*shard.strings.emplace(std::move(str)).first;
+}
+} // namespace
 
 /// Constructor
 PropertyHistory::PropertyHistory(std::string name, std::string value, std::string type, const bool isdefault,
                                  const unsigned int direction)
-    : m_name(std::move(name)), m_value(std::move(value)), m_type(std::move(type)), m_isDefault(isdefault),
-      m_direction(direction) {}
+    : m_name(intern(std::move(name))), m_value(std::move(value)), m_type(intern(std::move(type))),
+      m_isDefault(isdefault), m_direction(direction) {}
 
 PropertyHistory::PropertyHistory(Property const *const prop)
-    : m_name(prop->name()), m_value(prop->valueAsPrettyStr(0, true)), m_type(prop->type()),
+    : m_name(intern(prop->name())), m_value(prop->valueAsPrettyStr(0, true)), m_type(intern(prop->type())),
       m_isDefault(prop->isDefault()), m_direction(prop->direction()) {}
 
 /** Prints a text representation of itself
@@ -38,7 +66,7 @@ PropertyHistory::PropertyHistory(Property const *const prop)
  * = full length)
  */
 void PropertyHistory::printSelf(std::ostream &os, const int indent, const size_t maxPropertyLength) const {
-  os << std::string(indent, ' ') << "Name: " << m_name;
+  os << std::string(indent, ' ') << "Name: " << *m_name;
   if ((maxPropertyLength > 0) && (m_value.size() > maxPropertyLength)) {
     os << ", Value: " << Strings::shorten(m_value, maxPropertyLength);
   } else {
@@ -81,7 +109,7 @@ bool PropertyHistory::isEmptyDefault() const {
 
   // If default, input, number type and matches empty value then return true
   if (m_isDefault && m_direction != Direction::Output) {
-    if (std::find(numberTypes.begin(), numberTypes.end(), m_type) != numberTypes.end()) {
+    if (std::find(numberTypes.begin(), numberTypes.end(), *m_type) != numberTypes.end()) {
       if (std::find(emptyValues.begin(), emptyValues.end(), m_value) != emptyValues.end()) {
         emptyDefault = true;
       }
@@ -14,7 +14,9 @@
 #include <nexus/NeXusFile.hpp>
 
 #include <boost/regex.hpp>
+#include <algorithm>
 #include <numeric>
+#include <type_traits>
 
 namespace Mantid {
 using namespace Types::Core;
@@ -31,7 +33,7 @@ Logger g_log("TimeSeriesProperty");
 template <typename TYPE>
 TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name)
     : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_values(), m_size(), m_propSortedFlag(),
-      m_filterApplied() {}
+      m_filterApplied(), m_indexTimes(), m_valueIntegral(), m_timeIndexValid(false) {}
 
 /**
  * Constructor
@@ -47,6 +49,29 @@ TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name,
   addValues(times, values);
 }
 
+/**
+ * Copy constructor. The cached time index is copied if it is up to date.
+ * @param other :: The property to copy
+ */
+template <typename TYPE>
+TimeSeriesProperty<TYPE>::TimeSeriesProperty(const TimeSeriesProperty &other)
+    : Property(other), ITimeSeriesProperty(other), m_values(), m_size(), m_propSortedFlag(), m_filterApplied(),
+      m_timeIndexValid(false) {
+  // the values may be being sorted by a const query of other
+  std::lock_guard<std::mutex> lock(other.m_timeIndexMutex);
+  m_values = other.m_values;
+  m_size = other.m_size;
+  m_propSortedFlag = other.m_propSortedFlag;
+  m_filter = other.m_filter;
+  m_filterQuickRef = other.m_filterQuickRef;
+  m_filterApplied = other.m_filterApplied;
+  if (other.m_timeIndexValid) {
+    m_indexTimes = other.m_indexTimes;
+    m_valueIntegral = other.m_valueIntegral;
+    m_timeIndexValid = true;
+  }
+}
+
 /// Virtual destructor
 template <typename TYPE> TimeSeriesProperty<TYPE>::~TimeSeriesProperty() = default;
 
@@ -122,7 +147,8 @@ template <> std::unique_ptr<TimeSeriesProperty<double>> TimeSeriesProperty<std::
  * */
 template <typename TYPE> size_t TimeSeriesProperty<TYPE>::getMemorySize() const {
   // Rough estimate
-  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime)) +
+         m_indexTimes.size() * sizeof(int64_t) + m_valueIntegral.size() * sizeof(double);
 }
 
 /**
@@ -146,6 +172,7 @@ template <typename TYPE> TimeSeriesProperty<TYPE> &TimeSeriesProperty<TYPE>::ope
     if (this->operator!=(*rhs)) {
       m_values.insert(m_values.end(), rhs->m_values.begin(), rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      invalidateTimeIndex();
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -307,6 +334,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Types::Core::DateAndTime &star
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
+  invalidateTimeIndex();
 }
 
 /**
@@ -380,6 +408,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(const std::vector<SplittingInterval
   mp_copy.clear();
 
   m_size = static_cast<int>(m_values.size());
+  invalidateTimeIndex();
 }
 
 /**
@@ -400,7 +429,7 @@ template <typename TYPE>
 void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &splitter, std::vector<Property *> outputs,
                                            bool isPeriodic) const {
   // 0. Sort if necessary
-  sortIfNecessary();
+  buildTimeIndex();
 
   if (outputs.empty())
     return;
@@ -421,6 +450,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &split
         myOutput->m_values.clear();
         myOutput->m_size = 0;
       }
+      myOutput->invalidateTimeIndex();
     } else {
       outputs_tsp.emplace_back(nullptr);
     }
@@ -458,8 +488,8 @@ void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &split
     }
 
     // Skip the events before the start of the time
-    while (i_property < m_values.size() && m_values[i_property].time() < start)
-      ++i_property;
+    i_property = std::lower_bound(m_indexTimes.cbegin() + i_property, m_indexTimes.cend(), start.totalNanoseconds()) -
+                 m_indexTimes.cbegin();
 
     if (i_property == m_values.size()) {
       // i_property is out of the range. Then use the last entry
@@ -517,16 +547,14 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
   if (output.empty())
     return;
 
-  sortIfNecessary();
-
-  // work on m_values, m_size, and m_time
-  auto const currentTimes = timesAsVector();
-  auto const currentValues = valuesAsVector();
+  // search the cached times rather than copying the times and values out
+  buildTimeIndex();
+  const auto &currentTimes = m_indexTimes;
   size_t index_splitter = 0;
 
   // move splitter index such that the first entry of TSP is before the stop
   // time of a splitter
-  DateAndTime firstPropTime = currentTimes[0];
+  DateAndTime firstPropTime = m_values.front().time();
   auto firstFilterTime = std::lower_bound(timeToFilterTo.begin(), timeToFilterTo.end(), firstPropTime);
   if (firstFilterTime == timeToFilterTo.end()) {
     // do nothing as the first TimeSeriesProperty entry's time is before any
@@ -541,7 +569,8 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
   DateAndTime filterEndTime;
 
   // move along the entries to find the entry inside the current splitter
-  auto firstEntryInSplitter = std::lower_bound(currentTimes.begin(), currentTimes.end(), filterStartTime);
+  auto firstEntryInSplitter =
+      std::lower_bound(currentTimes.begin(), currentTimes.end(), filterStartTime.totalNanoseconds());
   if (firstEntryInSplitter == currentTimes.end()) {
     // the first splitter's start time is LATER than the last TSP entry, then
     // there won't be any
@@ -558,7 +587,7 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
   // before it. so the index for firstEntryInSplitter is the first TSP entry
   // in the splitter
   size_t timeIndex = firstEntryInSplitter - currentTimes.begin();
-  firstPropTime = *firstEntryInSplitter;
+  firstPropTime = m_values[timeIndex].time();
 
   for (; index_splitter < timeToFilterTo.size() - 1; ++index_splitter) {
     int wsIndex = inputWorkspaceIndicies[index_splitter];
@@ -577,18 +606,18 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
     if (timeIndex >= numEntries) {
       // We have run out of TSP entries, so use the last TSP value
       // for all remaining outputs
-      auto currentTime = currentTimes.back();
+      auto currentTime = m_values.back().time();
       if (output[wsIndex]->size() == 0 || output[wsIndex]->lastTime() != currentTime) {
-        output[wsIndex]->addValue(currentTime, currentValues.back());
+        output[wsIndex]->addValue(currentTime, m_values.back().value());
       }
     } else {
       // Add TSP values until we run out or go past the current filter
       // end time.
       for (; timeIndex < numEntries; ++timeIndex) {
-        auto currentTime = currentTimes[timeIndex];
+        auto currentTime = m_values[timeIndex].time();
         if (output[wsIndex]->size() == 0 || output[wsIndex]->lastTime() < currentTime) {
           // avoid to add duplicate entry
-          output[wsIndex]->addValue(currentTime, currentValues[timeIndex]);
+          output[wsIndex]->addValue(currentTime, m_values[timeIndex].value());
         }
         if (currentTime > filterEndTime)
           break;
@@ -822,7 +851,9 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(const std::vector<Splittin
     return static_cast<double>(m_values.front().value());
   }
 
-  sortIfNecessary();
+  buildTimeIndex();
+  const auto timesBegin = m_indexTimes.cbegin();
+  const auto timesEnd = m_indexTimes.cend();
 
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
@@ -830,20 +861,25 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(const std::vector<Splittin
     // Calculate the total time duration (in seconds) within by the filter
     totalTime += time.duration();
 
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = static_cast<double>(getSingleValue(time.start(), index));
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator += DateAndTime::secondsFromDuration(m_values[index].time() - startTime) * value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
+    // The entry whose value holds at the start of the filter range: the last
+    // one at or before it, or the first entry if the range starts earlier
+    const auto startIter = std::upper_bound(timesBegin, timesEnd, time.start().totalNanoseconds());
+    const auto first = static_cast<size_t>(std::max(startIter - timesBegin - 1, std::ptrdiff_t(0)));
+    // The last entry before the end of the filter range
+    const auto stopIter = std::lower_bound(timesBegin, timesEnd, time.stop().totalNanoseconds());
+    const auto last = std::max(first, static_cast<size_t>(std::max(stopIter - timesBegin - 1, std::ptrdiff_t(0))));
+
+    const double firstValue = static_cast<double>(m_values[first].value());
+    if (first == last) {
+      numerator += DateAndTime::secondsFromDuration(time.stop() - time.start()) * firstValue;
+    } else {
+      // Partial step at the start, whole steps in between from the cached
+      // integral, then close off with the end of the current filter range
+      numerator += DateAndTime::secondsFromDuration(m_values[first + 1].time() - time.start()) * firstValue;
+      numerator += m_valueIntegral[last] - m_valueIntegral[first + 1];
+      numerator += DateAndTime::secondsFromDuration(time.stop() - m_values[last].time()) *
+                   static_cast<double>(m_values[last].value());
     }
-
-    // Now close off with the end of the current filter range
-    numerator += DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
   }
 
   // 'Normalise' by the total time
@@ -1075,6 +1111,7 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time, co
   }
 
   m_filterApplied = false;
+  invalidateTimeIndex();
 }
 
 /** Add a value to the map
@@ -1115,6 +1152,7 @@ void TimeSeriesProperty<TYPE>::addValues(const std::vector<Types::Core::DateAndT
 
   if (!values.empty())
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+  invalidateTimeIndex();
 }
 
 /** replace vectors of values to the map. First we clear the vectors
@@ -1328,6 +1366,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
+  invalidateTimeIndex();
 }
 
 /** Clears out all but the last value in the property.
@@ -1899,6 +1938,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
   // update m_size
   countSize();
+  invalidateTimeIndex();
 
   // 3. Finish
   g_log.warning() << "Log " << this->name() << " has " << numremoved << " entries removed due to duplicated time. "
@@ -1938,7 +1978,39 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::sortIfNecessary() const
     g_log.information("TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
     std::stable_sort(m_values.begin(), m_values.end());
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+    invalidateTimeIndex();
+  }
+}
+
+/** Build the cached copy of the sorted times and the running integral of the
+ * value over time, if they are out of date. Together they let the average over
+ * any time interval be found with two binary searches instead of a scan.
+ * Concurrent const queries of the same log build the index once.
+ */
+template <typename TYPE> void TimeSeriesProperty<TYPE>::buildTimeIndex() const {
+  if (m_timeIndexValid)
+    return;
+  std::lock_guard<std::mutex> lock(m_timeIndexMutex);
+  sortIfNecessary();
+  if (m_timeIndexValid)
+    return;
+
+  const size_t numValues = m_values.size();
+  m_indexTimes.resize(numValues);
+  std::transform(m_values.cbegin(), m_values.cend(), m_indexTimes.begin(),
+                 [](const auto &entry) { return entry.time().totalNanoseconds(); });
+
+  if constexpr (std::is_arithmetic<TYPE>::value) {
+    m_valueIntegral.resize(numValues);
+    double integral(0.0);
+    for (size_t i = 0; i < numValues; ++i) {
+      m_valueIntegral[i] = integral;
+      if (i + 1 < numValues)
+        integral += DateAndTime::secondsFromDuration(m_values[i + 1].time() - m_values[i].time()) *
+                    static_cast<double>(m_values[i].value());
+    }
   }
+  m_timeIndexValid = true;
 }
 
 /** Find the index of the entry of time t in the mP vector (sorted)
@@ -2178,6 +2250,7 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::setValueFromPrope
   m_filter = prop->m_filter;
   m_filterQuickRef = prop->m_filterQuickRef;
   m_filterApplied = prop->m_filterApplied;
+  invalidateTimeIndex();
   return "";
 }
 
@@ -0,0 +1,132 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidKernel/PhiloxRandomNumberGenerator.h"
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+using Mantid::Kernel::PhiloxRandomNumberGenerator;
+
+class PhiloxRandomNumberGeneratorTest : public CxxTest::TestSuite {
+
+public:
+  void test_Philox_Matches_Known_Answers() {
+    // Known answer tests of the reference implementation, Random123
+    auto result = PhiloxRandomNumberGenerator::philox({0, 0, 0, 0}, {0, 0});
+    TS_ASSERT_EQUALS(result, PhiloxRandomNumberGenerator::Block({0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+    result = PhiloxRandomNumberGenerator::philox({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                                 {0xffffffff, 0xffffffff});
+    TS_ASSERT_EQUALS(result, PhiloxRandomNumberGenerator::Block({0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+    result = PhiloxRandomNumberGenerator::philox({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                                 {0xa4093822, 0x299f31d0});
+    TS_ASSERT_EQUALS(result, PhiloxRandomNumberGenerator::Block({0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+  }
+
+  void test_Same_Stream_Gives_Same_Sequence() {
+    PhiloxRandomNumberGenerator gen_1(212437999, 3, 7), gen_2(212437999, 3, 7);
+    TS_ASSERT_EQUALS(doNextValueCalls(25, gen_1), doNextValueCalls(25, gen_2));
+  }
+
+  void test_Different_Seeds_Streams_And_Substreams_Give_Different_Sequences() {
+    PhiloxRandomNumberGenerator reference(212437999, 3, 7);
+    const auto referenceValues = doNextValueCalls(10, reference);
+    PhiloxRandomNumberGenerator otherSeed(247021340, 3, 7), otherStream(212437999, 4, 7),
+        otherSubstream(212437999, 3, 8);
+    const auto otherSeedValues = doNextValueCalls(10, otherSeed);
+    const auto otherStreamValues = doNextValueCalls(10, otherStream);
+    const auto otherSubstreamValues = doNextValueCalls(10, otherSubstream);
+    for (size_t i = 0; i < referenceValues.size(); ++i) {
+      TS_ASSERT_DIFFERS(referenceValues[i], otherSeedValues[i]);
+      TS_ASSERT_DIFFERS(referenceValues[i], otherStreamValues[i]);
+      TS_ASSERT_DIFFERS(referenceValues[i], otherSubstreamValues[i]);
+    }
+  }
+
+  void test_Streams_Do_Not_Depend_On_The_Order_They_Are_Used_In() {
+    PhiloxRandomNumberGenerator first(1, 0), second(1, 1);
+    const auto firstValues = doNextValueCalls(10, first);
+    const auto secondValues = doNextValueCalls(10, second);
+
+    PhiloxRandomNumberGenerator secondAgain(1, 1), firstAgain(1, 0);
+    TS_ASSERT_EQUALS(doNextValueCalls(10, secondAgain), secondValues);
+    TS_ASSERT_EQUALS(doNextValueCalls(10, firstAgain), firstValues);
+  }
+
+  void test_Values_Are_Within_Range() {
+    PhiloxRandomNumberGenerator randGen(39857239, 0, 0, 2.1, 3.4);
+    TS_ASSERT_EQUALS(randGen.min(), 2.1);
+    TS_ASSERT_EQUALS(randGen.max(), 3.4);
+    double sum(0.);
+    for (const auto value : doNextValueCalls(10000, randGen)) {
+      TS_ASSERT_LESS_THAN_EQUALS(2.1, value);
+      TS_ASSERT_LESS_THAN(value, 3.4);
+      sum += value;
+    }
+    TS_ASSERT_DELTA(sum / 10000., 2.75, 0.01);
+  }
+
+  void test_NextInt_Covers_The_Inclusive_Range() {
+    PhiloxRandomNumberGenerator randGen(39857239);
+    std::vector<int> counts(4, 0);
+    for (int i = 0; i < 4000; ++i) {
+      const int value = randGen.nextInt(3, 6);
+      TS_ASSERT(value >= 3 && value <= 6);
+      if (value >= 3 && value <= 6)
+        ++counts[value - 3];
+    }
+    for (const auto count : counts)
+      TS_ASSERT_DELTA(count, 1000, 100);
+    TS_ASSERT_THROWS(randGen.nextInt(1, 0), const std::invalid_argument &);
+  }
+
+  void test_Generate_Gives_Same_Values_As_NextValue() {
+    PhiloxRandomNumberGenerator single(5, 11, 0, -1., 1.), bulk(5, 11, 0, -1., 1.);
+    const auto expected = doNextValueCalls(40, single);
+    // Start part way through a block and end part way through another
+    std::vector<double> values(40);
+    values[0] = bulk.nextValue();
+    bulk.generate(values.data() + 1, 38);
+    values[39] = bulk.nextValue();
+    TS_ASSERT_EQUALS(values, expected);
+  }
+
+  void test_Restart_Gives_Same_Sequence_Again_From_Start() {
+    PhiloxRandomNumberGenerator randGen(39857239, 2);
+    const auto firstValues = doNextValueCalls(11, randGen);
+    randGen.restart();
+    TS_ASSERT_EQUALS(doNextValueCalls(11, randGen), firstValues);
+  }
+
+  void test_Save_Then_Restore_Gives_Sequence_From_Saved_Point() {
+    PhiloxRandomNumberGenerator randGen(1);
+    doNextValueCalls(7, randGen); // Part way through a block
+    randGen.save();
+    const auto firstValues = doNextValueCalls(50, randGen);
+    randGen.restore();
+    TS_ASSERT_EQUALS(doNextValueCalls(50, randGen), firstValues);
+    randGen.restore();
+    TS_ASSERT_EQUALS(doNextValueCalls(50, randGen), firstValues);
+  }
+
+  void test_SetSeed_Restarts_The_Stream_With_The_New_Seed() {
+    PhiloxRandomNumberGenerator randGen(1, 9), expected(42, 9);
+    doNextValueCalls(3, randGen);
+    randGen.setSeed(42);
+    TS_ASSERT_EQUALS(doNextValueCalls(10, randGen), doNextValueCalls(10, expected));
+  }
+
+private:
+  std::vector<double> doNextValueCalls(const unsigned int ncalls, PhiloxRandomNumberGenerator &randGen) {
+    std::vector<double> values(ncalls);
+    for (unsigned int i = 0; i < ncalls; ++i) {
+      values[i] = randGen.nextValue();
+    }
+    return values;
+  }
+};
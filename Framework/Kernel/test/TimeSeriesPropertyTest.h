@@ -13,10 +13,12 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include <algorithm>
 #include <boost/scoped_ptr.hpp>
 #include <cmath>
 #include <json/value.h>
 #include <memory>
+#include <thread>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -627,6 +629,77 @@ public:
     delete intLog;
   }
 
+  void test_averageValueInFilter_is_updated_when_the_log_changes() {
+    auto dblLog = createDoubleTSP();
+    TimeSplitterType filter;
+    filter.emplace_back(SplittingInterval(DateAndTime("2007-11-30T16:17:05"), DateAndTime("2007-11-30T16:17:29")));
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), 7.308, 0.001);
+
+    // Out of order, so the log is sorted again before the next average
+    dblLog->addValue("2007-11-30T16:17:15", 1.0);
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), 142.65 / 24.0, 1e-10);
+
+    dblLog->filterByTime(DateAndTime("2007-11-30T16:17:12"), DateAndTime("2007-11-30T16:17:40"));
+    TS_ASSERT_DELTA(dblLog->averageValueInFilter(filter), (7.55 * 10 + 1.0 * 5 + 5.55 * 9) / 24.0, 1e-10);
+
+    delete dblLog;
+  }
+
+  void test_averageValueInFilter_with_many_intervals() {
+    // value i * i % 7 from i to i + 1 seconds, with a repeated time at 500 s
+    TimeSeriesProperty<double> log("manyValues");
+    const DateAndTime start("2007-11-30T16:17:00");
+    const auto valueAt = [](int i) { return static_cast<double>((i * i) % 7); };
+    for (int i = 0; i < 1000; ++i)
+      log.addValue(start + static_cast<double>(i), valueAt(i));
+    log.addValue(start + 500.0, -1.0);
+
+    // Integrate the step function one second at a time
+    const auto integral = [&valueAt](double from, double to) {
+      double sum(0.0);
+      for (double time = from; time < to;) {
+        const double next = std::min(std::floor(time) + 1.0, to);
+        const int i = std::min(std::max(static_cast<int>(std::floor(time)), 0), 999);
+        sum += (next - time) * (i == 500 ? -1.0 : valueAt(i));
+        time = next;
+      }
+      return sum;
+    };
+
+    TimeSplitterType filter;
+    double expected(0.0), totalTime(0.0);
+    for (int k = 0; k < 140; ++k) {
+      const double from = -2.0 + 7.5 * k + 0.25, to = from + 2.75 + (k % 3);
+      filter.emplace_back(start + from, start + to);
+      expected += integral(from, to);
+      totalTime += to - from;
+    }
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), expected / totalTime, 1e-9);
+  }
+
+  void test_averageValueInFilter_from_several_threads() {
+    // Out of order, so the first query sorts the log as well as indexing it
+    TimeSeriesProperty<double> log("unsorted");
+    const DateAndTime start("2007-11-30T16:17:00");
+    for (int i = 999; i >= 0; --i)
+      log.addValue(start + static_cast<double>(i), static_cast<double>(i % 10));
+    TimeSplitterType filter;
+    filter.emplace_back(SplittingInterval(start + 0.5, start + 100.5));
+    const auto copy = std::unique_ptr<TimeSeriesProperty<double>>(log.clone());
+    const double expected = copy->averageValueInFilter(filter);
+
+    // cxxtest assertions are not thread safe, so check the results afterwards
+    std::vector<double> averages(8, 0.0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < averages.size(); ++i)
+      threads.emplace_back([&log, &filter, &averages, i]() { averages[i] = log.averageValueInFilter(filter); });
+    for (auto &thread : threads)
+      thread.join();
+    for (const auto average : averages) {
+      TS_ASSERT_EQUALS(average, expected);
+    }
+  }
+
   void test_timeAverageValue() {
     auto dblLog = createDoubleTSP();
     auto intLog = createIntegerTSP(5);
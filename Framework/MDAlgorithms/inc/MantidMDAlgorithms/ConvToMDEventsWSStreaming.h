@@ -0,0 +1,288 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IBoxControllerIO.h"
+#include "MantidMDAlgorithms/ConvToMDEventsWS.h"
+#include "MantidMDAlgorithms/MDEventExternalSort.h"
+
+namespace Mantid {
+// Forward declarations
+namespace API {
+class Progress;
+}
+namespace MDAlgorithms {
+/**
+ * This class converts ToF events into MD events with a bounded amount of
+ * memory. The input event workspace is processed in chunks of spectra; the
+ * converted events of every chunk are sorted by their Morton index and spilled
+ * to temporary files when the memory limit is reached. A single external merge
+ * pass then streams the events, ordered by their position in the MD space, into
+ * the output workspace, which is expected to be file-backed for conversions
+ * that do not fit into memory.
+ */
+class ConvToMDEventsWSStreaming : public ConvToMDEventsWS {
+public:
+  ConvToMDEventsWSStreaming(size_t memoryLimit, std::string spillDirectory = "");
+
+  /// @return the memory limit, in bytes, of the conversion
+  size_t memoryLimit() const { return m_memoryLimit; }
+
+private:
+  enum MD_EVENT_TYPE { LEAN, REGULAR, NONE };
+
+  // Interface function
+  void appendEventsFromInputWS(API::Progress *pProgress, const API::BoxController_sptr &bc) override;
+
+  // Returns number of workers for parallel parts
+  int numWorkers() { return this->m_NumThreads < 0 ? PARALLEL_GET_MAX_THREADS : std::max(1, this->m_NumThreads); }
+
+  template <size_t ND> MD_EVENT_TYPE mdEventType();
+
+  // Wrapper to have the proper functions, for Nd in range 2 to maxDim
+  template <size_t maxDim> void appendEventsFromInputWS(API::Progress *pProgress, const API::BoxController_sptr &bc);
+
+  // Wrapper for ToF events of different types, number of dims, MD event type
+  template <typename EventType, size_t ND, template <size_t> class MDEventType>
+  void appendEvents(API::Progress *pProgress, const API::BoxController_sptr &bc);
+
+  // Specialization for ToF events of different types
+  template <size_t ND, template <size_t> class MDEventType>
+  void appendEvents(API::Progress *pProgress, const API::BoxController_sptr &bc);
+
+  // Specialization for MD event types
+  template <size_t ND> void appendEvents(API::Progress *pProgress, const API::BoxController_sptr &bc);
+
+  template <typename EventType, size_t ND, template <size_t> class MDEventType>
+  void convertSpectra(size_t beginIndex, size_t endIndex, const std::vector<MDTransf_sptr> &qConverters,
+                      std::vector<std::vector<MDEventType<ND>>> &eventsPerSpectrum);
+
+  template <size_t ND, template <size_t> class MDEventType> struct MDEventMaker {
+    static MDEventType<ND> makeMDEvent(const double &sig, const double &err, const uint16_t &expInfoIndex,
+                                       const uint16_t &goniometer_index, const uint32_t &det_id, coord_t *coord) {
+      return MDEventType<ND>(sig, err, expInfoIndex, goniometer_index, det_id, coord);
+    }
+  };
+
+  /// memory limit in bytes
+  const size_t m_memoryLimit;
+  /// directory for the temporary files of sorted events
+  const std::string m_spillDirectory;
+};
+
+/*-------------------------------definitions-------------------------------------*/
+
+/**
+ * Convert the events of the spectra in the range [beginIndex, endIndex) into
+ * MD events falling inside the output workspace. On return eventsPerSpectrum
+ * holds the events of each spectrum of the range, in the order of the spectra.
+ */
+template <typename EventType, size_t ND, template <size_t> class MDEventType>
+void ConvToMDEventsWSStreaming::convertSpectra(size_t beginIndex, size_t endIndex,
+                                               const std::vector<MDTransf_sptr> &qConverters,
+                                               std::vector<std::vector<MDEventType<ND>>> &eventsPerSpectrum) {
+  const auto &pws = m_OutWSWrapper->pWorkspace();
+  std::array<std::pair<coord_t, coord_t>, ND> bounds;
+  for (size_t ax = 0; ax < ND; ++ax) {
+    bounds[ax] = std::make_pair(pws->getDimension(ax)->getMinimum(), pws->getDimension(ax)->getMaximum());
+  }
+
+  const auto nSpectra = static_cast<int>(endIndex - beginIndex);
+  eventsPerSpectrum.clear();
+  eventsPerSpectrum.resize(nSpectra);
+#pragma omp parallel for schedule(dynamic) num_threads(numWorkers())
+  for (int i = 0; i < nSpectra; ++i) {
+    const size_t workspaceIndex = beginIndex + i;
+    const Mantid::DataObjects::EventList &el = m_EventWS->getSpectrum(workspaceIndex);
+    if (el.getNumberEvents() == 0)
+      continue;
+
+    // create local unit conversion class
+    UnitsConversionHelper localUnitConv(m_UnitConversion);
+    MDTransf_sptr localQConverter = qConverters[PARALLEL_THREAD_NUMBER];
+    int32_t detID = m_detID[workspaceIndex];
+    uint16_t goniometerIndex(0); // default value
+
+    std::vector<coord_t> locCoord(ND);
+    // set up unit conversion and calculate up all coordinates, which depend on
+    // spectra index only
+    if (!localQConverter->calcYDepCoordinates(locCoord, workspaceIndex))
+      continue; // skip if any y outsize of the range of interest;
+    localUnitConv.updateConversion(workspaceIndex);
+
+    typename std::vector<EventType> const *events_ptr;
+    getEventsFrom(el, events_ptr);
+    auto &mdEventsForSpectrum = eventsPerSpectrum[i];
+    mdEventsForSpectrum.reserve(events_ptr->size());
+    for (const auto &event : *events_ptr) {
+      double val = localUnitConv.convertUnits(event.tof());
+      double signal = event.weight();
+      double errorSq = event.errorSquared();
+
+      if (!localQConverter->calcMatrixCoord(val, locCoord, signal, errorSq))
+        continue; // skip ND outside the range
+
+      // the bounds of the resulting workspace are already defined, so
+      // reject events outside of them
+      bool isInOutWSBox = true;
+      for (size_t ax = 0; ax < ND; ++ax) {
+        if (locCoord[ax] < bounds[ax].first || locCoord[ax] > bounds[ax].second) {
+          isInOutWSBox = false;
+          break;
+        }
+      }
+      if (isInOutWSBox)
+        mdEventsForSpectrum.emplace_back(MDEventMaker<ND, MDEventType>::makeMDEvent(
+            signal, errorSq, m_ExpInfoIndex, goniometerIndex, detID, locCoord.data()));
+    }
+  }
+}
+
+template <typename EventType, size_t ND, template <size_t> class MDEventType>
+void ConvToMDEventsWSStreaming::appendEvents(API::Progress *pProgress, const API::BoxController_sptr &bc) {
+  using MDEvent = MDEventType<ND>;
+  using Sorter = MDEventExternalSort<ND, MDEventType>;
+  auto pws = std::dynamic_pointer_cast<DataObjects::MDEventWorkspace<MDEvent, ND>>(m_OutWSWrapper->pWorkspace());
+
+  morton_index::MDSpaceBounds<ND> space;
+  for (size_t ax = 0; ax < ND; ++ax) {
+    space(ax, 0) = pws->getDimension(ax)->getMinimum();
+    space(ax, 1) = pws->getDimension(ax)->getMaximum();
+  }
+
+  // Half of the memory is used for sorting, the other half for the spectra
+  // being converted. The converted events of a spectrum are freed as soon as
+  // the sorter has copied them, so the peak is the sort buffer plus one chunk
+  // of converted events, i.e. the memory limit, unless a single spectrum has
+  // more events than half of the limit.
+  Sorter sorter(space, m_memoryLimit / 2, m_spillDirectory);
+  const size_t chunkCapacity = std::max<size_t>(1, m_memoryLimit / 2 / Sorter::bytesPerEvent());
+
+  std::vector<MDTransf_sptr> qConverters;
+  for (int i = 0; i < numWorkers(); ++i)
+    qConverters.emplace_back(m_QConverter->clone());
+
+  pProgress->resetNumSteps(2 * m_NSpectra, 0, 1);
+  std::vector<std::vector<MDEvent>> chunk;
+  size_t beginIndex = 0;
+  while (beginIndex < m_NSpectra) {
+    // the number of ToF events is an upper bound for the number of MD events
+    size_t endIndex = beginIndex;
+    size_t nInputEvents = 0;
+    do {
+      nInputEvents += m_EventWS->getSpectrum(endIndex).getNumberEvents();
+      ++endIndex;
+    } while (endIndex < m_NSpectra &&
+             nInputEvents + m_EventWS->getSpectrum(endIndex).getNumberEvents() <= chunkCapacity);
+
+    convertSpectra<EventType, ND, MDEventType>(beginIndex, endIndex, qConverters, chunk);
+    for (auto &spectrumEvents : chunk) {
+      sorter.add(spectrumEvents);
+      std::vector<MDEvent>().swap(spectrumEvents);
+    }
+    pProgress->report(endIndex, "Converting events");
+    beginIndex = endIndex;
+  }
+  std::vector<std::vector<MDEvent>>().swap(chunk);
+  g_Log.information() << "Streaming conversion created " << sorter.numberOfEvents() << " MD events in "
+                      << sorter.numberOfSpillFiles() << " sorted runs\n";
+
+  // Events arrive sorted, so every batch touches a compact region of the box
+  // tree; file-backed boxes are flushed by the write buffer as they fill.
+  if (bc->isFileBacked())
+    bc->getFileIO()->setWriteBufferSize(std::max<uint64_t>(1, m_memoryLimit / 2 / sizeof(MDEvent)));
+
+  size_t lastNumBoxes = bc->getTotalNumMDBoxes();
+  size_t nEventsInWS = pws->getNPoints();
+  size_t eventsAdded = 0;
+  size_t nMerged = 0;
+  sorter.merge([&](std::vector<MDEvent> &batch) {
+    pws->addEvents(batch);
+    eventsAdded += batch.size();
+    nEventsInWS += batch.size();
+    nMerged += batch.size();
+    if (bc->shouldSplitBoxes(nEventsInWS, eventsAdded, lastNumBoxes)) {
+      pws->splitAllIfNeeded(nullptr);
+      lastNumBoxes = bc->getTotalNumMDBoxes();
+      eventsAdded = 0;
+    }
+    const auto nEvents = std::max<size_t>(1, sorter.numberOfEvents());
+    pProgress->report(m_NSpectra + (m_NSpectra * nMerged) / nEvents, "Building boxes");
+  });
+
+  // Do a final splitting of everything
+  pws->splitAllIfNeeded(nullptr);
+  // Recount totals at the end.
+  pws->refreshCache();
+}
+
+// Specialization for ToF events of different types
+template <size_t ND, template <size_t> class MDEventType>
+void ConvToMDEventsWSStreaming::appendEvents(API::Progress *pProgress, const API::BoxController_sptr &bc) {
+  switch (m_EventWS->getSpectrum(0).getEventType()) {
+  case Mantid::API::TOF:
+    appendEvents<Mantid::Types::Event::TofEvent, ND, MDEventType>(pProgress, bc);
+    break;
+  case Mantid::API::WEIGHTED:
+    appendEvents<Mantid::DataObjects::WeightedEvent, ND, MDEventType>(pProgress, bc);
+    break;
+  case Mantid::API::WEIGHTED_NOTIME:
+    appendEvents<Mantid::DataObjects::WeightedEventNoTime, ND, MDEventType>(pProgress, bc);
+    break;
+  default:
+    throw std::runtime_error("Events in event workspace had an unexpected data type!");
+  }
+}
+
+// Specialization for MD event types
+template <size_t ND>
+void ConvToMDEventsWSStreaming::appendEvents(API::Progress *pProgress, const API::BoxController_sptr &bc) {
+  switch (mdEventType<ND>()) {
+  case LEAN:
+    appendEvents<ND, DataObjects::MDLeanEvent>(pProgress, bc);
+    break;
+  case REGULAR:
+    appendEvents<ND, DataObjects::MDEvent>(pProgress, bc);
+    break;
+  default:
+    throw std::runtime_error("MD events in md event workspace had an unexpected data type!");
+  }
+}
+
+// Wrapper to have the proper functions, for Nd in range 2 to maxDim
+template <size_t maxDim>
+void ConvToMDEventsWSStreaming::appendEventsFromInputWS(API::Progress *pProgress, const API::BoxController_sptr &bc) {
+  auto ndim = m_OutWSWrapper->nDimensions();
+  if (ndim < 2)
+    throw std::runtime_error("Can't convert to MD workspace with dims " + std::to_string(ndim) + "less than 2");
+  if (ndim > maxDim)
+    return;
+  if (ndim == maxDim) {
+    appendEvents<maxDim>(pProgress, bc);
+    return;
+  } else
+    appendEventsFromInputWS<maxDim - 1>(pProgress, bc);
+}
+
+template <size_t ND> struct ConvToMDEventsWSStreaming::MDEventMaker<ND, Mantid::DataObjects::MDLeanEvent> {
+  static Mantid::DataObjects::MDLeanEvent<ND> makeMDEvent(const double &sig, const double &err, const uint16_t,
+                                                          const uint16_t, const uint32_t, coord_t *coord) {
+    return Mantid::DataObjects::MDLeanEvent<ND>(sig, err, coord);
+  }
+};
+
+template <size_t ND> ConvToMDEventsWSStreaming::MD_EVENT_TYPE ConvToMDEventsWSStreaming::mdEventType() {
+  if (dynamic_cast<DataObjects::MDEventWorkspace<DataObjects::MDEvent<ND>, ND> *>(m_OutWSWrapper->pWorkspace().get()))
+    return REGULAR;
+
+  if (dynamic_cast<DataObjects::MDEventWorkspace<DataObjects::MDLeanEvent<ND>, ND> *>(
+          m_OutWSWrapper->pWorkspace().get()))
+    return LEAN;
+  return NONE;
+}
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -24,19 +24,27 @@ namespace MDAlgorithms {
 
 class DLLExport ConvToMDSelector {
 public:
-  enum ConverterType { DEFAULT, INDEXED };
+  enum ConverterType { DEFAULT, INDEXED, STREAMING };
   /**
    *
-   * @param tp :: type of converter (indexed or default)
+   * @param tp :: type of converter (indexed, streaming or default)
+   * @param memoryLimit :: memory limit in bytes used by the streaming converter
+   * @param spillDirectory :: directory for the temporary files of the
+   * streaming converter
    */
-  ConvToMDSelector(ConverterType tp = DEFAULT);
+  ConvToMDSelector(ConverterType tp = DEFAULT, size_t memoryLimit = 0, std::string spillDirectory = "");
   /// function which selects the convertor depending on workspace type and
   /// (possibly, in a future) some workspace properties
   std::shared_ptr<ConvToMDBase> convSelector(const API::MatrixWorkspace_sptr &inputWS,
                                              std::shared_ptr<ConvToMDBase> &currentSolver) const;
 
 private:
+  /// create a new converter for event workspaces
+  std::shared_ptr<ConvToMDBase> createEventsConverter() const;
+
   ConverterType converterType;
+  size_t m_memoryLimit;
+  std::string m_spillDirectory;
 };
 } // namespace MDAlgorithms
 } // namespace Mantid
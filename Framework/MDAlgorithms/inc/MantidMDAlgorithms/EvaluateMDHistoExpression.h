@@ -0,0 +1,44 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidKernel/System.h"
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/** EvaluateMDHistoExpression : evaluates an arithmetic, boolean and masking
+  expression over MDHistoWorkspaces in the analysis data service.
+
+  Chains of operations are evaluated in one pass over the data with
+  DataObjects::MDHistoWorkspaceExpression, rather than one pass and one
+  workspace per operation as when the individual algorithms (PlusMD,
+  MultiplyMD, LessThanMD, SetMDUsingMask, ...) are called in turn.
+ */
+class DLLExport EvaluateMDHistoExpression final : public API::Algorithm {
+public:
+  const std::string name() const override { return "EvaluateMDHistoExpression"; }
+  /// Summary of algorithms purpose
+  const std::string summary() const override {
+    return "Evaluate an element-wise expression of MDHistoWorkspaces in a single pass over the data.";
+  }
+
+  int version() const override { return 1; }
+  const std::vector<std::string> seeAlso() const override {
+    return {"PlusMD", "MinusMD", "MultiplyMD", "DivideMD", "LessThanMD", "GreaterThanMD", "SetMDUsingMask"};
+  }
+  const std::string category() const override { return "MDAlgorithms\\MDArithmetic"; }
+
+private:
+  void init() override;
+  void exec() override;
+  std::map<std::string, std::string> validateInputs() override;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
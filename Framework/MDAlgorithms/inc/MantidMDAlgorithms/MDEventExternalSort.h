@@ -0,0 +1,261 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDLeanEvent.h"
+
+#include <Poco/TemporaryFile.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/**
+ * Sorts a stream of MD events by their Morton index using a bounded amount of
+ * memory. Events are accumulated in an in-memory buffer; once the buffer
+ * reaches the memory limit it is sorted and spilled to a temporary file as a
+ * sorted run. MDEventExternalSort::merge performs a single k-way merge over
+ * all runs (and whatever remains in memory) and hands the globally sorted
+ * events to a consumer in batches, so events arrive grouped by the region of
+ * the MD space they belong to.
+ *
+ * Spill files are private to the process and store events in their in-memory
+ * layout; they are removed when the sorter is destroyed.
+ *
+ * @tparam ND :: number of dimensions
+ * @tparam MDEventType :: type of the MD event [MDLeanEvent, MDEvent]
+ */
+template <size_t ND, template <size_t> class MDEventType> class MDEventExternalSort {
+public:
+  using MDEvent = MDEventType<ND>;
+  using IntT = typename MDEvent::IntT;
+  using MortonT = typename MDEvent::MortonT;
+  /// Function receiving consecutive batches of sorted events
+  using BatchConsumer = std::function<void(std::vector<MDEvent> &)>;
+
+  MDEventExternalSort(const morton_index::MDSpaceBounds<ND> &space, size_t memoryLimit,
+                      const std::string &spillDirectory = "");
+
+  /// Add events to the sorter. The input vector is cleared on return.
+  void add(std::vector<MDEvent> &events);
+  /// Merge all the events added so far and pass them to the consumer in order
+  size_t merge(const BatchConsumer &consumer);
+
+  /// @return the number of events added to the sorter
+  size_t numberOfEvents() const { return m_numberOfEvents; }
+  /// @return the number of sorted runs written to disk
+  size_t numberOfSpillFiles() const { return m_runs.size(); }
+  /// @return the memory used per buffered event, including the sort keys
+  static constexpr size_t bytesPerEvent() { return sizeof(MDEvent) + sizeof(MortonT) + sizeof(size_t); }
+
+private:
+  /// A sorted run stored on disk
+  struct SortedRun {
+    std::unique_ptr<Poco::TemporaryFile> file;
+    size_t size;
+  };
+  /// Buffered sequential reader of a sorted run
+  struct RunReader {
+    std::ifstream stream;
+    size_t remaining;
+    std::vector<MDEvent> block;
+    std::vector<MortonT> keys;
+    size_t position;
+  };
+
+  MortonT mortonIndex(const MDEvent &event) const;
+  std::vector<size_t> sortedOrder(const std::vector<MDEvent> &events) const;
+  void spillBuffer();
+  bool fillBlock(RunReader &reader, size_t blockSize) const;
+
+  const morton_index::MDSpaceBounds<ND> m_space;
+  const size_t m_bufferCapacity;
+  const std::string m_spillDirectory;
+  std::vector<MDEvent> m_buffer;
+  std::vector<SortedRun> m_runs;
+  size_t m_numberOfEvents;
+};
+
+/*-------------------------------definitions-------------------------------------*/
+
+/**
+ * @param space :: bounds of the MD space used to calculate Morton indexes
+ * @param memoryLimit :: approximate memory, in bytes, the sorter may use for
+ * buffering events
+ * @param spillDirectory :: directory for the temporary run files. Uses the
+ * system temporary directory if empty
+ */
+template <size_t ND, template <size_t> class MDEventType>
+MDEventExternalSort<ND, MDEventType>::MDEventExternalSort(const morton_index::MDSpaceBounds<ND> &space,
+                                                          size_t memoryLimit, const std::string &spillDirectory)
+    : m_space(space), m_bufferCapacity(std::max<size_t>(1, memoryLimit / bytesPerEvent())),
+      m_spillDirectory(spillDirectory), m_numberOfEvents(0) {}
+
+template <size_t ND, template <size_t> class MDEventType>
+void MDEventExternalSort<ND, MDEventType>::add(std::vector<MDEvent> &events) {
+  m_numberOfEvents += events.size();
+  auto begin = events.cbegin();
+  while (begin != events.cend()) {
+    const auto toCopy =
+        std::min(static_cast<size_t>(std::distance(begin, events.cend())), m_bufferCapacity - m_buffer.size());
+    m_buffer.insert(m_buffer.end(), begin, begin + toCopy);
+    begin += toCopy;
+    if (m_buffer.size() >= m_bufferCapacity)
+      spillBuffer();
+  }
+  events.clear();
+}
+
+/**
+ * Merge all the sorted runs and the in-memory buffer.
+ * @param consumer :: function called with each batch of sorted events. The
+ * batch may be modified by the consumer.
+ * @return the total number of events passed to the consumer
+ */
+template <size_t ND, template <size_t> class MDEventType>
+size_t MDEventExternalSort<ND, MDEventType>::merge(const BatchConsumer &consumer) {
+  if (m_runs.empty()) {
+    // everything fits into memory, so no merging is required
+    const auto order = sortedOrder(m_buffer);
+    std::vector<MDEvent> batch;
+    batch.reserve(std::min(m_buffer.size(), m_bufferCapacity));
+    for (const auto index : order)
+      batch.emplace_back(m_buffer[index]);
+    std::vector<MDEvent>().swap(m_buffer);
+    const size_t nEvents = batch.size();
+    if (nEvents > 0)
+      consumer(batch);
+    return nEvents;
+  }
+  if (!m_buffer.empty())
+    spillBuffer();
+  std::vector<MDEvent>().swap(m_buffer);
+
+  // Share the memory budget between a read block for every run and the output
+  // batch
+  const size_t blockSize = std::max<size_t>(1, m_bufferCapacity / (m_runs.size() + 1));
+  std::vector<RunReader> readers(m_runs.size());
+  for (size_t i = 0; i < m_runs.size(); ++i) {
+    readers[i].stream.open(m_runs[i].file->path(), std::ios::binary);
+    if (!readers[i].stream)
+      throw std::runtime_error("MDEventExternalSort: cannot open the temporary file " + m_runs[i].file->path());
+    readers[i].remaining = m_runs[i].size;
+    readers[i].position = 0;
+  }
+
+  using HeapEntry = std::pair<MortonT, size_t>;
+  auto greater = [](const HeapEntry &lhs, const HeapEntry &rhs) { return rhs.first < lhs.first; };
+  std::priority_queue<HeapEntry, std::vector<HeapEntry>, decltype(greater)> heap(greater);
+  for (size_t i = 0; i < readers.size(); ++i) {
+    if (fillBlock(readers[i], blockSize))
+      heap.emplace(readers[i].keys[0], i);
+  }
+
+  size_t nEvents = 0;
+  std::vector<MDEvent> batch;
+  batch.reserve(blockSize);
+  while (!heap.empty()) {
+    const size_t runIndex = heap.top().second;
+    heap.pop();
+    auto &reader = readers[runIndex];
+    batch.emplace_back(reader.block[reader.position++]);
+    if (reader.position < reader.block.size() || fillBlock(reader, blockSize))
+      heap.emplace(reader.keys[reader.position], runIndex);
+
+    if (batch.size() >= blockSize) {
+      nEvents += batch.size();
+      consumer(batch);
+      batch.clear();
+    }
+  }
+  if (!batch.empty()) {
+    nEvents += batch.size();
+    consumer(batch);
+  }
+  m_runs.clear();
+  return nEvents;
+}
+
+template <size_t ND, template <size_t> class MDEventType>
+typename MDEventExternalSort<ND, MDEventType>::MortonT
+MDEventExternalSort<ND, MDEventType>::mortonIndex(const MDEvent &event) const {
+  return morton_index::coordinatesToIndex<ND, IntT, MortonT>(event.getCenter(), m_space);
+}
+
+/// @return the permutation which sorts the events by their Morton index
+template <size_t ND, template <size_t> class MDEventType>
+std::vector<size_t> MDEventExternalSort<ND, MDEventType>::sortedOrder(const std::vector<MDEvent> &events) const {
+  std::vector<MortonT> keys(events.size());
+  std::transform(events.cbegin(), events.cend(), keys.begin(),
+                 [this](const MDEvent &event) { return mortonIndex(event); });
+  std::vector<size_t> order(events.size());
+  std::iota(order.begin(), order.end(), 0);
+  // stable ordering of equal keys keeps the result independent of the sort
+  // implementation
+  tbb::parallel_sort(order.begin(), order.end(), [&keys](const size_t lhs, const size_t rhs) {
+    return keys[lhs] < keys[rhs] || (!(keys[rhs] < keys[lhs]) && lhs < rhs);
+  });
+  return order;
+}
+
+/// Sort the in-memory buffer and write it to a new temporary file
+template <size_t ND, template <size_t> class MDEventType> void MDEventExternalSort<ND, MDEventType>::spillBuffer() {
+  const auto order = sortedOrder(m_buffer);
+  auto file = m_spillDirectory.empty() ? std::make_unique<Poco::TemporaryFile>()
+                                       : std::make_unique<Poco::TemporaryFile>(m_spillDirectory);
+  std::ofstream stream(file->path(), std::ios::binary);
+  if (!stream)
+    throw std::runtime_error("MDEventExternalSort: cannot create the temporary file " + file->path());
+
+  constexpr size_t writeBlockSize = 65536;
+  std::vector<MDEvent> block;
+  block.reserve(std::min(writeBlockSize, order.size()));
+  for (size_t i = 0; i < order.size(); ++i) {
+    block.emplace_back(m_buffer[order[i]]);
+    if (block.size() == writeBlockSize || i + 1 == order.size()) {
+      stream.write(reinterpret_cast<const char *>(block.data()),
+                   static_cast<std::streamsize>(block.size() * sizeof(MDEvent)));
+      block.clear();
+    }
+  }
+  if (!stream)
+    throw std::runtime_error("MDEventExternalSort: failed writing to the temporary file " + file->path());
+  m_runs.emplace_back(SortedRun{std::move(file), m_buffer.size()});
+  m_buffer.clear();
+}
+
+/// Read the next block of a sorted run. @return false if the run is exhausted
+template <size_t ND, template <size_t> class MDEventType>
+bool MDEventExternalSort<ND, MDEventType>::fillBlock(RunReader &reader, size_t blockSize) const {
+  reader.position = 0;
+  const size_t toRead = std::min(blockSize, reader.remaining);
+  reader.block.resize(toRead);
+  if (toRead == 0)
+    return false;
+  reader.stream.read(reinterpret_cast<char *>(reader.block.data()),
+                     static_cast<std::streamsize>(toRead * sizeof(MDEvent)));
+  if (!reader.stream)
+    throw std::runtime_error("MDEventExternalSort: failed reading a temporary file");
+  reader.remaining -= toRead;
+  reader.keys.resize(toRead);
+  std::transform(reader.block.cbegin(), reader.block.cend(), reader.keys.begin(),
+                 [this](const MDEvent &event) { return mortonIndex(event); });
+  return true;
+}
+
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -8,6 +8,7 @@
 
 #include "MantidAPI/Algorithm.h"
 #include "MantidAPI/IMDEventWorkspace_fwd.h"
+#include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDBoxFlatTree.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidKernel/System.h"
@@ -55,6 +56,8 @@ private:
   void finalizeOutput(const std::string &outputFile);
 
   uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
+  uint64_t copyEventsFromSubBoxes(API::IMDNode *TargetBox, API::IBoxControllerIO &saver);
+  bool canReadConcurrently() const;
 
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
@@ -77,7 +80,7 @@ protected:
   std::vector<std::string> m_Filenames;
 
   /// Vector of file handles to each input file //TODO unique?
-  std::vector<API::IBoxControllerIO *> m_EventLoader;
+  std::vector<DataObjects::BoxControllerNeXusIO *> m_EventLoader;
 
   /// Output IMDEventWorkspace
   Mantid::API::IMDEventWorkspace_sptr m_OutIWS;
@@ -0,0 +1,33 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidMDAlgorithms/ConvToMDEventsWSStreaming.h"
+
+namespace Mantid::MDAlgorithms {
+
+/**
+ * @param memoryLimit :: approximate memory, in bytes, the conversion may use
+ * for buffering MD events
+ * @param spillDirectory :: directory for temporary files. The system temporary
+ * directory is used if empty
+ */
+ConvToMDEventsWSStreaming::ConvToMDEventsWSStreaming(size_t memoryLimit, std::string spillDirectory)
+    : ConvToMDEventsWS(), m_memoryLimit(memoryLimit), m_spillDirectory(std::move(spillDirectory)) {
+  if (m_memoryLimit == 0)
+    throw std::invalid_argument("The memory limit of the streaming conversion must be positive");
+}
+
+template <>
+void ConvToMDEventsWSStreaming::appendEventsFromInputWS<2>(API::Progress *pProgress,
+                                                           const API::BoxController_sptr &bc) {
+  if (m_OutWSWrapper->nDimensions() == 2)
+    appendEvents<2>(pProgress, bc);
+}
+
+void ConvToMDEventsWSStreaming::appendEventsFromInputWS(API::Progress *pProgress, const API::BoxController_sptr &bc) {
+  appendEventsFromInputWS<8>(pProgress, bc);
+}
+} // namespace Mantid::MDAlgorithms
@@ -10,6 +10,7 @@
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidMDAlgorithms/ConvToMDEventsWSIndexing.h"
+#include "MantidMDAlgorithms/ConvToMDEventsWSStreaming.h"
 #include "MantidMDAlgorithms/ConvToMDHistoWS.h"
 
 namespace Mantid::MDAlgorithms {
@@ -20,7 +21,8 @@ enum wsType {
   Undefined   //< unknown initial state
 };
 
-ConvToMDSelector::ConvToMDSelector(ConvToMDSelector::ConverterType tp) : converterType(tp) {}
+ConvToMDSelector::ConvToMDSelector(ConvToMDSelector::ConverterType tp, size_t memoryLimit, std::string spillDirectory)
+    : converterType(tp), m_memoryLimit(memoryLimit), m_spillDirectory(std::move(spillDirectory)) {}
 
 /** function which selects the convertor depending on workspace type and
 (possibly, in a future) some workspace properties
@@ -59,11 +61,8 @@ std::shared_ptr<ConvToMDBase> ConvToMDSelector::convSelector(const API::MatrixWo
   if ((existingWsConvType == Undefined) || (existingWsConvType != inputWSType)) {
     switch (inputWSType) {
     case (EventWS):
-      // check if user set a property to use indexing
-      if (converterType == ConvToMDSelector::DEFAULT)
-        res = std::make_shared<ConvToMDEventsWS>();
-      else
-        res = std::make_shared<ConvToMDEventsWSIndexing>();
+      // check if user set a property to use indexing or streaming
+      res = createEventsConverter();
       break;
     case (Matrix2DWS):
       res = std::make_shared<ConvToMDHistoWS>();
@@ -75,11 +74,9 @@ std::shared_ptr<ConvToMDBase> ConvToMDSelector::convSelector(const API::MatrixWo
   } else {
     // existing converter is suitable for the workspace
     // in case of Event workspace check if user set a property to use indexing
+    // or streaming
     if (inputWSType == EventWS) {
-      if (converterType == ConvToMDSelector::DEFAULT)
-        res = std::make_shared<ConvToMDEventsWS>();
-      else
-        res = std::make_shared<ConvToMDEventsWSIndexing>();
+      res = createEventsConverter();
     } else {
       res = std::make_shared<ConvToMDHistoWS>();
     }
@@ -87,4 +84,16 @@ std::shared_ptr<ConvToMDBase> ConvToMDSelector::convSelector(const API::MatrixWo
 
   return res;
 }
+
+/// @return new converter for event workspaces of the type requested
+std::shared_ptr<ConvToMDBase> ConvToMDSelector::createEventsConverter() const {
+  switch (converterType) {
+  case ConvToMDSelector::INDEXED:
+    return std::make_shared<ConvToMDEventsWSIndexing>();
+  case ConvToMDSelector::STREAMING:
+    return std::make_shared<ConvToMDEventsWSStreaming>(m_memoryLimit, m_spillDirectory);
+  default:
+    return std::make_shared<ConvToMDEventsWS>();
+  }
+}
 } // namespace Mantid::MDAlgorithms
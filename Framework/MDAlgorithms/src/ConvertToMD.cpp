@@ -108,13 +108,30 @@ void ConvertToMD::init() {
                   "workspace. The workspace will load data from the file on "
                   "demand in order to reduce memory use.");
 
-  std::vector<std::string> converterType{"Default", "Indexed"};
+  std::vector<std::string> converterType{"Default", "Indexed", "Streaming"};
 
   auto loadTypeValidator = std::make_shared<StringListValidator>(converterType);
   declareProperty("ConverterType", "Default", loadTypeValidator,
-                  "[Default, Indexed], indexed is the experimental type that "
+                  "[Default, Indexed, Streaming], indexed is the experimental type that "
                   "can speedup the conversion process"
-                  "for the big files using the indexing.");
+                  "for the big files using the indexing. Streaming converts the events "
+                  "in chunks of spectra, sorting them through temporary files, so that "
+                  "the memory used stays below StreamingMemoryLimit. Use it together "
+                  "with FileBackEnd for conversions which do not fit into memory.");
+
+  auto mustBePositive = std::make_shared<BoundedValidator<int>>();
+  mustBePositive->setLower(1);
+  declareProperty("StreamingMemoryLimit", 4096, mustBePositive,
+                  "The approximate amount of memory, in MB, used to buffer MD events "
+                  "by the Streaming converter.");
+  setPropertySettings("StreamingMemoryLimit",
+                      std::make_unique<VisibleWhenProperty>("ConverterType", IS_EQUAL_TO, "Streaming"));
+
+  declareProperty(std::make_unique<FileProperty>("SpillDirectory", "", FileProperty::OptionalDirectory),
+                  "The directory for the temporary files of the Streaming converter. "
+                  "The system temporary directory is used if not given.");
+  setPropertySettings("SpillDirectory",
+                      std::make_unique<VisibleWhenProperty>("ConverterType", IS_EQUAL_TO, "Streaming"));
 }
 //----------------------------------------------------------------------------------------------
 
@@ -258,9 +275,15 @@ void ConvertToMD::exec() {
   // get pointer to appropriate  ConverttToMD plugin from the CovertToMD plugins
   // factory, (will throw if logic is wrong and ChildAlgorithm is not found
   // among existing)
-  ConvToMDSelector::ConverterType convType =
-      getPropertyValue("ConverterType") == "Indexed" ? ConvToMDSelector::INDEXED : ConvToMDSelector::DEFAULT;
-  ConvToMDSelector AlgoSelector(convType);
+  const std::string converterType = getPropertyValue("ConverterType");
+  ConvToMDSelector::ConverterType convType = ConvToMDSelector::DEFAULT;
+  if (converterType == "Indexed")
+    convType = ConvToMDSelector::INDEXED;
+  else if (converterType == "Streaming")
+    convType = ConvToMDSelector::STREAMING;
+  const int memoryLimitMB = getProperty("StreamingMemoryLimit");
+  ConvToMDSelector AlgoSelector(convType, static_cast<size_t>(memoryLimitMB) * 1024 * 1024,
+                                getPropertyValue("SpillDirectory"));
   this->m_Convertor = AlgoSelector.convSelector(m_InWS2D, this->m_Convertor);
 
   bool ignoreZeros = getProperty("IgnoreZeroSignals");
@@ -0,0 +1,334 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidMDAlgorithms/EvaluateMDHistoExpression.h"
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/ExperimentInfo.h"
+#include "MantidAPI/Run.h"
+#include "MantidAPI/WorkspaceExpressionParser.h"
+#include "MantidAPI/WorkspaceProperty.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidDataObjects/MDHistoWorkspaceExpression.h"
+#include "MantidKernel/Exception.h"
+#include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/PropertyWithValue.h"
+
+#include <cmath>
+#include <set>
+
+using namespace Mantid::Kernel;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+namespace Mantid::MDAlgorithms {
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(EvaluateMDHistoExpression)
+
+namespace {
+using Node = WorkspaceExpressionParser::Node;
+
+//----------------------------------------------------------------------------------------------
+/** A compiled sub-expression: a number, or a workspace followed by a chain of
+ * steps. The steps are only applied when the chain is materialised, to a
+ * copy of the workspace unless it may be overwritten.
+ *
+ * The boolean operations treat masked bins as false. As for the individual
+ * algorithms, which clear the masking of their output, only a boolean
+ * operation applied directly to a workspace sees its masking: it is kept in
+ * the head of the chain, after which the masking is cleared.
+ */
+struct Chain {
+  MDHistoWorkspace_sptr workspace;
+  std::string name;
+  double number = 0.0;
+  MDHistoWorkspaceExpression head;
+  MDHistoWorkspaceExpression steps;
+
+  bool isNumber() const { return !workspace; }
+  bool isWorkspace() const { return workspace && head.empty() && steps.empty(); }
+  /// The expression taking the next step
+  MDHistoWorkspaceExpression &next(bool usesMasking) {
+    return (usesMasking && head.empty() && steps.empty()) ? head : steps;
+  }
+};
+
+/// Turns a parsed expression into chains of steps, evaluated as late as possible
+class Compiler {
+public:
+  Compiler(double tolerance, double filler) : m_tolerance(tolerance), m_filler(filler) {}
+
+  Chain compile(const Node &node) {
+    switch (node.kind) {
+    case Node::Kind::Number: {
+      Chain chain;
+      chain.number = node.value;
+      return chain;
+    }
+    case Node::Kind::Workspace: {
+      Chain chain;
+      chain.name = node.text;
+      chain.workspace = retrieve(node.text);
+      return chain;
+    }
+    case Node::Kind::Unary:
+      return unary(node.text, compile(*node.arguments[0]));
+    case Node::Kind::Binary:
+      return binary(node.text, compile(*node.arguments[0]), compile(*node.arguments[1]));
+    case Node::Kind::Function:
+      if (node.text == "where")
+        return where(compile(*node.arguments[0]), compile(*node.arguments[1]), compile(*node.arguments[2]));
+      return function(node.text, compile(*node.arguments[0]));
+    }
+    throw std::logic_error("Unknown expression node");
+  }
+
+  /** Evaluate a chain.
+   * @param chain :: a chain holding a workspace
+   * @param inPlace :: if true the steps are applied to the workspace itself
+   * @return the workspace holding the result
+   */
+  static MDHistoWorkspace_sptr materialise(Chain &chain, bool inPlace) {
+    MDHistoWorkspace_sptr result = inPlace ? chain.workspace : MDHistoWorkspace_sptr(chain.workspace->clone());
+    chain.head.evaluate(*result);
+    result->clearMDMasking();
+    chain.steps.evaluate(*result);
+    return result;
+  }
+
+  static MDHistoWorkspace_sptr retrieve(const std::string &name) {
+    MDHistoWorkspace_sptr ws;
+    try {
+      ws = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(name);
+    } catch (Exception::NotFoundError &) {
+      throw std::invalid_argument("Workspace " + name + " does not exist.");
+    }
+    if (!ws)
+      throw std::invalid_argument("Workspace " + name + " is not a MDHistoWorkspace.");
+    return ws;
+  }
+
+private:
+  /// A workspace holding the value of a chain, to be used as an operand
+  const MDHistoWorkspace &operand(Chain &chain) {
+    m_operands.emplace_back(chain.isWorkspace() ? chain.workspace : materialise(chain, false));
+    return *m_operands.back();
+  }
+
+  Chain unary(const std::string &op, Chain arg) {
+    if (arg.isNumber()) {
+      arg.number = (op == "-") ? -arg.number : (arg.number == 0.0);
+    } else if (op == "-") {
+      arg.next(false).multiply(-1.0, 0.0);
+    } else {
+      arg.next(true).operatorNot();
+    }
+    return arg;
+  }
+
+  Chain function(const std::string &name, Chain arg) {
+    if (arg.isNumber()) {
+      const double a = arg.number;
+      if (name == "exp")
+        arg.number = std::exp(a);
+      else
+        arg.number = (a <= 0) ? m_filler : ((name == "log") ? std::log(a) : std::log10(a));
+    } else if (name == "log") {
+      arg.next(false).log(m_filler);
+    } else if (name == "log10") {
+      arg.next(false).log10(m_filler);
+    } else {
+      arg.next(false).exp();
+    }
+    return arg;
+  }
+
+  Chain where(Chain mask, Chain values, Chain otherwise) {
+    if (mask.isNumber() || otherwise.isNumber())
+      throw std::invalid_argument("The first and last arguments of where() must involve a workspace.");
+    const auto &maskWS = operand(mask);
+    if (values.isNumber())
+      otherwise.next(false).setUsingMask(maskWS, values.number, 0.0);
+    else
+      otherwise.next(false).setUsingMask(maskWS, operand(values));
+    return otherwise;
+  }
+
+  Chain binary(std::string op, Chain lhs, Chain rhs) {
+    if (lhs.isNumber() && rhs.isNumber()) {
+      lhs.number = fold(op, lhs.number, rhs.number);
+      return lhs;
+    }
+    if (op == "**") {
+      if (!rhs.isNumber())
+        throw std::invalid_argument("The exponent of ** must be a number.");
+      if (lhs.isNumber())
+        throw std::logic_error("Unexpected number as the base of **");
+      lhs.next(false).power(rhs.number);
+      return lhs;
+    }
+
+    // Keep the workspace or the longer chain on the left when the order of
+    // the operands does not matter. "2 < A" becomes "A > 2".
+    const bool swappable = op == "+" || op == "*" || op == "==" || op == "&" || op == "|" || op == "^" ||
+                           op == "<" || op == ">";
+    if (swappable && (lhs.isNumber() || (lhs.isWorkspace() && !rhs.isNumber() && !rhs.isWorkspace()))) {
+      std::swap(lhs, rhs);
+      if (op == "<")
+        op = ">";
+      else if (op == ">")
+        op = "<";
+    }
+    if (lhs.isNumber()) {
+      if (op != "-")
+        throw std::invalid_argument("A number can not be on the left of " + op + " with a workspace on the right.");
+      // a - B == -B + a
+      rhs.next(false).multiply(-1.0, 0.0);
+      rhs.next(false).add(lhs.number, 0.0);
+      return rhs;
+    }
+
+    const bool booleanOperation = op == "&" || op == "|" || op == "^";
+    auto &steps = lhs.next(booleanOperation);
+    if (rhs.isNumber()) {
+      const double b = rhs.number;
+      if (op == "+")
+        steps.add(b, 0.0);
+      else if (op == "-")
+        steps.subtract(b, 0.0);
+      else if (op == "*")
+        steps.multiply(b, 0.0);
+      else if (op == "/")
+        steps.divide(b, 0.0);
+      else if (op == "<")
+        steps.lessThan(b);
+      else if (op == ">")
+        steps.greaterThan(b);
+      else if (op == "==")
+        steps.equalTo(b, m_tolerance);
+      else
+        throw std::invalid_argument("Both operands of " + op + " must be workspaces.");
+    } else {
+      const auto &b = operand(rhs);
+      if (op == "+")
+        steps.add(b);
+      else if (op == "-")
+        steps.subtract(b);
+      else if (op == "*")
+        steps.multiply(b);
+      else if (op == "/")
+        steps.divide(b);
+      else if (op == "<")
+        steps.lessThan(b);
+      else if (op == ">")
+        steps.greaterThan(b);
+      else if (op == "==")
+        steps.equalTo(b, m_tolerance);
+      else if (op == "&")
+        steps.operatorAnd(b);
+      else if (op == "|")
+        steps.operatorOr(b);
+      else
+        steps.operatorXor(b);
+    }
+    return lhs;
+  }
+
+  double fold(const std::string &op, double a, double b) const {
+    if (op == "+")
+      return a + b;
+    if (op == "-")
+      return a - b;
+    if (op == "*")
+      return a * b;
+    if (op == "/")
+      return a / b;
+    if (op == "**")
+      return std::pow(a, b);
+    if (op == "<")
+      return a < b;
+    if (op == ">")
+      return a > b;
+    if (op == "==")
+      return std::fabs(a - b) < m_tolerance;
+    if (op == "&")
+      return (a != 0) && (b != 0);
+    if (op == "|")
+      return (a != 0) || (b != 0);
+    return (a != 0) ^ (b != 0);
+  }
+
+  const double m_tolerance;
+  const double m_filler;
+  /// The operands of the steps, including materialised sub-expressions
+  std::vector<MDHistoWorkspace_sptr> m_operands;
+};
+} // namespace
+
+//----------------------------------------------------------------------------------------------
+/** Initialize the algorithm's properties.
+ */
+void EvaluateMDHistoExpression::init() {
+  declareProperty("Expression", "", std::make_shared<MandatoryValidator<std::string>>(),
+                  "The expression to evaluate, e.g. \"where(A < 0, 0, (A - B) * 2)\". Names refer to "
+                  "MDHistoWorkspaces in the analysis data service; quote names which are not identifiers.");
+  declareProperty("Tolerance", 1e-5, "Tolerance when performing the == comparison. Default 10^-5.");
+  declareProperty("Filler", 0.0, "The result of log(x) and log10(x) where x <= 0. Default 0.");
+  declareProperty(std::make_unique<WorkspaceProperty<IMDHistoWorkspace>>("OutputWorkspace", "", Direction::Output),
+                  "An output MDHistoWorkspace.");
+}
+
+//----------------------------------------------------------------------------------------------
+/// @return a map of property names to errors
+std::map<std::string, std::string> EvaluateMDHistoExpression::validateInputs() {
+  std::map<std::string, std::string> errors;
+  const std::string expression = getProperty("Expression");
+  try {
+    const auto tree = WorkspaceExpressionParser::parse(expression);
+    std::multiset<std::string> names;
+    WorkspaceExpressionParser::workspaceNames(*tree, names);
+    if (names.empty())
+      errors["Expression"] = "The expression must involve at least one workspace.";
+    for (const auto &name : std::set<std::string>(names.begin(), names.end()))
+      Compiler::retrieve(name);
+  } catch (std::invalid_argument &err) {
+    errors["Expression"] = err.what();
+  }
+  return errors;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Execute the algorithm.
+ */
+void EvaluateMDHistoExpression::exec() {
+  const std::string expression = getProperty("Expression");
+  const auto tree = WorkspaceExpressionParser::parse(expression);
+  std::multiset<std::string> names;
+  WorkspaceExpressionParser::workspaceNames(*tree, names);
+
+  const double tolerance = getProperty("Tolerance");
+  const double filler = getProperty("Filler");
+  Compiler compiler(tolerance, filler);
+  auto chain = compiler.compile(*tree);
+  if (chain.isNumber())
+    throw std::invalid_argument("The expression must involve at least one workspace.");
+
+  // Work in-place when the output replaces the only reference to an input
+  const std::string outputName = getPropertyValue("OutputWorkspace");
+  const bool inPlace = chain.name == outputName && names.count(outputName) == 1;
+  auto out = Compiler::materialise(chain, inPlace);
+
+  // As for the binary operations, flag the workspace so that BinMD does not
+  // bin the modified workspace from its original events
+  if (out->getNumExperimentInfo() == 0)
+    out->addExperimentInfo(std::make_shared<ExperimentInfo>());
+  out->getExperimentInfo(0)->mutableRun().addProperty(new PropertyWithValue<std::string>("mdhisto_was_modified", "1"),
+                                                      true);
+
+  setProperty("OutputWorkspace", std::dynamic_pointer_cast<IMDHistoWorkspace>(out));
+}
+
+} // namespace Mantid::MDAlgorithms
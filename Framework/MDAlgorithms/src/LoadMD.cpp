@@ -22,12 +22,14 @@
 #include "MantidGeometry/MDGeometry/MDFrame.h"
 #include "MantidGeometry/MDGeometry/MDFrameFactory.h"
 #include "MantidGeometry/MDGeometry/UnknownFrame.h"
+#include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/EnabledWhenProperty.h"
 #include "MantidKernel/MDUnit.h"
 #include "MantidKernel/MDUnitFactory.h"
 #include "MantidKernel/Memory.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/System.h"
 #include "MantidMDAlgorithms/SetMDFrame.h"
@@ -100,6 +102,14 @@ void LoadMD::init() {
                   "If not specified, a default of 40% of free physical memory is used.");
   setPropertySettings("Memory", std::make_unique<EnabledWhenProperty>("FileBackEnd", IS_EQUAL_TO, "1"));
 
+  auto mustBeNonNegative = std::make_shared<BoundedValidator<double>>();
+  mustBeNonNegative->setLower(0.0);
+  declareProperty(std::make_unique<PropertyWithValue<double>>("ReadCacheMemory", 0.0, mustBeNonNegative),
+                  "For FileBackEnd only: the amount of memory (in MB) used to keep the most "
+                  "recently read blocks of events, so that repeated reads of the same boxes do not "
+                  "go back to the file. 0 disables the cache.");
+  setPropertySettings("ReadCacheMemory", std::make_unique<EnabledWhenProperty>("FileBackEnd", IS_EQUAL_TO, "1"));
+
   declareProperty("LoadHistory", true, "If true, the workspace history will be loaded");
 
   declareProperty(std::make_unique<WorkspaceProperty<IMDWorkspace>>("OutputWorkspace", "", Direction::Output),
@@ -529,6 +539,9 @@ template <typename MDE, size_t nd> void LoadMD::doLoad(typename MDEventWorkspace
       bc->getFileIO()->setWriteBufferSize(cacheMemory);
 
       g_log.information() << "Setting a DiskBuffer cache size of " << mb << " MB, or " << cacheMemory << " events.\n";
+
+      const double readCacheMB = getProperty("ReadCacheMemory");
+      loader->setReadCacheSize(static_cast<size_t>(readCacheMB * 1024. * 1024.));
     }
   } // Not file back end
   else if (!m_BoxStructureAndMethadata) {
@@ -541,21 +554,25 @@ template <typename MDE, size_t nd> void LoadMD::doLoad(typename MDEventWorkspace
 
     const std::vector<uint64_t> &BoxEventIndex = FlatBoxTree.getEventIndex();
     prog->setNumSteps(numBoxes);
-    std::vector<coord_t> boxTemp;
-
-    for (size_t i = 0; i < numBoxes; i++) {
+    // one buffer per thread for the events data read from the file
+    std::vector<std::vector<coord_t>> boxTemp(PARALLEL_GET_MAX_THREADS);
+
+    // boxes are filled independently, so they can be read in parallel if the
+    // file does not have to be accessed through the NeXus API
+    PARALLEL_FOR_IF(loader->supportsConcurrentReads())
+    for (int64_t i = 0; i < static_cast<int64_t>(numBoxes); i++) {
+      PARALLEL_START_INTERRUPT_REGION
       prog->report();
       auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxTree[i]);
-      if (!box)
-        continue;
-
-      if (BoxEventIndex[2 * i + 1] > 0) // Load in memory NOT using the file as the back-end,
+      if (box && BoxEventIndex[2 * i + 1] > 0) // Load in memory NOT using the file as the back-end,
       {
         boxTree[i]->reserveMemoryForLoad(BoxEventIndex[2 * i + 1]);
         boxTree[i]->loadAndAddFrom(loader.get(), BoxEventIndex[2 * i], static_cast<size_t>(BoxEventIndex[2 * i + 1]),
-                                   boxTemp);
+                                   boxTemp[PARALLEL_THREAD_NUMBER]);
       }
+      PARALLEL_END_INTERRUPT_REGION
     }
+    PARALLEL_CHECK_INTERRUPT_REGION
     loader->closeFile();
   } else // box structure and metadata only
   {
@@ -11,6 +11,7 @@
 #include "MantidDataObjects/MDBoxBase.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidKernel/CPUTimer.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Strings.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/VectorHelper.h"
@@ -18,6 +19,9 @@
 #include <Poco/File.h>
 #include <boost/scoped_ptr.hpp>
 
+#include <algorithm>
+#include <iterator>
+
 using namespace Mantid::Kernel;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
@@ -56,8 +60,9 @@ void MergeMDFiles::init() {
                   "If not, it will be created in memory.");
 
   declareProperty("Parallel", false,
-                  "Run the loading tasks in parallel.\n"
-                  "This can be faster but might use more memory.");
+                  "Merge the boxes in parallel, if all the input files can be read "
+                  "concurrently.\n"
+                  "This is faster but keeps the events of one box per thread in memory.");
 
   declareProperty(std::make_unique<WorkspaceProperty<IMDEventWorkspace>>("OutputWorkspace", "", Direction::Output),
                   "An output MDEventWorkspace.");
@@ -173,6 +178,56 @@ uint64_t MergeMDFiles::loadEventsFromSubBoxes(API::IMDNode *TargetBox) {
   return nBoxEvents;
 }
 
+/** Task that copies the events from the corresponding boxes of all files being
+ * merged to the location of a box in the output file. The events are copied
+ * in their file representation, so they are never created in memory, and the
+ * box is left file-backed with its signal and error set from the copied data.
+ *
+ * @param TargetBox :: the box of the output workspace
+ * @param saver :: the IO operations of the output file
+ * @return the number of events copied
+ */
+uint64_t MergeMDFiles::copyEventsFromSubBoxes(API::IMDNode *TargetBox, API::IBoxControllerIO &saver) {
+  // the box has been emptied and given its file position in loadBoxData(); do
+  // not clear it again as that would release its file space
+  const size_t ID = TargetBox->getID();
+
+  std::vector<coord_t> boxData, fileData;
+  uint64_t nBoxEvents(0);
+  for (size_t iw = 0; iw < this->m_EventLoader.size(); iw++) {
+    const auto &eventIndex = m_fileComponentsStructure[iw].getEventIndex();
+    const auto numFileEvents = static_cast<size_t>(eventIndex[2 * ID + 1]);
+    if (numFileEvents == 0)
+      continue;
+    m_EventLoader[iw]->loadBlock(fileData, eventIndex[2 * ID], numFileEvents);
+    boxData.insert(boxData.end(), fileData.cbegin(), fileData.cend());
+    nBoxEvents += numFileEvents;
+  }
+  if (nBoxEvents == 0)
+    return 0;
+
+  // every event starts with its signal and error squared
+  const size_t nColumns = boxData.size() / nBoxEvents;
+  double totalSignal(0), totalErrSq(0);
+  for (size_t i = 0; i < boxData.size(); i += nColumns) {
+    totalSignal += boxData[i];
+    totalErrSq += boxData[i + 1];
+  }
+
+  const uint64_t filePosition = m_BoxStruct.getEventIndex()[2 * ID];
+  saver.saveBlock(boxData, filePosition);
+  TargetBox->setSignal(static_cast<signal_t>(totalSignal));
+  TargetBox->setErrorSquared(static_cast<signal_t>(totalErrSq));
+  TargetBox->setFileBacked(filePosition, static_cast<size_t>(nBoxEvents), true);
+  return nBoxEvents;
+}
+
+/// @return true if the events of every input file can be read concurrently
+bool MergeMDFiles::canReadConcurrently() const {
+  return std::all_of(m_EventLoader.cbegin(), m_EventLoader.cend(),
+                     [](const auto &loader) { return loader->supportsConcurrentReads(); });
+}
+
 //----------------------------------------------------------------------------------------------
 /** Perform the merging, but clone the initial workspace and use the same
  *splitting
@@ -186,8 +241,7 @@ void MergeMDFiles::doExecByCloning(const Mantid::API::IMDEventWorkspace_sptr &ws
   m_OutIWS = ws;
   m_MDEventType = ws->getEventTypeName();
 
-  // Run the tasks in parallel? TODO: enable
-  // bool Parallel = this->getProperty("Parallel");
+  const bool parallel = this->getProperty("Parallel");
 
   // Fix the box controller settings in the output workspace so that it splits
   // normally
@@ -218,69 +272,47 @@ void MergeMDFiles::doExecByCloning(const Mantid::API::IMDEventWorkspace_sptr &ws
   // positions of the target workspace
   this->loadBoxData();
 
-  size_t numBoxes = m_BoxStruct.getNBoxes();
-  // Progress report based on events processed.
-  m_progress = std::make_unique<Progress>(this, 0.1, 0.9, size_t(numBoxes));
-  m_progress->setNotifyStep(0.1);
+  // Only the boxes without children hold events
+  const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
+  std::vector<API::IMDNode *> eventBoxes;
+  std::copy_if(boxes.cbegin(), boxes.cend(), std::back_inserter(eventBoxes),
+               [](const API::IMDNode *box) { return box->isBox(); });
 
-  // For tracking progress
-  // uint64_t m_totalEventsInTasks = 0;
+  m_progress = std::make_unique<Progress>(this, 0.1, 0.9, eventBoxes.size());
+  m_progress->setNotifyStep(0.1);
 
-  // Prepare thread pool
   CPUTimer overallTime;
-
-  auto ts = new ThreadSchedulerFIFO();
-  ThreadPool tp(ts);
-
-  Kernel::DiskBuffer *DiskBuf(nullptr);
-  if (m_fileBasedTargetWS) {
-    DiskBuf = bc->getFileIO();
-  }
-
   this->m_totalLoaded = 0;
-  const std::vector<API::IMDNode *> &boxes = m_BoxStruct.getBoxes();
 
-  for (size_t ib = 0; ib < numBoxes; ib++) {
-    auto box = boxes[ib];
-    if (!box->isBox())
-      continue;
-    // load all contributed events into current box;
-    this->loadEventsFromSubBoxes(box);
-
-    if (DiskBuf) {
-      if (box->getDataInMemorySize() > 0) { // data position has been already pre-calculated
-        box->getISaveable()->save();
-        box->clearDataFromMemory();
-        // Kernel::ISaveable *Saver = box->getISaveable();
-        // DiskBuf->toWrite(Saver);
-      }
+  // The boxes of the output have the same structure as the boxes of every
+  // input file and their file positions are already known, so each box is
+  // merged independently of all the others.
+  const bool mergeInParallel = parallel && canReadConcurrently();
+  if (parallel && !mergeInParallel)
+    g_log.information() << "The input files can not be read concurrently; merging the boxes serially.\n";
+  PARALLEL_FOR_IF(mergeInParallel)
+  for (int64_t ib = 0; ib < static_cast<int64_t>(eventBoxes.size()); ib++) {
+    PARALLEL_START_INTERRUPT_REGION
+    auto box = eventBoxes[ib];
+    uint64_t nEvents(0);
+    // load all contributed events into current box, or stream them straight
+    // to its place in the output file
+    if (m_fileBasedTargetWS)
+      nEvents = this->copyEventsFromSubBoxes(box, *saver);
+    else
+      nEvents = this->loadEventsFromSubBoxes(box);
+    {
+      std::lock_guard<std::mutex> lock(m_statsMutex);
+      m_totalLoaded += nEvents;
     }
-    // else
-    //{   size_t ID = box->getID();
-    //    uint64_t filePosition = targetEventIndexes[2*ID];
-    //    box->saveAt(saver.get(), filePosition);
-    //}
-    //
-    // if (!Parallel)
-    //{
-    //  // Run the task serially only
-    //  task->run();
-    //  delete task;
-    //}
-    // else
-    //{
-    //  // Enqueue to run in parallel (at the joinAll() call below).
-    //  ts->push(task);
-    //}
-
-    m_progress->reportIncrement(ib, "Loading and merging box data");
+    m_progress->report("Loading and merging box data");
+    PARALLEL_END_INTERRUPT_REGION
   }
-  if (DiskBuf) {
-    DiskBuf->flushCache();
+  PARALLEL_CHECK_INTERRUPT_REGION
+  if (m_fileBasedTargetWS) {
+    bc->getFileIO()->flushCache();
     bc->getFileIO()->flushData();
   }
-  //// Run any final tasks
-  // tp.joinAll();
   g_log.information() << overallTime << " to do all the adding.\n";
 
   // Close any open file handle
@@ -317,6 +349,14 @@ void MergeMDFiles::finalizeOutput(const std::string &outputFile) {
 
     file->closeGroup();
     file->close();
+    // The box signals have changed while merging, so update them in the flat
+    // box structure before it is written
+    const auto &boxes = m_BoxStruct.getBoxes();
+    auto &sigErr = m_BoxStruct.getSigErrData();
+    for (size_t i = 0; i < boxes.size(); i++) {
+      sigErr[2 * i] = static_cast<double>(boxes[i]->getSignal());
+      sigErr[2 * i + 1] = static_cast<double>(boxes[i]->getErrorSquared());
+    }
     // -------------- Save Box Structure  -------------------------------------
     // OK, we've filled these big arrays of data representing flat box
     // structure. Save them.
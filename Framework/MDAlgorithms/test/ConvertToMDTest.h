@@ -480,6 +480,59 @@ public:
     }
   }
 
+  void test_streaming_converter_matches_default() {
+    auto create_alg = AlgorithmManager::Instance().createUnmanaged("CreateSampleWorkspace");
+    create_alg->initialize();
+    create_alg->setChild(true);
+    create_alg->setProperty("WorkspaceType", "Event");
+    create_alg->setProperty("Function", "Flat background");
+    create_alg->setProperty("XMin", 10000.0);
+    create_alg->setProperty("XMax", 100000.0);
+    create_alg->setProperty("NumEvents", 1000);
+    create_alg->setProperty("BankPixelWidth", 5);
+    create_alg->setProperty("Random", true);
+    create_alg->setPropertyValue("OutputWorkspace", "dummy");
+    create_alg->execute();
+    MatrixWorkspace_sptr event_ws = create_alg->getProperty("OutputWorkspace");
+
+    auto convert = [&event_ws](const std::string &type) {
+      Algorithm_sptr convert_alg = AlgorithmManager::Instance().createUnmanaged("ConvertToMD");
+      convert_alg->initialize();
+      convert_alg->setChild(true);
+      convert_alg->setRethrows(true);
+      convert_alg->setProperty("InputWorkspace", event_ws);
+      convert_alg->setProperty("QDimensions", "Q3D");
+      convert_alg->setProperty("dEAnalysisMode", "Elastic");
+      convert_alg->setProperty("Q3DFrames", "Q_lab");
+      convert_alg->setPropertyValue("MinValues", "-10,-10,-10");
+      convert_alg->setPropertyValue("MaxValues", "10,10,10");
+      convert_alg->setProperty("SplitThreshold", 100);
+      convert_alg->setProperty("ConverterType", type);
+      // a limit of 1 MB forces the events through several temporary files
+      convert_alg->setProperty("StreamingMemoryLimit", 1);
+      convert_alg->setProperty("OutputWorkspace", "blank");
+      convert_alg->execute();
+      IMDEventWorkspace_sptr out_ws = convert_alg->getProperty("OutputWorkspace");
+      return out_ws;
+    };
+    IMDEventWorkspace_sptr default_ws, streaming_ws;
+    TS_ASSERT_THROWS_NOTHING(default_ws = convert("Default"));
+    TS_ASSERT_THROWS_NOTHING(streaming_ws = convert("Streaming"));
+    TS_ASSERT_EQUALS(default_ws->getNEvents(), streaming_ws->getNEvents());
+
+    auto compare_alg = AlgorithmManager::Instance().createUnmanaged("CompareMDWorkspaces");
+    compare_alg->setChild(true);
+    compare_alg->initialize();
+    compare_alg->setProperty("Workspace1", default_ws);
+    compare_alg->setProperty("Workspace2", streaming_ws);
+    compare_alg->setProperty("Tolerance", 0.00001);
+    compare_alg->setProperty("CheckEvents", true);
+    compare_alg->setProperty("IgnoreBoxID", true);
+    TS_ASSERT_THROWS_NOTHING(compare_alg->execute());
+    bool is_equal = compare_alg->getProperty("Equals");
+    TS_ASSERT(is_equal);
+  }
+
 private:
   void checkHistogramsHaveBeenStored(const std::string &wsName, double val = 0.34, double bin_min = 0.3,
                                      double bin_max = 0.4) {
@@ -514,6 +567,7 @@ class ConvertToMDTestPerformance : public CxxTest::TestSuite {
 
   Mantid::MDAlgorithms::ConvertToMD convertAlgDefault;
   Mantid::MDAlgorithms::ConvertToMD convertAlgIndexed;
+  Mantid::MDAlgorithms::ConvertToMD convertAlgStreaming;
 
   WorkspaceCreationHelper::StubAlgorithm reporter;
 
@@ -679,6 +733,8 @@ public:
 
   void test_EventFromTOFConvBuildTreeIndexed() { convertAlgIndexed.execute(); }
 
+  void test_EventFromTOFConvBuildTreeStreaming() { convertAlgStreaming.execute(); }
+
   static void setUpConvAlg(Mantid::MDAlgorithms::ConvertToMD &convAlg, const std::string &type,
                            const std::string &inName) {
     static uint32_t cnt = 0;
@@ -759,5 +815,6 @@ public:
 
     setUpConvAlg(convertAlgDefault, "Default", inWsSampleName);
     setUpConvAlg(convertAlgIndexed, "Indexed", inWsSampleName);
+    setUpConvAlg(convertAlgStreaming, "Streaming", inWsSampleName);
   }
 };
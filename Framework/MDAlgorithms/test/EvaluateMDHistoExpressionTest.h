@@ -0,0 +1,129 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/ExperimentInfo.h"
+#include "MantidAPI/IMDHistoWorkspace.h"
+#include "MantidAPI/Run.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidFrameworkTestHelpers/MDEventsTestHelper.h"
+#include "MantidMDAlgorithms/EvaluateMDHistoExpression.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::MDAlgorithms;
+
+class EvaluateMDHistoExpressionTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EvaluateMDHistoExpressionTest *createSuite() { return new EvaluateMDHistoExpressionTest(); }
+  static void destroySuite(EvaluateMDHistoExpressionTest *suite) { delete suite; }
+
+  void setUp() override {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("histo_A", MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0, 2, 5, 10.0, 2.0));
+    ads.addOrReplace("histo_B", MDEventsTestHelper::makeFakeMDHistoWorkspace(3.0, 2, 5, 10.0, 3.0));
+    ads.addOrReplace("histo_zero", MDEventsTestHelper::makeFakeMDHistoWorkspace(0.0, 2, 5, 10.0, 0.0));
+    ads.addOrReplace("histo-small", MDEventsTestHelper::makeFakeMDHistoWorkspace(4.0, 2, 4, 10.0, 4.0));
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_Init() {
+    EvaluateMDHistoExpression alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_arithmetic() {
+    do_test("histo_A + histo_B", 5.0, 5.0);
+    do_test("histo_A - histo_B", -1.0, 5.0);
+    do_test("histo_A * histo_B", 6.0, 2.0 * 9.0 + 3.0 * 4.0);
+    do_test("(histo_A + 1) * 2.5 - 1", 6.5, 2.0 * 2.5 * 2.5);
+    do_test("histo_B / (histo_A * 2)", 0.75, 3.0 / 16.0 + 8.0 * 0.75 * 0.75 / 16.0);
+    do_test("10 - histo_A", 8.0, 2.0);
+    do_test("-histo_A ** 2", -4.0, 16.0 * 4.0 * 2.0 / 4.0);
+    do_test("exp(histo_zero)", 1.0, 0.0);
+  }
+
+  void test_logarithm_uses_filler() {
+    do_test("log10(histo_zero)", -1.0, 0.0, true, "-1");
+    do_test("log(histo_A)", std::log(2.0), 2.0 / 4.0);
+  }
+
+  void test_comparisons_and_boolean_operations() {
+    do_test("histo_A < histo_B", 1.0, 0.0);
+    do_test("2.5 < histo_A", 0.0, 0.0);
+    do_test("histo_A == 2", 1.0, 0.0);
+    do_test("(histo_A > 1) & ~histo_zero", 1.0, 0.0);
+    do_test("histo_zero | histo_zero ^ histo_A", 1.0, 0.0);
+  }
+
+  void test_where() {
+    do_test("where(histo_A < histo_B, histo_B, histo_A)", 3.0, 3.0);
+    do_test("where(histo_A > histo_B, 7, histo_A * 2)", 4.0, 8.0);
+  }
+
+  void test_quoted_names() { do_test("'histo-small' * 2", 8.0, 16.0); }
+
+  void test_inputs_are_not_modified() {
+    do_test("histo_A * histo_A + histo_A", 6.0, 2.0 * 4.0 + 2.0 * 4.0 + 2.0);
+    auto a = AnalysisDataService::Instance().retrieveWS<IMDHistoWorkspace>("histo_A");
+    TS_ASSERT_DELTA(a->signalAt(0), 2.0, 1e-12);
+  }
+
+  void test_in_place() {
+    auto before = AnalysisDataService::Instance().retrieveWS<IMDHistoWorkspace>("histo_A");
+    do_test("histo_A * 3", 6.0, 18.0, true, "0", "histo_A");
+    auto after = AnalysisDataService::Instance().retrieveWS<IMDHistoWorkspace>("histo_A");
+    TS_ASSERT_EQUALS(before, after);
+    TS_ASSERT(after->getExperimentInfo(0)->run().hasProperty("mdhisto_was_modified"));
+  }
+
+  void test_bad_expressions() {
+    do_test("histo_A +", 0, 0, false);
+    do_test("histo_A < histo_B < histo_A", 0, 0, false);
+    do_test("sqrt(histo_A)", 0, 0, false);
+    do_test("1 + 2", 0, 0, false);
+    do_test("2 / histo_A", 0, 0, false);
+    do_test("histo_A ** histo_B", 0, 0, false);
+    do_test("histo_A & 1", 0, 0, false);
+    do_test("histo_A + histo_C", 0, 0, false);
+    do_test("histo_A + 'histo-small'", 0, 0, false);
+  }
+
+private:
+  void do_test(const std::string &expression, double expectedSignal, double expectedErrorSquared,
+               bool succeeds = true, const std::string &filler = "0", const std::string &outputName = "out") {
+    EvaluateMDHistoExpression alg;
+    alg.setRethrows(true);
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Expression", expression));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filler", filler));
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", outputName));
+    if (!succeeds) {
+      TSM_ASSERT_THROWS_ANYTHING(expression, alg.execute());
+      TS_ASSERT(!alg.isExecuted());
+      return;
+    }
+    TSM_ASSERT_THROWS_NOTHING(expression, alg.execute());
+    TS_ASSERT(alg.isExecuted());
+    IMDHistoWorkspace_sptr out;
+    TS_ASSERT_THROWS_NOTHING(out = AnalysisDataService::Instance().retrieveWS<IMDHistoWorkspace>(outputName));
+    TS_ASSERT(out);
+    if (!out)
+      return;
+    for (size_t i = 0; i < out->getNPoints(); ++i) {
+      TSM_ASSERT_DELTA(expression, out->signalAt(i), expectedSignal, 1e-9);
+      TSM_ASSERT_DELTA(expression, out->errorSquaredAt(i), expectedErrorSquared, 1e-9);
+    }
+  }
+};
@@ -165,7 +165,8 @@ public:
 
   //=================================================================================================================
   template <size_t nd>
-  void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true, double memory = 0, bool BoxStructureOnly = false) {
+  void do_test_exec(bool FileBackEnd, bool deleteWorkspace = true, double memory = 0, bool BoxStructureOnly = false,
+                    double readCacheMemory = 0) {
     using MDE = MDLeanEvent<nd>;
 
     //------ Start by creating the file
@@ -212,6 +213,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Filename", filename));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("FileBackEnd", FileBackEnd));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("Memory", memory));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("ReadCacheMemory", readCacheMemory));
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", outWSName));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("MetadataOnly", false));
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("BoxStructureOnly", BoxStructureOnly));
@@ -377,6 +379,9 @@ public:
   /// Run the loading but keep the events on file and load on demand
   void test_exec_3D_with_FileBackEnd_andSmallBuffer() { do_test_exec<3>(true, true, 1.0); }
 
+  /// Run the loading keeping recently read blocks of events in the read cache
+  void test_exec_3D_with_FileBackEnd_andReadCache() { do_test_exec<3>(true, true, 1.0, false, 10.0); }
+
   /** Use the file back end,
    * then change it and save to update the file at the back end.
    */
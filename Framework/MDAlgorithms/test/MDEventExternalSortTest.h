@@ -0,0 +1,113 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataObjects/MDEvent.h"
+#include "MantidMDAlgorithms/MDEventExternalSort.h"
+
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::MDAlgorithms::MDEventExternalSort;
+
+class MDEventExternalSortTest : public CxxTest::TestSuite {
+public:
+  static MDEventExternalSortTest *createSuite() { return new MDEventExternalSortTest(); }
+  static void destroySuite(MDEventExternalSortTest *suite) { delete suite; }
+
+  MDEventExternalSortTest() {
+    for (int ax = 0; ax < 3; ++ax) {
+      m_space(ax, 0) = -10.f;
+      m_space(ax, 1) = 10.f;
+    }
+  }
+
+  void test_events_fitting_in_memory_are_sorted_without_spilling() {
+    MDEventExternalSort<3, MDEvent> sorter(m_space, 100 * 1024 * 1024);
+    addRandomEvents(sorter, 5, 1000);
+
+    TS_ASSERT_EQUALS(sorter.numberOfEvents(), 5000);
+    TS_ASSERT_EQUALS(sorter.numberOfSpillFiles(), 0);
+    checkMergeIsSorted(sorter, 5000);
+  }
+
+  void test_events_exceeding_memory_limit_are_merged_from_spill_files() {
+    const size_t memoryLimit = 500 * MDEventExternalSort<3, MDEvent>::bytesPerEvent();
+    MDEventExternalSort<3, MDEvent> sorter(m_space, memoryLimit);
+    addRandomEvents(sorter, 5, 1000);
+
+    TS_ASSERT_EQUALS(sorter.numberOfEvents(), 5000);
+    TS_ASSERT_EQUALS(sorter.numberOfSpillFiles(), 10);
+    checkMergeIsSorted(sorter, 5000);
+  }
+
+  void test_events_are_preserved_by_spilling() {
+    const size_t memoryLimit = 10 * MDEventExternalSort<3, MDEvent>::bytesPerEvent();
+    MDEventExternalSort<3, MDEvent> sorter(m_space, memoryLimit);
+    addRandomEvents(sorter, 3, 50);
+
+    double totalSignal(0.);
+    uint64_t totalDetectorID(0);
+    sorter.merge([&](std::vector<MDEvent<3>> &batch) {
+      for (const auto &event : batch) {
+        totalSignal += event.getSignal();
+        totalDetectorID += event.getDetectorID();
+      }
+    });
+    // signals are 1..150 and detector IDs are 0..49 repeated three times
+    TS_ASSERT_DELTA(totalSignal, 150. * 151. / 2., 1e-6);
+    TS_ASSERT_EQUALS(totalDetectorID, 3 * 49 * 50 / 2);
+  }
+
+  void test_merge_of_empty_sorter_does_not_call_consumer() {
+    MDEventExternalSort<3, MDLeanEvent> sorter(m_space, 1024);
+    bool called(false);
+    TS_ASSERT_EQUALS(sorter.merge([&called](std::vector<MDLeanEvent<3>> &) { called = true; }), 0);
+    TS_ASSERT(!called);
+  }
+
+private:
+  using Sorter = MDEventExternalSort<3, MDEvent>;
+
+  void addRandomEvents(Sorter &sorter, size_t nChunks, size_t eventsPerChunk) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> coordinate(-10.f, 10.f);
+    float signal(0.f);
+    for (size_t chunk = 0; chunk < nChunks; ++chunk) {
+      std::vector<MDEvent<3>> events;
+      for (size_t i = 0; i < eventsPerChunk; ++i) {
+        float centers[3] = {coordinate(generator), coordinate(generator), coordinate(generator)};
+        signal += 1.f;
+        events.emplace_back(signal, 1.f, uint16_t(0), uint16_t(0), static_cast<int32_t>(i), centers);
+      }
+      sorter.add(events);
+      TS_ASSERT(events.empty());
+    }
+  }
+
+  void checkMergeIsSorted(Sorter &sorter, size_t expectedEvents) {
+    Sorter::MortonT previous(0);
+    bool isSorted(true);
+    size_t nEvents(0);
+    const auto nMerged = sorter.merge([&](std::vector<MDEvent<3>> &batch) {
+      for (const auto &event : batch) {
+        const auto index =
+            morton_index::coordinatesToIndex<3, Sorter::IntT, Sorter::MortonT>(event.getCenter(), m_space);
+        isSorted &= !(index < previous);
+        previous = index;
+        ++nEvents;
+      }
+    });
+    TS_ASSERT(isSorted);
+    TS_ASSERT_EQUALS(nMerged, expectedEvents);
+    TS_ASSERT_EQUALS(nEvents, expectedEvents);
+  }
+
+  morton_index::MDSpaceBounds<3> m_space;
+};
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidDataObjects/MDEventFactory.h"
 #include "MantidFrameworkTestHelpers/MDAlgorithmsTestHelper.h"
 #include "MantidGeometry/MDGeometry/QSample.h"
@@ -32,7 +33,11 @@ public:
 
   void test_exec_fileBacked() { do_test_exec("MergeMDFilesTest_OutputWS.nxs"); }
 
-  void do_test_exec(const std::string &OutputFilename) {
+  void test_exec_serial() { do_test_exec("", false); }
+
+  void test_exec_fileBacked_serial() { do_test_exec("MergeMDFilesTest_OutputWS.nxs", false); }
+
+  void do_test_exec(const std::string &OutputFilename, const bool parallel = true) {
     if (OutputFilename != "") {
       if (Poco::File(OutputFilename).exists())
         Poco::File(OutputFilename).remove();
@@ -53,6 +58,14 @@ public:
       inWorkspaces.emplace_back(ws);
       filenames.emplace_back(std::vector<std::string>(1, ws->getBoxController()->getFilename()));
     }
+    // the boxes are only merged in parallel if every input can be read concurrently
+    for (const auto &inWorkspace : inWorkspaces) {
+      BoxControllerNeXusIO loader(inWorkspace->getBoxController().get());
+      loader.setDataType(sizeof(Mantid::coord_t), inWorkspace->getEventTypeName());
+      TS_ASSERT_THROWS_NOTHING(loader.openFile(inWorkspace->getBoxController()->getFilename(), "r"));
+      TS_ASSERT(loader.supportsConcurrentReads());
+      loader.closeFile();
+    }
 
     // Name of the output workspace.
     std::string outWSName("MergeMDFilesTest_OutputWS");
@@ -63,6 +76,7 @@ public:
     TS_ASSERT_THROWS_NOTHING(alg.setProperty("Filenames", filenames));
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputFilename", OutputFilename));
     TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("OutputWorkspace", outWSName));
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("Parallel", parallel));
 
     // clean up possible rubbish from previous runs
     std::string fullName = alg.getPropertyValue("OutputFilename");
@@ -92,6 +106,18 @@ public:
     for (size_t i = 0; i < box->getNumChildren(); i++)
       TS_ASSERT_LESS_THAN(1, box->getChild(i)->getNPoints());
 
+    // Every box holds the events of the corresponding boxes of all the inputs
+    for (size_t i = 0; i < box->getNumChildren(); i++) {
+      double expectedSignal(0);
+      uint64_t expectedPoints(0);
+      for (const auto &inWorkspace : inWorkspaces) {
+        expectedSignal += inWorkspace->getBox()->getChild(i)->getSignal();
+        expectedPoints += inWorkspace->getBox()->getChild(i)->getNPoints();
+      }
+      TS_ASSERT_DELTA(box->getChild(i)->getSignal(), expectedSignal, 1e-3);
+      TS_ASSERT_EQUALS(box->getChild(i)->getNPoints(), expectedPoints);
+    }
+
     if (!OutputFilename.empty()) {
       TS_ASSERT(ws->isFileBacked());
       TS_ASSERT(Poco::File(actualOutputFilename).exists());
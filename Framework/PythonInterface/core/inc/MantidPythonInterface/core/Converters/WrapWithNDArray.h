@@ -24,6 +24,10 @@ namespace Impl {
 template <typename ElementType>
 PyObject *wrapWithNDArray(const ElementType *, const int ndims, Py_intptr_t *dims, const NumpyWrapMode mode,
                           const OwnershipMode oMode = OwnershipMode::Cpp);
+// Wrap strided data owned by a Python object, which is kept alive by the array
+template <typename ElementType>
+PyObject *wrapWithStridedNDArray(const ElementType *, const int ndims, Py_intptr_t *dims, Py_intptr_t *strides,
+                                 const NumpyWrapMode mode, PyObject *owner);
 } // namespace Impl
 
 /**
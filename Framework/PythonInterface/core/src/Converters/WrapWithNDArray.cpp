@@ -92,12 +92,54 @@ PyObject *wrapWithNDArray(const ElementType *carray, const int ndims, Py_intptr_
   return reinterpret_cast<PyObject *>(nparray);
 }
 
+/**
+ * Wraps strided data in a numpy array structure without copying it. The
+ * array holds a reference to the owner of the data so that the owner lives at
+ * least as long as the array.
+ * @param carray :: A pointer to the first element
+ * @param ndims :: The dimensionality of the array
+ * @param dims :: The length of the arrays in each dimension
+ * @param strides :: The distance in bytes between consecutive elements in each
+ *dimension. A stride of zero repeats the same element.
+ * @param mode :: A mode switch to define whether the final array is read
+ *only/read-write
+ * @param owner :: The Python object owning the data, may be nullptr
+ * @return A pointer to a numpy ndarray object
+ */
+template <typename ElementType>
+PyObject *wrapWithStridedNDArray(const ElementType *carray, const int ndims, Py_intptr_t *dims, Py_intptr_t *strides,
+                                 const NumpyWrapMode mode, PyObject *owner) {
+  // numpy allocates a buffer of its own when given no data, even for an
+  // empty array
+  static const ElementType noData{};
+  if (!carray)
+    carray = &noData;
+  int datatype = NDArrayTypeIndex<ElementType>::typenum;
+  auto *nparray = reinterpret_cast<PyArrayObject *>(
+      PyArray_New(&PyArray_Type, ndims, dims, datatype, strides, static_cast<void *>(const_cast<ElementType *>(carray)),
+                  0, NPY_ARRAY_WRITEABLE, nullptr));
+  if (!nparray)
+    return nullptr;
+
+  if (owner) {
+    Py_INCREF(owner);
+    PyArray_SetBaseObject(nparray, owner);
+  }
+
+  if (mode == ReadOnly)
+    markReadOnly(nparray);
+  return reinterpret_cast<PyObject *>(nparray);
+}
+
 //-----------------------------------------------------------------------
 // Explicit instantiations
 //-----------------------------------------------------------------------
 #define INSTANTIATE_WRAPNUMPY(ElementType)                                                                             \
   template DLLExport PyObject *wrapWithNDArray<ElementType>(const ElementType *, const int ndims, Py_intptr_t *dims,   \
-                                                            const NumpyWrapMode mode, const OwnershipMode oMode);
+                                                            const NumpyWrapMode mode, const OwnershipMode oMode);      \
+  template DLLExport PyObject *wrapWithStridedNDArray<ElementType>(const ElementType *, const int ndims,               \
+                                                                   Py_intptr_t *dims, Py_intptr_t *strides,            \
+                                                                   const NumpyWrapMode mode, PyObject *owner);
 
 ///@cond Doxygen doesn't seem to like this...
 INSTANTIATE_WRAPNUMPY(int)
@@ -0,0 +1,16 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <boost/python/object.hpp> //Safer way to include Python.h
+
+namespace Mantid {
+namespace PythonInterface {
+/// Create a read-only 2D numpy view of the X values of the given workspace
+PyObject *viewX(const boost::python::object &self);
+} // namespace PythonInterface
+} // namespace Mantid
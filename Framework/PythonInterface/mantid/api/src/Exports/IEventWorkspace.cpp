@@ -53,7 +53,10 @@ void export_IEventWorkspace() {
            "Return the :class:`~mantid.api.IEventList` managing the events at "
            "the given :class:`~mantid.api.Workspace` "
            "index")
-      .def("clearMRU", &IEventWorkspace::clearMRU, args("self"), "Clear the most-recently-used lists");
+      .def("clearMRU", &IEventWorkspace::clearMRU, args("self"), "Clear the most-recently-used lists")
+      .def("cacheHistograms", &IEventWorkspace::cacheHistograms, args("self"),
+           "Histogram all the spectra in parallel and keep the histograms until the events or binning change, "
+           "within the limit set by EventWorkspace.HistogramCacheMB. Returns the number of spectra histogrammed.");
 
   RegisterWorkspacePtrToPython<IEventWorkspace>();
 }
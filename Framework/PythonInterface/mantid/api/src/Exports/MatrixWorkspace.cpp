@@ -16,6 +16,7 @@
 
 #include "MantidPythonInterface/api/CloneMatrixWorkspace.h"
 #include "MantidPythonInterface/api/RegisterWorkspacePtrToPython.h"
+#include "MantidPythonInterface/api/ViewMatrixWorkspace.h"
 #include "MantidPythonInterface/core/Converters/NDArrayToVector.h"
 #include "MantidPythonInterface/core/Converters/PySequenceToVector.h"
 #include "MantidPythonInterface/core/Converters/WrapWithNDArray.h"
@@ -488,6 +489,12 @@ void export_MatrixWorkspace() {
            "Note: This can fail for large workspaces as numpy will require a "
            "block "
            "of memory free that will fit all of the data.")
+      // --------------------------------------- View data
+      // ------------------------------
+      .def("viewX", Mantid::PythonInterface::viewX, args("self"),
+           "Returns a read-only 2D numpy array of the X data. Unlike extractX, "
+           "it shares the memory of the workspace when the layout of the spectra "
+           "allows it and must not be used once the workspace is modified.")
       .def("getSignalAtCoord", &getSignalAtCoord, args("self", "coords", "normalization"),
            "Return signal for array of coordinates")
       //-------------------------------------- Operators
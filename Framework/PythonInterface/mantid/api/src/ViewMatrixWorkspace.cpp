@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include "MantidPythonInterface/api/ViewMatrixWorkspace.h"
+#include "MantidAPI/IEventWorkspace.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidPythonInterface/api/CloneMatrixWorkspace.h"
+#include "MantidPythonInterface/core/Converters/WrapWithNDArray.h"
+
+#include <boost/python/extract.hpp>
+
+#include <cstdint>
+
+namespace Mantid::PythonInterface {
+using Mantid::API::MatrixWorkspace;
+using Mantid::PythonInterface::Converters::ReadOnly;
+
+/* Create a read-only numpy view of the X values of the given workspace. This
+ * is possible without copying when the spectra have the same length and each
+ * starts a fixed number of bytes after the previous one, e.g. when they share
+ * their X values. Otherwise the values are copied as by extractX. The Y and E
+ * values of a Workspace2D are held in a separate allocation per spectrum, so
+ * they are not offered as views.
+ * @param self :: A Python object holding a MatrixWorkspace. The view keeps it
+ * alive.
+ * @return A 2D numpy array, copied if the X values are not evenly spaced
+ * in memory
+ */
+PyObject *viewX(const boost::python::object &self) {
+  const MatrixWorkspace &workspace = boost::python::extract<const MatrixWorkspace &>(self)();
+  const size_t numHist = workspace.getNumberHistograms();
+  // Event workspaces make their histograms on demand so they can only be
+  // copied
+  if (numHist == 0 || dynamic_cast<const API::IEventWorkspace *>(&workspace))
+    return cloneX(workspace);
+
+  const MantidVec &first = workspace.readX(0);
+  const auto head = reinterpret_cast<std::intptr_t>(first.data());
+  const auto length = first.size();
+  const auto stride = numHist > 1 ? reinterpret_cast<std::intptr_t>(workspace.readX(1).data()) - head
+                                  : static_cast<std::intptr_t>(length * sizeof(double));
+  for (size_t i = 1; i < numHist; ++i) {
+    const MantidVec &values = workspace.readX(i);
+    if (values.size() != length ||
+        reinterpret_cast<std::intptr_t>(values.data()) != head + static_cast<std::intptr_t>(i) * stride)
+      return cloneX(workspace);
+  }
+
+  Py_intptr_t dims[2] = {static_cast<Py_intptr_t>(numHist), static_cast<Py_intptr_t>(length)};
+  Py_intptr_t strides[2] = {stride, static_cast<Py_intptr_t>(sizeof(double))};
+  return Converters::Impl::wrapWithStridedNDArray(first.data(), 2, dims, strides, ReadOnly, self.ptr());
+}
+} // namespace Mantid::PythonInterface
@@ -5,11 +5,15 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataObjects/EventList.h"
+#include "MantidPythonInterface/core/Converters/WrapWithNDArray.h"
 #include "MantidPythonInterface/core/GetPointer.h"
 #include <boost/python/class.hpp>
+#include <boost/python/extract.hpp>
 #include <boost/python/register_ptr_to_python.hpp>
 #include <boost/python/return_arg.hpp>
 
+#include <cstdint>
+
 using namespace boost::python;
 using namespace Mantid::DataObjects;
 
@@ -24,6 +28,32 @@ void addWeightedEventToEventList(EventList &self, double tof, double weight, dou
                                  Mantid::Types::Core::DateAndTime pulsetime) {
   self.addEventQuickly(WeightedEvent(Mantid::Types::Event::TofEvent(tof, pulsetime), weight, errorsquare));
 }
+
+/// Wrap a column of the events in a read-only 1D numpy array that keeps the
+/// Python EventList object alive
+template <typename ElementType> PyObject *wrapColumn(const object &self, const EventColumn &column) {
+  Py_intptr_t dims[1] = {static_cast<Py_intptr_t>(column.size)};
+  Py_intptr_t strides[1] = {static_cast<Py_intptr_t>(column.stride)};
+  return Mantid::PythonInterface::Converters::Impl::wrapWithStridedNDArray(
+      static_cast<const ElementType *>(column.data), 1, dims, strides, Mantid::PythonInterface::Converters::ReadOnly,
+      self.ptr());
+}
+
+PyObject *viewTofs(const object &self) {
+  return wrapColumn<double>(self, extract<const EventList &>(self)().tofColumn());
+}
+
+PyObject *viewPulseTimes(const object &self) {
+  return wrapColumn<int64_t>(self, extract<const EventList &>(self)().pulseTimeColumn());
+}
+
+PyObject *viewWeights(const object &self) {
+  return wrapColumn<float>(self, extract<const EventList &>(self)().weightColumn());
+}
+
+PyObject *viewErrorSquared(const object &self) {
+  return wrapColumn<float>(self, extract<const EventList &>(self)().errorSquaredColumn());
+}
 } // namespace
 
 void export_EventList() {
@@ -34,6 +64,18 @@ void export_EventList() {
            "Create TofEvent and add to EventList.")
       .def("addWeightedEventQuickly", &addWeightedEventToEventList,
            args("self", "tof", "weight", "errorsquare", "pulsetime"), "Create weighted TofEvent and add to eventlist")
+      .def("viewTofs", &viewTofs, args("self"),
+           "Returns a read-only numpy array of the TOF of the events that shares the memory of the list. "
+           "It must not be used once the list is modified.")
+      .def("viewPulseTimes", &viewPulseTimes, args("self"),
+           "Returns a read-only numpy array of the pulse times of the events, as int64 nanoseconds since "
+           "1990-01-01, that shares the memory of the list. It must not be used once the list is modified.")
+      .def("viewWeights", &viewWeights, args("self"),
+           "Returns a read-only float32 numpy array of the weights of the events that shares the memory of the "
+           "list. It must not be used once the list is modified.")
+      .def("viewErrorSquared", &viewErrorSquared, args("self"),
+           "Returns a read-only float32 numpy array of the squared errors of the weights of the events that "
+           "shares the memory of the list. It must not be used once the list is modified.")
       .def("__iadd__", (EventList & (EventList::*)(const EventList &)) & EventList::operator+=, return_self<>(),
            (arg("self"), arg("other")))
       .def("__isub__", (EventList & (EventList::*)(const EventList &)) & EventList::operator-=, return_self<>(),
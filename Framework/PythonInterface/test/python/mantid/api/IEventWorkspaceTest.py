@@ -39,6 +39,12 @@ class IEventWorkspaceTest(unittest.TestCase):
             error_raised = True
         self.assertFalse(error_raised)
 
+    def test_cacheHistograms_histograms_each_spectrum_once(self):
+        self._test_ws.clearMRU()
+        self.assertEqual(self._test_ws.cacheHistograms(), self._npixels)
+        self.assertEqual(self._test_ws.cacheHistograms(), 0)
+        self.assertEqual(len(self._test_ws.readY(0)), self._nbins)
+
     def test_event_list_is_return_as_correct_type(self):
         el = self._test_ws.getSpectrum(0)
         self.assertTrue(isinstance(el, IEventList))
@@ -239,6 +239,21 @@ class MatrixWorkspaceTest(unittest.TestCase):
         self.assertTrue(len(dx), 0)
         self._do_numpy_comparison(self._test_ws, x, y, e)
 
+    def test_x_data_can_be_viewed_as_a_read_only_numpy_array(self):
+        x = self._test_ws.viewX()
+
+        self.assertFalse(x.flags.writeable)
+        self.assertTrue(np.array_equal(x, self._test_ws.extractX()))
+
+    def test_view_of_shared_x_values_does_not_copy(self):
+        ws = CreateSampleWorkspace(NumBanks=1, BankPixelWidth=2, StoreInADS=False)
+        # Rebin gives all the spectra the same bin edges
+        ws = Rebin(ws, Params="0,1000,20000", StoreInADS=False)
+        x = ws.viewX()
+        self.assertEqual(x.shape, (4, 21))
+        self.assertEqual(x.strides[0], 0)
+        self.assertTrue(np.array_equal(x[3], ws.readX(3)))
+
     def _do_numpy_comparison(self, workspace, x_np, y_np, e_np, index=None):
         if index is None:
             nhist = workspace.getNumberHistograms()
@@ -47,6 +47,21 @@ class EventListTest(unittest.TestCase):
         self.assertEqual(el.getPulseTimesAsNumpy()[0], gps_epoch_plus_42_nanoseconds)
         self.assertEqual(el.getWeights()[0], 1.0)
 
+    def test_event_columns_can_be_viewed_as_numpy_arrays(self):
+        el = self.createRandomEventList(10)
+        tofs = el.viewTofs()
+        self.assertFalse(tofs.flags.writeable)
+        self.assertTrue(np.array_equal(tofs, el.getTofs()))
+        self.assertTrue(np.array_equal(el.viewPulseTimes(), np.arange(10)))
+        self.assertTrue(np.array_equal(el.viewWeights(), np.ones(10)))
+
+        el.switchTo(EventType.WEIGHTED)
+        el.addWeightedEventQuickly(12.5, 2.0, 0.25, DateAndTime(42))
+        self.assertTrue(np.array_equal(el.viewTofs(), el.getTofs()))
+        self.assertEqual(el.viewPulseTimes()[-1], 42)
+        self.assertEqual(el.viewWeights()[-1], 2.0)
+        self.assertEqual(el.viewErrorSquared()[-1], 0.25)
+
     def test_event_list_iadd(self):
         left = self.createRandomEventList(10)
         rght = self.createRandomEventList(20)
@@ -12,6 +12,7 @@
 #include "MantidDataObjects/GroupingWorkspace.h"
 #include "MantidDataObjects/MaskWorkspace.h"
 #include "MantidDataObjects/OffsetsWorkspace.h"
+#include "MantidDataObjects/TableWorkspace.h"
 
 namespace Mantid {
 namespace Kernel {
@@ -51,6 +52,9 @@ private:
   void init() override;
   void exec() override;
   void loadCalFile(const std::string &calFilename, const std::string &groupFilename);
+  bool canFuseReduction(const DataObjects::TableWorkspace_sptr &maskBinTableWS, const bool applyLorentz);
+  API::MatrixWorkspace_sptr fusedReduction();
+  void finishFocussing(const double compressEventsTolerance, const double wallClockTolerance);
   API::MatrixWorkspace_sptr rebin(API::MatrixWorkspace_sptr matrixws);
   API::MatrixWorkspace_sptr rebinRagged(API::MatrixWorkspace_sptr matrixws, const bool inDspace);
 
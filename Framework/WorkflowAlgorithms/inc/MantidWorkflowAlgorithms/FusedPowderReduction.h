@@ -0,0 +1,110 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/MaskWorkspace.h"
+#include "MantidKernel/System.h"
+#include "MantidKernel/Unit.h"
+
+#include <limits>
+#include <set>
+#include <vector>
+
+namespace Mantid {
+namespace API {
+class Progress;
+class Run;
+} // namespace API
+
+namespace WorkflowAlgorithms {
+/**
+FusedPowderReduction focusses an EventWorkspace into d-spacing in a single
+pass over its events. Each event is cropped in time-of-flight, checked
+against the prompt pulses, converted to d-spacing with the diffractometer
+constants of its spectrum and added straight into its group, which does in
+one go what CropWorkspace, RemovePromptPulse, MaskDetectors, ConvertUnits,
+Rebin and DiffractionFocussing do one after the other.
+
+The output has one spectrum per group, numbered by group, holding either
+a histogram of the counts or the converted events. Like the output of
+DiffractionFocussing, it is binned logarithmically over the range of the
+requested bins, with as many bins, and the histograms are normalised by
+the share of each bin that the spectra cover.
+*/
+class DLLExport FusedPowderReduction {
+public:
+  FusedPowderReduction(const API::MatrixWorkspace &calibrated, const DataObjects::GroupingWorkspace &grouping,
+                       const DataObjects::MaskWorkspace *mask, std::vector<double> dSpacingEdges);
+
+  /// Only keep events with a time-of-flight in [tofMin, tofMax]
+  void setTofRange(const double tofMin, const double tofMax) {
+    m_tofMin = tofMin;
+    m_tofMax = tofMax;
+  }
+  /// Remove events in [time, time + width] after each of the prompt pulse times
+  void setPromptPulses(std::vector<double> times, const double width) {
+    m_promptPulses = std::move(times);
+    m_promptPulseWidth = width;
+  }
+  /// @return the group numbers, in the order of the output spectra
+  const std::vector<int> &groups() const { return m_groups; }
+
+  API::MatrixWorkspace_sptr focusToHistograms(const DataObjects::EventWorkspace &input,
+                                              API::Progress *progress = nullptr) const;
+  DataObjects::EventWorkspace_sptr focusToEvents(const DataObjects::EventWorkspace &input,
+                                                 API::Progress *progress = nullptr) const;
+
+  static std::vector<double> promptPulseTimes(const API::Run &run, const double tofMin, const double tofMax);
+
+private:
+  /// @return true if an event at this time-of-flight survives the cropping and prompt pulse removal
+  bool keep(const double tof) const {
+    if (tof < m_tofMin || tof > m_tofMax)
+      return false;
+    for (const auto pulse : m_promptPulses)
+      if (tof >= pulse && tof <= pulse + m_promptPulseWidth)
+        return false;
+    return true;
+  }
+  std::unique_ptr<Kernel::Unit> createConverter(const size_t wsIndex) const;
+  template <typename EventType>
+  void histogram(const std::vector<EventType> &events, const Kernel::Unit &converter, double *y, double *e2) const;
+  template <typename OutputType, typename EventType>
+  void convert(const std::vector<EventType> &events, const Kernel::Unit &converter,
+               std::vector<OutputType> &converted) const;
+  template <typename OutputType>
+  void focusEvents(const DataObjects::EventWorkspace &input, DataObjects::EventWorkspace &output,
+                   API::Progress *progress) const;
+  void setupOutputSpectra(API::MatrixWorkspace &output) const;
+
+  /// Bin edges in d-spacing the events of each spectrum are histogrammed into
+  std::vector<double> m_edges;
+  /// Bin edges of the focussed spectra in d-spacing
+  std::vector<double> m_focussedEdges;
+  /// Bin width of the focussed spectra over the width covered by the spectra in the group
+  std::vector<double> m_coverageWeights;
+  /// Primary flight path
+  double m_l1{0.};
+  /// The parameters converting each input spectrum to d-spacing
+  std::vector<Kernel::UnitParametersMap> m_parameters;
+  /// Output index of each input spectrum, or -1 if it is not focussed
+  std::vector<int> m_outputIndex;
+  /// The group number of each output spectrum
+  std::vector<int> m_groups;
+  /// The detectors in each output spectrum
+  std::vector<std::set<detid_t>> m_detectorIDs;
+  double m_tofMin{std::numeric_limits<double>::lowest()};
+  double m_tofMax{std::numeric_limits<double>::max()};
+  std::vector<double> m_promptPulses;
+  double m_promptPulseWidth{0.};
+};
+
+} // namespace WorkflowAlgorithms
+} // namespace Mantid
@@ -17,6 +17,8 @@
 #include "MantidDataObjects/OffsetsWorkspace.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ConfigService.h"
@@ -27,6 +29,10 @@
 #include "MantidKernel/PropertyManager.h"
 #include "MantidKernel/PropertyManagerDataService.h"
 #include "MantidKernel/System.h"
+#include "MantidKernel/VectorHelper.h"
+#include "MantidWorkflowAlgorithms/FusedPowderReduction.h"
+
+#include <limits>
 
 using Mantid::Geometry::Instrument_const_sptr;
 using namespace Mantid::Kernel;
@@ -80,6 +86,7 @@ const std::string LORENTZ("LorentzCorrection");
 const std::string UNWRAP_REF("UnwrapRef");
 const std::string LOWRES_REF("LowResRef");
 const std::string LOWRES_SPEC_OFF("LowResSpectrumOffset");
+const std::string FUSED_REDUCTION("FusedReduction");
 } // namespace PropertyNames
 } // namespace
 
@@ -232,6 +239,12 @@ void AlignAndFocusPowder::init() {
                   "Otherwise, the low resolution spectra will have spectrum "
                   "IDs offset from normal ones. ");
   declareProperty(PropertyNames::PM_NAME, "__powdereduction", Direction::Input);
+  declareProperty(PropertyNames::FUSED_REDUCTION, false,
+                  "If true, crop, remove the prompt pulse, mask, calibrate, bin and focus the events in a single "
+                  "pass instead of running each step as a separate algorithm. Only used for an EventWorkspace "
+                  "binned in d-spacing with Params and a grouping, and without the resonance, Lorentz, wavelength, "
+                  "unwrapping, low resolution, MaskBinTable or UnfocussedWorkspace options. The output is binned "
+                  "and normalised as DiffractionFocussing does it.");
 }
 
 std::map<std::string, std::string> AlignAndFocusPowder::validateInputs() {
@@ -440,6 +453,17 @@ void AlignAndFocusPowder::exec() {
 
   loadCalFile(calFilename, groupFilename);
 
+  if (getProperty(PropertyNames::FUSED_REDUCTION)) {
+    if (canFuseReduction(maskBinTableWS, applyLorentz)) {
+      m_outputW = fusedReduction();
+      m_progress = std::make_unique<Progress>(this, 0.8, 1., 4);
+      finishFocussing(compressEventsTolerance, wallClockTolerance);
+      setProperty("OutputWorkspace", m_outputW);
+      return;
+    }
+    g_log.notice("The fused reduction does not support the options given, running each step separately\n");
+  }
+
   // Now setup the output workspace
   m_outputW = getProperty(PropertyNames::OUTPUT_WKSP);
   if (m_inputEW) {
@@ -771,6 +795,84 @@ void AlignAndFocusPowder::exec() {
   }
   m_progress->report();
 
+  finishFocussing(compressEventsTolerance, wallClockTolerance);
+
+  if (!dspace && !m_delta_ragged.empty()) {
+    m_outputW = rebinRagged(m_outputW, false);
+  }
+
+  // return the output workspace
+  setProperty("OutputWorkspace", m_outputW);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Check whether the requested steps can all be done by FusedPowderReduction
+ * @param maskBinTableWS :: The MaskBinTable, if any
+ * @param applyLorentz :: Whether the Lorentz correction was requested
+ * @return true if the fused reduction gives the requested output
+ */
+bool AlignAndFocusPowder::canFuseReduction(const DataObjects::TableWorkspace_sptr &maskBinTableWS,
+                                           const bool applyLorentz) {
+  if (!m_inputEW || !m_groupWS || !dspace)
+    return false;
+  if (m_resampleX != 0 || !m_delta_ragged.empty() || m_params.size() < 3)
+    return false;
+  if (maskBinTableWS || applyLorentz || !m_resonanceLower.empty() || m_processLowResTOF)
+    return false;
+  if (LRef > 0. || minwl > 0. || !isEmpty(maxwl) || DIFCref > 0.)
+    return false;
+  return isDefault(PropertyNames::UNFOCUS_WKSP);
+}
+
+//----------------------------------------------------------------------------------------------
+/** Focus the input events into d-spacing in a single pass. This replaces
+ * CompressEvents, CropWorkspace, RemovePromptPulse, MaskDetectors, ApplyDiffCal,
+ * ConvertUnits, Rebin and DiffractionFocussing; the input is not copied.
+ * @return the focussed workspace in d-spacing, histograms unless PreserveEvents is set
+ */
+API::MatrixWorkspace_sptr AlignAndFocusPowder::fusedReduction() {
+  g_log.information() << "running the fused reduction started at " << Types::Core::DateAndTime::getCurrentTime()
+                      << "\n";
+
+  // The calibration is applied to a copy of the instrument that holds no events
+  MatrixWorkspace_sptr calibrated = create<Workspace2D>(*m_inputW, m_inputW->indexInfo(), HistogramData::BinEdges(2));
+  if (m_calibrationWS) {
+    API::IAlgorithm_sptr applyDiffCalAlg = createChildAlgorithm("ApplyDiffCal");
+    applyDiffCalAlg->setProperty("InstrumentWorkspace", std::dynamic_pointer_cast<Workspace>(calibrated));
+    applyDiffCalAlg->setProperty("CalibrationWorkspace", m_calibrationWS);
+    applyDiffCalAlg->executeAsChildAlg();
+  }
+
+  std::vector<double> edges;
+  VectorHelper::createAxisFromRebinParams(m_params, edges);
+  FusedPowderReduction reduction(*calibrated, *m_groupWS, m_maskWS.get(), edges);
+  reduction.setTofRange(xmin, xmax > 0. ? xmax : std::numeric_limits<double>::max());
+  const double removePromptPulseWidth = getProperty(PropertyNames::REMOVE_PROMPT_PULSE);
+  if (removePromptPulseWidth > 0.) {
+    double tofMin, tofMax;
+    m_inputEW->getEventXMinMax(tofMin, tofMax);
+    reduction.setPromptPulses(FusedPowderReduction::promptPulseTimes(m_inputEW->run(), tofMin, tofMax),
+                              removePromptPulseWidth);
+  }
+
+  Progress progress(this, 0., 0.8, m_inputEW->getNumberHistograms());
+  MatrixWorkspace_sptr output;
+  if (m_preserveEvents) {
+    output = reduction.focusToEvents(*m_inputEW, &progress);
+    doSortEvents(output);
+  } else {
+    output = reduction.focusToHistograms(*m_inputEW, &progress);
+  }
+  return output;
+}
+
+//----------------------------------------------------------------------------------------------
+/** Edit the instrument of the focussed workspace, convert it back to
+ * time-of-flight and compress its events.
+ * @param compressEventsTolerance :: CompressEvents tolerance, 0 to skip compressing
+ * @param wallClockTolerance :: CompressEvents wall-clock tolerance
+ */
+void AlignAndFocusPowder::finishFocussing(const double compressEventsTolerance, const double wallClockTolerance) {
   // edit the instrument geometry
   if (m_groupWS && (m_l1 > 0 || !tths.empty() || !l2s.empty() || !phis.empty())) {
     size_t numreg = m_outputW->getNumberHistograms();
@@ -825,13 +927,6 @@ void AlignAndFocusPowder::exec() {
     m_outputW = std::dynamic_pointer_cast<MatrixWorkspace>(m_outputEW);
   }
   m_progress->report();
-
-  if (!dspace && !m_delta_ragged.empty()) {
-    m_outputW = rebinRagged(m_outputW, false);
-  }
-
-  // return the output workspace
-  setProperty("OutputWorkspace", m_outputW);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -0,0 +1,420 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2022 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidWorkflowAlgorithms/FusedPowderReduction.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/Progress.h"
+#include "MantidAPI/Run.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidHistogramData/LogarithmicGenerator.h"
+#include "MantidKernel/DeltaEMode.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/TimeSeriesProperty.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/VectorHelper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <type_traits>
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using Mantid::HistogramData::BinEdges;
+using Mantid::Kernel::UnitParams;
+using Mantid::Types::Event::TofEvent;
+
+namespace Mantid::WorkflowAlgorithms {
+
+namespace {
+/// @return the median of a time series log, or EMPTY_DBL if there is no such log
+double getMedian(const Run &run, const std::string &name) {
+  if (!run.hasProperty(name))
+    return EMPTY_DBL();
+  auto *log = dynamic_cast<Kernel::TimeSeriesProperty<double> *>(run.getLogData(name));
+  if (!log)
+    return EMPTY_DBL();
+  return log->getStatistics().median;
+}
+
+/// Copies of the events moved to a new time-of-flight
+TofEvent atTof(const TofEvent &event, const double tof) { return TofEvent(tof, event.pulseTime()); }
+WeightedEvent atTof(const WeightedEvent &event, const double tof) {
+  return WeightedEvent(tof, event.pulseTime(), event.weight(), event.errorSquared());
+}
+WeightedEventNoTime atTof(const WeightedEventNoTime &event, const double tof) {
+  return WeightedEventNoTime(tof, event.weight(), event.errorSquared());
+}
+} // namespace
+
+/**
+ * Constructor: works out which group each spectrum is focussed into and how
+ * its events are converted to d-spacing.
+ *
+ * A spectrum is left out if its detectors are not all in the same group, if
+ * it is masked in the instrument or any of its detectors is in the mask
+ * workspace, or if it can not be converted to d-spacing, as
+ * DiffractionFocussing, MaskDetectors and ConvertUnits would do.
+ *
+ * The focussed bins and the share of each of them covered by the spectra are
+ * worked out here as DiffractionFocussing does for spectra binned with
+ * dSpacingEdges.
+ * @param calibrated :: A workspace with the same spectra as the data, with any
+ * calibration applied to its instrument
+ * @param grouping :: The grouping of the detectors
+ * @param mask :: Masked detectors (optional)
+ * @param dSpacingEdges :: Bin edges the events of each spectrum are histogrammed into, as Rebin would
+ * @throw std::invalid_argument if there is not at least one bin
+ * @throw std::runtime_error if no spectrum is in a group
+ */
+FusedPowderReduction::FusedPowderReduction(const MatrixWorkspace &calibrated, const GroupingWorkspace &grouping,
+                                           const MaskWorkspace *mask, std::vector<double> dSpacingEdges)
+    : m_edges(std::move(dSpacingEdges)) {
+  if (m_edges.size() < 2)
+    throw std::invalid_argument("FusedPowderReduction: at least one d-spacing bin is needed");
+
+  // DiffractionFocussing bins each group logarithmically over the range of
+  // its spectra, with the number of bins they have
+  const auto nBins = static_cast<int>(m_edges.size() - 1);
+  double xMin = m_edges.front();
+  const double xMax = m_edges.back();
+  if (xMin <= 0)
+    xMin = xMax / nBins;
+  if (xMin <= 0)
+    xMin = 1.0;
+  const double step = std::expm1((std::log(xMax) - std::log(xMin)) / nBins);
+  m_focussedEdges = BinEdges(nBins + 1, HistogramData::LogarithmicGenerator(xMin, step)).rawData();
+
+  // and weights every bin by its width over the width the spectra cover in
+  // it. All the spectra are binned over the same range, so the weights do not
+  // depend on the size of the group.
+  std::vector<double> covered(nBins, 0.), unused(nBins, 0.);
+  Kernel::VectorHelper::rebin({m_edges.front(), m_edges.back()}, {1.}, {0.}, m_focussedEdges, covered, unused, true,
+                              true);
+  m_coverageWeights.resize(nBins);
+  for (int i = 0; i < nBins; ++i)
+    m_coverageWeights[i] = (m_focussedEdges[i + 1] - m_focussedEdges[i]) / covered[i];
+
+  std::vector<int> detIDToGroup;
+  int64_t nGroups(0);
+  grouping.makeDetectorIDToGroupVector(detIDToGroup, nGroups);
+  const auto groupOf = [&detIDToGroup](const detid_t detID) {
+    return (detID >= 0 && static_cast<size_t>(detID) < detIDToGroup.size()) ? detIDToGroup[detID] : 0;
+  };
+
+  const auto maskedDetectors = mask ? mask->getMaskedDetectors() : std::set<detid_t>();
+
+  const auto &spectrumInfo = calibrated.spectrumInfo();
+  m_l1 = spectrumInfo.l1();
+  const auto nHist = static_cast<int64_t>(calibrated.getNumberHistograms());
+  std::vector<int> spectrumGroup(nHist, 0);
+  m_parameters.resize(nHist);
+  const Kernel::Units::TOF tofUnit;
+  const Kernel::Units::dSpacing dSpacingUnit;
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < nHist; ++i) {
+    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMonitor(i) || spectrumInfo.isMasked(i))
+      continue;
+    const auto &detIDs = calibrated.getSpectrum(i).getDetectorIDs();
+    const int group = groupOf(*detIDs.cbegin());
+    if (group <= 0 ||
+        std::any_of(detIDs.cbegin(), detIDs.cend(), [&](const detid_t detID) { return groupOf(detID) != group; }))
+      continue;
+    if (std::any_of(detIDs.cbegin(), detIDs.cend(),
+                    [&maskedDetectors](const detid_t detID) { return maskedDetectors.count(detID) > 0; }))
+      continue;
+
+    auto &parameters = m_parameters[i];
+    parameters[UnitParams::delta] = 0.;
+    spectrumInfo.getDetectorValues(tofUnit, dSpacingUnit, Kernel::DeltaEMode::Elastic, false, i, parameters);
+    try {
+      createConverter(i);
+    } catch (std::runtime_error &) {
+      continue;
+    }
+    spectrumGroup[i] = group;
+  }
+
+  // The output spectra are in increasing group number
+  std::map<int, std::set<detid_t>> groupDetectors;
+  for (int64_t i = 0; i < nHist; ++i) {
+    if (spectrumGroup[i] > 0) {
+      const auto &detIDs = calibrated.getSpectrum(i).getDetectorIDs();
+      groupDetectors[spectrumGroup[i]].insert(detIDs.cbegin(), detIDs.cend());
+    }
+  }
+  if (groupDetectors.empty())
+    throw std::runtime_error("FusedPowderReduction: no spectra are in a group");
+  std::map<int, int> outputIndexOfGroup;
+  for (auto &item : groupDetectors) {
+    outputIndexOfGroup[item.first] = static_cast<int>(m_groups.size());
+    m_groups.emplace_back(item.first);
+    m_detectorIDs.emplace_back(std::move(item.second));
+  }
+  m_outputIndex.assign(nHist, -1);
+  for (int64_t i = 0; i < nHist; ++i) {
+    if (spectrumGroup[i] > 0)
+      m_outputIndex[i] = outputIndexOfGroup[spectrumGroup[i]];
+  }
+}
+
+/**
+ * Focus the events into histograms of the counts in each group. The events
+ * are summed in the requested bins, then rebinned onto the focussed bins and
+ * weighted by their coverage, as DiffractionFocussing does with the spectra.
+ * @param input :: The events to focus, with the same spectra as the workspace
+ * given to the constructor
+ * @param progress :: Reports one step per input spectrum (optional)
+ * @return a Workspace2D in d-spacing with one spectrum per group
+ */
+MatrixWorkspace_sptr FusedPowderReduction::focusToHistograms(const EventWorkspace &input, Progress *progress) const {
+  const size_t nBins = m_edges.size() - 1;
+  const size_t size = m_groups.size() * nBins;
+  const auto nHist = static_cast<int64_t>(input.getNumberHistograms());
+
+  // Each thread fills its own histograms so the events are added without
+  // locking. They are summed once all the events are in.
+  std::vector<std::vector<double>> threadY(PARALLEL_GET_MAX_THREADS);
+  std::vector<std::vector<double>> threadE2(PARALLEL_GET_MAX_THREADS);
+  PARALLEL_FOR_IF(Kernel::threadSafe(input))
+  for (int64_t i = 0; i < nHist; ++i) {
+    const int outputIndex = m_outputIndex[i];
+    if (outputIndex >= 0) {
+      auto &y = threadY[PARALLEL_THREAD_NUMBER];
+      auto &e2 = threadE2[PARALLEL_THREAD_NUMBER];
+      if (y.empty()) {
+        y.assign(size, 0.);
+        e2.assign(size, 0.);
+      }
+      const auto converter = createConverter(i);
+      const auto offset = static_cast<size_t>(outputIndex) * nBins;
+      const auto &el = input.getSpectrum(i);
+      switch (el.getEventType()) {
+      case TOF:
+        histogram(el.getEvents(), *converter, &y[offset], &e2[offset]);
+        break;
+      case WEIGHTED:
+        histogram(el.getWeightedEvents(), *converter, &y[offset], &e2[offset]);
+        break;
+      case WEIGHTED_NOTIME:
+        histogram(el.getWeightedEventsNoTime(), *converter, &y[offset], &e2[offset]);
+        break;
+      }
+    }
+    if (progress)
+      progress->report();
+  }
+
+  std::vector<double> y(size, 0.);
+  std::vector<double> e2(size, 0.);
+  for (size_t thread = 0; thread < threadY.size(); ++thread) {
+    if (threadY[thread].empty())
+      continue;
+    std::transform(y.cbegin(), y.cend(), threadY[thread].cbegin(), y.begin(), std::plus<double>());
+    std::transform(e2.cbegin(), e2.cend(), threadE2[thread].cbegin(), e2.begin(), std::plus<double>());
+  }
+
+  MatrixWorkspace_sptr output = create<Workspace2D>(input, m_groups.size(), BinEdges(m_focussedEdges));
+  setupOutputSpectra(*output);
+  const size_t nFocussedBins = m_focussedEdges.size() - 1;
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t outputIndex = 0; outputIndex < static_cast<int64_t>(m_groups.size()); ++outputIndex) {
+    const auto first = static_cast<std::ptrdiff_t>(outputIndex * nBins);
+    const std::vector<double> groupY(y.cbegin() + first, y.cbegin() + first + nBins);
+    std::vector<double> groupE(nBins);
+    std::transform(e2.cbegin() + first, e2.cbegin() + first + nBins, groupE.begin(),
+                   static_cast<double (*)(double)>(std::sqrt));
+    std::vector<double> focussedY(nFocussedBins), focussedE(nFocussedBins);
+    Kernel::VectorHelper::rebinHistogram(m_edges, groupY, groupE, m_focussedEdges, focussedY, focussedE, false);
+    std::transform(focussedY.cbegin(), focussedY.cend(), m_coverageWeights.cbegin(), focussedY.begin(),
+                   std::multiplies<double>());
+    std::transform(focussedE.cbegin(), focussedE.cend(), m_coverageWeights.cbegin(), focussedE.begin(),
+                   std::multiplies<double>());
+    output->mutableY(outputIndex) = focussedY;
+    output->mutableE(outputIndex) = focussedE;
+  }
+  return output;
+}
+
+/**
+ * Focus the events into one event list per group, converted to d-spacing.
+ * The events keep their weights and, if all the input events have them,
+ * their pulse times. They are binned in the focussed bins.
+ * @param input :: The events to focus, with the same spectra as the workspace
+ * given to the constructor
+ * @param progress :: Reports one step per input spectrum (optional)
+ * @return an EventWorkspace in d-spacing with one spectrum per group
+ */
+EventWorkspace_sptr FusedPowderReduction::focusToEvents(const EventWorkspace &input, Progress *progress) const {
+  EventWorkspace_sptr output = create<EventWorkspace>(input, m_groups.size(), BinEdges(m_focussedEdges));
+  setupOutputSpectra(*output);
+  switch (input.getEventType()) {
+  case TOF:
+    focusEvents<TofEvent>(input, *output, progress);
+    break;
+  case WEIGHTED:
+    focusEvents<WeightedEvent>(input, *output, progress);
+    break;
+  case WEIGHTED_NOTIME:
+    focusEvents<WeightedEventNoTime>(input, *output, progress);
+    break;
+  }
+  return output;
+}
+
+/**
+ * The times of the prompt pulses between two times-of-flight, from the
+ * frequency logs of the run as RemovePromptPulse finds them.
+ * @param run :: The run holding the frequency log
+ * @param tofMin :: The shortest time-of-flight in the data
+ * @param tofMax :: The longest time-of-flight in the data
+ * @return the prompt pulse times in microseconds
+ * @throw std::runtime_error if the frequency can not be found
+ */
+std::vector<double> FusedPowderReduction::promptPulseTimes(const Run &run, const double tofMin, const double tofMax) {
+  double frequency = EMPTY_DBL();
+  for (const auto &name : {"Frequency", "frequency", "FREQUENCY"}) {
+    frequency = getMedian(run, name);
+    if (frequency != EMPTY_DBL())
+      break;
+  }
+  if (frequency == EMPTY_DBL())
+    throw std::runtime_error("Failed to determine the frequency");
+
+  const double period = 1000000. / frequency; // period in microseconds
+  std::vector<double> times;
+  double time = 0.;
+  while (time < tofMin)
+    time += period;
+  while (time < tofMax) {
+    times.emplace_back(time);
+    time += period;
+  }
+  return times;
+}
+
+/// @return a unit converting time-of-flight to d-spacing for an input spectrum
+std::unique_ptr<Kernel::Unit> FusedPowderReduction::createConverter(const size_t wsIndex) const {
+  auto converter = std::make_unique<Kernel::Units::dSpacing>();
+  converter->initialize(m_l1, 0, m_parameters[wsIndex]);
+  return converter;
+}
+
+/**
+ * Add the events of one spectrum to the histogram of its group
+ * @param events :: The events of the spectrum
+ * @param converter :: Converts the events to d-spacing
+ * @param y :: The counts of the group
+ * @param e2 :: The squared errors of the group
+ */
+template <typename EventType>
+void FusedPowderReduction::histogram(const std::vector<EventType> &events, const Kernel::Unit &converter, double *y,
+                                     double *e2) const {
+  const auto nBins = static_cast<std::ptrdiff_t>(m_edges.size() - 1);
+  for (const auto &event : events) {
+    const double tof = event.tof();
+    if (!keep(tof))
+      continue;
+    const double d = converter.singleFromTOF(tof);
+    const auto bin = std::upper_bound(m_edges.cbegin(), m_edges.cend(), d) - m_edges.cbegin() - 1;
+    if (bin < 0 || bin >= nBins)
+      continue;
+    y[bin] += event.weight();
+    e2[bin] += event.errorSquared();
+  }
+}
+
+/**
+ * Convert the surviving events of one spectrum to d-spacing
+ * @param events :: The events of the spectrum
+ * @param converter :: Converts the events to d-spacing
+ * @param converted :: The converted events are appended here
+ */
+template <typename OutputType, typename EventType>
+void FusedPowderReduction::convert(const std::vector<EventType> &events, const Kernel::Unit &converter,
+                                   std::vector<OutputType> &converted) const {
+  if constexpr (std::is_constructible_v<OutputType, const EventType &>) {
+    for (const auto &event : events) {
+      const double tof = event.tof();
+      if (keep(tof))
+        converted.emplace_back(atTof(event, converter.singleFromTOF(tof)));
+    }
+  } else {
+    // EventWorkspace::getEventType is the most general type of its lists
+    throw std::logic_error("FusedPowderReduction: the events can not be converted to the output type");
+  }
+}
+
+/**
+ * Convert the events of every spectrum, then move them into their groups
+ * @param input :: The events to focus
+ * @param output :: The focussed workspace
+ * @param progress :: Reports one step per input spectrum (optional)
+ */
+template <typename OutputType>
+void FusedPowderReduction::focusEvents(const EventWorkspace &input, EventWorkspace &output, Progress *progress) const {
+  const auto nHist = static_cast<int64_t>(input.getNumberHistograms());
+  std::vector<std::vector<OutputType>> converted(nHist);
+  PARALLEL_FOR_IF(Kernel::threadSafe(input))
+  for (int64_t i = 0; i < nHist; ++i) {
+    if (m_outputIndex[i] >= 0) {
+      const auto converter = createConverter(i);
+      const auto &el = input.getSpectrum(i);
+      switch (el.getEventType()) {
+      case TOF:
+        convert(el.getEvents(), *converter, converted[i]);
+        break;
+      case WEIGHTED:
+        convert(el.getWeightedEvents(), *converter, converted[i]);
+        break;
+      case WEIGHTED_NOTIME:
+        convert(el.getWeightedEventsNoTime(), *converter, converted[i]);
+        break;
+      }
+    }
+    if (progress)
+      progress->report();
+  }
+
+  std::vector<std::vector<size_t>> inputIndices(m_groups.size());
+  for (int64_t i = 0; i < nHist; ++i) {
+    if (m_outputIndex[i] >= 0)
+      inputIndices[m_outputIndex[i]].emplace_back(i);
+  }
+  const auto eventType = input.getEventType();
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t outputIndex = 0; outputIndex < static_cast<int64_t>(m_groups.size()); ++outputIndex) {
+    auto &el = output.getSpectrum(outputIndex);
+    el.switchTo(eventType);
+    std::vector<OutputType> *events;
+    getEventsFrom(el, events);
+    size_t numberOfEvents(0);
+    for (const auto i : inputIndices[outputIndex])
+      numberOfEvents += converted[i].size();
+    events->reserve(numberOfEvents);
+    for (const auto i : inputIndices[outputIndex]) {
+      events->insert(events->end(), converted[i].cbegin(), converted[i].cend());
+      std::vector<OutputType>().swap(converted[i]);
+    }
+    el.setSortOrder(UNSORTED);
+  }
+  output.clearMRU();
+}
+
+/// Number the output spectra by group, give them the detectors of their group and set the unit to d-spacing
+void FusedPowderReduction::setupOutputSpectra(MatrixWorkspace &output) const {
+  for (size_t outputIndex = 0; outputIndex < m_groups.size(); ++outputIndex) {
+    auto &spectrum = output.getSpectrum(outputIndex);
+    spectrum.setSpectrumNo(m_groups[outputIndex]);
+    spectrum.setDetectorIDs(m_detectorIDs[outputIndex]);
+  }
+  output.getAxis(0)->unit() = Kernel::UnitFactory::Instance().create("dSpacing");
+}
+
+} // namespace Mantid::WorkflowAlgorithms
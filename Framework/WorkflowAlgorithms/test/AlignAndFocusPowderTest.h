@@ -9,8 +9,11 @@
 #include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
 #include <cxxtest/TestSuite.h>
 
+#include <numeric>
+
 #include "MantidAPI/Axis.h"
 #include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/TableRow.h"
 #include "MantidAlgorithms/AddSampleLog.h"
 #include "MantidAlgorithms/AddTimeSeriesLog.h"
@@ -651,6 +654,103 @@ public:
     AnalysisDataService::Instance().remove(m_outputWS);
   }
 
+  void testEventWksp_fusedReduction_preserveEvents() {
+    setUp_EventWorkspace("EventWksp_fusedReduction_preserveEvents");
+    doTestFusedReduction(true);
+  }
+
+  void testEventWksp_fusedReduction_doNotPreserveEvents() {
+    setUp_EventWorkspace("EventWksp_fusedReduction_doNotPreserveEvents");
+    doTestFusedReduction(false);
+  }
+
+  void testEventWksp_fusedReduction_cropAndRemovePromptPulse_preserveEvents() {
+    setUp_EventWorkspace("EventWksp_fusedReduction_cropAndRemovePromptPulse_preserveEvents");
+    addFrequencyLog(m_inputWS);
+    doTestFusedReduction(true, true);
+  }
+
+  void testEventWksp_fusedReduction_cropAndRemovePromptPulse_doNotPreserveEvents() {
+    setUp_EventWorkspace("EventWksp_fusedReduction_cropAndRemovePromptPulse_doNotPreserveEvents");
+    addFrequencyLog(m_inputWS);
+    doTestFusedReduction(false, true);
+  }
+
+  void testEventWksp_fusedReduction_skipsMaskedSpectra() {
+    setUp_EventWorkspace("EventWksp_fusedReduction_skipsMaskedSpectra");
+    // Mask half of the spectra in the instrument only, keeping their events
+    const auto inputWS = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(m_inputWS);
+    auto &spectrumInfo = inputWS->mutableSpectrumInfo();
+    for (size_t i = 0; i < inputWS->getNumberHistograms() / 2; ++i)
+      spectrumInfo.setMasked(i, true);
+    doTestFusedReduction(true);
+  }
+
+  /* Focus the input with and without FusedReduction and compare every bin */
+  void doTestFusedReduction(const bool preserveEvents, const bool cropAndRemovePromptPulse = false) {
+    groupAllBanks(m_inputWS);
+    const std::string separateWS = m_outputWS + "_separate";
+    const std::string fusedWS = m_outputWS + "_fused";
+    for (const bool fused : {false, true}) {
+      AlignAndFocusPowder align_and_focus;
+      align_and_focus.initialize();
+      align_and_focus.setPropertyValue("InputWorkspace", m_inputWS);
+      align_and_focus.setPropertyValue("OutputWorkspace", fused ? fusedWS : separateWS);
+      align_and_focus.setPropertyValue("GroupingWorkspace", m_groupWS);
+      align_and_focus.setProperty("Dspacing", true);
+      align_and_focus.setPropertyValue("Params", "0.05,-0.002,3.5");
+      align_and_focus.setProperty("PreserveEvents", preserveEvents);
+      if (cropAndRemovePromptPulse) {
+        align_and_focus.setProperty("TMin", 1000.);
+        align_and_focus.setProperty("TMax", 15000.);
+        align_and_focus.setProperty("RemovePromptPulseWidth", 500.);
+      }
+      align_and_focus.setProperty("FusedReduction", fused);
+      TS_ASSERT_THROWS_NOTHING(align_and_focus.execute());
+      TS_ASSERT(align_and_focus.isExecuted());
+    }
+
+    const auto separate = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(separateWS);
+    const auto fused = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(fusedWS);
+    TS_ASSERT_EQUALS(fused->getAxis(0)->unit()->unitID(), "TOF");
+    TS_ASSERT_EQUALS(fused->getNumberHistograms(), separate->getNumberHistograms());
+    TS_ASSERT_EQUALS(fused->blocksize(), separate->blocksize());
+    TS_ASSERT_EQUALS(std::dynamic_pointer_cast<EventWorkspace>(fused) != nullptr, preserveEvents);
+    for (size_t i = 0; i < fused->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(fused->getSpectrum(i).getSpectrumNo(), separate->getSpectrum(i).getSpectrumNo());
+      TS_ASSERT_EQUALS(fused->x(i).rawData(), separate->x(i).rawData());
+      const auto &fusedY = fused->y(i);
+      const auto &separateY = separate->y(i);
+      TS_ASSERT_LESS_THAN(0., std::accumulate(separateY.begin(), separateY.end(), 0.));
+      for (size_t j = 0; j < fusedY.size(); ++j) {
+        if (preserveEvents) {
+          // The same events are in each bin
+          TS_ASSERT_EQUALS(fusedY[j], separateY[j]);
+        } else {
+          // Only the order the counts are added in differs
+          TS_ASSERT_DELTA(fusedY[j], separateY[j], 1e-9 * std::max(1., separateY[j]));
+          TS_ASSERT_DELTA(fused->e(i)[j], separate->e(i)[j], 1e-9 * std::max(1., separate->e(i)[j]));
+        }
+      }
+    }
+
+    AnalysisDataService::Instance().remove(m_inputWS);
+    AnalysisDataService::Instance().remove(m_groupWS);
+    AnalysisDataService::Instance().remove(separateWS);
+    AnalysisDataService::Instance().remove(fusedWS);
+  }
+
+  /* Add a 120 Hz frequency log, putting a prompt pulse at 8333 microseconds */
+  void addFrequencyLog(const std::string &wkspname) {
+    AddTimeSeriesLog logAlg;
+    logAlg.initialize();
+    logAlg.setPropertyValue("Workspace", wkspname);
+    logAlg.setPropertyValue("Name", "frequency");
+    logAlg.setPropertyValue("Time", "2010-01-01T00:00:00");
+    logAlg.setPropertyValue("Value", "120");
+    logAlg.execute();
+  }
+
   /* Setup for event data. The caller supplies the workspace name */
 
   void setUp_EventWorkspace(const std::string &wkspname) {